@@ -0,0 +1,25 @@
+-- Analytics Indexes Migration
+-- Covering indexes for the aggregate queries in AnalyticsRepository
+-- (per-engineer and per-area score rollups read only the index, not the table)
+
+USE training_matrix;
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_core_skill_assessments_engineer_score' AND object_id = OBJECT_ID('core_skill_assessments'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_core_skill_assessments_engineer_score]
+        ON [dbo].[core_skill_assessments]([engineer_id]) INCLUDE ([score], [skill_id]);
+    PRINT 'Created index: IX_core_skill_assessments_engineer_score';
+END
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_assessments_area_score' AND object_id = OBJECT_ID('assessments'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_assessments_area_score]
+        ON [dbo].[assessments]([production_area_id]) INCLUDE ([score]);
+    PRINT 'Created index: IX_assessments_area_score';
+END
+GO
+
+PRINT 'Analytics indexes migration complete';
+GO
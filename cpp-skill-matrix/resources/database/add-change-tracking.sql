@@ -0,0 +1,99 @@
+-- Change Tracking Migration
+-- Adds ROWVERSION columns and delete tombstones so clients can fetch only the
+-- rows changed since their last sync (see ChangeTracking / findChangedSince)
+
+USE training_matrix;
+GO
+
+-- Row versions on tracked tables
+IF NOT EXISTS (SELECT * FROM sys.columns WHERE object_id = OBJECT_ID(N'[dbo].[engineers]') AND name = 'row_version')
+BEGIN
+    ALTER TABLE [dbo].[engineers] ADD [row_version] ROWVERSION;
+    PRINT 'Added row_version to engineers';
+END
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.columns WHERE object_id = OBJECT_ID(N'[dbo].[assessments]') AND name = 'row_version')
+BEGIN
+    ALTER TABLE [dbo].[assessments] ADD [row_version] ROWVERSION;
+    PRINT 'Added row_version to assessments';
+END
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.columns WHERE object_id = OBJECT_ID(N'[dbo].[core_skill_assessments]') AND name = 'row_version')
+BEGIN
+    ALTER TABLE [dbo].[core_skill_assessments] ADD [row_version] ROWVERSION;
+    PRINT 'Added row_version to core_skill_assessments';
+END
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.columns WHERE object_id = OBJECT_ID(N'[dbo].[certifications]') AND name = 'row_version')
+BEGIN
+    ALTER TABLE [dbo].[certifications] ADD [row_version] ROWVERSION;
+    PRINT 'Added row_version to certifications';
+END
+GO
+
+-- Indexes for "row_version > @mark" range seeks
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_engineers_row_version' AND object_id = OBJECT_ID('engineers'))
+    CREATE NONCLUSTERED INDEX [IX_engineers_row_version] ON [dbo].[engineers]([row_version]);
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_assessments_row_version' AND object_id = OBJECT_ID('assessments'))
+    CREATE NONCLUSTERED INDEX [IX_assessments_row_version] ON [dbo].[assessments]([row_version]);
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_core_skill_assessments_row_version' AND object_id = OBJECT_ID('core_skill_assessments'))
+    CREATE NONCLUSTERED INDEX [IX_core_skill_assessments_row_version] ON [dbo].[core_skill_assessments]([row_version]);
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_certifications_row_version' AND object_id = OBJECT_ID('certifications'))
+    CREATE NONCLUSTERED INDEX [IX_certifications_row_version] ON [dbo].[certifications]([row_version]);
+GO
+
+-- Tombstones for deleted rows (row_version shares the database-wide counter)
+IF NOT EXISTS (SELECT * FROM sys.objects WHERE object_id = OBJECT_ID(N'[dbo].[deleted_rows]') AND type in (N'U'))
+BEGIN
+    CREATE TABLE [dbo].[deleted_rows] (
+        [id] BIGINT IDENTITY(1,1) PRIMARY KEY,
+        [table_name] NVARCHAR(64) NOT NULL,
+        [row_key] NVARCHAR(50) NOT NULL,
+        [deleted_at] DATETIME DEFAULT GETDATE(),
+        [row_version] ROWVERSION
+    );
+    CREATE NONCLUSTERED INDEX [IX_deleted_rows_table_version] ON [dbo].[deleted_rows]([table_name], [row_version]) INCLUDE ([row_key]);
+    PRINT 'Created table: deleted_rows';
+END
+GO
+
+-- Delete triggers (also fire for ON DELETE CASCADE from engineers)
+CREATE OR ALTER TRIGGER [dbo].[TR_engineers_deleted] ON [dbo].[engineers] AFTER DELETE AS
+BEGIN
+    SET NOCOUNT ON;
+    INSERT INTO [dbo].[deleted_rows] ([table_name], [row_key]) SELECT 'engineers', [id] FROM deleted;
+END
+GO
+
+CREATE OR ALTER TRIGGER [dbo].[TR_assessments_deleted] ON [dbo].[assessments] AFTER DELETE AS
+BEGIN
+    SET NOCOUNT ON;
+    INSERT INTO [dbo].[deleted_rows] ([table_name], [row_key]) SELECT 'assessments', CAST([id] AS NVARCHAR(50)) FROM deleted;
+END
+GO
+
+CREATE OR ALTER TRIGGER [dbo].[TR_core_skill_assessments_deleted] ON [dbo].[core_skill_assessments] AFTER DELETE AS
+BEGIN
+    SET NOCOUNT ON;
+    INSERT INTO [dbo].[deleted_rows] ([table_name], [row_key]) SELECT 'core_skill_assessments', CAST([id] AS NVARCHAR(50)) FROM deleted;
+END
+GO
+
+CREATE OR ALTER TRIGGER [dbo].[TR_certifications_deleted] ON [dbo].[certifications] AFTER DELETE AS
+BEGIN
+    SET NOCOUNT ON;
+    INSERT INTO [dbo].[deleted_rows] ([table_name], [row_key]) SELECT 'certifications', CAST([id] AS NVARCHAR(50)) FROM deleted;
+END
+GO
+
+PRINT 'Change tracking migration complete';
+GO
@@ -0,0 +1,101 @@
+-- Keyset Pagination Indexes Migration
+-- Covering indexes for the findPage() queries: each page is a seek to the
+-- cursor followed by a TOP (n) range scan of the index, with no lookups back
+-- into the table and no OFFSET scans (see src/database/Pagination.h)
+
+USE training_matrix;
+GO
+
+-- Engineers: ORDER BY name, id (optionally filtered by shift)
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_engineers_name_id' AND object_id = OBJECT_ID('engineers'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_engineers_name_id]
+        ON [dbo].[engineers]([name], [id]) INCLUDE ([shift], [created_at], [updated_at]);
+    PRINT 'Created index: IX_engineers_name_id';
+END
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_engineers_shift_name_id' AND object_id = OBJECT_ID('engineers'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_engineers_shift_name_id]
+        ON [dbo].[engineers]([shift], [name], [id]) INCLUDE ([created_at], [updated_at]);
+    PRINT 'Created index: IX_engineers_shift_name_id';
+END
+GO
+
+-- Assessments: ORDER BY id (the clustered key covers the unfiltered case)
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_assessments_engineer_id' AND object_id = OBJECT_ID('assessments'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_assessments_engineer_id]
+        ON [dbo].[assessments]([engineer_id], [id])
+        INCLUDE ([production_area_id], [machine_id], [competency_id], [score], [created_at], [updated_at]);
+    PRINT 'Created index: IX_assessments_engineer_id';
+END
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_assessments_area_id' AND object_id = OBJECT_ID('assessments'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_assessments_area_id]
+        ON [dbo].[assessments]([production_area_id], [id])
+        INCLUDE ([engineer_id], [machine_id], [competency_id], [score], [created_at], [updated_at]);
+    PRINT 'Created index: IX_assessments_area_id';
+END
+GO
+
+-- Certifications: ORDER BY id (the clustered key covers the unfiltered case)
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_certifications_engineer_id' AND object_id = OBJECT_ID('certifications'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_certifications_engineer_id]
+        ON [dbo].[certifications]([engineer_id], [id])
+        INCLUDE ([name], [date_earned], [expiry_date], [created_at]);
+    PRINT 'Created index: IX_certifications_engineer_id';
+END
+GO
+
+-- Users: ORDER BY username (unique)
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_users_username' AND object_id = OBJECT_ID('users'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_users_username]
+        ON [dbo].[users]([username])
+        INCLUDE ([password], [role], [engineer_id], [created_at], [updated_at]);
+    PRINT 'Created index: IX_users_username';
+END
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_users_role_username' AND object_id = OBJECT_ID('users'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_users_role_username]
+        ON [dbo].[users]([role], [username])
+        INCLUDE ([password], [engineer_id], [created_at], [updated_at]);
+    PRINT 'Created index: IX_users_role_username';
+END
+GO
+
+-- Audit logs: ORDER BY timestamp DESC, id DESC (replaces IX_audit_logs_timestamp)
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_audit_logs_timestamp_id' AND object_id = OBJECT_ID('audit_logs'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_audit_logs_timestamp_id]
+        ON [dbo].[audit_logs]([timestamp] DESC, [id] DESC)
+        INCLUDE ([user_id], [action], [details], [created_at]);
+    PRINT 'Created index: IX_audit_logs_timestamp_id';
+END
+GO
+
+IF EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_audit_logs_timestamp' AND object_id = OBJECT_ID('audit_logs'))
+BEGIN
+    DROP INDEX [IX_audit_logs_timestamp] ON [dbo].[audit_logs];
+    PRINT 'Dropped index: IX_audit_logs_timestamp (superseded by IX_audit_logs_timestamp_id)';
+END
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_audit_logs_user_timestamp_id' AND object_id = OBJECT_ID('audit_logs'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_audit_logs_user_timestamp_id]
+        ON [dbo].[audit_logs]([user_id], [timestamp] DESC, [id] DESC)
+        INCLUDE ([action], [details], [created_at]);
+    PRINT 'Created index: IX_audit_logs_user_timestamp_id';
+END
+GO
+
+PRINT 'Keyset pagination indexes migration complete';
+GO
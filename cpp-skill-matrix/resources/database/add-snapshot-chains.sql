@@ -0,0 +1,44 @@
+-- Snapshot Chains Migration
+-- Scheduled snapshots are stored as chains: a full checkpoint followed by
+-- delta snapshots holding only the scores changed since the previous one.
+-- checkpoint_id is NULL for checkpoints and names the chain's checkpoint for
+-- deltas (see SnapshotController::materialize). Requires add-snapshot-payload.sql.
+
+USE training_matrix;
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.columns WHERE object_id = OBJECT_ID(N'[dbo].[snapshots]') AND name = 'checkpoint_id')
+BEGIN
+    ALTER TABLE [dbo].[snapshots] ADD [checkpoint_id] NVARCHAR(50) NULL;
+    PRINT 'Added checkpoint_id to snapshots';
+END
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.columns WHERE object_id = OBJECT_ID(N'[dbo].[snapshots]') AND name = 'source')
+BEGIN
+    ALTER TABLE [dbo].[snapshots] ADD [source] NVARCHAR(20) NOT NULL
+        CONSTRAINT [DF_snapshots_source] DEFAULT 'manual';
+    PRINT 'Added source to snapshots';
+END
+GO
+
+-- Replaying a chain reads the checkpoint's deltas in time order
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_snapshots_checkpoint_timestamp' AND object_id = OBJECT_ID('snapshots'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_snapshots_checkpoint_timestamp]
+        ON [dbo].[snapshots]([checkpoint_id], [timestamp]);
+    PRINT 'Created index: IX_snapshots_checkpoint_timestamp';
+END
+GO
+
+-- The scheduler looks up the latest scheduled snapshot
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_snapshots_source_timestamp' AND object_id = OBJECT_ID('snapshots'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_snapshots_source_timestamp]
+        ON [dbo].[snapshots]([source], [timestamp] DESC);
+    PRINT 'Created index: IX_snapshots_source_timestamp';
+END
+GO
+
+PRINT 'Snapshot chains migration complete';
+GO
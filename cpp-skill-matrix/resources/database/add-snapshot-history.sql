@@ -0,0 +1,58 @@
+-- Snapshot History Migration
+-- One row per engineer per snapshot with that engineer's score averages and
+-- materialised scores, written when the snapshot is saved. My Progress reads
+-- an engineer's trend with a single seek instead of decoding every snapshot.
+-- Requires add-snapshot-chains.sql.
+
+USE training_matrix;
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.objects WHERE object_id = OBJECT_ID(N'[dbo].[snapshot_engineer_history]') AND type in (N'U'))
+BEGIN
+    CREATE TABLE [dbo].[snapshot_engineer_history] (
+        [engineer_id] NVARCHAR(50) NOT NULL,
+        [snapshot_id] NVARCHAR(50) NOT NULL,
+        [timestamp] DATETIME NOT NULL,
+        [competency_count] INT NOT NULL,
+        [competency_avg] FLOAT NOT NULL,
+        [core_skill_count] INT NOT NULL,
+        [core_skill_avg] FLOAT NOT NULL,
+        [scores] VARBINARY(MAX) NOT NULL,
+        CONSTRAINT [PK_snapshot_engineer_history] PRIMARY KEY ([engineer_id], [snapshot_id]),
+        CONSTRAINT [FK_snapshot_engineer_history_snapshot] FOREIGN KEY ([snapshot_id])
+            REFERENCES [dbo].[snapshots]([id]) ON DELETE CASCADE
+    );
+    PRINT 'Created table: snapshot_engineer_history';
+END
+GO
+
+-- Trend query: one engineer, newest first
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_snapshot_engineer_history_engineer_timestamp' AND object_id = OBJECT_ID('snapshot_engineer_history'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_snapshot_engineer_history_engineer_timestamp]
+        ON [dbo].[snapshot_engineer_history]([engineer_id], [timestamp] DESC)
+        INCLUDE ([competency_count], [competency_avg], [core_skill_count], [core_skill_avg]);
+    PRINT 'Created index: IX_snapshot_engineer_history_engineer_timestamp';
+END
+GO
+
+-- Cascading deletes look rows up by snapshot
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_snapshot_engineer_history_snapshot' AND object_id = OBJECT_ID('snapshot_engineer_history'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_snapshot_engineer_history_snapshot]
+        ON [dbo].[snapshot_engineer_history]([snapshot_id]);
+    PRINT 'Created index: IX_snapshot_engineer_history_snapshot';
+END
+GO
+
+-- Snapshots written before this migration are indexed in the background
+IF NOT EXISTS (SELECT * FROM sys.columns WHERE object_id = OBJECT_ID(N'[dbo].[snapshots]') AND name = 'history_indexed')
+BEGIN
+    ALTER TABLE [dbo].[snapshots] ADD [history_indexed] BIT NOT NULL
+        CONSTRAINT [DF_snapshots_history_indexed] DEFAULT 0;
+    PRINT 'Added history_indexed to snapshots';
+END
+GO
+
+PRINT 'Snapshot history migration complete';
+GO
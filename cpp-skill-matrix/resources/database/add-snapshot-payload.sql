@@ -0,0 +1,33 @@
+-- Snapshot Payload Migration
+-- Snapshots store the assessment and core skill state as a compressed binary
+-- payload (see src/models/SnapshotCodec.h) instead of a JSON string. The old
+-- data column is kept, nullable, so existing rows stay readable.
+
+USE training_matrix;
+GO
+
+IF NOT EXISTS (SELECT * FROM sys.columns WHERE object_id = OBJECT_ID(N'[dbo].[snapshots]') AND name = 'payload')
+BEGIN
+    ALTER TABLE [dbo].[snapshots] ADD [payload] VARBINARY(MAX) NULL;
+    PRINT 'Added payload to snapshots';
+END
+GO
+
+IF EXISTS (SELECT * FROM sys.columns WHERE object_id = OBJECT_ID(N'[dbo].[snapshots]') AND name = 'data' AND is_nullable = 0)
+BEGIN
+    ALTER TABLE [dbo].[snapshots] ALTER COLUMN [data] NVARCHAR(MAX) NULL;
+    PRINT 'Made snapshots.data nullable';
+END
+GO
+
+-- Snapshot lists are read newest first
+IF NOT EXISTS (SELECT * FROM sys.indexes WHERE name = 'IX_snapshots_timestamp' AND object_id = OBJECT_ID('snapshots'))
+BEGIN
+    CREATE NONCLUSTERED INDEX [IX_snapshots_timestamp]
+        ON [dbo].[snapshots]([timestamp] DESC) INCLUDE ([description], [created_at]);
+    PRINT 'Created index: IX_snapshots_timestamp';
+END
+GO
+
+PRINT 'Snapshot payload migration complete';
+GO
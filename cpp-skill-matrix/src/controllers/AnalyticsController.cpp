@@ -1,9 +1,6 @@
 #include "AnalyticsController.h"
-#include "CoreSkillsController.h"
-#include "EngineerController.h"
-#include "AssessmentController.h"
 #include "CertificationController.h"
-#include "ProductionController.h"
+#include "../database/AnalyticsRepository.h"
 #include "../utils/Logger.h"
 #include "../core/Constants.h"
 
@@ -15,42 +12,18 @@ QMap<QString, int> AnalyticsController::getSkillDistribution()
     lastError_.clear();
     QMap<QString, int> distribution;
 
-    // Initialize distribution
-    distribution["not_assessed"] = 0;
-    distribution["basic"] = 0;
-    distribution["intermediate"] = 0;
-    distribution["advanced"] = 0;
-
-    CoreSkillsController coreCtrl;
-    auto allSkills = coreCtrl.getAllSkills();
-
-    EngineerController engineerCtrl;
-    auto engineers = engineerCtrl.getAllEngineers();
-
-    for (const auto& engineer : engineers) {
-        auto assessments = coreCtrl.getEngineerAssessments(engineer.id());
-
-        // Count assessed skills
-        QMap<QString, bool> assessedSkillIds;
-        for (const auto& assessment : assessments) {
-            assessedSkillIds[assessment.skillId()] = true;
-
-            switch (assessment.score()) {
-                case 0: distribution["not_assessed"]++; break;
-                case 1: distribution["basic"]++; break;
-                case 2: distribution["intermediate"]++; break;
-                case 3: distribution["advanced"]++; break;
-            }
-        }
-
-        // Count not assessed skills
-        for (const auto& skill : allSkills) {
-            if (!assessedSkillIds.contains(skill.id())) {
-                distribution["not_assessed"]++;
-            }
-        }
+    AnalyticsRepository repo;
+    ScoreDistribution scores = repo.findCoreSkillScoreDistribution();
+    if (!repo.lastError().isEmpty()) {
+        lastError_ = repo.lastError();
     }
 
+    // Unassessed skills count as "not_assessed" alongside explicit zero scores
+    distribution["not_assessed"] = scores.countsByScore.value(0) + scores.unassessedCount;
+    distribution["basic"] = scores.countsByScore.value(1);
+    distribution["intermediate"] = scores.countsByScore.value(2);
+    distribution["advanced"] = scores.countsByScore.value(3);
+
     return distribution;
 }
 
@@ -67,23 +40,24 @@ QMap<QString, double> AnalyticsController::getCompletionRatesByShift()
         Constants::SHIFT_DAY
     };
 
-    EngineerController engineerCtrl;
-    CoreSkillsController coreCtrl;
-
     for (const QString& shift : shifts) {
-        auto engineers = engineerCtrl.getEngineersByShift(shift);
+        rates[shift] = 0.0;
+    }
 
-        if (engineers.isEmpty()) {
-            rates[shift] = 0.0;
-            continue;
-        }
+    AnalyticsRepository repo;
+    QList<ShiftSummary> summaries = repo.findShiftSummaries();
+    if (!repo.lastError().isEmpty()) {
+        lastError_ = repo.lastError();
+        return rates;
+    }
 
-        double totalCompletion = 0.0;
-        for (const auto& engineer : engineers) {
-            totalCompletion += coreCtrl.getCompletionPercentage(engineer.id());
+    // Mean of per-engineer completion == assessed skills / (engineers * skills)
+    for (const ShiftSummary& summary : summaries) {
+        if (!rates.contains(summary.shift) || summary.engineerCount == 0 || summary.coreSkillCount == 0) {
+            continue;
         }
-
-        rates[shift] = totalCompletion / engineers.size();
+        rates[summary.shift] = (double)summary.assessedCoreSkillCount /
+                               ((double)summary.engineerCount * summary.coreSkillCount) * 100.0;
     }
 
     return rates;
@@ -94,32 +68,11 @@ QList<QString> AnalyticsController::getTopPerformers(int limit)
     lastError_.clear();
     QList<QString> topPerformers;
 
-    EngineerController engineerCtrl;
-    CoreSkillsController coreCtrl;
-
-    auto engineers = engineerCtrl.getAllEngineers();
-
-    // Create list of (engineerId, avgScore) pairs
-    QList<QPair<QString, double>> engineerScores;
-
-    for (const auto& engineer : engineers) {
-        double avgScore = coreCtrl.getAverageScore(engineer.id());
-        if (avgScore > 0.0) {  // Only include engineers with assessments
-            engineerScores.append(qMakePair(engineer.id(), avgScore));
-        }
-    }
-
-    // Sort by score descending
-    std::sort(engineerScores.begin(), engineerScores.end(),
-              [](const QPair<QString, double>& a, const QPair<QString, double>& b) {
-                  return a.second > b.second;
-              });
-
-    // Get top N
-    int count = qMin(limit, engineerScores.size());
-    for (int i = 0; i < count; i++) {
-        topPerformers.append(engineerScores[i].first);
+    AnalyticsRepository repo;
+    for (const EngineerScoreSummary& summary : repo.findRankedEngineers(limit)) {
+        topPerformers.append(summary.engineerId);
     }
+    lastError_ = repo.lastError();
 
     return topPerformers;
 }
@@ -129,32 +82,11 @@ QList<QString> AnalyticsController::getEngineersNeedingImprovement(int limit)
     lastError_.clear();
     QList<QString> needingImprovement;
 
-    EngineerController engineerCtrl;
-    CoreSkillsController coreCtrl;
-
-    auto engineers = engineerCtrl.getAllEngineers();
-
-    // Create list of (engineerId, avgScore) pairs
-    QList<QPair<QString, double>> engineerScores;
-
-    for (const auto& engineer : engineers) {
-        double avgScore = coreCtrl.getAverageScore(engineer.id());
-        if (avgScore > 0.0) {  // Only include engineers with assessments
-            engineerScores.append(qMakePair(engineer.id(), avgScore));
-        }
-    }
-
-    // Sort by score ascending (lowest first)
-    std::sort(engineerScores.begin(), engineerScores.end(),
-              [](const QPair<QString, double>& a, const QPair<QString, double>& b) {
-                  return a.second < b.second;
-              });
-
-    // Get bottom N
-    int count = qMin(limit, engineerScores.size());
-    for (int i = 0; i < count; i++) {
-        needingImprovement.append(engineerScores[i].first);
+    AnalyticsRepository repo;
+    for (const EngineerScoreSummary& summary : repo.findRankedEngineers(limit, true)) {
+        needingImprovement.append(summary.engineerId);
     }
+    lastError_ = repo.lastError();
 
     return needingImprovement;
 }
@@ -164,27 +96,12 @@ QMap<int, double> AnalyticsController::getProductionAreaCoverage()
     lastError_.clear();
     QMap<int, double> coverage;
 
-    ProductionController prodCtrl;
-    AssessmentController assessmentCtrl;
-
-    auto areas = prodCtrl.getAllProductionAreas();
-
-    for (const auto& area : areas) {
-        auto competencies = prodCtrl.getCompetenciesByProductionArea(area.id());
-        auto assessments = assessmentCtrl.getAssessmentsByProductionArea(area.id());
-
-        int assessedCount = 0;
-        for (const auto& assessment : assessments) {
-            if (assessment.score() > 0) {
-                assessedCount++;
-            }
-        }
-
-        double coveragePercent = competencies.size() > 0 ?
-            (double)assessedCount / competencies.size() * 100.0 : 0.0;
-
-        coverage[area.id()] = coveragePercent;
+    AnalyticsRepository repo;
+    for (const AreaCoverage& area : repo.findProductionAreaCoverage()) {
+        coverage[area.productionAreaId] = area.competencyCount > 0 ?
+            (double)area.assessedCount / area.competencyCount * 100.0 : 0.0;
     }
+    lastError_ = repo.lastError();
 
     return coverage;
 }
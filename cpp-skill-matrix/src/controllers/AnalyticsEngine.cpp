@@ -0,0 +1,397 @@
+#include "AnalyticsEngine.h"
+#include "../database/SkillMatrixStore.h"
+#include "../core/Constants.h"
+#include <QVector>
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Radar axis and weight for every column of a score matrix
+ */
+struct RadarAxes
+{
+    QStringList labels;             // axis index -> label
+    QVector<int> columnAxis;        // column -> axis index, -1 if not charted
+    QVector<double> columnWeight;   // column -> weight
+
+    int axisFor(const QString& label, QHash<QString, int>& axisByLabel)
+    {
+        auto it = axisByLabel.constFind(label);
+        if (it != axisByLabel.constEnd()) {
+            return it.value();
+        }
+        int axis = labels.size();
+        labels.append(label);
+        axisByLabel.insert(label, axis);
+        return axis;
+    }
+};
+
+RadarAxes productionAxes(const ProductionHierarchy& hierarchy, const QList<int>& competencyIds)
+{
+    RadarAxes axes;
+    QHash<QString, int> axisByLabel;
+    axes.columnAxis.fill(-1, competencyIds.size());
+    axes.columnWeight.fill(0.0, competencyIds.size());
+
+    for (int column = 0; column < competencyIds.size(); ++column) {
+        if (!hierarchy.containsCompetency(competencyIds[column])) {
+            continue;
+        }
+        Competency comp = hierarchy.competency(competencyIds[column]);
+        if (!hierarchy.containsMachine(comp.machineId())) {
+            continue;
+        }
+        Machine machine = hierarchy.machine(comp.machineId());
+        if (!hierarchy.containsArea(machine.productionAreaId())) {
+            continue;
+        }
+
+        axes.columnAxis[column] = axes.axisFor(hierarchy.area(machine.productionAreaId()).name(), axisByLabel);
+        // Combined weight: competency weight × machine production impact (+1 to avoid zero weight)
+        axes.columnWeight[column] = comp.calculatedWeight() * (machine.importance() + 1);
+    }
+    return axes;
+}
+
+RadarAxes coreSkillAxes(const QList<CoreSkillCategory>& categories,
+                        const QList<CoreSkill>& skills,
+                        const QList<QString>& skillIds)
+{
+    QHash<QString, QString> categoryNames;
+    for (const CoreSkillCategory& category : categories) {
+        categoryNames.insert(category.id(), category.name());
+    }
+    QHash<QString, int> skillPositions;
+    for (int i = 0; i < skills.size(); ++i) {
+        skillPositions.insert(skills[i].id(), i);
+    }
+
+    RadarAxes axes;
+    QHash<QString, int> axisByLabel;
+    axes.columnAxis.fill(-1, skillIds.size());
+    axes.columnWeight.fill(0.0, skillIds.size());
+
+    for (int column = 0; column < skillIds.size(); ++column) {
+        auto skill = skillPositions.constFind(skillIds[column]);
+        if (skill == skillPositions.constEnd()) {
+            continue;
+        }
+        const CoreSkill& coreSkill = skills[skill.value()];
+        auto category = categoryNames.constFind(coreSkill.categoryId());
+        if (category == categoryNames.constEnd()) {
+            continue;
+        }
+
+        axes.columnAxis[column] = axes.axisFor(category.value(), axisByLabel);
+        axes.columnWeight[column] = coreSkill.calculatedWeight();
+    }
+    return axes;
+}
+
+/**
+ * @brief Weighted average score per axis for one matrix row
+ *
+ * sums/weights are caller-owned scratch buffers sized to the axis count.
+ */
+AnalyticsEngine::RadarData radarForRow(const ScoreGrid& grid, int row, const RadarAxes& axes,
+                                       QVector<double>& sums, QVector<double>& weights)
+{
+    AnalyticsEngine::RadarData radar;
+    if (row < 0) {
+        return radar;
+    }
+
+    sums.fill(0.0, axes.labels.size());
+    weights.fill(0.0, axes.labels.size());
+    grid.forEachInRow(row, [&](int column, int score) {
+        int axis = axes.columnAxis[column];
+        if (axis >= 0) {
+            sums[axis] += score * axes.columnWeight[column];
+            weights[axis] += axes.columnWeight[column];
+        }
+    });
+
+    for (int axis = 0; axis < axes.labels.size(); ++axis) {
+        if (weights[axis] > 0) {
+            radar.insert(axes.labels[axis], sums[axis] / weights[axis]);
+        }
+    }
+    return radar;
+}
+
+/**
+ * @brief Running per-axis mean across engineers (only engineers with a value count)
+ */
+struct RadarAverage
+{
+    QMap<QString, double> totals;
+    QMap<QString, int> counts;
+
+    void add(const AnalyticsEngine::RadarData& data)
+    {
+        for (auto it = data.constBegin(); it != data.constEnd(); ++it) {
+            totals[it.key()] += it.value();
+            counts[it.key()]++;
+        }
+    }
+
+    AnalyticsEngine::RadarData result() const
+    {
+        AnalyticsEngine::RadarData averages;
+        for (auto it = totals.constBegin(); it != totals.constEnd(); ++it) {
+            int count = counts.value(it.key());
+            if (count > 0) {
+                averages.insert(it.key(), it.value() / count);
+            }
+        }
+        return averages;
+    }
+};
+
+} // namespace
+
+AnalyticsEngine::AnalyticsEngine()
+{
+}
+
+AnalyticsEngine::AnalyticsEngine(const QList<Engineer>& engineers,
+                                 const ProductionHierarchy& hierarchy,
+                                 const CompetencyScoreMatrix& competencyScores,
+                                 const QList<CoreSkillCategory>& categories,
+                                 const QList<CoreSkill>& skills,
+                                 const CoreSkillScoreMatrix& coreSkillScores)
+    : engineers_(engineers)
+{
+    compute(hierarchy, competencyScores, categories, skills, coreSkillScores);
+}
+
+AnalyticsEngine::~AnalyticsEngine()
+{
+}
+
+AnalyticsEngine AnalyticsEngine::fromStore()
+{
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    return AnalyticsEngine(store.engineers().items(),
+                           store.hierarchy(),
+                           store.competencyScores(),
+                           store.coreSkillCategories().items(),
+                           store.coreSkills().items(),
+                           store.coreSkillScores());
+}
+
+// ============================================================================
+// Computation
+// ============================================================================
+
+void AnalyticsEngine::compute(const ProductionHierarchy& hierarchy,
+                              const CompetencyScoreMatrix& competencyScores,
+                              const QList<CoreSkillCategory>& categories,
+                              const QList<CoreSkill>& skills,
+                              const CoreSkillScoreMatrix& coreSkillScores)
+{
+    const RadarAxes production = productionAxes(hierarchy, competencyScores.columnIds());
+    const RadarAxes coreSkills = coreSkillAxes(categories, skills, coreSkillScores.columnIds());
+
+    QVector<double> sums;
+    QVector<double> weights;
+    ScoreStats totals;
+    QMap<QString, ShiftStats> shiftsMap;
+    QHash<QString, RadarAverage> shiftProduction;
+    QHash<QString, RadarAverage> shiftCoreSkills;
+
+    engineerResults_.reserve(engineers_.size());
+
+    // Single pass over every engineer row
+    for (int position = 0; position < engineers_.size(); ++position) {
+        const Engineer& engineer = engineers_[position];
+        int row = competencyScores.rowIndex(engineer.id());
+
+        EngineerResult result;
+        result.stats = competencyScores.rowStats(row);
+        result.productionRadar = radarForRow(competencyScores, row, production, sums, weights);
+        result.coreSkillsRadar = radarForRow(coreSkillScores, coreSkillScores.rowIndex(engineer.id()),
+                                             coreSkills, sums, weights);
+        totals += result.stats;
+
+        // Shift comparison groups unassigned engineers together
+        QString shiftName = engineer.shift().isEmpty() ? QString("Unassigned") : engineer.shift();
+        ShiftStats& shiftStats = shiftsMap[shiftName];
+        shiftStats.shiftName = shiftName;
+        shiftStats.engineerCount++;
+        shiftStats.totalScore += result.stats.totalScore;
+        shiftStats.maxScore += result.stats.assessed * Constants::SCORE_MAX;
+
+        if (!engineer.shift().isEmpty()) {
+            engineersByShift_[engineer.shift()].append(position);
+            shiftProduction[engineer.shift()].add(result.productionRadar);
+            shiftCoreSkills[engineer.shift()].add(result.coreSkillsRadar);
+        }
+
+        engineerResults_.insert(engineer.id(), result);
+    }
+
+    shifts_ = engineersByShift_.keys();
+    std::sort(shifts_.begin(), shifts_.end());
+
+    for (auto it = shiftProduction.constBegin(); it != shiftProduction.constEnd(); ++it) {
+        shiftProductionRadar_.insert(it.key(), it.value().result());
+    }
+    for (auto it = shiftCoreSkills.constBegin(); it != shiftCoreSkills.constEnd(); ++it) {
+        shiftCoreSkillsRadar_.insert(it.key(), it.value().result());
+    }
+
+    // Shift comparison, best average completion first
+    for (auto it = shiftsMap.begin(); it != shiftsMap.end(); ++it) {
+        ShiftStats stats = it.value();
+        if (stats.maxScore > 0) {
+            stats.averageCompletion = (stats.totalScore * 100.0) / stats.maxScore;
+        }
+        shiftComparison_.append(stats);
+    }
+    std::sort(shiftComparison_.begin(), shiftComparison_.end(),
+              [](const ShiftStats& a, const ShiftStats& b) {
+                  return a.averageCompletion > b.averageCompletion;
+              });
+
+    prediction_ = predictionFor(totals);
+    buildInsights(totals);
+}
+
+AnalyticsEngine::Prediction AnalyticsEngine::predictionFor(const ScoreStats& totals)
+{
+    // Completion rate over every assessed cell.
+    // Simple prediction: assume 5% improvement; a real model would use snapshot history.
+    Prediction prediction;
+    if (totals.assessed > 0) {
+        prediction.current = totals.percentage();
+        prediction.predicted = qMin(100.0, prediction.current + 5.0);
+        prediction.change = prediction.predicted - prediction.current;
+
+        if (prediction.change > 0.5) {
+            prediction.trend = "up";
+        } else if (prediction.change < -0.5) {
+            prediction.trend = "down";
+        }
+    }
+    return prediction;
+}
+
+void AnalyticsEngine::buildInsights(const ScoreStats& totals)
+{
+    // Trend insight
+    if (prediction_.trend == "up") {
+        Insight insight;
+        insight.type = "positive";
+        insight.icon = "📈";
+        insight.title = "Positive Growth Trend";
+        insight.message = QString("Team competency is projected to increase by %1% based on current progress.")
+            .arg(QString::number(prediction_.change, 'f', 1));
+        insights_.append(insight);
+    } else if (prediction_.trend == "down") {
+        Insight insight;
+        insight.type = "warning";
+        insight.icon = "📉";
+        insight.title = "Declining Trend Detected";
+        insight.message = QString("Team competency is projected to decrease by %1%. Consider additional training initiatives.")
+            .arg(QString::number(qAbs(prediction_.change), 'f', 1));
+        insights_.append(insight);
+    }
+
+    // Shift performance gap
+    if (shiftComparison_.size() > 1) {
+        const ShiftStats& best = shiftComparison_.first();
+        const ShiftStats& worst = shiftComparison_.last();
+        double gap = best.averageCompletion - worst.averageCompletion;
+        if (gap > 10.0) {
+            Insight insight;
+            insight.type = "alert";
+            insight.icon = "⚠️";
+            insight.title = "Shift Performance Gap";
+            insight.message = QString("%1 outperforms %2 by %3%. Consider cross-shift training programs.")
+                .arg(best.shiftName)
+                .arg(worst.shiftName)
+                .arg(QString::number(gap, 'f', 1));
+            insights_.append(insight);
+        }
+    }
+
+    // Low competency alert
+    if (totals.assessed > 0) {
+        int lowScores = totals.counts[Constants::SCORE_NOT_TRAINED] + totals.counts[Constants::SCORE_BASIC];
+        double lowPercentage = (lowScores * 100.0) / totals.assessed;
+        if (lowPercentage > 30.0) {
+            Insight insight;
+            insight.type = "warning";
+            insight.icon = "🎯";
+            insight.title = "Training Priority Alert";
+            insight.message = QString("%1% of competencies are below proficient level. Prioritize structured training programs.")
+                .arg(QString::number(lowPercentage, 'f', 0));
+            insights_.append(insight);
+        }
+    }
+
+    // Top performer recognition
+    const Engineer* topEngineer = nullptr;
+    double topPercentage = 0.0;
+    for (const Engineer& engineer : engineers_) {
+        const ScoreStats& stats = engineerResults_[engineer.id()].stats;
+        if (stats.assessed > 0 && (!topEngineer || stats.percentage() > topPercentage)) {
+            topEngineer = &engineer;
+            topPercentage = stats.percentage();
+        }
+    }
+
+    if (topEngineer && topPercentage >= 85.0) {
+        Insight insight;
+        insight.type = "positive";
+        insight.icon = "🏆";
+        insight.title = "Top Performer Recognition";
+        insight.message = QString("%1 leads the team with %2% competency mastery.")
+            .arg(topEngineer->name())
+            .arg(QString::number(topPercentage, 'f', 0));
+        insights_.append(insight);
+    }
+}
+
+// ============================================================================
+// Lookups
+// ============================================================================
+
+QList<Engineer> AnalyticsEngine::engineersInShift(const QString& shift) const
+{
+    QList<Engineer> result;
+    const QList<int> positions = engineersByShift_.value(shift);
+    result.reserve(positions.size());
+    for (int position : positions) {
+        result.append(engineers_[position]);
+    }
+    return result;
+}
+
+ScoreStats AnalyticsEngine::engineerStats(const QString& engineerId) const
+{
+    return engineerResults_.value(engineerId).stats;
+}
+
+AnalyticsEngine::RadarData AnalyticsEngine::engineerProductionRadar(const QString& engineerId) const
+{
+    return engineerResults_.value(engineerId).productionRadar;
+}
+
+AnalyticsEngine::RadarData AnalyticsEngine::engineerCoreSkillsRadar(const QString& engineerId) const
+{
+    return engineerResults_.value(engineerId).coreSkillsRadar;
+}
+
+AnalyticsEngine::RadarData AnalyticsEngine::shiftProductionRadar(const QString& shift) const
+{
+    return shiftProductionRadar_.value(shift);
+}
+
+AnalyticsEngine::RadarData AnalyticsEngine::shiftCoreSkillsRadar(const QString& shift) const
+{
+    return shiftCoreSkillsRadar_.value(shift);
+}
@@ -0,0 +1,112 @@
+#ifndef ANALYTICSENGINE_H
+#define ANALYTICSENGINE_H
+
+#include "../models/Engineer.h"
+#include "../models/CoreSkill.h"
+#include "../models/CoreSkillCategory.h"
+#include "../models/ProductionHierarchy.h"
+#include "../models/ScoreMatrix.h"
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QMap>
+#include <QHash>
+
+/**
+ * @brief UI-free analytics over an in-memory skill matrix
+ *
+ * Resolves competency -> machine -> area and core skill -> category once, then
+ * computes every engineer's scores and radar data plus the per-shift aggregates
+ * in a single linear pass over the score matrices. The accessors afterwards are
+ * lookups. Needs no QApplication and no database, so it can be unit tested or
+ * benchmarked on synthetic data.
+ */
+class AnalyticsEngine
+{
+public:
+    using RadarData = QMap<QString, double>;   // axis label -> weighted average score (0-3)
+
+    struct Prediction {
+        double current = 0.0;
+        double predicted = 0.0;
+        double change = 0.0;
+        QString trend = "stable";   // "up", "down", "stable"
+    };
+
+    struct ShiftStats {
+        QString shiftName;
+        double averageCompletion = 0.0;
+        int engineerCount = 0;
+        int totalScore = 0;
+        int maxScore = 0;
+    };
+
+    struct Insight {
+        QString type;  // "positive", "warning", "alert"
+        QString icon;
+        QString title;
+        QString message;
+    };
+
+    AnalyticsEngine();
+    AnalyticsEngine(const QList<Engineer>& engineers,
+                    const ProductionHierarchy& hierarchy,
+                    const CompetencyScoreMatrix& competencyScores,
+                    const QList<CoreSkillCategory>& categories,
+                    const QList<CoreSkill>& skills,
+                    const CoreSkillScoreMatrix& coreSkillScores);
+    ~AnalyticsEngine();
+
+    /**
+     * @brief Build an engine from the current SkillMatrixStore snapshots
+     */
+    static AnalyticsEngine fromStore();
+
+    /**
+     * @brief Completion prediction from matrix totals alone (cheap; no per-engineer pass)
+     */
+    static Prediction predictionFor(const ScoreStats& totals);
+
+    const QList<Engineer>& engineers() const { return engineers_; }
+    QStringList shifts() const { return shifts_; }   // sorted, excludes unassigned
+    QList<Engineer> engineersInShift(const QString& shift) const;
+
+    Prediction prediction() const { return prediction_; }
+    QList<ShiftStats> shiftComparison() const { return shiftComparison_; }   // best first
+    QList<Insight> insights() const { return insights_; }
+
+    ScoreStats engineerStats(const QString& engineerId) const;
+    RadarData engineerProductionRadar(const QString& engineerId) const;
+    RadarData engineerCoreSkillsRadar(const QString& engineerId) const;
+    RadarData shiftProductionRadar(const QString& shift) const;
+    RadarData shiftCoreSkillsRadar(const QString& shift) const;
+
+private:
+    struct EngineerResult {
+        ScoreStats stats;
+        RadarData productionRadar;
+        RadarData coreSkillsRadar;
+    };
+
+    void compute(const ProductionHierarchy& hierarchy,
+                 const CompetencyScoreMatrix& competencyScores,
+                 const QList<CoreSkillCategory>& categories,
+                 const QList<CoreSkill>& skills,
+                 const CoreSkillScoreMatrix& coreSkillScores);
+    void buildInsights(const ScoreStats& totals);
+
+private:
+    QList<Engineer> engineers_;
+    QStringList shifts_;
+    QHash<QString, QList<int>> engineersByShift_;   // shift -> positions in engineers_
+
+    QHash<QString, EngineerResult> engineerResults_;
+    QHash<QString, RadarData> shiftProductionRadar_;
+    QHash<QString, RadarData> shiftCoreSkillsRadar_;
+
+    Prediction prediction_;
+    QList<ShiftStats> shiftComparison_;
+    QList<Insight> insights_;
+};
+
+#endif // ANALYTICSENGINE_H
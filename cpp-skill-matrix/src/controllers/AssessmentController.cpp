@@ -1,6 +1,6 @@
 #include "AssessmentController.h"
 #include "../database/AssessmentRepository.h"
-#include "../database/ProductionRepository.h"
+#include "../database/SkillMatrixStore.h"
 #include "../utils/Logger.h"
 #include "../core/Constants.h"
 
@@ -39,22 +39,23 @@ QList<Assessment> AssessmentController::getAssessmentsByProductionArea(int produ
 {
     lastError_.clear();
     AssessmentRepository repo;
-    QList<Assessment> allAssessments = repo.findAll();
 
-    if (!repo.lastError().isEmpty()) {
+    // Filtered on the server and streamed; only the matching rows are kept
+    AssessmentRepository::PageFilter filter;
+    filter.productionAreaId = productionAreaId;
+
+    QList<Assessment> filtered;
+    bool ok = repo.forEach([&filtered](const Assessment& assessment) {
+        filtered.append(assessment);
+        return true;
+    }, filter);
+
+    if (!ok) {
         lastError_ = repo.lastError();
         Logger::instance().error("AssessmentController", "Failed to get assessments by production area: " + lastError_);
         return QList<Assessment>();
     }
 
-    // Filter by production area ID
-    QList<Assessment> filtered;
-    for (const Assessment& assessment : allAssessments) {
-        if (assessment.productionAreaId() == productionAreaId) {
-            filtered.append(assessment);
-        }
-    }
-
     return filtered;
 }
 
@@ -154,17 +155,8 @@ double AssessmentController::getCompletionPercentage(const QString& engineerId,
 {
     lastError_.clear();
 
-    // Get all competencies in the production area by iterating through machines
-    ProductionRepository prodRepo;
-    QList<Machine> machines = prodRepo.findMachinesByArea(productionAreaId);
-
-    QList<Competency> competencies;
-    for (const Machine& machine : machines) {
-        QList<Competency> machineComps = prodRepo.findCompetenciesByMachine(machine.id());
-        competencies.append(machineComps);
-    }
-
-    int totalCompetencies = competencies.size();
+    // Count competencies in the production area from the store's cached hierarchy
+    int totalCompetencies = SkillMatrixStore::instance().hierarchy().competencyCountByArea(productionAreaId);
     if (totalCompetencies == 0) {
         return 0.0;
     }
@@ -1,13 +1,141 @@
 #include "AuthController.h"
 #include "../core/Application.h"
 #include "../database/UserRepository.h"
+#include "../database/ConnectionPool.h"
 #include "../utils/Crypto.h"
 #include "../utils/Logger.h"
+#include <QtConcurrent/QtConcurrent>
 
-AuthController::AuthController() {}
-AuthController::~AuthController() {}
+AuthController::AuthController(QObject* parent)
+    : QObject(parent)
+    , watcher_(new QFutureWatcher<LoginResult>(this))
+    , state_(Idle)
+{
+    connect(watcher_, &QFutureWatcher<LoginResult>::progressValueChanged,
+            this, &AuthController::onProgressValueChanged);
+    connect(watcher_, &QFutureWatcher<LoginResult>::finished,
+            this, &AuthController::onLoginJobFinished);
+}
+
+AuthController::~AuthController()
+{
+    // The job only touches its own copies and the repository; let it finish
+    watcher_->waitForFinished();
+}
+
+bool AuthController::login(const QString& username, const QString& password)
+{
+    LoginResult result = verify(username, password, nullptr);
+    setState(result.success ? Succeeded : Failed);
+
+    if (result.success) {
+        const User& user = result.user;
+        Application::instance().onUserLogin(user.id(), user.username(), user.role(), user.engineerId());
+    }
+    return result.success;
+}
+
+void AuthController::loginAsync(const QString& username, const QString& password)
+{
+    if (watcher_->isRunning()) {
+        return;
+    }
+
+    setState(LookingUpUser);
+    watcher_->setFuture(QtConcurrent::run(&AuthController::authenticate, username, password));
+}
+
+QString AuthController::stateText(State state)
+{
+    switch (state) {
+        case LookingUpUser: return "Looking up user...";
+        case Verifying:     return "Verifying password...";
+        case Upgrading:     return "Updating password security...";
+        case Succeeded:     return "Login successful!";
+        case Failed:        return "Invalid username or password";
+        default:            return QString();
+    }
+}
+
+void AuthController::authenticate(QPromise<LoginResult>& promise, QString username, QString password)
+{
+    // Repository calls issued from this job use the worker thread's pooled connection
+    ScopedConnection connection;
+    promise.setProgressRange(Idle, Succeeded);
+    promise.addResult(verify(username, password, &promise));
+}
+
+AuthController::LoginResult AuthController::verify(const QString& username, const QString& password,
+                                                   QPromise<LoginResult>* promise)
+{
+    LoginResult result;
+
+    if (promise) {
+        promise->setProgressValue(LookingUpUser);
+    }
+    UserRepository userRepo;
+    User user = userRepo.findByUsername(username);
+    if (!user.isValid()) {
+        result.error = userRepo.lastError().isEmpty() ? "Invalid username or password" : userRepo.lastError();
+        return result;
+    }
+
+    if (promise) {
+        promise->setProgressValue(Verifying);
+    }
+    if (!Crypto::verifyPassword(password, user.password())) {
+        result.error = "Invalid username or password";
+        return result;
+    }
+
+    // Old format or below the current cost: store a fresh hash while the password is at hand
+    if (Crypto::needsRehash(user.password())) {
+        if (promise) {
+            promise->setProgressValue(Upgrading);
+        }
+        QString upgraded = Crypto::hashPassword(password);
+        if (userRepo.updatePassword(user.id(), upgraded)) {
+            user.setPassword(upgraded);
+            Logger::instance().info("AuthController", "Upgraded password hash for user: " + user.username());
+        } else {
+            Logger::instance().warning("AuthController", "Could not upgrade password hash: " + userRepo.lastError());
+        }
+    }
+
+    result.success = true;
+    result.user = user;
+    return result;
+}
+
+void AuthController::onProgressValueChanged(int value)
+{
+    // Progress only moves forward, so a late update never overrides the final state
+    if (watcher_->isRunning()) {
+        setState(State(value));
+    }
+}
+
+void AuthController::onLoginJobFinished()
+{
+    LoginResult result;
+    if (watcher_->future().resultCount() > 0) {
+        result = watcher_->result();
+    } else {
+        result.error = "Login was interrupted";
+    }
+
+    setState(result.success ? Succeeded : Failed);
+    emit loginFinished(result.success, result.user, result.error);
+}
+
+void AuthController::setState(State state)
+{
+    if (state_ != state) {
+        state_ = state;
+        emit stateChanged(state);
+    }
+}
 
-bool AuthController::login(const QString& username, const QString& password) { return false; }
 void AuthController::logout() {}
 
 bool AuthController::changePassword(const QString& oldPassword, const QString& newPassword)
@@ -35,7 +163,6 @@ bool AuthController::changePassword(const QString& oldPassword, const QString& n
     }
 
     // Verify old password
-    QString oldPasswordHash = Crypto::hashPassword(oldPassword);
     if (!Crypto::verifyPassword(oldPassword, user.password())) {
         Logger::instance().warning("AuthController", "Change password failed - incorrect old password for: " + user.username());
         return false;
@@ -55,3 +182,10 @@ bool AuthController::changePassword(const QString& oldPassword, const QString& n
 
     return success;
 }
+
+QFuture<QString> AuthController::hashPasswordsAsync(const QStringList& passwords)
+{
+    return QtConcurrent::mapped(passwords, [](const QString& password) {
+        return Crypto::hashPassword(password);
+    });
+}
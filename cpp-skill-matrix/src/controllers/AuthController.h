@@ -1,17 +1,95 @@
 #ifndef AUTHCONTROLLER_H
 #define AUTHCONTROLLER_H
 
+#include <QObject>
 #include <QString>
+#include <QStringList>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QPromise>
+#include "../models/User.h"
 
-class AuthController
+/**
+ * @brief Authentication and password management
+ *
+ * Password hashing is slow by design, so loginAsync() looks the user up and
+ * verifies the password on a worker thread. It reports its stage through
+ * stateChanged() and ends with loginFinished(). A hash in an old format or
+ * below the current cost is upgraded in the same job.
+ */
+class AuthController : public QObject
 {
+    Q_OBJECT
+
 public:
-    AuthController();
+    enum State {
+        Idle = 0,
+        LookingUpUser,
+        Verifying,
+        Upgrading,
+        Succeeded,
+        Failed
+    };
+
+    /**
+     * @brief Outcome of one authentication job
+     */
+    struct LoginResult {
+        bool success = false;
+        User user;
+        QString error;
+    };
+
+    explicit AuthController(QObject* parent = nullptr);
     ~AuthController();
 
+    /**
+     * @brief Verify credentials and start the session (blocks the caller)
+     */
     bool login(const QString& username, const QString& password);
+
+    /**
+     * @brief Verify credentials on a worker thread
+     *
+     * Does not start the session; the caller does that on loginFinished().
+     * Ignored while a login is in flight.
+     */
+    void loginAsync(const QString& username, const QString& password);
+
+    bool isBusy() const { return watcher_->isRunning(); }
+    State state() const { return state_; }
+
+    /**
+     * @brief Short user-facing description of a state
+     */
+    static QString stateText(State state);
+
     void logout();
     bool changePassword(const QString& oldPassword, const QString& newPassword);
+
+    /**
+     * @brief Hash several passwords in parallel on the global thread pool
+     *
+     * Results are in the order of the input list.
+     */
+    static QFuture<QString> hashPasswordsAsync(const QStringList& passwords);
+
+signals:
+    void stateChanged(AuthController::State state);
+    void loginFinished(bool success, const User& user, const QString& error);
+
+private slots:
+    void onProgressValueChanged(int value);
+    void onLoginJobFinished();
+
+private:
+    void setState(State state);
+    static void authenticate(QPromise<LoginResult>& promise, QString username, QString password);
+    static LoginResult verify(const QString& username, const QString& password, QPromise<LoginResult>* promise);
+
+private:
+    QFutureWatcher<LoginResult>* watcher_;
+    State state_;
 };
 
 #endif // AUTHCONTROLLER_H
@@ -64,19 +64,17 @@ QList<CoreSkillAssessment> CoreSkillsController::getEngineerAssessments(const QS
     QList<CoreSkillAssessment> engineerAssessments;
 
     CoreSkillsRepository repo;
-    QList<CoreSkillAssessment> allAssessments = repo.findAllAssessments();
 
-    if (!repo.lastError().isEmpty()) {
+    // Filtered on the server and streamed; only this engineer's rows are read
+    bool ok = repo.forEachAssessment([&engineerAssessments](const CoreSkillAssessment& assessment) {
+        engineerAssessments.append(assessment);
+        return true;
+    }, engineerId);
+
+    if (!ok) {
         lastError_ = repo.lastError();
         Logger::instance().error("CoreSkillsController", "Failed to get assessments: " + lastError_);
-        return engineerAssessments;
-    }
-
-    // Filter assessments by engineer
-    for (const CoreSkillAssessment& assessment : allAssessments) {
-        if (assessment.engineerId() == engineerId) {
-            engineerAssessments.append(assessment);
-        }
+        return QList<CoreSkillAssessment>();
     }
 
     return engineerAssessments;
@@ -6,6 +6,7 @@
 #include "../models/Competency.h"
 #include "../utils/Logger.h"
 #include <QRandomGenerator>
+#include <QSet>
 #include <QDateTime>
 
 DataController::DataController() {}
@@ -31,19 +32,14 @@ QString DataController::generateRandomAssessments(int percentageToFill)
     };
     QList<CompetencyInfo> competencyInfos;
 
-    QList<ProductionArea> areas = productionRepo.findAllAreas();
-    for (const ProductionArea& area : areas) {
-        QList<Machine> machines = productionRepo.findMachinesByArea(area.id());
-        for (const Machine& machine : machines) {
-            QList<Competency> competencies = productionRepo.findCompetenciesByMachine(machine.id());
-            for (const Competency& competency : competencies) {
-                CompetencyInfo info;
-                info.competency = competency;
-                info.machineId = machine.id();
-                info.areaId = area.id();
-                competencyInfos.append(info);
-            }
-        }
+    ProductionHierarchy hierarchy = productionRepo.loadHierarchy();
+    competencyInfos.reserve(hierarchy.competencyCount());
+    for (const Competency& competency : hierarchy.competencies()) {
+        CompetencyInfo info;
+        info.competency = competency;
+        info.machineId = competency.machineId();
+        info.areaId = hierarchy.areaIdForMachine(competency.machineId());
+        competencyInfos.append(info);
     }
 
     if (competencyInfos.isEmpty()) {
@@ -55,44 +51,47 @@ QString DataController::generateRandomAssessments(int percentageToFill)
     int totalSkipped = 0;
     QRandomGenerator* random = QRandomGenerator::global();
 
-    for (const Engineer& engineer : engineers) {
-        // Get existing assessments for this engineer
-        QList<Assessment> existingAssessments = assessmentRepo.findByEngineer(engineer.id());
+    // Existing (engineer, competency) pairs, loaded once instead of per engineer
+    // (streamed, so only the keys are held in memory)
+    QSet<QString> existingKeys;
+    assessmentRepo.forEach([&existingKeys](const Assessment& existing) {
+        existingKeys.insert(existing.engineerId() + "|" + QString::number(existing.competencyId()));
+        return true;
+    });
 
+    QList<Assessment> newAssessments;
+
+    for (const Engineer& engineer : engineers) {
         for (const CompetencyInfo& info : competencyInfos) {
             // Use percentage to determine if we should create an assessment
             if (random->bounded(100) < percentageToFill) {
-                // Check if assessment already exists for this competency
-                bool exists = false;
-                for (const Assessment& existing : existingAssessments) {
-                    if (existing.competencyId() == info.competency.id()) {
-                        exists = true;
-                        totalSkipped++;
-                        break;
-                    }
+                // Skip competencies this engineer has already been assessed on
+                if (existingKeys.contains(engineer.id() + "|" + QString::number(info.competency.id()))) {
+                    totalSkipped++;
+                    continue;
                 }
 
-                if (!exists) {
-                    // Generate random score (0 to maxScore)
-                    int score = random->bounded(info.competency.maxScore() + 1);
+                // Generate random score (0 to maxScore)
+                int score = random->bounded(info.competency.maxScore() + 1);
 
-                    Assessment assessment(
-                        0,  // id (auto-generated)
-                        engineer.id(),
-                        info.areaId,
-                        info.machineId,
-                        info.competency.id(),
-                        score
-                    );
-
-                    if (assessmentRepo.saveOrUpdate(assessment)) {
-                        totalCreated++;
-                    }
-                }
+                newAssessments.append(Assessment(
+                    0,  // id (auto-generated)
+                    engineer.id(),
+                    info.areaId,
+                    info.machineId,
+                    info.competency.id(),
+                    score
+                ));
             }
         }
     }
 
+    // Write everything in one transaction
+    if (!assessmentRepo.saveOrUpdateBatch(newAssessments)) {
+        return "Error: Failed to save generated assessments: " + assessmentRepo.lastError();
+    }
+    totalCreated = newAssessments.size();
+
     QString message = QString("Successfully generated %1 random assessments for %2 engineers across %3 competencies.\n"
                              "%4 existing assessments were skipped.")
                           .arg(totalCreated)
@@ -1,5 +1,6 @@
 #include "ProductionController.h"
 #include "../database/ProductionRepository.h"
+#include "../database/SkillMatrixStore.h"
 #include "../utils/Logger.h"
 #include "../core/Constants.h"
 
@@ -99,18 +100,7 @@ bool ProductionController::deleteProductionArea(int id)
 QList<Machine> ProductionController::getAllMachines()
 {
     lastError_.clear();
-    ProductionRepository repo;
-
-    // Get all machines by iterating through all areas
-    QList<Machine> allMachines;
-    QList<ProductionArea> areas = repo.findAllAreas();
-
-    for (const ProductionArea& area : areas) {
-        QList<Machine> areaMachines = repo.findMachinesByArea(area.id());
-        allMachines.append(areaMachines);
-    }
-
-    return allMachines;
+    return SkillMatrixStore::instance().hierarchy().machines();
 }
 
 QList<Machine> ProductionController::getMachinesByProductionArea(int productionAreaId)
@@ -215,18 +205,7 @@ bool ProductionController::deleteMachine(int id)
 QList<Competency> ProductionController::getAllCompetencies()
 {
     lastError_.clear();
-    ProductionRepository repo;
-
-    // Get all competencies by iterating through all machines
-    QList<Competency> allCompetencies;
-    QList<Machine> machines = getAllMachines();
-
-    for (const Machine& machine : machines) {
-        QList<Competency> machineComps = repo.findCompetenciesByMachine(machine.id());
-        allCompetencies.append(machineComps);
-    }
-
-    return allCompetencies;
+    return SkillMatrixStore::instance().hierarchy().competencies();
 }
 
 QList<Competency> ProductionController::getCompetenciesByMachine(int machineId)
@@ -239,18 +218,8 @@ QList<Competency> ProductionController::getCompetenciesByMachine(int machineId)
 QList<Competency> ProductionController::getCompetenciesByProductionArea(int productionAreaId)
 {
     lastError_.clear();
-    ProductionRepository repo;
-
-    // Get competencies by iterating through machines in this area
-    QList<Competency> areaCompetencies;
-    QList<Machine> machines = repo.findMachinesByArea(productionAreaId);
-
-    for (const Machine& machine : machines) {
-        QList<Competency> machineComps = repo.findCompetenciesByMachine(machine.id());
-        areaCompetencies.append(machineComps);
-    }
-
-    return areaCompetencies;
+    // The store's hierarchy is loaded once and dropped on hierarchy writes
+    return SkillMatrixStore::instance().hierarchy().competenciesByArea(productionAreaId);
 }
 
 Competency ProductionController::getCompetencyById(int id)
@@ -3,6 +3,7 @@
 #include "EngineerController.h"
 #include "AssessmentController.h"
 #include "ProductionController.h"
+#include "../database/AnalyticsRepository.h"
 #include "../utils/Logger.h"
 
 ReportController::ReportController() : lastError_("") {}
@@ -94,32 +95,18 @@ QMap<QString, QString> ReportController::generateShiftReport(const QString& shif
     lastError_.clear();
     QMap<QString, QString> report;
 
-    EngineerController engineerCtrl;
-    auto engineers = engineerCtrl.getEngineersByShift(shift);
-
-    CoreSkillsController coreSkillsCtrl;
-    AssessmentController assessmentCtrl;
-
-    int totalCoreAssessments = 0;
-    int totalMachineAssessments = 0;
-    double totalCoreAvg = 0.0;
-
-    for (const auto& engineer : engineers) {
-        auto coreAssessments = coreSkillsCtrl.getEngineerAssessments(engineer.id());
-        auto machineAssessments = assessmentCtrl.getAssessmentsByEngineer(engineer.id());
-
-        totalCoreAssessments += coreAssessments.size();
-        totalMachineAssessments += machineAssessments.size();
-        totalCoreAvg += coreSkillsCtrl.getAverageScore(engineer.id());
+    AnalyticsRepository analyticsRepo;
+    ShiftSummary summary = analyticsRepo.findShiftSummary(shift);
+    if (!analyticsRepo.lastError().isEmpty()) {
+        lastError_ = analyticsRepo.lastError();
+        return report;
     }
 
-    double avgCoreScore = engineers.size() > 0 ? totalCoreAvg / engineers.size() : 0.0;
-
     report["shift"] = shift;
-    report["engineer_count"] = QString::number(engineers.size());
-    report["total_core_assessments"] = QString::number(totalCoreAssessments);
-    report["total_machine_assessments"] = QString::number(totalMachineAssessments);
-    report["average_core_score"] = QString::number(avgCoreScore, 'f', 2);
+    report["engineer_count"] = QString::number(summary.engineerCount);
+    report["total_core_assessments"] = QString::number(summary.coreAssessmentCount);
+    report["total_machine_assessments"] = QString::number(summary.machineAssessmentCount);
+    report["average_core_score"] = QString::number(summary.averageCoreScore, 'f', 2);
 
     return report;
 }
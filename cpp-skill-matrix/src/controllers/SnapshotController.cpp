@@ -1,5 +1,9 @@
 #include "SnapshotController.h"
 #include "../database/SnapshotRepository.h"
+#include "../database/SnapshotHistoryRepository.h"
+#include "../database/SkillMatrixStore.h"
+#include "../database/DatabaseManager.h"
+#include "../core/Constants.h"
 #include "../utils/Logger.h"
 #include "../utils/Crypto.h"
 
@@ -20,20 +24,27 @@ Snapshot SnapshotController::getSnapshotById(const QString& id)
     return repo.findById(id);
 }
 
-QString SnapshotController::createSnapshot(const QString& description, const QString& jsonData)
+QString SnapshotController::createSnapshot(const QString& description)
 {
     lastError_.clear();
 
-    if (jsonData.isEmpty()) {
-        lastError_ = "Snapshot data cannot be empty";
-        return QString();
-    }
+    // Pick up edits made by other clients before capturing
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    store.sync(SkillMatrixStore::Engineers | SkillMatrixStore::Assessments |
+               SkillMatrixStore::CoreSkillAssessments);
+
+    // One copy of each matrix feeds the payload and the history rows, so a
+    // write-through landing in between cannot make them disagree
+    const CompetencyScoreMatrix competencyScores = store.competencyScores();
+    const CoreSkillScoreMatrix coreSkillScores = store.coreSkillScores();
+    QByteArray payload = SnapshotCodec::encode(competencyScores, coreSkillScores);
 
     Snapshot snapshot;
     snapshot.setId(Crypto::generateId("snapshot"));
     snapshot.setDescription(description);
     snapshot.setTimestamp(QDateTime::currentDateTime());
-    snapshot.setData(jsonData);
+    snapshot.setPayload(payload);
+    snapshot.setSource(Constants::SNAPSHOT_SOURCE_MANUAL);
 
     SnapshotRepository repo;
     bool success = repo.save(snapshot);
@@ -44,10 +55,268 @@ QString SnapshotController::createSnapshot(const QString& description, const QSt
         return QString();
     }
 
+    indexHistory(snapshot, SnapshotCodec::capture(competencyScores, coreSkillScores));
+
     Logger::instance().info("SnapshotController", "Created snapshot: " + snapshot.id());
     return snapshot.id();
 }
 
+QString SnapshotController::createScheduledSnapshot(int checkpointInterval)
+{
+    lastError_.clear();
+
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    store.sync(SkillMatrixStore::Engineers | SkillMatrixStore::Assessments |
+               SkillMatrixStore::CoreSkillAssessments);
+
+    // Payload, diff and history rows all come from the same copies
+    const CompetencyScoreMatrix competencyScores = store.competencyScores();
+    const CoreSkillScoreMatrix coreSkillScores = store.coreSkillScores();
+
+    SnapshotRepository repo;
+    Snapshot snapshot;
+    snapshot.setId(Crypto::generateId("snapshot"));
+    snapshot.setTimestamp(QDateTime::currentDateTime());
+    snapshot.setSource(Constants::SNAPSHOT_SOURCE_SCHEDULED);
+
+    // Extend the latest chain while it is shorter than the checkpoint interval
+    Snapshot latest = repo.findLatest();
+    SnapshotCodec::SnapshotState base;
+    bool asDelta = false;
+    if (latest.isValid() && checkpointInterval > 1) {
+        int deltas = repo.countDeltas(latest.chainId());
+        asDelta = deltas >= 0 && deltas + 1 < checkpointInterval && replayChain(repo, latest, base);
+    }
+
+    if (asDelta) {
+        SnapshotCodec::SnapshotState changes =
+            SnapshotCodec::diff(base, competencyScores, coreSkillScores);
+        snapshot.setPayload(SnapshotCodec::encodeState(changes, SnapshotCodec::Delta));
+        snapshot.setCheckpointId(latest.chainId());
+        snapshot.setDescription(QString("Scheduled snapshot (%1 engineers changed)").arg(changes.size()));
+    } else {
+        snapshot.setPayload(SnapshotCodec::encode(competencyScores, coreSkillScores));
+        snapshot.setDescription("Scheduled checkpoint");
+    }
+
+    if (!repo.save(snapshot)) {
+        lastError_ = repo.lastError();
+        Logger::instance().error("SnapshotController", "Failed to create scheduled snapshot: " + lastError_);
+        return QString();
+    }
+
+    indexHistory(snapshot, SnapshotCodec::capture(competencyScores, coreSkillScores));
+
+    Logger::instance().info("SnapshotController",
+        QString("Created scheduled %1: %2 (%3 bytes)")
+        .arg(asDelta ? "delta" : "checkpoint")
+        .arg(snapshot.id())
+        .arg(snapshot.payload().size()));
+    return snapshot.id();
+}
+
+bool SnapshotController::replayChain(SnapshotRepository& repo, const Snapshot& snapshot,
+                                     SnapshotCodec::SnapshotState& state)
+{
+    state.clear();
+
+    QList<Snapshot> chain = repo.findChain(snapshot.chainId(), snapshot.timestamp());
+    if (chain.isEmpty() || !chain.first().isCheckpoint()) {
+        lastError_ = repo.lastError().isEmpty() ? "Snapshot chain has no checkpoint" : repo.lastError();
+        return false;
+    }
+
+    for (const Snapshot& link : chain) {
+        SnapshotReader reader(link.payload());
+        if (!reader.isValid()) {
+            lastError_ = QString("Snapshot %1 is unreadable: %2").arg(link.id(), reader.error());
+            return false;
+        }
+
+        if (link.isCheckpoint()) {
+            state = reader.decodeAll();
+        } else {
+            SnapshotCodec::applyDelta(state, reader.decodeAll());
+        }
+
+        if (link.id() == snapshot.id()) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool SnapshotController::materialize(const QString& snapshotId, SnapshotCodec::SnapshotState& state)
+{
+    lastError_.clear();
+
+    SnapshotRepository repo;
+    Snapshot snapshot = repo.findById(snapshotId);
+    if (!snapshot.isValid()) {
+        lastError_ = repo.lastError().isEmpty() ? "Snapshot not found" : repo.lastError();
+        return false;
+    }
+
+    if (!replayChain(repo, snapshot, state)) {
+        Logger::instance().error("SnapshotController", "Failed to materialize snapshot: " + lastError_);
+        return false;
+    }
+
+    return true;
+}
+
+SnapshotCodec::EngineerScores SnapshotController::materializeEngineer(const QString& snapshotId,
+                                                                       const QString& engineerId)
+{
+    lastError_.clear();
+    SnapshotCodec::EngineerScores scores;
+
+    SnapshotRepository repo;
+    Snapshot snapshot = repo.findById(snapshotId);
+    if (!snapshot.isValid()) {
+        lastError_ = repo.lastError().isEmpty() ? "Snapshot not found" : repo.lastError();
+        return scores;
+    }
+
+    QList<Snapshot> chain = repo.findChain(snapshot.chainId(), snapshot.timestamp());
+    for (const Snapshot& link : chain) {
+        SnapshotCodec::applyDelta(scores, SnapshotReader(link.payload()).engineer(engineerId));
+        if (link.id() == snapshot.id()) {
+            break;
+        }
+    }
+
+    return scores;
+}
+
+QList<SnapshotHistoryPoint> SnapshotController::engineerHistory(const QString& engineerId, int limit)
+{
+    lastError_.clear();
+
+    SnapshotHistoryRepository historyRepo;
+    QList<SnapshotHistoryPoint> points = historyRepo.findByEngineer(engineerId, limit);
+    lastError_ = historyRepo.lastError();
+    return points;
+}
+
+SnapshotCodec::EngineerScores SnapshotController::engineerScores(const QString& snapshotId,
+                                                                  const QString& engineerId)
+{
+    lastError_.clear();
+
+    SnapshotHistoryRepository historyRepo;
+    bool found = false;
+    SnapshotCodec::EngineerScores scores = historyRepo.findScores(snapshotId, engineerId, &found);
+    if (found) {
+        return scores;
+    }
+
+    return materializeEngineer(snapshotId, engineerId);
+}
+
+bool SnapshotController::indexHistory(const Snapshot& snapshot, const SnapshotCodec::SnapshotState& state)
+{
+    // A snapshot left unindexed here is picked up again by backfillHistory()
+    DatabaseManager& dbManager = DatabaseManager::instance();
+    if (!dbManager.beginTransaction()) {
+        Logger::instance().warning("SnapshotController", "History not indexed: " + dbManager.lastError());
+        return false;
+    }
+
+    SnapshotHistoryRepository historyRepo;
+    if (!historyRepo.saveSnapshot(snapshot.id(), snapshot.timestamp(), state)) {
+        dbManager.rollback();
+        Logger::instance().warning("SnapshotController", "History not indexed: " + historyRepo.lastError());
+        return false;
+    }
+
+    if (!dbManager.commit()) {
+        dbManager.rollback();
+        Logger::instance().warning("SnapshotController", "History not indexed: " + dbManager.lastError());
+        return false;
+    }
+
+    return true;
+}
+
+int SnapshotController::backfillHistory(int limit)
+{
+    lastError_.clear();
+
+    SnapshotRepository repo;
+    QList<Snapshot> pending = repo.findUnindexed(limit);
+    if (!repo.lastError().isEmpty()) {
+        lastError_ = repo.lastError();
+        return -1;
+    }
+
+    int indexed = 0;
+    for (const Snapshot& snapshot : pending) {
+        SnapshotCodec::SnapshotState state;
+        if (!replayChain(repo, snapshot, state)) {
+            // Legacy snapshots without a payload index as empty
+            LOG_DEBUG("SnapshotController",
+                QString("Indexing snapshot %1 without scores: %2").arg(snapshot.id(), lastError_));
+            state.clear();
+            lastError_.clear();
+        }
+
+        if (!indexHistory(snapshot, state)) {
+            lastError_ = "Failed to index snapshot " + snapshot.id();
+            return -1;
+        }
+        indexed++;
+    }
+
+    if (indexed > 0) {
+        Logger::instance().info("SnapshotController", QString("Indexed history of %1 snapshots").arg(indexed));
+    }
+    return indexed;
+}
+
+bool SnapshotController::foldIntoNext(SnapshotRepository& repo, const Snapshot& target)
+{
+    Snapshot next = repo.findNextInChain(target);
+    if (!next.isValid()) {
+        return true;   // last link of its chain, nothing depends on it
+    }
+
+    if (target.isCheckpoint()) {
+        // The next delta becomes the chain's checkpoint
+        SnapshotCodec::SnapshotState state;
+        if (!replayChain(repo, next, state)) {
+            return false;
+        }
+        next.setPayload(SnapshotCodec::encodeState(state, SnapshotCodec::Checkpoint));
+        next.setCheckpointId(QString());
+
+        if (!repo.updateChainLink(next) || !repo.reassignCheckpoint(target.id(), next.id())) {
+            lastError_ = repo.lastError();
+            return false;
+        }
+        return true;
+    }
+
+    // The next delta takes over both steps
+    SnapshotReader targetReader(target.payload());
+    SnapshotReader nextReader(next.payload());
+    if (!targetReader.isValid() || !nextReader.isValid()) {
+        lastError_ = "Snapshot chain is unreadable";
+        return false;
+    }
+
+    SnapshotCodec::SnapshotState composed = targetReader.decodeAll();
+    SnapshotCodec::composeDelta(composed, nextReader.decodeAll());
+    next.setPayload(SnapshotCodec::encodeState(composed, SnapshotCodec::Delta));
+
+    if (!repo.updateChainLink(next)) {
+        lastError_ = repo.lastError();
+        return false;
+    }
+    return true;
+}
+
 bool SnapshotController::deleteSnapshot(const QString& id)
 {
     lastError_.clear();
@@ -58,11 +327,32 @@ bool SnapshotController::deleteSnapshot(const QString& id)
     }
 
     SnapshotRepository repo;
-    bool success = repo.remove(id);
+    Snapshot target = repo.findById(id);
+    if (!target.isValid()) {
+        lastError_ = repo.lastError().isEmpty() ? "Snapshot not found" : repo.lastError();
+        return false;
+    }
 
-    if (!success) {
-        lastError_ = repo.lastError();
+    DatabaseManager& dbManager = DatabaseManager::instance();
+    if (!dbManager.beginTransaction()) {
+        lastError_ = dbManager.lastError();
+        return false;
+    }
+
+    if (!foldIntoNext(repo, target) || !repo.remove(id)) {
+        if (lastError_.isEmpty()) {
+            lastError_ = repo.lastError();
+        }
+        dbManager.rollback();
+        Logger::instance().error("SnapshotController", "Failed to delete snapshot: " + lastError_);
+        return false;
+    }
+
+    if (!dbManager.commit()) {
+        lastError_ = dbManager.lastError();
+        dbManager.rollback();
+        return false;
     }
 
-    return success;
+    return true;
 }
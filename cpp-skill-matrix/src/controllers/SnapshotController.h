@@ -2,12 +2,22 @@
 #define SNAPSHOTCONTROLLER_H
 
 #include "../models/Snapshot.h"
+#include "../models/SnapshotCodec.h"
+#include "../database/SnapshotHistoryRepository.h"
 #include <QList>
 #include <QString>
 #include <QDateTime>
 
+class SnapshotRepository;
+
 /**
  * @brief Controller for Snapshot business logic
+ *
+ * Snapshots form chains: a checkpoint holds the full state and the deltas
+ * that follow it hold only the scores that changed since the previous
+ * snapshot. Any snapshot is materialised by replaying its chain. Every new
+ * snapshot is also written to the per-engineer history, so trends are read
+ * without replaying anything.
  */
 class SnapshotController
 {
@@ -17,11 +27,68 @@ public:
 
     QList<Snapshot> getAllSnapshots(int limit = 50);
     Snapshot getSnapshotById(const QString& id);
-    QString createSnapshot(const QString& description, const QString& jsonData);
+
+    /**
+     * @brief Capture the current assessment and core skill state
+     *
+     * Brings the store up to date, then encodes its score matrices with
+     * SnapshotCodec. Manual snapshots are always checkpoints.
+     * @return New snapshot id, or an empty string on failure
+     */
+    QString createSnapshot(const QString& description);
+
+    /**
+     * @brief Capture the current state as the next link of the latest chain
+     *
+     * Writes a delta against the latest snapshot, or a new checkpoint when
+     * there is no usable chain or it already holds checkpointInterval snapshots.
+     * @return New snapshot id, or an empty string on failure
+     */
+    QString createScheduledSnapshot(int checkpointInterval);
+
+    /**
+     * @brief Full state of a snapshot, replayed from its checkpoint
+     * @return false if the snapshot or its chain cannot be read
+     */
+    bool materialize(const QString& snapshotId, SnapshotCodec::SnapshotState& state);
+
+    /**
+     * @brief One engineer's scores in a snapshot, replayed from its checkpoint
+     */
+    SnapshotCodec::EngineerScores materializeEngineer(const QString& snapshotId, const QString& engineerId);
+
+    /**
+     * @brief An engineer's averages in the most recent snapshots, newest first
+     *
+     * Reads the per-engineer history index with a single query.
+     */
+    QList<SnapshotHistoryPoint> engineerHistory(const QString& engineerId, int limit = 50);
+
+    /**
+     * @brief One engineer's scores in a snapshot, from the history index
+     *
+     * Falls back to replaying the chain for snapshots not indexed yet.
+     */
+    SnapshotCodec::EngineerScores engineerScores(const QString& snapshotId, const QString& engineerId);
+
+    /**
+     * @brief Index up to limit snapshots written before the history existed, oldest first
+     * @return Number of snapshots indexed, or -1 on failure
+     */
+    int backfillHistory(int limit);
+
+    /**
+     * @brief Delete a snapshot, folding it into the next snapshot of its chain
+     */
     bool deleteSnapshot(const QString& id);
 
     QString lastError() const { return lastError_; }
 
+private:
+    bool replayChain(SnapshotRepository& repo, const Snapshot& snapshot, SnapshotCodec::SnapshotState& state);
+    bool foldIntoNext(SnapshotRepository& repo, const Snapshot& target);
+    bool indexHistory(const Snapshot& snapshot, const SnapshotCodec::SnapshotState& state);
+
 private:
     QString lastError_;
 };
@@ -0,0 +1,211 @@
+#include "SnapshotScheduler.h"
+#include "SnapshotController.h"
+#include "../database/SnapshotRepository.h"
+#include "../database/ConnectionPool.h"
+#include "../database/DatabaseManager.h"
+#include "../core/Constants.h"
+#include "../utils/Config.h"
+#include "../utils/Logger.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <memory>
+
+namespace {
+
+/**
+ * @brief Session-owned SQL Server application lock, released on destruction
+ *
+ * Serializes the due check and the write across every client on the database.
+ */
+class ScheduleLock
+{
+public:
+    explicit ScheduleLock(QSqlDatabase& db)
+        : db_(db)
+        , held_(false)
+    {
+        QSqlQuery query(db_);
+        query.prepare("DECLARE @result INT; "
+                      "EXEC @result = sp_getapplock @Resource = ?, @LockMode = 'Exclusive', "
+                      "@LockOwner = 'Session', @LockTimeout = ?; "
+                      "SELECT @result;");
+        query.addBindValue(QString(RESOURCE));
+        query.addBindValue(Constants::SNAPSHOT_SCHEDULE_LOCK_TIMEOUT);
+        if (!query.exec()) {
+            error_ = query.lastError().text();
+        } else if (!query.next() || query.value(0).toInt() < 0) {
+            error_ = "Timed out waiting for another client's scheduled snapshot";
+        } else {
+            held_ = true;
+        }
+    }
+
+    ~ScheduleLock()
+    {
+        if (held_) {
+            QSqlQuery query(db_);
+            query.prepare("EXEC sp_releaseapplock @Resource = ?, @LockOwner = 'Session'");
+            query.addBindValue(QString(RESOURCE));
+            query.exec();
+        }
+    }
+
+    bool isHeld() const { return held_; }
+    QString error() const { return error_; }
+
+private:
+    static constexpr const char* RESOURCE = "skill_matrix.scheduled_snapshot";
+
+    QSqlDatabase& db_;
+    bool held_;
+    QString error_;
+};
+
+} // namespace
+
+SnapshotScheduler& SnapshotScheduler::instance()
+{
+    static SnapshotScheduler instance;
+    return instance;
+}
+
+SnapshotScheduler::SnapshotScheduler(QObject* parent)
+    : QObject(parent)
+    , timer_(new QTimer(this))
+    , watcher_(new QFutureWatcher<RunResult>(this))
+{
+    timer_->setInterval(Constants::SNAPSHOT_SCHEDULER_CHECK_INTERVAL);
+    connect(timer_, &QTimer::timeout, this, &SnapshotScheduler::onTimeout);
+    connect(watcher_, &QFutureWatcher<RunResult>::finished, this, &SnapshotScheduler::onRunFinished);
+    connect(&Config::instance(), &Config::configChanged, this, &SnapshotScheduler::onConfigChanged);
+}
+
+SnapshotScheduler::~SnapshotScheduler()
+{
+}
+
+void SnapshotScheduler::start()
+{
+    // The first run also indexes the history of older snapshots, whatever the schedule
+    launch(false);
+
+    if (Config::instance().snapshotSchedule() == Constants::SNAPSHOT_SCHEDULE_MANUAL) {
+        Logger::instance().info("SnapshotScheduler", "Scheduled snapshots are off");
+        timer_->stop();
+        return;
+    }
+
+    Logger::instance().info("SnapshotScheduler",
+        "Scheduled snapshots: " + Config::instance().snapshotSchedule());
+    timer_->start();
+}
+
+void SnapshotScheduler::stop()
+{
+    timer_->stop();
+    watcher_->waitForFinished();
+}
+
+void SnapshotScheduler::runNow()
+{
+    launch(true);
+}
+
+void SnapshotScheduler::onTimeout()
+{
+    launch(false);
+}
+
+void SnapshotScheduler::onConfigChanged(const QString& key)
+{
+    if (key != "snapshots.schedule") {
+        return;
+    }
+
+    if (Config::instance().snapshotSchedule() == Constants::SNAPSHOT_SCHEDULE_MANUAL) {
+        if (timer_->isActive()) {
+            Logger::instance().info("SnapshotScheduler", "Scheduled snapshots are off");
+            timer_->stop();
+        }
+    } else if (!timer_->isActive()) {
+        start();
+    }
+}
+
+void SnapshotScheduler::launch(bool force)
+{
+    if (watcher_->isRunning()) {
+        return;
+    }
+
+    Config& config = Config::instance();
+    watcher_->setFuture(QtConcurrent::run(&SnapshotScheduler::runScheduled,
+                                          config.snapshotSchedule(),
+                                          config.snapshotCheckpointInterval(),
+                                          force));
+}
+
+void SnapshotScheduler::runScheduled(QPromise<RunResult>& promise, QString schedule, int checkpointInterval, bool force)
+{
+    // Repository calls issued from this job use the worker thread's pooled connection
+    ScopedConnection connection;
+    RunResult result;
+
+    // Snapshots written before the per-engineer history existed
+    SnapshotController controller;
+    controller.backfillHistory(Constants::SNAPSHOT_HISTORY_BACKFILL_BATCH);
+
+    // Check and write under one lock so concurrent clients write one per period
+    std::unique_ptr<ScheduleLock> lock;
+    if (!force) {
+        int periodDays = 0;
+        if (schedule == Constants::SNAPSHOT_SCHEDULE_DAILY) {
+            periodDays = 1;
+        } else if (schedule == Constants::SNAPSHOT_SCHEDULE_WEEKLY) {
+            periodDays = 7;
+        }
+        if (periodDays == 0) {
+            promise.addResult(result);
+            return;
+        }
+
+        lock.reset(new ScheduleLock(DatabaseManager::instance().database()));
+        if (!lock->isHeld()) {
+            result.error = lock->error();
+            promise.addResult(result);
+            return;
+        }
+
+        SnapshotRepository repo;
+        Snapshot last = repo.findLatest(Constants::SNAPSHOT_SOURCE_SCHEDULED);
+        if (!repo.lastError().isEmpty()) {
+            result.error = repo.lastError();
+            promise.addResult(result);
+            return;
+        }
+        if (last.isValid() && last.timestamp().addDays(periodDays) > QDateTime::currentDateTime()) {
+            promise.addResult(result);   // not due yet
+            return;
+        }
+    }
+
+    result.snapshotId = controller.createScheduledSnapshot(checkpointInterval);
+    result.error = controller.lastError();
+    promise.addResult(result);
+}
+
+void SnapshotScheduler::onRunFinished()
+{
+    if (watcher_->future().resultCount() == 0) {
+        return;
+    }
+
+    RunResult result = watcher_->result();
+    if (!result.snapshotId.isEmpty()) {
+        emit snapshotCreated(result.snapshotId);
+    } else if (!result.error.isEmpty()) {
+        Logger::instance().error("SnapshotScheduler", "Scheduled snapshot failed: " + result.error);
+        emit snapshotFailed(result.error);
+    }
+}
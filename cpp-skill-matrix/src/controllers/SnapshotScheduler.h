@@ -0,0 +1,79 @@
+#ifndef SNAPSHOTSCHEDULER_H
+#define SNAPSHOTSCHEDULER_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QFutureWatcher>
+#include <QPromise>
+
+/**
+ * @brief Background creator of scheduled snapshots
+ *
+ * Checks periodically whether the configured schedule ("snapshots.schedule")
+ * is due and, if so, writes the next link of the snapshot chain on a worker
+ * thread. Due-ness is read from the latest scheduled snapshot in the
+ * database, and the check and the write run under an sp_getapplock
+ * application lock, so several clients running at once still write one per
+ * period.
+ * Each run first indexes a batch of snapshots missing from the per-engineer
+ * history.
+ */
+class SnapshotScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Outcome of one scheduler run
+     */
+    struct RunResult {
+        QString snapshotId;     // empty if nothing was written
+        QString error;
+    };
+
+    static SnapshotScheduler& instance();
+
+    /**
+     * @brief Start the periodic check (runs once straight away, even when off)
+     */
+    void start();
+
+    /**
+     * @brief Stop checking and wait for a run in progress
+     */
+    void stop();
+
+    bool isRunning() const { return watcher_->isRunning(); }
+
+public slots:
+    /**
+     * @brief Write a scheduled snapshot now, whatever the schedule
+     */
+    void runNow();
+
+signals:
+    void snapshotCreated(const QString& snapshotId);
+    void snapshotFailed(const QString& error);
+
+private slots:
+    void onTimeout();
+    void onConfigChanged(const QString& key);
+    void onRunFinished();
+
+private:
+    SnapshotScheduler(QObject* parent = nullptr);
+    ~SnapshotScheduler();
+
+    SnapshotScheduler(const SnapshotScheduler&) = delete;
+    SnapshotScheduler& operator=(const SnapshotScheduler&) = delete;
+
+    void launch(bool force);
+    static void runScheduled(QPromise<RunResult>& promise, QString schedule, int checkpointInterval, bool force);
+
+private:
+    QTimer* timer_;
+    QFutureWatcher<RunResult>* watcher_;
+};
+
+#endif // SNAPSHOTSCHEDULER_H
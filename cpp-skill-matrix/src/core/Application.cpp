@@ -5,9 +5,13 @@
 #include "../ui/LoginDialog.h"
 #include "../ui/StyleManager.h"
 #include "../database/DatabaseManager.h"
+#include "../database/SkillMatrixStore.h"
+#include "../controllers/SnapshotScheduler.h"
 #include "../utils/Logger.h"
 #include "../utils/Config.h"
+#include "../utils/Crypto.h"
 #include "../utils/IconProvider.h"
+#include "../utils/ProductionDataImporter.h"
 
 #include <QMessageBox>
 #include <QFile>
@@ -28,6 +32,7 @@ Application::Application(QObject* parent)
     , mainWindow_(nullptr)
     , settings_(nullptr)
     , debugMode_(false)
+    , dryRun_(false)
     , currentTheme_(Constants::THEME_DARK)
 {
 }
@@ -39,6 +44,13 @@ Application::~Application()
 
 bool Application::initialize(int argc, char* argv[])
 {
+    // A headless import needs no display; let it run over SSH or from a scheduler
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--import-production-data") == 0 && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
+
     // Create Qt application
     qApp_ = new QApplication(argc, argv);
 
@@ -73,13 +85,17 @@ bool Application::initialize(int argc, char* argv[])
     Logger::instance().initialize();
     Logger::instance().info("Application", "Starting Skill Matrix v" + version());
 
-    // Check for debug mode
+    // Check for debug mode and a headless import
     for (int i = 1; i < argc; ++i) {
         QString arg = QString::fromUtf8(argv[i]);
         if (arg == "--debug" || arg == "-d") {
             debugMode_ = true;
             Logger::instance().setLevel(Logger::Debug);
-            Logger::instance().debug("Application", "Debug mode enabled");
+            LOG_DEBUG("Application", "Debug mode enabled");
+        } else if (arg == "--import-production-data" && i + 1 < argc) {
+            importFile_ = QString::fromLocal8Bit(argv[++i]);
+        } else if (arg == "--dry-run") {
+            dryRun_ = true;
         }
     }
 
@@ -95,9 +111,15 @@ bool Application::initialize(int argc, char* argv[])
     // Initialize database
     DatabaseManager& dbManager = DatabaseManager::instance();
 
+    // Create the shared cache on the GUI thread, before any worker can touch it first
+    SkillMatrixStore::instance();
+
     // Load database configuration from config file
     Config& config = Config::instance();
     config.load();
+    applyLoggingConfig();
+    applyPasswordCost();
+    dbManager.setPoolLimits(config.databasePoolSize(), config.databasePoolIdleTimeout());
 
     // Connect to database using config
     if (config.has("database.server")) {
@@ -118,8 +140,59 @@ bool Application::initialize(int argc, char* argv[])
     return true;
 }
 
+void Application::applyLoggingConfig()
+{
+    Logger& logger = Logger::instance();
+    Config& config = Config::instance();
+    bool ok = false;
+
+    // --debug wins over the configured global level
+    if (!debugMode_ && !config.loggingLevel().isEmpty()) {
+        Logger::LogLevel level = Logger::levelFromString(config.loggingLevel(), &ok);
+        if (ok) {
+            logger.setLevel(level);
+        } else {
+            logger.warning("Application", "Unknown logging.level: " + config.loggingLevel());
+        }
+    }
+
+    // Per-category thresholds, e.g. "logging": {"categories": {"AssessmentRepository": "info"}}
+    const QVariantMap categories = config.loggingCategoryLevels();
+    for (auto it = categories.constBegin(); it != categories.constEnd(); ++it) {
+        Logger::LogLevel level = Logger::levelFromString(it.value().toString(), &ok);
+        if (ok) {
+            logger.setCategoryLevel(it.key(), level);
+        } else {
+            logger.warning("Application", QString("Unknown level for logging category %1: %2")
+                .arg(it.key(), it.value().toString()));
+        }
+    }
+}
+
+void Application::applyPasswordCost()
+{
+    Config& config = Config::instance();
+
+    // Calibrate once per installation; the cost then stays fixed until changed in the config
+    int iterations = config.passwordIterations();
+    if (iterations <= 0) {
+        iterations = Crypto::calibrateIterations(Constants::PASSWORD_HASH_TARGET_MS);
+        config.setPasswordIterations(iterations);
+        config.save();
+        Logger::instance().info("Application",
+            QString("Calibrated password hashing: %1 PBKDF2 iterations (~%2 ms)")
+            .arg(iterations).arg(Constants::PASSWORD_HASH_TARGET_MS));
+    }
+
+    Crypto::setDefaultIterations(iterations);
+}
+
 int Application::run()
 {
+    if (!importFile_.isEmpty()) {
+        return runImport();
+    }
+
     // Show login dialog
     LoginDialog loginDialog;
     if (loginDialog.exec() != QDialog::Accepted) {
@@ -133,10 +206,31 @@ int Application::run()
 
     Logger::instance().info("Application", "Main window displayed");
 
+    // Periodic snapshots per the configured schedule
+    SnapshotScheduler::instance().start();
+
     // Run event loop
     return qApp_->exec();
 }
 
+int Application::runImport()
+{
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if (!DatabaseManager::instance().isConnected()) {
+        err << "Cannot import " << importFile_ << ": not connected to the database (check config.json)\n";
+        return 2;
+    }
+
+    ProductionDataImporter importer;
+    importer.setDryRun(dryRun_);
+    ProductionDataImporter::Report report = importer.importFile(importFile_);
+
+    out << importFile_ << "\n" << report.summary() << "\n";
+    return report.success ? 0 : 1;
+}
+
 void Application::shutdown()
 {
     Logger::instance().info("Application", "Shutting down");
@@ -150,6 +244,9 @@ void Application::shutdown()
         mainWindow_ = nullptr;
     }
 
+    // Let a scheduled snapshot in progress finish before its connection goes away
+    SnapshotScheduler::instance().stop();
+
     // Disconnect from database
     DatabaseManager::instance().disconnect();
 
@@ -274,7 +371,7 @@ void Application::loadSettings()
     bool autoSave = settings_->value(Constants::SETTING_AUTO_SAVE, true).toBool();
     Q_UNUSED(autoSave); // Will be used later
 
-    Logger::instance().debug("Application", "Settings loaded");
+    LOG_DEBUG("Application", "Settings loaded");
 }
 
 void Application::saveSettings()
@@ -294,7 +391,7 @@ void Application::saveSettings()
     }
 
     settings_->sync();
-    Logger::instance().debug("Application", "Settings saved");
+    LOG_DEBUG("Application", "Settings saved");
 }
 
 void Application::setupApplication()
@@ -321,7 +418,7 @@ void Application::loadStylesheet(const QString& theme)
         QString stylesheet = stream.readAll();
         qApp_->setStyleSheet(stylesheet);
         file.close();
-        Logger::instance().debug("Application", "Loaded stylesheet: " + theme);
+        LOG_DEBUG("Application", "Loaded stylesheet: " + theme);
     } else {
         // Fallback to default Qt style
         Logger::instance().warning("Application", "Failed to load stylesheet: " + stylesheetPath);
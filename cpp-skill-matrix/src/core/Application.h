@@ -37,7 +37,11 @@ public:
 
     /**
      * @brief Run the application event loop
-     * @return Application exit code
+     *
+     * With --import-production-data <file> [--dry-run] the file is imported
+     * without the login dialog or main window and the report is printed.
+     *
+     * @return Application exit code (import: 0 success, 1 failed, 2 no database)
      */
     int run();
 
@@ -180,11 +184,27 @@ private:
      */
     void saveSettings();
 
+    /**
+     * @brief Apply the global and per-category log levels from Config
+     */
+    void applyLoggingConfig();
+
+    /**
+     * @brief Set the password hashing cost from Config, calibrating it on first run
+     */
+    void applyPasswordCost();
+
     /**
      * @brief Setup application metadata
      */
     void setupApplication();
 
+    /**
+     * @brief Headless import of production-data-import.json
+     * @return Process exit code
+     */
+    int runImport();
+
     /**
      * @brief Load stylesheet
      * @param theme Theme name
@@ -197,6 +217,8 @@ private:
     MainWindow* mainWindow_;
     QSettings* settings_;
     bool debugMode_;
+    QString importFile_;    // --import-production-data
+    bool dryRun_;           // --dry-run
     QString currentTheme_;
 };
 
@@ -15,6 +15,40 @@ constexpr const char* APP_DOMAIN = "aptitude.local";
 constexpr const char* DB_CONNECTION_NAME = "SkillMatrixDB";
 constexpr int DB_CONNECTION_TIMEOUT = 5000; // milliseconds
 
+// Database Connection Pool (worker threads)
+constexpr int DB_POOL_MAX_SIZE = 8;
+constexpr int DB_POOL_IDLE_TIMEOUT = 300000; // 5 minutes in milliseconds
+constexpr int DB_POOL_ACQUIRE_TIMEOUT = 10000; // milliseconds
+constexpr int DB_POOL_HEALTH_CHECK_INTERVAL = 30000; // idle time before re-validating
+constexpr int DB_POOL_SWEEP_INTERVAL = 60000; // milliseconds
+constexpr int DB_POOL_REAP_INTERVAL = 100; // poll for finished threads while waiting for a slot
+
+// Bulk writes (rows sent per set-based MERGE statement)
+constexpr int DB_UPSERT_BATCH_SIZE = 5000;
+
+// Bulk reads: TDS packet size in bytes (SQL Server maximum). QODBC fetches one
+// row per SQLFetch, so larger packets are what cut round trips on big scans.
+constexpr int DB_PACKET_SIZE = 32767;
+
+// Prepared statements kept per connection (least recently used dropped first)
+constexpr int DB_STATEMENT_CACHE_SIZE = 64;
+
+// Logging (records queued for the writer thread)
+constexpr int LOG_RING_CAPACITY = 8192; // power of two; records beyond this are dropped and counted
+constexpr int LOG_FLUSH_INTERVAL = 250; // milliseconds between file flushes
+constexpr int LOG_FLUSH_BYTES = 65536; // buffered bytes that force an earlier flush
+
+// Snapshots
+constexpr int SNAPSHOT_CHECKPOINT_INTERVAL = 30; // scheduled snapshots per chain (checkpoint + deltas)
+constexpr int SNAPSHOT_SCHEDULER_CHECK_INTERVAL = 900000; // 15 minutes in milliseconds
+constexpr int SNAPSHOT_HISTORY_BACKFILL_BATCH = 100; // snapshots indexed per scheduler run
+constexpr int SNAPSHOT_SCHEDULE_LOCK_TIMEOUT = 60000; // wait for another client writing the same period
+constexpr const char* SNAPSHOT_SCHEDULE_MANUAL = "manual";
+constexpr const char* SNAPSHOT_SCHEDULE_DAILY = "daily";
+constexpr const char* SNAPSHOT_SCHEDULE_WEEKLY = "weekly";
+constexpr const char* SNAPSHOT_SOURCE_MANUAL = "manual";
+constexpr const char* SNAPSHOT_SOURCE_SCHEDULED = "scheduled";
+
 // User Roles
 constexpr const char* ROLE_ADMIN = "admin";
 constexpr const char* ROLE_ENGINEER = "engineer";
@@ -86,6 +120,12 @@ constexpr int PASSWORD_MIN_LENGTH = 6;
 constexpr int PASSWORD_MAX_LENGTH = 255;
 constexpr int BCRYPT_ROUNDS = 10;
 
+// Password hashing (PBKDF2-HMAC-SHA256; the cost is stored in every hash)
+constexpr int PASSWORD_HASH_TARGET_MS = 250; // calibrated cost of one hash
+constexpr int PASSWORD_PBKDF2_MIN_ITERATIONS = 100000;
+constexpr int PASSWORD_PBKDF2_MAX_ITERATIONS = 5000000;
+constexpr int PASSWORD_PBKDF2_DEFAULT_ITERATIONS = 600000; // until calibrated
+
 // Pagination
 constexpr int DEFAULT_PAGE_SIZE = 50;
 constexpr int MAX_PAGE_SIZE = 1000;
@@ -94,6 +134,19 @@ constexpr int MAX_PAGE_SIZE = 1000;
 constexpr int EXPORT_BATCH_SIZE = 100;
 constexpr const char* EXPORT_DATE_FORMAT = "yyyy-MM-dd";
 constexpr const char* EXPORT_DATETIME_FORMAT = "yyyy-MM-dd HH:mm:ss";
+constexpr int EXPORT_DEFLATE_LEVEL = 3; // zlib level for XLSX parts (1 fastest .. 9 smallest)
+constexpr int EXPORT_WRITE_BUFFER = 65536; // sheet XML bytes buffered before deflating
+constexpr int EXPORT_SHARED_STRINGS_MAX = 100000; // distinct shared strings; later ones are written inline
+constexpr const char* EXPORT_JSON_VERSION = "1.0.0"; // "version" of the web app's data file
+
+// Import
+constexpr int IMPORT_BATCH_SIZE = 5000; // records per write transaction
+constexpr int IMPORT_CHUNK_ROWS = 256; // sheet rows handed to validation at once
+constexpr int IMPORT_QUEUE_DEPTH = 8; // chunks / batches buffered between pipeline stages
+constexpr int IMPORT_MAX_ERRORS = 200; // row errors listed in an import result; the rest are counted
+constexpr int IMPORT_CSV_CHUNK_BYTES = 4 * 1024 * 1024; // CSV bytes parsed per task
+constexpr qint64 IMPORT_MAX_ENTRY_BYTES = 1024LL * 1024 * 1024; // inflated size of one workbook part (zip bomb guard)
+constexpr qint64 IMPORT_MAX_SHARED_STRINGS_BYTES = 256LL * 1024 * 1024; // inflated shared string table, held in memory
 
 // Audit Actions
 constexpr const char* ACTION_LOGIN = "LOGIN";
@@ -0,0 +1,201 @@
+#include "AnalyticsRepository.h"
+#include "DatabaseManager.h"
+#include "../utils/Logger.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+
+AnalyticsRepository::AnalyticsRepository() : lastError_("") {}
+AnalyticsRepository::~AnalyticsRepository() {}
+
+QList<EngineerScoreSummary> AnalyticsRepository::findRankedEngineers(int limit, bool ascending)
+{
+    lastError_.clear();
+    QList<EngineerScoreSummary> results;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("AnalyticsRepository", lastError_);
+        return results;
+    }
+
+    // Only engineers with at least one scored skill are ranked
+    QString order = ascending ? "ASC" : "DESC";
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(QString("SELECT TOP (?) engineer_id, AVG(CAST(score AS FLOAT)) AS avg_score, COUNT(*) "
+                          "FROM core_skill_assessments "
+                          "WHERE score > 0 "
+                          "GROUP BY engineer_id "
+                          "ORDER BY avg_score %1, engineer_id").arg(order));
+    query.addBindValue(limit);
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("AnalyticsRepository", "findRankedEngineers failed: " + lastError_);
+        return results;
+    }
+
+    while (query.next()) {
+        EngineerScoreSummary summary;
+        summary.engineerId = query.value(0).toString();
+        summary.averageScore = query.value(1).toDouble();
+        summary.assessedCount = query.value(2).toInt();
+        results.append(summary);
+    }
+
+    LOG_DEBUG("AnalyticsRepository", QString("Ranked %1 engineers").arg(results.size()));
+    return results;
+}
+
+QList<ShiftSummary> AnalyticsRepository::findShiftSummaries()
+{
+    return queryShiftSummaries(QString());
+}
+
+ShiftSummary AnalyticsRepository::findShiftSummary(const QString& shift)
+{
+    QList<ShiftSummary> summaries = queryShiftSummaries(shift);
+    if (!summaries.isEmpty()) {
+        return summaries.first();
+    }
+
+    ShiftSummary empty;
+    empty.shift = shift;
+    return empty;
+}
+
+QList<ShiftSummary> AnalyticsRepository::queryShiftSummaries(const QString& shift)
+{
+    lastError_.clear();
+    QList<ShiftSummary> results;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("AnalyticsRepository", lastError_);
+        return results;
+    }
+
+    // Per-engineer aggregates are computed with OUTER APPLY so each engineer is
+    // resolved through the engineer_id indexes, then rolled up per shift
+    QString sql = "SELECT e.shift, COUNT(*), "
+                  "       (SELECT COUNT(*) FROM core_skills), "
+                  "       ISNULL(SUM(c.core_count), 0), "
+                  "       ISNULL(SUM(c.assessed_count), 0), "
+                  "       ISNULL(SUM(m.machine_count), 0), "
+                  "       ISNULL(SUM(c.core_avg), 0) / COUNT(*) "
+                  "FROM engineers e "
+                  "OUTER APPLY (SELECT COUNT(*) AS core_count, "
+                  "                    SUM(CASE WHEN score > 0 THEN 1 ELSE 0 END) AS assessed_count, "
+                  "                    AVG(CASE WHEN score > 0 THEN CAST(score AS FLOAT) END) AS core_avg "
+                  "             FROM core_skill_assessments WHERE engineer_id = e.id) c "
+                  "OUTER APPLY (SELECT COUNT(*) AS machine_count "
+                  "             FROM assessments WHERE engineer_id = e.id) m ";
+    if (!shift.isEmpty()) {
+        sql += "WHERE e.shift = ? ";
+    }
+    sql += "GROUP BY e.shift ORDER BY e.shift";
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    if (!shift.isEmpty()) {
+        query.addBindValue(shift);
+    }
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("AnalyticsRepository", "queryShiftSummaries failed: " + lastError_);
+        return results;
+    }
+
+    while (query.next()) {
+        ShiftSummary summary;
+        summary.shift = query.value(0).toString();
+        summary.engineerCount = query.value(1).toInt();
+        summary.coreSkillCount = query.value(2).toInt();
+        summary.coreAssessmentCount = query.value(3).toInt();
+        summary.assessedCoreSkillCount = query.value(4).toInt();
+        summary.machineAssessmentCount = query.value(5).toInt();
+        summary.averageCoreScore = query.value(6).toDouble();
+        results.append(summary);
+    }
+
+    LOG_DEBUG("AnalyticsRepository", QString("Summarised %1 shifts").arg(results.size()));
+    return results;
+}
+
+ScoreDistribution AnalyticsRepository::findCoreSkillScoreDistribution()
+{
+    lastError_.clear();
+    ScoreDistribution distribution;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("AnalyticsRepository", lastError_);
+        return distribution;
+    }
+
+    // Score buckets plus one extra row (score NULL) holding the unassessed pairs
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT score, COUNT(*) FROM core_skill_assessments GROUP BY score "
+                    "UNION ALL "
+                    "SELECT NULL, (SELECT COUNT(*) FROM engineers) * (SELECT COUNT(*) FROM core_skills) "
+                    "           - (SELECT COUNT(*) FROM core_skill_assessments a "
+                    "              INNER JOIN core_skills s ON s.id = a.skill_id)")) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("AnalyticsRepository", "findCoreSkillScoreDistribution failed: " + lastError_);
+        return distribution;
+    }
+
+    while (query.next()) {
+        if (query.value(0).isNull()) {
+            distribution.unassessedCount = qMax(0, query.value(1).toInt());
+        } else {
+            distribution.countsByScore.insert(query.value(0).toInt(), query.value(1).toInt());
+        }
+    }
+
+    return distribution;
+}
+
+QList<AreaCoverage> AnalyticsRepository::findProductionAreaCoverage()
+{
+    lastError_.clear();
+    QList<AreaCoverage> results;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("AnalyticsRepository", lastError_);
+        return results;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT pa.id, "
+                    "       (SELECT COUNT(*) FROM competencies c "
+                    "        INNER JOIN machines m ON m.id = c.machine_id "
+                    "        WHERE m.production_area_id = pa.id), "
+                    "       (SELECT COUNT(*) FROM assessments a "
+                    "        WHERE a.production_area_id = pa.id AND a.score > 0) "
+                    "FROM production_areas pa ORDER BY pa.id")) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("AnalyticsRepository", "findProductionAreaCoverage failed: " + lastError_);
+        return results;
+    }
+
+    while (query.next()) {
+        AreaCoverage coverage;
+        coverage.productionAreaId = query.value(0).toInt();
+        coverage.competencyCount = query.value(1).toInt();
+        coverage.assessedCount = query.value(2).toInt();
+        results.append(coverage);
+    }
+
+    return results;
+}
@@ -0,0 +1,85 @@
+#ifndef ANALYTICSREPOSITORY_H
+#define ANALYTICSREPOSITORY_H
+
+#include <QString>
+#include <QList>
+#include <QMap>
+
+/**
+ * @brief Average core skill score of one engineer (assessed skills only)
+ */
+struct EngineerScoreSummary
+{
+    QString engineerId;
+    double averageScore = 0.0;
+    int assessedCount = 0;
+};
+
+/**
+ * @brief Core skill and machine assessment totals for one shift
+ */
+struct ShiftSummary
+{
+    QString shift;
+    int engineerCount = 0;
+    int coreSkillCount = 0;            // core skills defined in the system
+    int coreAssessmentCount = 0;       // all core skill assessment rows
+    int assessedCoreSkillCount = 0;    // core skill assessments with score > 0
+    int machineAssessmentCount = 0;
+    double averageCoreScore = 0.0;     // mean of per-engineer averages (0 for unassessed engineers)
+};
+
+/**
+ * @brief Core skill score histogram across all engineers
+ */
+struct ScoreDistribution
+{
+    QMap<int, int> countsByScore;      // score -> number of assessments
+    int unassessedCount = 0;           // (engineer, skill) pairs with no assessment row
+};
+
+/**
+ * @brief Production area competency coverage
+ */
+struct AreaCoverage
+{
+    int productionAreaId = 0;
+    int competencyCount = 0;
+    int assessedCount = 0;             // machine assessments with score > 0
+};
+
+/**
+ * @brief Read-only aggregate queries for analytics and reports
+ *
+ * GROUP BY, AVG, COUNT and TOP are evaluated by SQL Server so only summary rows
+ * cross the connection, instead of loading every assessment and filtering in C++.
+ */
+class AnalyticsRepository
+{
+public:
+    AnalyticsRepository();
+    ~AnalyticsRepository();
+
+    /**
+     * @brief Engineers with the highest (or lowest) average core skill score
+     * @param limit Maximum number of rows
+     * @param ascending true for the lowest scores first
+     */
+    QList<EngineerScoreSummary> findRankedEngineers(int limit, bool ascending = false);
+
+    QList<ShiftSummary> findShiftSummaries();
+    ShiftSummary findShiftSummary(const QString& shift);
+
+    ScoreDistribution findCoreSkillScoreDistribution();
+    QList<AreaCoverage> findProductionAreaCoverage();
+
+    QString lastError() const { return lastError_; }
+
+private:
+    QList<ShiftSummary> queryShiftSummaries(const QString& shift);
+
+private:
+    QString lastError_;
+};
+
+#endif // ANALYTICSREPOSITORY_H
@@ -1,9 +1,17 @@
 #include "AssessmentRepository.h"
 #include "DatabaseManager.h"
+#include "ChangeTracking.h"
+#include "SkillMatrixStore.h"
 #include "../utils/Logger.h"
+#include "../core/Constants.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QHash>
+#include <QStringList>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 AssessmentRepository::AssessmentRepository() : lastError_("") {}
 AssessmentRepository::~AssessmentRepository() {}
@@ -20,6 +28,7 @@ QList<Assessment> AssessmentRepository::findAll()
     }
 
     QSqlQuery query(db);
+    query.setForwardOnly(true);
     query.prepare("SELECT id, engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at "
                   "FROM assessments ORDER BY created_at DESC");
 
@@ -42,10 +51,159 @@ QList<Assessment> AssessmentRepository::findAll()
         assessments.append(assessment);
     }
 
-    Logger::instance().debug("AssessmentRepository", QString("Found %1 assessments").arg(assessments.size()));
+    LOG_DEBUG("AssessmentRepository", QString("Found %1 assessments").arg(assessments.size()));
     return assessments;
 }
 
+Page<Assessment> AssessmentRepository::findPage(int pageSize, const PageCursor& after, const PageFilter& filter)
+{
+    lastError_.clear();
+    Page<Assessment> page;
+    page.next = after;
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("AssessmentRepository", lastError_);
+        return page;
+    }
+
+    pageSize = Pagination::boundedPageSize(pageSize);
+
+    QStringList conditions;
+    QVariantList values;
+    if (!filter.engineerId.isEmpty()) {
+        conditions << "engineer_id = ?";
+        values << filter.engineerId;
+    }
+    if (filter.productionAreaId > 0) {
+        conditions << "production_area_id = ?";
+        values << filter.productionAreaId;
+    }
+    if (!after.isStart()) {
+        conditions << "id > ?";
+        values << after.id;
+    }
+
+    QString sql = "SELECT TOP (?) id, engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at "
+                  "FROM assessments";
+    if (!conditions.isEmpty()) {
+        sql += " WHERE " + conditions.join(" AND ");
+    }
+    sql += " ORDER BY id";
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    query.addBindValue(pageSize + 1);   // one extra row tells whether another page follows
+    for (const QVariant& value : values) {
+        query.addBindValue(value);
+    }
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("AssessmentRepository", "findPage failed: " + lastError_);
+        return page;
+    }
+
+    while (query.next()) {
+        if (page.items.size() == pageSize) {
+            page.hasMore = true;
+            break;
+        }
+        Assessment assessment;
+        assessment.setId(query.value(0).toInt());
+        assessment.setEngineerId(query.value(1).toString());
+        assessment.setProductionAreaId(query.value(2).toInt());
+        assessment.setMachineId(query.value(3).toInt());
+        assessment.setCompetencyId(query.value(4).toInt());
+        assessment.setScore(query.value(5).toInt());
+        assessment.setCreatedAt(query.value(6).toDateTime());
+        assessment.setUpdatedAt(query.value(7).toDateTime());
+        page.items.append(assessment);
+    }
+
+    if (!page.items.isEmpty()) {
+        page.next.id = page.items.last().id();
+    }
+
+    LOG_DEBUG("AssessmentRepository", QString("Found %1 assessments (page)").arg(page.items.size()));
+    return page;
+}
+
+bool AssessmentRepository::forEach(const std::function<bool(const Assessment&)>& visitor, const PageFilter& filter,
+                                   Order order)
+{
+    lastError_.clear();
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("AssessmentRepository", lastError_);
+        return false;
+    }
+
+    QStringList conditions;
+    QVariantList values;
+    if (!filter.engineerId.isEmpty()) {
+        conditions << "engineer_id = ?";
+        values << filter.engineerId;
+    }
+    if (filter.productionAreaId > 0) {
+        conditions << "production_area_id = ?";
+        values << filter.productionAreaId;
+    }
+
+    QString sql = "SELECT id, engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at "
+                  "FROM assessments";
+    if (!conditions.isEmpty()) {
+        sql += " WHERE " + conditions.join(" AND ");
+    }
+    // A binary collation makes the server's order independent of the column's
+    // collation, so callers can merge the stream against a client-sorted list
+    sql += order == Order::ByEngineer ? " ORDER BY engineer_id COLLATE Latin1_General_BIN2, id" : " ORDER BY id";
+
+    // Forward-only: no client-side scrollable cursor, rows are not retained
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    for (const QVariant& value : values) {
+        query.addBindValue(value);
+    }
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("AssessmentRepository", "forEach failed: " + lastError_);
+        return false;
+    }
+
+    int visited = 0;
+    Assessment assessment;
+    while (query.next()) {
+        assessment.setId(query.value(0).toInt());
+        assessment.setEngineerId(query.value(1).toString());
+        assessment.setProductionAreaId(query.value(2).toInt());
+        assessment.setMachineId(query.value(3).toInt());
+        assessment.setCompetencyId(query.value(4).toInt());
+        assessment.setScore(query.value(5).toInt());
+        assessment.setCreatedAt(query.value(6).toDateTime());
+        assessment.setUpdatedAt(query.value(7).toDateTime());
+        ++visited;
+        if (!visitor(assessment)) {
+            break;
+        }
+    }
+
+    if (query.lastError().isValid()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("AssessmentRepository", "forEach fetch failed: " + lastError_);
+        return false;
+    }
+
+    LOG_DEBUG("AssessmentRepository", QString("Streamed %1 assessments").arg(visited));
+    return true;
+}
+
 QList<Assessment> AssessmentRepository::findByEngineer(const QString& engineerId)
 {
     QList<Assessment> assessments;
@@ -57,9 +215,10 @@ QList<Assessment> AssessmentRepository::findByEngineer(const QString& engineerId
         return assessments;
     }
 
-    QSqlQuery query(db);
-    query.prepare("SELECT id, engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at "
-                  "FROM assessments WHERE engineer_id = ? ORDER BY production_area_id, machine_id, competency_id");
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT id, engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at "
+        "FROM assessments WHERE engineer_id = ? ORDER BY production_area_id, machine_id, competency_id");
+    QSqlQuery& query = statement.query();
     query.addBindValue(engineerId);
 
     if (!query.exec()) {
@@ -81,7 +240,7 @@ QList<Assessment> AssessmentRepository::findByEngineer(const QString& engineerId
         assessments.append(assessment);
     }
 
-    Logger::instance().debug("AssessmentRepository",
+    LOG_DEBUG("AssessmentRepository",
         QString("Found %1 assessments for engineer %2").arg(assessments.size()).arg(engineerId));
     return assessments;
 }
@@ -95,9 +254,10 @@ Assessment AssessmentRepository::findById(int id)
         return Assessment();
     }
 
-    QSqlQuery query(db);
-    query.prepare("SELECT id, engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at "
-                  "FROM assessments WHERE id = ?");
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT id, engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at "
+        "FROM assessments WHERE id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(id);
 
     if (!query.exec()) {
@@ -117,11 +277,11 @@ Assessment AssessmentRepository::findById(int id)
         assessment.setCreatedAt(query.value(6).toDateTime());
         assessment.setUpdatedAt(query.value(7).toDateTime());
 
-        Logger::instance().debug("AssessmentRepository", QString("Found assessment with id: %1").arg(id));
+        LOG_DEBUG("AssessmentRepository", QString("Found assessment with id: %1").arg(id));
         return assessment;
     }
 
-    Logger::instance().debug("AssessmentRepository", QString("Assessment not found with id: %1").arg(id));
+    LOG_DEBUG("AssessmentRepository", QString("Assessment not found with id: %1").arg(id));
     return Assessment();
 }
 
@@ -135,10 +295,11 @@ bool AssessmentRepository::saveOrUpdate(Assessment& assessment)
     }
 
     // Check if assessment already exists for this combination
-    QSqlQuery checkQuery(db);
-    checkQuery.prepare("SELECT id FROM assessments "
-                       "WHERE engineer_id = ? AND production_area_id = ? "
-                       "AND machine_id = ? AND competency_id = ?");
+    CachedQuery checkStatement = DatabaseManager::instance().prepared(
+        "SELECT id FROM assessments "
+        "WHERE engineer_id = ? AND production_area_id = ? "
+        "AND machine_id = ? AND competency_id = ?");
+    QSqlQuery& checkQuery = checkStatement.query();
     checkQuery.addBindValue(assessment.engineerId());
     checkQuery.addBindValue(assessment.productionAreaId());
     checkQuery.addBindValue(assessment.machineId());
@@ -153,11 +314,16 @@ bool AssessmentRepository::saveOrUpdate(Assessment& assessment)
     bool exists = checkQuery.next();
     int existingId = exists ? checkQuery.value(0).toInt() : 0;
 
+    // Close the forward-only cursor before the write: without MARS the
+    // connection is busy while a result set is still open
+    checkQuery.finish();
+
     if (exists) {
         // UPDATE existing assessment
-        QSqlQuery updateQuery(db);
-        updateQuery.prepare("UPDATE assessments SET score = ?, updated_at = GETDATE() "
-                           "WHERE id = ?");
+        CachedQuery updateStatement = DatabaseManager::instance().prepared(
+            "UPDATE assessments SET score = ?, updated_at = GETDATE() "
+            "WHERE id = ?");
+        QSqlQuery& updateQuery = updateStatement.query();
         updateQuery.addBindValue(assessment.score());
         updateQuery.addBindValue(existingId);
 
@@ -168,15 +334,17 @@ bool AssessmentRepository::saveOrUpdate(Assessment& assessment)
         }
 
         assessment.setId(existingId);
-        Logger::instance().info("AssessmentRepository",
+        SkillMatrixStore::instance().assessmentsSaved({assessment});
+        LOG_INFO("AssessmentRepository",
             QString("Updated assessment for engineer %1, competency %2").arg(assessment.engineerId()).arg(assessment.competencyId()));
         return true;
     } else {
         // INSERT new assessment
-        QSqlQuery insertQuery(db);
-        insertQuery.prepare("INSERT INTO assessments (engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at) "
-                           "VALUES (?, ?, ?, ?, ?, GETDATE(), GETDATE()); "
-                           "SELECT SCOPE_IDENTITY();");
+        CachedQuery insertStatement = DatabaseManager::instance().prepared(
+            "INSERT INTO assessments (engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at) "
+            "VALUES (?, ?, ?, ?, ?, GETDATE(), GETDATE()); "
+            "SELECT SCOPE_IDENTITY();");
+        QSqlQuery& insertQuery = insertStatement.query();
         insertQuery.addBindValue(assessment.engineerId());
         insertQuery.addBindValue(assessment.productionAreaId());
         insertQuery.addBindValue(assessment.machineId());
@@ -193,7 +361,8 @@ bool AssessmentRepository::saveOrUpdate(Assessment& assessment)
         if (insertQuery.next()) {
             int newId = insertQuery.value(0).toInt();
             assessment.setId(newId);
-            Logger::instance().info("AssessmentRepository",
+            SkillMatrixStore::instance().assessmentsSaved({assessment});
+            LOG_INFO("AssessmentRepository",
                 QString("Created assessment for engineer %1, competency %2 (ID: %3)").arg(assessment.engineerId()).arg(assessment.competencyId()).arg(newId));
             return true;
         }
@@ -204,8 +373,14 @@ bool AssessmentRepository::saveOrUpdate(Assessment& assessment)
     }
 }
 
-bool AssessmentRepository::remove(int id)
+bool AssessmentRepository::saveOrUpdateBatch(QList<Assessment>& assessments, bool inCallerTransaction)
 {
+    lastError_.clear();
+
+    if (assessments.isEmpty()) {
+        return true;
+    }
+
     QSqlDatabase& db = DatabaseManager::instance().database();
     if (!db.isOpen()) {
         lastError_ = "Database not connected";
@@ -213,8 +388,172 @@ bool AssessmentRepository::remove(int id)
         return false;
     }
 
+    // MERGE rejects a batch that touches the same target row twice, so only
+    // the last row for each key is sent; duplicates receive its id afterwards
+    QHash<QString, int> lastRowForKey;
+    lastRowForKey.reserve(assessments.size());
+    for (int i = 0; i < assessments.size(); ++i) {
+        lastRowForKey.insert(assessments[i].getKey(), i);
+    }
+
+    QList<int> rows;
+    rows.reserve(lastRowForKey.size());
+    for (int i = 0; i < assessments.size(); ++i) {
+        if (lastRowForKey.value(assessments[i].getKey()) == i) {
+            rows.append(i);
+        }
+    }
+
+    if (!inCallerTransaction && !db.transaction()) {
+        lastError_ = db.lastError().text();
+        Logger::instance().error("AssessmentRepository", "saveOrUpdateBatch begin failed: " + lastError_);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    for (int offset = 0; offset < rows.size(); offset += Constants::DB_UPSERT_BATCH_SIZE) {
+        int end = qMin(offset + Constants::DB_UPSERT_BATCH_SIZE, rows.size());
+
+        QJsonArray batch;
+        for (int r = offset; r < end; ++r) {
+            const Assessment& assessment = assessments[rows[r]];
+            QJsonObject row;
+            row["i"] = rows[r];
+            row["e"] = assessment.engineerId();
+            row["a"] = assessment.productionAreaId();
+            row["m"] = assessment.machineId();
+            row["c"] = assessment.competencyId();
+            row["s"] = assessment.score();
+            batch.append(row);
+        }
+
+        query.prepare("MERGE assessments WITH (HOLDLOCK) AS target "
+                      "USING (SELECT row_index, engineer_id, production_area_id, machine_id, competency_id, score "
+                      "       FROM OPENJSON(CAST(? AS NVARCHAR(MAX))) WITH ("
+                      "           row_index INT '$.i', engineer_id NVARCHAR(50) '$.e', "
+                      "           production_area_id INT '$.a', machine_id INT '$.m', "
+                      "           competency_id INT '$.c', score INT '$.s')) AS source "
+                      "ON target.engineer_id = source.engineer_id "
+                      "AND target.production_area_id = source.production_area_id "
+                      "AND target.machine_id = source.machine_id "
+                      "AND target.competency_id = source.competency_id "
+                      "WHEN MATCHED THEN UPDATE SET score = source.score, updated_at = GETDATE() "
+                      "WHEN NOT MATCHED THEN INSERT (engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at) "
+                      "VALUES (source.engineer_id, source.production_area_id, source.machine_id, source.competency_id, source.score, GETDATE(), GETDATE()) "
+                      "OUTPUT source.row_index, inserted.id;");
+        query.addBindValue(QString::fromUtf8(QJsonDocument(batch).toJson(QJsonDocument::Compact)));
+
+        if (!query.exec()) {
+            lastError_ = query.lastError().text();
+            Logger::instance().error("AssessmentRepository", "saveOrUpdateBatch merge failed: " + lastError_);
+            if (!inCallerTransaction) {
+                db.rollback();
+            }
+            return false;
+        }
+
+        while (query.next()) {
+            assessments[query.value(0).toInt()].setId(query.value(1).toInt());
+        }
+    }
+
+    for (Assessment& assessment : assessments) {
+        assessment.setId(assessments[lastRowForKey.value(assessment.getKey())].id());
+    }
+
+    if (inCallerTransaction) {
+        LOG_INFO("AssessmentRepository", QString("Wrote %1 assessments into the open transaction").arg(rows.size()));
+        return true;
+    }
+
+    if (!db.commit()) {
+        lastError_ = db.lastError().text();
+        Logger::instance().error("AssessmentRepository", "saveOrUpdateBatch commit failed: " + lastError_);
+        db.rollback();
+        return false;
+    }
+
+    SkillMatrixStore::instance().assessmentsSaved(assessments);
+
+    LOG_INFO("AssessmentRepository",
+        QString("Upserted %1 assessments in %2 batches")
+        .arg(rows.size()).arg((rows.size() + Constants::DB_UPSERT_BATCH_SIZE - 1) / Constants::DB_UPSERT_BATCH_SIZE));
+    return true;
+}
+
+ChangeSet<Assessment, int> AssessmentRepository::findChangedSince(qint64 version)
+{
+    lastError_.clear();
+    ChangeSet<Assessment, int> changes;
+    changes.version = version;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("AssessmentRepository", lastError_);
+        return changes;
+    }
+
+    // Upper bound first, so rows committed while we read are caught next time
+    qint64 upTo = ChangeTracking::currentVersion(db, &lastError_);
+    if (upTo < 0) {
+        return changes;
+    }
+
     QSqlQuery query(db);
-    query.prepare("DELETE FROM assessments WHERE id = ?");
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, engineer_id, production_area_id, machine_id, competency_id, score, created_at, updated_at "
+                  "FROM assessments "
+                  "WHERE row_version > CAST(CAST(? AS BIGINT) AS BINARY(8)) "
+                  "AND row_version <= CAST(CAST(? AS BIGINT) AS BINARY(8))");
+    query.addBindValue(version);
+    query.addBindValue(upTo);
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("AssessmentRepository", "findChangedSince failed: " + lastError_);
+        return changes;
+    }
+
+    while (query.next()) {
+        Assessment assessment;
+        assessment.setId(query.value(0).toInt());
+        assessment.setEngineerId(query.value(1).toString());
+        assessment.setProductionAreaId(query.value(2).toInt());
+        assessment.setMachineId(query.value(3).toInt());
+        assessment.setCompetencyId(query.value(4).toInt());
+        assessment.setScore(query.value(5).toInt());
+        assessment.setCreatedAt(query.value(6).toDateTime());
+        assessment.setUpdatedAt(query.value(7).toDateTime());
+        changes.changed.append(assessment);
+    }
+
+    QStringList deletedKeys;
+    if (!ChangeTracking::findDeletedKeys(db, "assessments", version, upTo, deletedKeys, &lastError_)) {
+        return changes;
+    }
+    for (const QString& key : deletedKeys) {
+        changes.removed.append(key.toInt());
+    }
+
+    changes.version = upTo;
+    LOG_DEBUG("AssessmentRepository",
+        QString("findChangedSince: %1 changed, %2 removed").arg(changes.changed.size()).arg(changes.removed.size()));
+    return changes;
+}
+
+bool AssessmentRepository::remove(int id)
+{
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("AssessmentRepository", lastError_);
+        return false;
+    }
+
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "DELETE FROM assessments WHERE id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(id);
 
     if (!query.exec()) {
@@ -223,6 +562,7 @@ bool AssessmentRepository::remove(int id)
         return false;
     }
 
-    Logger::instance().info("AssessmentRepository", QString("Assessment removed: %1").arg(id));
+    SkillMatrixStore::instance().assessmentRemoved(id);
+    LOG_INFO("AssessmentRepository", QString("Assessment removed: %1").arg(id));
     return true;
 }
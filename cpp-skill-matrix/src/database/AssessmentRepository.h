@@ -2,18 +2,66 @@
 #define ASSESSMENTREPOSITORY_H
 
 #include "../models/Assessment.h"
+#include "ChangeTracking.h"
+#include "Pagination.h"
 #include <QList>
+#include <functional>
 
 class AssessmentRepository
 {
 public:
+    struct PageFilter {
+        QString engineerId;         // empty = any
+        int productionAreaId = 0;   // 0 = any
+    };
+
+    enum class Order {
+        ById,           // clustered key
+        ByEngineer      // engineer_id by code point, then id
+    };
+
     AssessmentRepository();
     ~AssessmentRepository();
 
     QList<Assessment> findAll();
+
+    /**
+     * @brief Up to pageSize assessments after a cursor, ordered by id
+     *
+     * Keyset pagination on the clustered key, or IX_assessments_engineer_id /
+     * IX_assessments_area_id when filtered.
+     */
+    Page<Assessment> findPage(int pageSize, const PageCursor& after = PageCursor(),
+                              const PageFilter& filter = PageFilter());
+
+    /**
+     * @brief Stream assessments to a visitor, one row at a time
+     *
+     * Reads through a forward-only cursor and never builds a list, so memory
+     * stays constant however many rows match. Return false from the visitor
+     * to stop early. Order::ByEngineer groups each engineer's rows together,
+     * with engineer ids in the order QString::compare() puts them.
+     * @return false on query error (stopping early is not an error)
+     */
+    bool forEach(const std::function<bool(const Assessment&)>& visitor,
+                 const PageFilter& filter = PageFilter(), Order order = Order::ById);
+    ChangeSet<Assessment, int> findChangedSince(qint64 version); // Delta since a rowversion mark (see ChangeTracking)
     QList<Assessment> findByEngineer(const QString& engineerId);
     Assessment findById(int id);
     bool saveOrUpdate(Assessment& assessment); // Upsert
+
+    /**
+     * @brief Upsert many assessments in one transaction
+     *
+     * Rows are sent as JSON to a set-based MERGE (OPENJSON), up to
+     * Constants::DB_UPSERT_BATCH_SIZE rows per statement. Generated or existing
+     * ids are written back into the list. Requires SQL Server 2016+.
+     *
+     * With inCallerTransaction the rows join a transaction the caller has
+     * begun; committing it and syncing SkillMatrixStore are then the caller's.
+     * @return true if every batch committed (or, joined, was written)
+     */
+    bool saveOrUpdateBatch(QList<Assessment>& assessments, bool inCallerTransaction = false);
     bool remove(int id);
 
     QString lastError() const { return lastError_; }
@@ -5,34 +5,81 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QStringList>
 
 AuditLogRepository::AuditLogRepository() : lastError_("") {}
 AuditLogRepository::~AuditLogRepository() {}
 
 QList<AuditLog> AuditLogRepository::findAll(int limit)
+{
+    return findPage(limit).items;
+}
+
+Page<AuditLog> AuditLogRepository::findPage(int pageSize, const PageCursor& after, const PageFilter& filter)
 {
     lastError_.clear();
-    QList<AuditLog> logs;
+    Page<AuditLog> page;
+    page.next = after;
     QSqlDatabase& db = DatabaseManager::instance().database();
 
     if (!db.isOpen()) {
         lastError_ = "Database not connected";
         Logger::instance().error("AuditLogRepository", lastError_);
-        return logs;
+        return page;
+    }
+
+    pageSize = Pagination::boundedPageSize(pageSize);
+
+    QStringList conditions;
+    QVariantList values;
+    if (!filter.userId.isEmpty()) {
+        conditions << "user_id = ?";
+        values << filter.userId;
+    }
+    if (!filter.action.isEmpty()) {
+        conditions << "action = ?";
+        values << filter.action;
+    }
+    if (filter.from.isValid()) {
+        conditions << "timestamp >= ?";
+        values << filter.from;
+    }
+    if (filter.to.isValid()) {
+        conditions << "timestamp < ?";
+        values << filter.to;
+    }
+    if (!after.isStart()) {
+        // Newest first: seek below (timestamp, id); the leading timestamp <= ? stays sargable.
+        // The cursor is cast back to DATETIME so its rounding matches the column.
+        conditions << "timestamp <= CAST(? AS DATETIME) AND (timestamp < CAST(? AS DATETIME) OR id < ?)";
+        values << after.sortKey << after.sortKey << after.id;
     }
 
+    QString sql = "SELECT TOP (?) id, timestamp, user_id, action, details, created_at FROM audit_logs";
+    if (!conditions.isEmpty()) {
+        sql += " WHERE " + conditions.join(" AND ");
+    }
+    sql += " ORDER BY timestamp DESC, id DESC";
+
     QSqlQuery query(db);
-    query.prepare("SELECT TOP (?) id, timestamp, user_id, action, details, created_at "
-                  "FROM audit_logs ORDER BY timestamp DESC");
-    query.addBindValue(limit);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    query.addBindValue(pageSize + 1);   // one extra row tells whether another page follows
+    for (const QVariant& value : values) {
+        query.addBindValue(value);
+    }
 
     if (!query.exec()) {
         lastError_ = query.lastError().text();
-        Logger::instance().error("AuditLogRepository", "findAll failed: " + lastError_);
-        return logs;
+        Logger::instance().error("AuditLogRepository", "findPage failed: " + lastError_);
+        return page;
     }
 
     while (query.next()) {
+        if (page.items.size() == pageSize) {
+            page.hasMore = true;
+            break;
+        }
         AuditLog log;
         log.setId(query.value(0).toString());
         log.setTimestamp(query.value(1).toDateTime());
@@ -40,11 +87,16 @@ QList<AuditLog> AuditLogRepository::findAll(int limit)
         log.setAction(query.value(3).toString());
         log.setDetails(query.value(4).toString());
         log.setCreatedAt(query.value(5).toDateTime());
-        logs.append(log);
+        page.items.append(log);
     }
 
-    Logger::instance().debug("AuditLogRepository", QString("Found %1 audit log entries").arg(logs.size()));
-    return logs;
+    if (!page.items.isEmpty()) {
+        page.next.sortKey = page.items.last().timestamp();
+        page.next.id = page.items.last().id();
+    }
+
+    LOG_DEBUG("AuditLogRepository", QString("Found %1 audit log entries (page)").arg(page.items.size()));
+    return page;
 }
 
 QList<AuditLog> AuditLogRepository::findByUser(const QString& userId)
@@ -81,7 +133,7 @@ QList<AuditLog> AuditLogRepository::findByUser(const QString& userId)
         logs.append(log);
     }
 
-    Logger::instance().debug("AuditLogRepository",
+    LOG_DEBUG("AuditLogRepository",
         QString("Found %1 audit log entries for user %2").arg(logs.size()).arg(userId));
     return logs;
 }
@@ -122,7 +174,7 @@ bool AuditLogRepository::save(AuditLog& log)
         return false;
     }
 
-    Logger::instance().info("AuditLogRepository",
+    LOG_INFO("AuditLogRepository",
         QString("Audit log saved: %1 - %2").arg(log.action()).arg(log.details()));
     return true;
 }
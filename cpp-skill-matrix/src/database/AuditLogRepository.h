@@ -2,15 +2,33 @@
 #define AUDITLOGREPOSITORY_H
 
 #include "../models/AuditLog.h"
+#include "Pagination.h"
 #include <QList>
+#include <QDateTime>
 
 class AuditLogRepository
 {
 public:
+    struct PageFilter {
+        QString userId;     // empty = any
+        QString action;     // exact match; empty = any
+        QDateTime from;     // inclusive; null = unbounded
+        QDateTime to;       // exclusive; null = unbounded
+    };
+
     AuditLogRepository();
     ~AuditLogRepository();
 
-    QList<AuditLog> findAll(int limit = 1000);
+    QList<AuditLog> findAll(int limit = Constants::MAX_PAGE_SIZE);   // newest first (first page of findPage)
+
+    /**
+     * @brief Up to pageSize entries after a cursor, newest first
+     *
+     * Keyset pagination on (timestamp DESC, id DESC), backed by
+     * IX_audit_logs_timestamp_id / IX_audit_logs_user_timestamp_id.
+     */
+    Page<AuditLog> findPage(int pageSize, const PageCursor& after = PageCursor(),
+                            const PageFilter& filter = PageFilter());
     QList<AuditLog> findByUser(const QString& userId);
     bool save(AuditLog& log);
 
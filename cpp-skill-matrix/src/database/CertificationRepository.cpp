@@ -1,9 +1,17 @@
 #include "CertificationRepository.h"
 #include "DatabaseManager.h"
+#include "ChangeTracking.h"
+#include "SkillMatrixStore.h"
 #include "../utils/Logger.h"
+#include "../core/Constants.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QStringList>
+#include <QSet>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 CertificationRepository::CertificationRepository() : lastError_("") {}
 CertificationRepository::~CertificationRepository() {}
@@ -41,10 +49,83 @@ QList<Certification> CertificationRepository::findAll()
         certifications.append(cert);
     }
 
-    Logger::instance().debug("CertificationRepository", QString("Found %1 certifications").arg(certifications.size()));
+    LOG_DEBUG("CertificationRepository", QString("Found %1 certifications").arg(certifications.size()));
     return certifications;
 }
 
+Page<Certification> CertificationRepository::findPage(int pageSize, const PageCursor& after, const PageFilter& filter)
+{
+    lastError_.clear();
+    Page<Certification> page;
+    page.next = after;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("CertificationRepository", lastError_);
+        return page;
+    }
+
+    pageSize = Pagination::boundedPageSize(pageSize);
+
+    QStringList conditions;
+    QVariantList values;
+    if (!filter.engineerId.isEmpty()) {
+        conditions << "engineer_id = ?";
+        values << filter.engineerId;
+    }
+    if (filter.expiringBefore.isValid()) {
+        conditions << "expiry_date IS NOT NULL AND expiry_date < ?";
+        values << filter.expiringBefore;
+    }
+    if (!after.isStart()) {
+        conditions << "id > ?";
+        values << after.id;
+    }
+
+    QString sql = "SELECT TOP (?) id, engineer_id, name, date_earned, expiry_date, created_at FROM certifications";
+    if (!conditions.isEmpty()) {
+        sql += " WHERE " + conditions.join(" AND ");
+    }
+    sql += " ORDER BY id";
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    query.addBindValue(pageSize + 1);   // one extra row tells whether another page follows
+    for (const QVariant& value : values) {
+        query.addBindValue(value);
+    }
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("CertificationRepository", "findPage failed: " + lastError_);
+        return page;
+    }
+
+    while (query.next()) {
+        if (page.items.size() == pageSize) {
+            page.hasMore = true;
+            break;
+        }
+        Certification cert;
+        cert.setId(query.value(0).toInt());
+        cert.setEngineerId(query.value(1).toString());
+        cert.setName(query.value(2).toString());
+        cert.setDateEarned(query.value(3).toDate());
+        cert.setExpiryDate(query.value(4).toDate());
+        cert.setCreatedAt(query.value(5).toDateTime());
+        page.items.append(cert);
+    }
+
+    if (!page.items.isEmpty()) {
+        page.next.id = page.items.last().id();
+    }
+
+    LOG_DEBUG("CertificationRepository", QString("Found %1 certifications (page)").arg(page.items.size()));
+    return page;
+}
+
 QList<Certification> CertificationRepository::findByEngineer(const QString& engineerId)
 {
     lastError_.clear();
@@ -57,9 +138,10 @@ QList<Certification> CertificationRepository::findByEngineer(const QString& engi
         return certifications;
     }
 
-    QSqlQuery query(db);
-    query.prepare("SELECT id, engineer_id, name, date_earned, expiry_date, created_at "
-                  "FROM certifications WHERE engineer_id = ? ORDER BY date_earned DESC");
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT id, engineer_id, name, date_earned, expiry_date, created_at "
+        "FROM certifications WHERE engineer_id = ? ORDER BY date_earned DESC");
+    QSqlQuery& query = statement.query();
     query.addBindValue(engineerId);
 
     if (!query.exec()) {
@@ -79,11 +161,70 @@ QList<Certification> CertificationRepository::findByEngineer(const QString& engi
         certifications.append(cert);
     }
 
-    Logger::instance().debug("CertificationRepository",
+    LOG_DEBUG("CertificationRepository",
         QString("Found %1 certifications for engineer %2").arg(certifications.size()).arg(engineerId));
     return certifications;
 }
 
+ChangeSet<Certification, int> CertificationRepository::findChangedSince(qint64 version)
+{
+    lastError_.clear();
+    ChangeSet<Certification, int> changes;
+    changes.version = version;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("CertificationRepository", lastError_);
+        return changes;
+    }
+
+    // Upper bound first, so rows committed while we read are caught next time
+    qint64 upTo = ChangeTracking::currentVersion(db, &lastError_);
+    if (upTo < 0) {
+        return changes;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, engineer_id, name, date_earned, expiry_date, created_at "
+                  "FROM certifications "
+                  "WHERE row_version > CAST(CAST(? AS BIGINT) AS BINARY(8)) "
+                  "AND row_version <= CAST(CAST(? AS BIGINT) AS BINARY(8))");
+    query.addBindValue(version);
+    query.addBindValue(upTo);
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("CertificationRepository", "findChangedSince failed: " + lastError_);
+        return changes;
+    }
+
+    while (query.next()) {
+        Certification cert;
+        cert.setId(query.value(0).toInt());
+        cert.setEngineerId(query.value(1).toString());
+        cert.setName(query.value(2).toString());
+        cert.setDateEarned(query.value(3).toDate());
+        cert.setExpiryDate(query.value(4).toDate());
+        cert.setCreatedAt(query.value(5).toDateTime());
+        changes.changed.append(cert);
+    }
+
+    QStringList deletedKeys;
+    if (!ChangeTracking::findDeletedKeys(db, "certifications", version, upTo, deletedKeys, &lastError_)) {
+        return changes;
+    }
+    for (const QString& key : deletedKeys) {
+        changes.removed.append(key.toInt());
+    }
+
+    changes.version = upTo;
+    LOG_DEBUG("CertificationRepository",
+        QString("findChangedSince: %1 changed, %2 removed").arg(changes.changed.size()).arg(changes.removed.size()));
+    return changes;
+}
+
 bool CertificationRepository::save(Certification& certification)
 {
     lastError_.clear();
@@ -113,7 +254,8 @@ bool CertificationRepository::save(Certification& certification)
             return false;
         }
 
-        Logger::instance().info("CertificationRepository", "Certification updated: " + certification.name());
+        SkillMatrixStore::instance().certificationSaved(certification);
+        LOG_INFO("CertificationRepository", "Certification updated: " + certification.name());
         return true;
     } else {
         // Insert new certification
@@ -136,9 +278,89 @@ bool CertificationRepository::save(Certification& certification)
             certification.setId(lastId.toInt());
         }
 
-        Logger::instance().info("CertificationRepository", "Certification created: " + certification.name());
+        SkillMatrixStore::instance().certificationSaved(certification);
+        LOG_INFO("CertificationRepository", "Certification created: " + certification.name());
+        return true;
+    }
+}
+
+bool CertificationRepository::insertMissing(QList<Certification>& certifications)
+{
+    lastError_.clear();
+
+    if (certifications.isEmpty()) {
         return true;
     }
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("CertificationRepository", lastError_);
+        return false;
+    }
+
+    // First row per natural key only; a repeat would be inserted twice
+    QSet<QString> keys;
+    QList<int> rows;
+    rows.reserve(certifications.size());
+    for (int i = 0; i < certifications.size(); ++i) {
+        const Certification& certification = certifications[i];
+        QString key = certification.engineerId() + '|' + certification.name().toLower() + '|'
+                    + certification.dateEarned().toString(Qt::ISODate);
+        if (!keys.contains(key)) {
+            keys.insert(key);
+            rows.append(i);
+        }
+    }
+
+    int inserted = 0;
+    QSqlQuery query(db);
+    for (int offset = 0; offset < rows.size(); offset += Constants::DB_UPSERT_BATCH_SIZE) {
+        int end = qMin(offset + Constants::DB_UPSERT_BATCH_SIZE, rows.size());
+
+        QJsonArray batch;
+        for (int r = offset; r < end; ++r) {
+            const Certification& certification = certifications[rows[r]];
+            QJsonObject row;
+            row["i"] = rows[r];
+            row["e"] = certification.engineerId();
+            row["n"] = certification.name();
+            row["d"] = certification.dateEarned().toString(Qt::ISODate);
+            if (certification.expiryDate().isValid()) {
+                row["x"] = certification.expiryDate().toString(Qt::ISODate);
+            }
+            batch.append(row);
+        }
+
+        query.prepare("MERGE certifications WITH (HOLDLOCK) AS target "
+                      "USING (SELECT row_index, engineer_id, name, date_earned, expiry_date "
+                      "       FROM OPENJSON(CAST(? AS NVARCHAR(MAX))) WITH ("
+                      "           row_index INT '$.i', engineer_id NVARCHAR(50) '$.e', name NVARCHAR(200) '$.n', "
+                      "           date_earned DATE '$.d', expiry_date DATE '$.x')) AS source "
+                      "ON target.engineer_id = source.engineer_id "
+                      "AND LOWER(target.name) = LOWER(source.name) "
+                      "AND target.date_earned = source.date_earned "
+                      "WHEN NOT MATCHED THEN INSERT (engineer_id, name, date_earned, expiry_date, created_at) "
+                      "VALUES (source.engineer_id, source.name, source.date_earned, source.expiry_date, GETDATE()) "
+                      "OUTPUT source.row_index, inserted.id;");
+        query.addBindValue(QString::fromUtf8(QJsonDocument(batch).toJson(QJsonDocument::Compact)));
+
+        if (!query.exec()) {
+            lastError_ = query.lastError().text();
+            Logger::instance().error("CertificationRepository", "insertMissing failed: " + lastError_);
+            return false;
+        }
+
+        while (query.next()) {
+            Certification& certification = certifications[query.value(0).toInt()];
+            certification.setId(query.value(1).toInt());
+            SkillMatrixStore::instance().certificationSaved(certification);
+            ++inserted;
+        }
+    }
+
+    LOG_INFO("CertificationRepository", QString("Inserted %1 of %2 certifications").arg(inserted).arg(certifications.size()));
+    return true;
 }
 
 bool CertificationRepository::remove(int id)
@@ -162,6 +384,7 @@ bool CertificationRepository::remove(int id)
         return false;
     }
 
-    Logger::instance().info("CertificationRepository", QString("Certification removed: %1").arg(id));
+    SkillMatrixStore::instance().certificationRemoved(id);
+    LOG_INFO("CertificationRepository", QString("Certification removed: %1").arg(id));
     return true;
 }
@@ -2,17 +2,46 @@
 #define CERTIFICATIONREPOSITORY_H
 
 #include "../models/Certification.h"
+#include "ChangeTracking.h"
+#include "Pagination.h"
 #include <QList>
+#include <QDate>
 
 class CertificationRepository
 {
 public:
+    struct PageFilter {
+        QString engineerId;     // empty = any
+        QDate expiringBefore;   // only certifications expiring before this date; null = any
+    };
+
     CertificationRepository();
     ~CertificationRepository();
 
     QList<Certification> findAll();
+
+    /**
+     * @brief Up to pageSize certifications after a cursor, ordered by id
+     *
+     * Keyset pagination on the clustered key, or IX_certifications_engineer_id
+     * when filtered by engineer.
+     */
+    Page<Certification> findPage(int pageSize, const PageCursor& after = PageCursor(),
+                                 const PageFilter& filter = PageFilter());
+    ChangeSet<Certification, int> findChangedSince(qint64 version); // Delta since a rowversion mark (see ChangeTracking)
     QList<Certification> findByEngineer(const QString& engineerId);
     bool save(Certification& certification);
+
+    /**
+     * @brief Insert the certifications not on file yet, in set-based batches
+     *
+     * A certification is on file when one with the same engineer, name (any
+     * case) and date earned exists; repeats within the list are inserted once.
+     * Inserted rows get their id; the others keep id 0. Up to
+     * Constants::DB_UPSERT_BATCH_SIZE rows per MERGE statement.
+     * @return false on a database error (earlier batches stay inserted)
+     */
+    bool insertMissing(QList<Certification>& certifications);
     bool remove(int id);
 
     QString lastError() const { return lastError_; }
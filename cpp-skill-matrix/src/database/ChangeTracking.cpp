@@ -0,0 +1,48 @@
+#include "ChangeTracking.h"
+#include "../utils/Logger.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+
+qint64 ChangeTracking::currentVersion(QSqlDatabase& db, QString* error)
+{
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT CAST(MIN_ACTIVE_ROWVERSION() AS BIGINT) - 1") || !query.next()) {
+        if (error) {
+            *error = query.lastError().text();
+        }
+        Logger::instance().error("ChangeTracking", "currentVersion failed: " + query.lastError().text());
+        return -1;
+    }
+
+    return query.value(0).toLongLong();
+}
+
+bool ChangeTracking::findDeletedKeys(QSqlDatabase& db, const QString& table, qint64 since, qint64 upTo,
+                                     QStringList& keys, QString* error)
+{
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT row_key FROM deleted_rows "
+                  "WHERE table_name = ? "
+                  "AND row_version > CAST(CAST(? AS BIGINT) AS BINARY(8)) "
+                  "AND row_version <= CAST(CAST(? AS BIGINT) AS BINARY(8))");
+    query.addBindValue(table);
+    query.addBindValue(since);
+    query.addBindValue(upTo);
+
+    if (!query.exec()) {
+        if (error) {
+            *error = query.lastError().text();
+        }
+        Logger::instance().error("ChangeTracking", "findDeletedKeys failed: " + query.lastError().text());
+        return false;
+    }
+
+    while (query.next()) {
+        keys.append(query.value(0).toString());
+    }
+
+    return true;
+}
@@ -0,0 +1,52 @@
+#ifndef CHANGETRACKING_H
+#define CHANGETRACKING_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QSqlDatabase>
+
+/**
+ * @brief Rows changed and deleted since a rowversion high-water mark
+ *
+ * Pass version back into the next findChangedSince() call to continue from here.
+ */
+template <typename T, typename Key>
+struct ChangeSet
+{
+    QList<T> changed;
+    QList<Key> removed;
+    qint64 version = 0;
+
+    bool isEmpty() const { return changed.isEmpty() && removed.isEmpty(); }
+};
+
+/**
+ * @brief Helpers for rowversion-based delta queries
+ *
+ * Tracked tables carry a ROWVERSION column (row_version) and record deletes in
+ * deleted_rows via triggers (see resources/database/add-change-tracking.sql).
+ * Versions are exchanged as qint64 and compared against BINARY(8) on the server
+ * so the row_version indexes can be used.
+ */
+class ChangeTracking
+{
+public:
+    /**
+     * @brief Highest rowversion whose transaction is known to be committed
+     *
+     * Rows written by still-open transactions have versions above this mark and
+     * are picked up by the next sync instead of being skipped.
+     * @return Version, or -1 on error (error text written to @p error)
+     */
+    static qint64 currentVersion(QSqlDatabase& db, QString* error = nullptr);
+
+    /**
+     * @brief Keys of rows deleted from @p table in (since, upTo]
+     * @return false on error (error text written to @p error)
+     */
+    static bool findDeletedKeys(QSqlDatabase& db, const QString& table, qint64 since, qint64 upTo,
+                                QStringList& keys, QString* error = nullptr);
+};
+
+#endif // CHANGETRACKING_H
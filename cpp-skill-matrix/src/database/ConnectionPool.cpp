@@ -0,0 +1,369 @@
+#include "ConnectionPool.h"
+#include "DatabaseManager.h"
+#include "../core/Constants.h"
+#include "../utils/Logger.h"
+
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QDeadlineTimer>
+
+ConnectionPool::ConnectionPool()
+    : maxSize_(Constants::DB_POOL_MAX_SIZE)
+    , idleTimeoutMs_(Constants::DB_POOL_IDLE_TIMEOUT)
+    , serial_(0)
+    , opening_(0)
+    , waiting_(0)
+{
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    // Static destruction: no worker is left to close its own connection
+    QMutexLocker locker(&mutex_);
+    for (PooledConnection* connection : connections_) {
+        closeConnection(connection);
+    }
+    connections_.clear();
+}
+
+void ConnectionPool::configure(const QString& sourceConnection, int maxSize, int idleTimeoutMs)
+{
+    QMutexLocker locker(&mutex_);
+    sourceConnection_ = sourceConnection;
+    maxSize_ = qMax(1, maxSize);
+    idleTimeoutMs_ = qMax(0, idleTimeoutMs);
+
+    LOG_INFO("ConnectionPool",
+        QString("Configured pool from %1 (max %2 connections, idle timeout %3 ms)")
+        .arg(sourceConnection_).arg(maxSize_).arg(idleTimeoutMs_));
+}
+
+QSqlDatabase& ConnectionPool::acquire()
+{
+    QMutexLocker locker(&mutex_);
+    QThread* current = QThread::currentThread();
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    PooledConnection* connection = connections_.value(current, nullptr);
+    if (connection && connection->checkouts == 0 && connection->expired) {
+        // Expired by another thread; only this one may close it
+        connections_.remove(current);
+        closeConnection(connection);
+        available_.wakeAll();
+        connection = nullptr;
+    }
+
+    if (connection) {
+        bool probe = connection->checkouts == 0
+            && (now - connection->lastUsedMs >= Constants::DB_POOL_HEALTH_CHECK_INTERVAL || !connection->db.isOpen());
+        connection->checkouts++;
+        connection->lastUsedMs = now;
+
+        // The round trip runs unlocked; the checkout keeps the connection this thread's
+        if (probe) {
+            locker.unlock();
+            QString error;
+            bool healthy = healthCheck(connection, error);
+            locker.relock();
+            if (!healthy) {
+                lastError_ = error;
+                connection->checkouts--;
+                return invalid_;
+            }
+        }
+        return connection->db;
+    }
+
+    if (sourceConnection_.isEmpty()) {
+        lastError_ = "Connection pool not configured";
+        Logger::instance().error("ConnectionPool", lastError_);
+        return invalid_;
+    }
+
+    // Wait for capacity. Connections of live threads are closed by their owners
+    // (see release()), so poll for finished threads between wake-ups.
+    QDeadlineTimer deadline(Constants::DB_POOL_ACQUIRE_TIMEOUT);
+    while (connections_.size() + opening_ >= maxSize_) {
+        if (evictOne()) {
+            continue;
+        }
+        // Only a checked-out or opening slot is handed back by release(); idle
+        // threads keep theirs until they next run, so waiting would not help
+        if (opening_ == 0 && checkedOut() == 0) {
+            lastError_ = QString("No pooled connection available: all %1 are held by idle threads")
+                .arg(connections_.size());
+            Logger::instance().error("ConnectionPool", lastError_);
+            return invalid_;
+        }
+        if (deadline.hasExpired()) {
+            lastError_ = QString("Timed out waiting for a pooled connection (%1 in use)").arg(connections_.size());
+            Logger::instance().error("ConnectionPool", lastError_);
+            return invalid_;
+        }
+        waiting_++;
+        available_.wait(&mutex_, QDeadlineTimer(qMin<qint64>(deadline.remainingTime(), Constants::DB_POOL_REAP_INTERVAL)));
+        waiting_--;
+    }
+
+    // Reserve the slot and open unlocked
+    QString name = QString("%1_pool_%2").arg(sourceConnection_).arg(++serial_);
+    QString source = sourceConnection_;
+    opening_++;
+    locker.unlock();
+    QString error;
+    connection = openConnection(source, name, error);
+    locker.relock();
+    opening_--;
+
+    if (!connection) {
+        lastError_ = error;
+        available_.wakeOne();
+        return invalid_;
+    }
+
+    connection->thread = current;
+    connection->checkouts = 1;
+    connection->lastUsedMs = QDateTime::currentMSecsSinceEpoch();
+    connections_.insert(current, connection);
+    return connection->db;
+}
+
+void ConnectionPool::release()
+{
+    QMutexLocker locker(&mutex_);
+    QThread* current = QThread::currentThread();
+
+    PooledConnection* connection = connections_.value(current, nullptr);
+    if (!connection || connection->checkouts == 0) {
+        return;
+    }
+
+    connection->checkouts--;
+    connection->lastUsedMs = QDateTime::currentMSecsSinceEpoch();
+    if (connection->checkouts > 0) {
+        return;
+    }
+
+    // Give the slot up now if it was expired, another thread is waiting for one or
+    // the pool is full: an idle thread would otherwise hold it until the thread
+    // exits, and nobody else may close this thread's connection
+    if (connection->expired || waiting_ > 0 || connections_.size() + opening_ >= maxSize_) {
+        connections_.remove(current);
+        closeConnection(connection);
+    }
+    available_.wakeOne();
+}
+
+QSqlDatabase& ConnectionPool::threadConnection()
+{
+    QMutexLocker locker(&mutex_);
+    PooledConnection* connection = connections_.value(QThread::currentThread(), nullptr);
+    if (connection && connection->checkouts > 0) {
+        connection->lastUsedMs = QDateTime::currentMSecsSinceEpoch();
+        return connection->db;
+    }
+
+    // An implicit checkout would never be returned and hold a slot for the thread's lifetime
+    lastError_ = "No connection checked out on this worker thread; wrap the job in a ScopedConnection";
+    Logger::instance().error("ConnectionPool", lastError_);
+    return invalid_;
+}
+
+StatementCache* ConnectionPool::threadStatements()
+{
+    QMutexLocker locker(&mutex_);
+    PooledConnection* connection = connections_.value(QThread::currentThread(), nullptr);
+    if (!connection || connection->checkouts == 0) {
+        return nullptr;
+    }
+    return connection->statements;
+}
+
+int ConnectionPool::evictIdle()
+{
+    QMutexLocker locker(&mutex_);
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    int evicted = 0;
+
+    for (auto it = connections_.begin(); it != connections_.end(); ) {
+        PooledConnection* connection = it.value();
+        bool idle = connection->checkouts == 0 && now - connection->lastUsedMs >= idleTimeoutMs_;
+
+        if (isThreadFinished(connection) || (idle && isCurrentThread(connection))) {
+            closeConnection(connection);
+            it = connections_.erase(it);
+            evicted++;
+            continue;
+        }
+        if (idle) {
+            connection->expired = true;  // closed by its thread on the next acquire()
+        }
+        ++it;
+    }
+
+    if (evicted > 0) {
+        available_.wakeAll();
+        LOG_DEBUG("ConnectionPool", QString("Evicted %1 idle connections").arg(evicted));
+    }
+
+    return evicted;
+}
+
+void ConnectionPool::closeAll()
+{
+    QMutexLocker locker(&mutex_);
+
+    for (auto it = connections_.begin(); it != connections_.end(); ) {
+        PooledConnection* connection = it.value();
+        if (isThreadFinished(connection) || isCurrentThread(connection)) {
+            closeConnection(connection);
+            it = connections_.erase(it);
+        } else {
+            connection->expired = true;
+            ++it;
+        }
+    }
+    available_.wakeAll();
+}
+
+int ConnectionPool::size() const
+{
+    QMutexLocker locker(&mutex_);
+    return connections_.size();
+}
+
+int ConnectionPool::inUse() const
+{
+    QMutexLocker locker(&mutex_);
+    return checkedOut();
+}
+
+QString ConnectionPool::lastError() const
+{
+    QMutexLocker locker(&mutex_);
+    return lastError_;
+}
+
+ConnectionPool::PooledConnection* ConnectionPool::openConnection(const QString& source, const QString& name, QString& error)
+{
+    QSqlDatabase db = QSqlDatabase::cloneDatabase(source, name);
+
+    if (!db.open()) {
+        error = db.lastError().text();
+        Logger::instance().error("ConnectionPool", "Failed to open pooled connection: " + error);
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(name);
+        return nullptr;
+    }
+
+    PooledConnection* connection = new PooledConnection;
+    connection->name = name;
+    connection->db = db;
+    connection->statements = new StatementCache(Constants::DB_STATEMENT_CACHE_SIZE);
+
+    LOG_DEBUG("ConnectionPool", "Opened pooled connection " + name);
+    return connection;
+}
+
+bool ConnectionPool::healthCheck(PooledConnection* connection, QString& error)
+{
+    {
+        QSqlQuery query(connection->db);
+        if (connection->db.isOpen() && query.exec("SELECT 1")) {
+            return true;
+        }
+    }
+
+    Logger::instance().warning("ConnectionPool", "Health check failed, reopening " + connection->name);
+    connection->statements->clear();
+    connection->db.close();
+    if (!connection->db.open()) {
+        error = connection->db.lastError().text();
+        Logger::instance().error("ConnectionPool", "Failed to reopen pooled connection: " + error);
+        return false;
+    }
+
+    return true;
+}
+
+int ConnectionPool::checkedOut() const
+{
+    int count = 0;
+    for (const PooledConnection* connection : connections_) {
+        if (connection->checkouts > 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool ConnectionPool::isThreadFinished(const PooledConnection* connection) const
+{
+    return connection->thread.isNull() || connection->thread->isFinished();
+}
+
+bool ConnectionPool::isCurrentThread(const PooledConnection* connection) const
+{
+    return connection->thread == QThread::currentThread();
+}
+
+bool ConnectionPool::evictOne()
+{
+    // Connections of finished threads can be reaped from here
+    for (auto it = connections_.begin(); it != connections_.end(); ++it) {
+        if (isThreadFinished(it.value())) {
+            closeConnection(it.value());
+            connections_.erase(it);
+            return true;
+        }
+    }
+
+    // Idle ones of live threads are only marked; their owners close them
+    PooledConnection* victim = nullptr;
+    for (PooledConnection* connection : connections_) {
+        if (connection->checkouts == 0 && !connection->expired
+            && (!victim || connection->lastUsedMs < victim->lastUsedMs)) {
+            victim = connection;
+        }
+    }
+    if (victim) {
+        victim->expired = true;
+    }
+    return false;
+}
+
+void ConnectionPool::closeConnection(PooledConnection* connection)
+{
+    QString name = connection->name;
+
+    // Prepared statements must go before their connection
+    delete connection->statements;
+    connection->statements = nullptr;
+
+    // The Qt SQL driver may already be gone during static destruction
+    if (QSqlDatabase::contains(name)) {
+        connection->db.close();
+        connection->db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(name);
+    }
+
+    delete connection;
+}
+
+// ============================================================================
+// ScopedConnection
+// ============================================================================
+
+ScopedConnection::ScopedConnection()
+    : pooled_(QThread::currentThread() != DatabaseManager::instance().thread())
+    , db_(pooled_ ? DatabaseManager::instance().pool().acquire() : DatabaseManager::instance().database())
+{
+}
+
+ScopedConnection::~ScopedConnection()
+{
+    if (pooled_) {
+        DatabaseManager::instance().pool().release();
+    }
+}
@@ -0,0 +1,145 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QPointer>
+#include <QThread>
+#include <QSqlDatabase>
+#include "StatementCache.h"
+
+/**
+ * @brief Thread-aware pool of database connections
+ *
+ * Qt SQL connections may only be used from the thread that opened them, so the
+ * pool hands every worker thread its own connection, cloned from the primary
+ * connection configured in DatabaseManager. A thread checks its connection out
+ * with acquire() and returns it with release(); returned connections stay bound
+ * to their thread for cheap reuse while the pool has spare capacity; at capacity
+ * release() closes the connection so the slot goes back. A connection is only
+ * ever closed by its own thread: idle ones, and those wanted by a waiting thread,
+ * are marked expired and closed on the owner's next acquire() or release().
+ * Connections of finished threads are reaped from any thread.
+ */
+class ConnectionPool
+{
+public:
+    ConnectionPool();
+    ~ConnectionPool();
+
+    /**
+     * @brief Configure the pool
+     * @param sourceConnection Name of the open connection to clone settings from
+     * @param maxSize Maximum number of pooled connections
+     * @param idleTimeoutMs Time after which a returned connection is evicted
+     */
+    void configure(const QString& sourceConnection, int maxSize, int idleTimeoutMs);
+
+    /**
+     * @brief Check out the connection for the current thread
+     *
+     * Opens a new connection if the thread has none, waiting for a checked-out
+     * one to come back if the pool is full; fails at once if every slot is held
+     * by an idle thread. Nested calls on the same thread share one connection.
+     * @return Open connection, or an invalid QSqlDatabase on failure
+     */
+    QSqlDatabase& acquire();
+
+    /**
+     * @brief Return the current thread's connection to the pool
+     */
+    void release();
+
+    /**
+     * @brief Get the connection the current thread has checked out
+     *
+     * There is no implicit checkout (it would never be returned): worker code
+     * must hold a ScopedConnection, otherwise this is an invalid QSqlDatabase.
+     */
+    QSqlDatabase& threadConnection();
+
+    /**
+     * @brief Get the prepared statement cache of the current thread's connection
+     * @return nullptr if the thread has no connection checked out
+     */
+    StatementCache* threadStatements();
+
+    /**
+     * @brief Close connections of finished threads and the caller's own idle one
+     *
+     * Idle connections of other live threads are marked expired instead.
+     * @return Number of connections evicted
+     */
+    int evictIdle();
+
+    /**
+     * @brief Close every pooled connection this thread may close; expire the rest
+     */
+    void closeAll();
+
+    int size() const;
+    int inUse() const;
+    int maxSize() const { return maxSize_; }
+    QString lastError() const;
+
+private:
+    struct PooledConnection
+    {
+        QString name;
+        QSqlDatabase db;
+        StatementCache* statements = nullptr;
+        QPointer<QThread> thread;
+        int checkouts = 0;
+        qint64 lastUsedMs = 0;
+        bool expired = false;   // to be closed by its thread once returned
+    };
+
+    // Open and probe run without mutex_ held
+    static PooledConnection* openConnection(const QString& source, const QString& name, QString& error);
+    static bool healthCheck(PooledConnection* connection, QString& error);
+    int checkedOut() const;
+    bool isThreadFinished(const PooledConnection* connection) const;
+    bool isCurrentThread(const PooledConnection* connection) const;
+    bool evictOne();
+    void closeConnection(PooledConnection* connection);
+
+private:
+    mutable QMutex mutex_;
+    QWaitCondition available_;
+    QHash<QThread*, PooledConnection*> connections_;
+    QSqlDatabase invalid_;
+    QString sourceConnection_;
+    QString lastError_;
+    int maxSize_;
+    int idleTimeoutMs_;
+    int serial_;
+    int opening_;   // slots reserved by acquire() calls opening a connection
+    int waiting_;   // threads waiting for a slot
+};
+
+/**
+ * @brief RAII checkout of the current thread's pooled connection
+ *
+ * Wrap worker-thread jobs in a ScopedConnection so repositories called inside
+ * the job run on the thread's own connection and it is returned afterwards.
+ */
+class ScopedConnection
+{
+public:
+    ScopedConnection();
+    ~ScopedConnection();
+
+    ScopedConnection(const ScopedConnection&) = delete;
+    ScopedConnection& operator=(const ScopedConnection&) = delete;
+
+    QSqlDatabase& database() { return db_; }
+    bool isValid() const { return db_.isOpen(); }
+
+private:
+    bool pooled_;
+    QSqlDatabase& db_;
+};
+
+#endif // CONNECTIONPOOL_H
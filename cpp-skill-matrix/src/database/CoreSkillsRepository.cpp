@@ -1,9 +1,16 @@
 #include "CoreSkillsRepository.h"
 #include "DatabaseManager.h"
+#include "ChangeTracking.h"
+#include "SkillMatrixStore.h"
 #include "../utils/Logger.h"
+#include "../core/Constants.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 CoreSkillsRepository::CoreSkillsRepository() : lastError_("") {}
 CoreSkillsRepository::~CoreSkillsRepository() {}
@@ -37,7 +44,7 @@ QList<CoreSkillCategory> CoreSkillsRepository::findAllCategories()
         categories.append(category);
     }
 
-    Logger::instance().debug("CoreSkillsRepository", QString("Found %1 core skill categories").arg(categories.size()));
+    LOG_DEBUG("CoreSkillsRepository", QString("Found %1 core skill categories").arg(categories.size()));
     return categories;
 }
 
@@ -82,7 +89,7 @@ QList<CoreSkill> CoreSkillsRepository::findAllSkills()
         skills.append(skill);
     }
 
-    Logger::instance().debug("CoreSkillsRepository", QString("Found %1 core skills").arg(skills.size()));
+    LOG_DEBUG("CoreSkillsRepository", QString("Found %1 core skills").arg(skills.size()));
     return skills;
 }
 
@@ -99,6 +106,7 @@ QList<CoreSkillAssessment> CoreSkillsRepository::findAllAssessments()
     }
 
     QSqlQuery query(db);
+    query.setForwardOnly(true);
     query.prepare("SELECT id, engineer_id, category_id, skill_id, score, created_at, updated_at "
                   "FROM core_skill_assessments ORDER BY engineer_id, category_id, skill_id");
 
@@ -120,11 +128,12 @@ QList<CoreSkillAssessment> CoreSkillsRepository::findAllAssessments()
         assessments.append(assessment);
     }
 
-    Logger::instance().debug("CoreSkillsRepository", QString("Found %1 core skill assessments").arg(assessments.size()));
+    LOG_DEBUG("CoreSkillsRepository", QString("Found %1 core skill assessments").arg(assessments.size()));
     return assessments;
 }
 
-bool CoreSkillsRepository::saveOrUpdateAssessment(CoreSkillAssessment& assessment)
+bool CoreSkillsRepository::forEachAssessment(const std::function<bool(const CoreSkillAssessment&)>& visitor,
+                                             const QString& engineerId)
 {
     lastError_.clear();
     QSqlDatabase& db = DatabaseManager::instance().database();
@@ -135,11 +144,126 @@ bool CoreSkillsRepository::saveOrUpdateAssessment(CoreSkillAssessment& assessmen
         return false;
     }
 
+    // Forward-only: no client-side scrollable cursor, rows are not retained
     QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (engineerId.isEmpty()) {
+        query.prepare("SELECT id, engineer_id, category_id, skill_id, score, created_at, updated_at "
+                      "FROM core_skill_assessments ORDER BY engineer_id, category_id, skill_id");
+    } else {
+        query.prepare("SELECT id, engineer_id, category_id, skill_id, score, created_at, updated_at "
+                      "FROM core_skill_assessments WHERE engineer_id = ? ORDER BY category_id, skill_id");
+        query.addBindValue(engineerId);
+    }
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("CoreSkillsRepository", "forEachAssessment failed: " + lastError_);
+        return false;
+    }
+
+    int visited = 0;
+    CoreSkillAssessment assessment;
+    while (query.next()) {
+        assessment.setId(query.value(0).toInt());
+        assessment.setEngineerId(query.value(1).toString());
+        assessment.setCategoryId(query.value(2).toString());
+        assessment.setSkillId(query.value(3).toString());
+        assessment.setScore(query.value(4).toInt());
+        assessment.setCreatedAt(query.value(5).toDateTime());
+        assessment.setUpdatedAt(query.value(6).toDateTime());
+        ++visited;
+        if (!visitor(assessment)) {
+            break;
+        }
+    }
+
+    if (query.lastError().isValid()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("CoreSkillsRepository", "forEachAssessment fetch failed: " + lastError_);
+        return false;
+    }
+
+    LOG_DEBUG("CoreSkillsRepository", QString("Streamed %1 core skill assessments").arg(visited));
+    return true;
+}
+
+ChangeSet<CoreSkillAssessment, int> CoreSkillsRepository::findAssessmentsChangedSince(qint64 version)
+{
+    lastError_.clear();
+    ChangeSet<CoreSkillAssessment, int> changes;
+    changes.version = version;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("CoreSkillsRepository", lastError_);
+        return changes;
+    }
+
+    // Upper bound first, so rows committed while we read are caught next time
+    qint64 upTo = ChangeTracking::currentVersion(db, &lastError_);
+    if (upTo < 0) {
+        return changes;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, engineer_id, category_id, skill_id, score, created_at, updated_at "
+                  "FROM core_skill_assessments "
+                  "WHERE row_version > CAST(CAST(? AS BIGINT) AS BINARY(8)) "
+                  "AND row_version <= CAST(CAST(? AS BIGINT) AS BINARY(8))");
+    query.addBindValue(version);
+    query.addBindValue(upTo);
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("CoreSkillsRepository", "findAssessmentsChangedSince failed: " + lastError_);
+        return changes;
+    }
+
+    while (query.next()) {
+        CoreSkillAssessment assessment;
+        assessment.setId(query.value(0).toInt());
+        assessment.setEngineerId(query.value(1).toString());
+        assessment.setCategoryId(query.value(2).toString());
+        assessment.setSkillId(query.value(3).toString());
+        assessment.setScore(query.value(4).toInt());
+        assessment.setCreatedAt(query.value(5).toDateTime());
+        assessment.setUpdatedAt(query.value(6).toDateTime());
+        changes.changed.append(assessment);
+    }
+
+    QStringList deletedKeys;
+    if (!ChangeTracking::findDeletedKeys(db, "core_skill_assessments", version, upTo, deletedKeys, &lastError_)) {
+        return changes;
+    }
+    for (const QString& key : deletedKeys) {
+        changes.removed.append(key.toInt());
+    }
+
+    changes.version = upTo;
+    LOG_DEBUG("CoreSkillsRepository",
+        QString("findAssessmentsChangedSince: %1 changed, %2 removed").arg(changes.changed.size()).arg(changes.removed.size()));
+    return changes;
+}
+
+bool CoreSkillsRepository::saveOrUpdateAssessment(CoreSkillAssessment& assessment)
+{
+    lastError_.clear();
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("CoreSkillsRepository", lastError_);
+        return false;
+    }
 
     // Check if assessment already exists (using UNIQUE constraint on engineer_id, category_id, skill_id)
-    query.prepare("SELECT id FROM core_skill_assessments "
-                  "WHERE engineer_id = ? AND category_id = ? AND skill_id = ?");
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT id FROM core_skill_assessments "
+        "WHERE engineer_id = ? AND category_id = ? AND skill_id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(assessment.engineerId());
     query.addBindValue(assessment.categoryId());
     query.addBindValue(assessment.skillId());
@@ -150,14 +274,18 @@ bool CoreSkillsRepository::saveOrUpdateAssessment(CoreSkillAssessment& assessmen
         return false;
     }
 
-    if (query.next()) {
+    bool exists = query.next();
+    int existingId = exists ? query.value(0).toInt() : 0;
+    query.finish();  // no open cursor while the write runs on this connection
+
+    if (exists) {
         // Update existing assessment
-        int existingId = query.value(0).toInt();
         assessment.setId(existingId);
 
-        QSqlQuery updateQuery(db);
-        updateQuery.prepare("UPDATE core_skill_assessments SET score = ?, updated_at = GETDATE() "
-                           "WHERE id = ?");
+        CachedQuery updateStatement = DatabaseManager::instance().prepared(
+            "UPDATE core_skill_assessments SET score = ?, updated_at = GETDATE() "
+            "WHERE id = ?");
+        QSqlQuery& updateQuery = updateStatement.query();
         updateQuery.addBindValue(assessment.score());
         updateQuery.addBindValue(existingId);
 
@@ -167,16 +295,18 @@ bool CoreSkillsRepository::saveOrUpdateAssessment(CoreSkillAssessment& assessmen
             return false;
         }
 
-        Logger::instance().info("CoreSkillsRepository",
+        SkillMatrixStore::instance().coreSkillAssessmentsSaved({assessment});
+        LOG_INFO("CoreSkillsRepository",
             QString("Updated core skill assessment for engineer %1, skill %2, score %3")
             .arg(assessment.engineerId()).arg(assessment.skillId()).arg(assessment.score()));
         return true;
     } else {
         // Insert new assessment
-        QSqlQuery insertQuery(db);
-        insertQuery.prepare("INSERT INTO core_skill_assessments "
-                           "(engineer_id, category_id, skill_id, score, created_at, updated_at) "
-                           "VALUES (?, ?, ?, ?, GETDATE(), GETDATE())");
+        CachedQuery insertStatement = DatabaseManager::instance().prepared(
+            "INSERT INTO core_skill_assessments "
+            "(engineer_id, category_id, skill_id, score, created_at, updated_at) "
+            "VALUES (?, ?, ?, ?, GETDATE(), GETDATE())");
+        QSqlQuery& insertQuery = insertStatement.query();
         insertQuery.addBindValue(assessment.engineerId());
         insertQuery.addBindValue(assessment.categoryId());
         insertQuery.addBindValue(assessment.skillId());
@@ -194,13 +324,114 @@ bool CoreSkillsRepository::saveOrUpdateAssessment(CoreSkillAssessment& assessmen
             assessment.setId(lastId.toInt());
         }
 
-        Logger::instance().info("CoreSkillsRepository",
+        SkillMatrixStore::instance().coreSkillAssessmentsSaved({assessment});
+        LOG_INFO("CoreSkillsRepository",
             QString("Created core skill assessment for engineer %1, skill %2, score %3")
             .arg(assessment.engineerId()).arg(assessment.skillId()).arg(assessment.score()));
         return true;
     }
 }
 
+bool CoreSkillsRepository::saveOrUpdateAssessmentBatch(QList<CoreSkillAssessment>& assessments)
+{
+    lastError_.clear();
+
+    if (assessments.isEmpty()) {
+        return true;
+    }
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("CoreSkillsRepository", lastError_);
+        return false;
+    }
+
+    auto keyOf = [](const CoreSkillAssessment& assessment) {
+        return assessment.engineerId() + "|" + assessment.categoryId() + "|" + assessment.skillId();
+    };
+
+    // Send only the last row per (engineer, category, skill); MERGE cannot touch a row twice
+    QHash<QString, int> lastRowForKey;
+    lastRowForKey.reserve(assessments.size());
+    for (int i = 0; i < assessments.size(); ++i) {
+        lastRowForKey.insert(keyOf(assessments[i]), i);
+    }
+
+    QList<int> rows;
+    rows.reserve(lastRowForKey.size());
+    for (int i = 0; i < assessments.size(); ++i) {
+        if (lastRowForKey.value(keyOf(assessments[i])) == i) {
+            rows.append(i);
+        }
+    }
+
+    if (!db.transaction()) {
+        lastError_ = db.lastError().text();
+        Logger::instance().error("CoreSkillsRepository", "saveOrUpdateAssessmentBatch begin failed: " + lastError_);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    for (int offset = 0; offset < rows.size(); offset += Constants::DB_UPSERT_BATCH_SIZE) {
+        int end = qMin(offset + Constants::DB_UPSERT_BATCH_SIZE, rows.size());
+
+        QJsonArray batch;
+        for (int r = offset; r < end; ++r) {
+            const CoreSkillAssessment& assessment = assessments[rows[r]];
+            QJsonObject row;
+            row["i"] = rows[r];
+            row["e"] = assessment.engineerId();
+            row["c"] = assessment.categoryId();
+            row["k"] = assessment.skillId();
+            row["s"] = assessment.score();
+            batch.append(row);
+        }
+
+        query.prepare("MERGE core_skill_assessments WITH (HOLDLOCK) AS target "
+                      "USING (SELECT row_index, engineer_id, category_id, skill_id, score "
+                      "       FROM OPENJSON(CAST(? AS NVARCHAR(MAX))) WITH ("
+                      "           row_index INT '$.i', engineer_id NVARCHAR(50) '$.e', "
+                      "           category_id NVARCHAR(50) '$.c', skill_id NVARCHAR(50) '$.k', "
+                      "           score INT '$.s')) AS source "
+                      "ON target.engineer_id = source.engineer_id "
+                      "AND target.category_id = source.category_id "
+                      "AND target.skill_id = source.skill_id "
+                      "WHEN MATCHED THEN UPDATE SET score = source.score, updated_at = GETDATE() "
+                      "WHEN NOT MATCHED THEN INSERT (engineer_id, category_id, skill_id, score, created_at, updated_at) "
+                      "VALUES (source.engineer_id, source.category_id, source.skill_id, source.score, GETDATE(), GETDATE()) "
+                      "OUTPUT source.row_index, inserted.id;");
+        query.addBindValue(QString::fromUtf8(QJsonDocument(batch).toJson(QJsonDocument::Compact)));
+
+        if (!query.exec()) {
+            lastError_ = query.lastError().text();
+            Logger::instance().error("CoreSkillsRepository", "saveOrUpdateAssessmentBatch merge failed: " + lastError_);
+            db.rollback();
+            return false;
+        }
+
+        while (query.next()) {
+            assessments[query.value(0).toInt()].setId(query.value(1).toInt());
+        }
+    }
+
+    if (!db.commit()) {
+        lastError_ = db.lastError().text();
+        Logger::instance().error("CoreSkillsRepository", "saveOrUpdateAssessmentBatch commit failed: " + lastError_);
+        db.rollback();
+        return false;
+    }
+
+    for (CoreSkillAssessment& assessment : assessments) {
+        assessment.setId(assessments[lastRowForKey.value(keyOf(assessment))].id());
+    }
+    SkillMatrixStore::instance().coreSkillAssessmentsSaved(assessments);
+
+    LOG_INFO("CoreSkillsRepository",
+        QString("Upserted %1 core skill assessments").arg(rows.size()));
+    return true;
+}
+
 bool CoreSkillsRepository::saveCategory(const CoreSkillCategory& category)
 {
     lastError_.clear();
@@ -237,7 +468,8 @@ bool CoreSkillsRepository::saveCategory(const CoreSkillCategory& category)
             return false;
         }
 
-        Logger::instance().info("CoreSkillsRepository", QString("Updated category: %1").arg(category.name()));
+        SkillMatrixStore::instance().coreSkillCatalogChanged();
+        LOG_INFO("CoreSkillsRepository", QString("Updated category: %1").arg(category.name()));
         return true;
     } else {
         // Insert new category
@@ -253,7 +485,8 @@ bool CoreSkillsRepository::saveCategory(const CoreSkillCategory& category)
             return false;
         }
 
-        Logger::instance().info("CoreSkillsRepository", QString("Created category: %1").arg(category.name()));
+        SkillMatrixStore::instance().coreSkillCatalogChanged();
+        LOG_INFO("CoreSkillsRepository", QString("Created category: %1").arg(category.name()));
         return true;
     }
 }
@@ -279,7 +512,8 @@ bool CoreSkillsRepository::deleteCategory(const QString& categoryId)
         return false;
     }
 
-    Logger::instance().info("CoreSkillsRepository", QString("Deleted category: %1").arg(categoryId));
+    SkillMatrixStore::instance().coreSkillCatalogChanged();
+    LOG_INFO("CoreSkillsRepository", QString("Deleted category: %1").arg(categoryId));
     return true;
 }
 
@@ -328,7 +562,8 @@ bool CoreSkillsRepository::saveSkill(const CoreSkill& skill)
             return false;
         }
 
-        Logger::instance().info("CoreSkillsRepository", QString("Updated skill: %1").arg(skill.name()));
+        SkillMatrixStore::instance().coreSkillCatalogChanged();
+        LOG_INFO("CoreSkillsRepository", QString("Updated skill: %1").arg(skill.name()));
         return true;
     } else {
         // Insert new skill
@@ -353,7 +588,8 @@ bool CoreSkillsRepository::saveSkill(const CoreSkill& skill)
             return false;
         }
 
-        Logger::instance().info("CoreSkillsRepository", QString("Created skill: %1").arg(skill.name()));
+        SkillMatrixStore::instance().coreSkillCatalogChanged();
+        LOG_INFO("CoreSkillsRepository", QString("Created skill: %1").arg(skill.name()));
         return true;
     }
 }
@@ -379,6 +615,7 @@ bool CoreSkillsRepository::deleteSkill(const QString& skillId)
         return false;
     }
 
-    Logger::instance().info("CoreSkillsRepository", QString("Deleted skill: %1").arg(skillId));
+    SkillMatrixStore::instance().coreSkillCatalogChanged();
+    LOG_INFO("CoreSkillsRepository", QString("Deleted skill: %1").arg(skillId));
     return true;
 }
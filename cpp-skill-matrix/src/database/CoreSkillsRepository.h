@@ -4,7 +4,9 @@
 #include "../models/CoreSkillCategory.h"
 #include "../models/CoreSkill.h"
 #include "../models/CoreSkillAssessment.h"
+#include "ChangeTracking.h"
 #include <QList>
+#include <functional>
 
 class CoreSkillsRepository
 {
@@ -15,8 +17,28 @@ public:
     QList<CoreSkillCategory> findAllCategories();
     QList<CoreSkill> findAllSkills();
     QList<CoreSkillAssessment> findAllAssessments();
+
+    /**
+     * @brief Stream core skill assessments to a visitor, one row at a time
+     *
+     * Forward-only, constant memory; ordered like findAllAssessments(). Pass an
+     * engineer id to read only that engineer's rows. Return false from the
+     * visitor to stop early.
+     * @return false on query error (stopping early is not an error)
+     */
+    bool forEachAssessment(const std::function<bool(const CoreSkillAssessment&)>& visitor,
+                           const QString& engineerId = QString());
+    ChangeSet<CoreSkillAssessment, int> findAssessmentsChangedSince(qint64 version); // Delta since a rowversion mark (see ChangeTracking)
     bool saveOrUpdateAssessment(CoreSkillAssessment& assessment);
 
+    /**
+     * @brief Upsert many core skill assessments in one transaction
+     *
+     * Same set-based OPENJSON MERGE as AssessmentRepository::saveOrUpdateBatch;
+     * ids are written back into the list.
+     */
+    bool saveOrUpdateAssessmentBatch(QList<CoreSkillAssessment>& assessments);
+
     // Category management
     bool saveCategory(const CoreSkillCategory& category);
     bool deleteCategory(const QString& categoryId);
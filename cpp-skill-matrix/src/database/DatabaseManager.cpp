@@ -4,6 +4,7 @@
 
 #include <QSqlQuery>
 #include <QSqlDriver>
+#include <QThread>
 
 DatabaseManager& DatabaseManager::instance()
 {
@@ -13,10 +14,18 @@ DatabaseManager& DatabaseManager::instance()
 
 DatabaseManager::DatabaseManager(QObject* parent)
     : QObject(parent)
+    , statements_(Constants::DB_STATEMENT_CACHE_SIZE)
+    , poolSweepTimer_(new QTimer(this))
+    , poolMaxSize_(Constants::DB_POOL_MAX_SIZE)
+    , poolIdleTimeout_(Constants::DB_POOL_IDLE_TIMEOUT)
     , connected_(false)
 {
     // Initialize database connection
     db_ = QSqlDatabase::addDatabase("QODBC", Constants::DB_CONNECTION_NAME);
+
+    // Periodically close worker connections that are idle or orphaned
+    poolSweepTimer_->setInterval(Constants::DB_POOL_SWEEP_INTERVAL);
+    QObject::connect(poolSweepTimer_, &QTimer::timeout, this, [this]() { pool_.evictIdle(); });
 }
 
 DatabaseManager::~DatabaseManager()
@@ -28,7 +37,7 @@ bool DatabaseManager::connect(const QString& server, const QString& database,
                               const QString& user, const QString& password,
                               int port)
 {
-    Logger::instance().info("DatabaseManager", QString("Connecting to SQL Server: %1/%2").arg(server).arg(database));
+    LOG_INFO("DatabaseManager", QString("Connecting to SQL Server: %1/%2").arg(server).arg(database));
 
     // Disconnect if already connected
     if (connected_) {
@@ -57,6 +66,9 @@ bool DatabaseManager::connect(const QString& server, const QString& database,
 
     db_.setDatabaseName(connectionString);
 
+    // Large result sets stream in fewer, larger packets (pooled clones inherit this)
+    db_.setConnectOptions(QString("SQL_ATTR_PACKET_SIZE=%1").arg(Constants::DB_PACKET_SIZE));
+
     // Open connection
     if (!db_.open()) {
         lastErrorMessage_ = db_.lastError().text();
@@ -78,21 +90,36 @@ bool DatabaseManager::connect(const QString& server, const QString& database,
         return false;
     }
 
+    // Worker threads get their own connections cloned from this one
+    pool_.configure(Constants::DB_CONNECTION_NAME, poolMaxSize_, poolIdleTimeout_);
+    poolSweepTimer_->start();
+
     connected_ = true;
     emit connectionChanged(true);
-    Logger::instance().info("DatabaseManager", "Successfully connected to database");
+    LOG_INFO("DatabaseManager", "Successfully connected to database");
     return true;
 }
 
 void DatabaseManager::disconnect()
 {
+    poolSweepTimer_->stop();
+    pool_.closeAll();
+    statements_.clear();
+
+    StatementCache::Statistics stats = StatementCache::statistics();
+    if (stats.hits + stats.misses > 0) {
+        LOG_INFO("DatabaseManager",
+            QString("Statement cache: %1 hits, %2 misses (%3% reused)")
+            .arg(stats.hits).arg(stats.misses).arg(stats.hitRate() * 100.0, 0, 'f', 1));
+    }
+
     // During static destruction, the Qt database driver may already be destroyed
     // Use QSqlDatabase::contains() which is a static method that doesn't access
     // the database object itself, preventing crashes during shutdown
     if (QSqlDatabase::contains(Constants::DB_CONNECTION_NAME)) {
         if (db_.isOpen()) {
             db_.close();
-            Logger::instance().info("DatabaseManager", "Disconnected from database");
+            LOG_INFO("DatabaseManager", "Disconnected from database");
         }
     }
 
@@ -102,6 +129,35 @@ void DatabaseManager::disconnect()
     }
 }
 
+QSqlDatabase& DatabaseManager::database()
+{
+    if (QThread::currentThread() == thread()) {
+        return db_;
+    }
+
+    return pool_.threadConnection();
+}
+
+CachedQuery DatabaseManager::prepared(const QString& sql)
+{
+    if (QThread::currentThread() == thread()) {
+        return statements_.acquire(db_, sql);
+    }
+
+    QSqlDatabase& db = pool_.threadConnection();
+    StatementCache* statements = pool_.threadStatements();
+    if (!statements) {
+        return StatementCache::uncached(db, sql);
+    }
+    return statements->acquire(db, sql);
+}
+
+void DatabaseManager::setPoolLimits(int maxSize, int idleTimeoutMs)
+{
+    poolMaxSize_ = maxSize;
+    poolIdleTimeout_ = idleTimeoutMs;
+}
+
 bool DatabaseManager::testConnection()
 {
     if (!db_.isValid() || !db_.isOpen()) {
@@ -158,13 +214,14 @@ bool DatabaseManager::beginTransaction()
         return false;
     }
 
-    if (!db_.transaction()) {
-        lastErrorMessage_ = db_.lastError().text();
+    QSqlDatabase& db = database();
+    if (!db.transaction()) {
+        lastErrorMessage_ = db.lastError().text();
         Logger::instance().error("DatabaseManager", "Failed to begin transaction: " + lastErrorMessage_);
         return false;
     }
 
-    Logger::instance().debug("DatabaseManager", "Transaction started");
+    LOG_DEBUG("DatabaseManager", "Transaction started");
     return true;
 }
 
@@ -175,13 +232,14 @@ bool DatabaseManager::commit()
         return false;
     }
 
-    if (!db_.commit()) {
-        lastErrorMessage_ = db_.lastError().text();
+    QSqlDatabase& db = database();
+    if (!db.commit()) {
+        lastErrorMessage_ = db.lastError().text();
         Logger::instance().error("DatabaseManager", "Failed to commit transaction: " + lastErrorMessage_);
         return false;
     }
 
-    Logger::instance().debug("DatabaseManager", "Transaction committed");
+    LOG_DEBUG("DatabaseManager", "Transaction committed");
     return true;
 }
 
@@ -192,13 +250,14 @@ bool DatabaseManager::rollback()
         return false;
     }
 
-    if (!db_.rollback()) {
-        lastErrorMessage_ = db_.lastError().text();
+    QSqlDatabase& db = database();
+    if (!db.rollback()) {
+        lastErrorMessage_ = db.lastError().text();
         Logger::instance().error("DatabaseManager", "Failed to rollback transaction: " + lastErrorMessage_);
         return false;
     }
 
-    Logger::instance().debug("DatabaseManager", "Transaction rolled back");
+    LOG_DEBUG("DatabaseManager", "Transaction rolled back");
     return true;
 }
 
@@ -5,11 +5,15 @@
 #include <QString>
 #include <QSqlDatabase>
 #include <QSqlError>
+#include <QTimer>
+#include "ConnectionPool.h"
 
 /**
  * @brief Database connection manager (Singleton)
  *
- * Manages SQL Server database connection and provides access to the database
+ * Manages SQL Server database connection and provides access to the database.
+ * The primary connection belongs to the GUI thread; worker threads are served
+ * from a ConnectionPool of connections cloned from it.
  */
 class DatabaseManager : public QObject
 {
@@ -46,10 +50,37 @@ public:
     bool testConnection();
 
     /**
-     * @brief Get database connection
+     * @brief Get database connection for the calling thread
+     *
+     * Returns the primary connection on the GUI thread and the thread's pooled
+     * connection on any other thread.
      * @return Reference to QSqlDatabase
      */
-    QSqlDatabase& database() { return db_; }
+    QSqlDatabase& database();
+
+    /**
+     * @brief Lease a prepared statement on the calling thread's connection
+     *
+     * Statements are cached per connection keyed by their SQL text, so repeated
+     * calls only rebind values instead of preparing again. Bind with
+     * query->addBindValue() and run with query.exec(); the statement returns to
+     * the cache when the CachedQuery goes out of scope.
+     * @param sql Parameterized SQL
+     * @return Forward-only statement lease
+     */
+    CachedQuery prepared(const QString& sql);
+
+    /**
+     * @brief Get the worker thread connection pool
+     */
+    ConnectionPool& pool() { return pool_; }
+
+    /**
+     * @brief Set connection pool limits (applied on next connect)
+     * @param maxSize Maximum number of worker connections
+     * @param idleTimeoutMs Idle time before a returned connection is closed
+     */
+    void setPoolLimits(int maxSize, int idleTimeoutMs);
 
     /**
      * @brief Check if connected to database
@@ -126,6 +157,11 @@ private:
 
 private:
     QSqlDatabase db_;
+    StatementCache statements_;
+    ConnectionPool pool_;
+    QTimer* poolSweepTimer_;
+    int poolMaxSize_;
+    int poolIdleTimeout_;
     QString server_;
     QString database_;
     QString user_;
@@ -1,10 +1,18 @@
 #include "EngineerRepository.h"
 #include "DatabaseManager.h"
+#include "ChangeTracking.h"
+#include "SkillMatrixStore.h"
 #include "../utils/Logger.h"
 #include "../utils/Crypto.h"
+#include "../core/Constants.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QStringList>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 EngineerRepository::EngineerRepository() : lastError_("") {}
 EngineerRepository::~EngineerRepository() {}
@@ -37,10 +45,84 @@ QList<Engineer> EngineerRepository::findAll()
         engineers.append(engineer);
     }
 
-    Logger::instance().debug("EngineerRepository", QString("Found %1 engineers").arg(engineers.size()));
+    LOG_DEBUG("EngineerRepository", QString("Found %1 engineers").arg(engineers.size()));
     return engineers;
 }
 
+Page<Engineer> EngineerRepository::findPage(int pageSize, const PageCursor& after, const PageFilter& filter)
+{
+    lastError_.clear();
+    Page<Engineer> page;
+    page.next = after;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("EngineerRepository", lastError_);
+        return page;
+    }
+
+    pageSize = Pagination::boundedPageSize(pageSize);
+
+    QStringList conditions;
+    QVariantList values;
+    if (!filter.shift.isEmpty()) {
+        conditions << "shift = ?";
+        values << filter.shift;
+    }
+    if (!filter.namePrefix.isEmpty()) {
+        conditions << "name LIKE ?";
+        values << Pagination::likePrefix(filter.namePrefix);
+    }
+    if (!after.isStart()) {
+        // Seek past (name, id); written so the leading name >= ? stays sargable
+        conditions << "name >= ? AND (name > ? OR id > ?)";
+        values << after.sortKey << after.sortKey << after.id;
+    }
+
+    QString sql = "SELECT TOP (?) id, name, shift, created_at, updated_at FROM engineers";
+    if (!conditions.isEmpty()) {
+        sql += " WHERE " + conditions.join(" AND ");
+    }
+    sql += " ORDER BY name, id";
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    query.addBindValue(pageSize + 1);   // one extra row tells whether another page follows
+    for (const QVariant& value : values) {
+        query.addBindValue(value);
+    }
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("EngineerRepository", "findPage failed: " + lastError_);
+        return page;
+    }
+
+    while (query.next()) {
+        if (page.items.size() == pageSize) {
+            page.hasMore = true;
+            break;
+        }
+        Engineer engineer;
+        engineer.setId(query.value(0).toString());
+        engineer.setName(query.value(1).toString());
+        engineer.setShift(query.value(2).toString());
+        engineer.setCreatedAt(query.value(3).toDateTime());
+        engineer.setUpdatedAt(query.value(4).toDateTime());
+        page.items.append(engineer);
+    }
+
+    if (!page.items.isEmpty()) {
+        page.next.sortKey = page.items.last().name();
+        page.next.id = page.items.last().id();
+    }
+
+    LOG_DEBUG("EngineerRepository", QString("Found %1 engineers (page)").arg(page.items.size()));
+    return page;
+}
+
 QList<Engineer> EngineerRepository::findByShift(const QString& shift)
 {
     QList<Engineer> engineers;
@@ -51,8 +133,9 @@ QList<Engineer> EngineerRepository::findByShift(const QString& shift)
         return engineers;
     }
 
-    QSqlQuery query(db);
-    query.prepare("SELECT id, name, shift, created_at, updated_at FROM engineers WHERE shift = ? ORDER BY name");
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT id, name, shift, created_at, updated_at FROM engineers WHERE shift = ? ORDER BY name");
+    QSqlQuery& query = statement.query();
     query.addBindValue(shift);
 
     if (!query.exec()) {
@@ -71,7 +154,7 @@ QList<Engineer> EngineerRepository::findByShift(const QString& shift)
         engineers.append(engineer);
     }
 
-    Logger::instance().debug("EngineerRepository", QString("Found %1 engineers in shift %2").arg(engineers.size()).arg(shift));
+    LOG_DEBUG("EngineerRepository", QString("Found %1 engineers in shift %2").arg(engineers.size()).arg(shift));
     return engineers;
 }
 
@@ -84,8 +167,9 @@ Engineer EngineerRepository::findById(const QString& id)
         return Engineer();
     }
 
-    QSqlQuery query(db);
-    query.prepare("SELECT id, name, shift, created_at, updated_at FROM engineers WHERE id = ?");
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT id, name, shift, created_at, updated_at FROM engineers WHERE id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(id);
 
     if (!query.exec()) {
@@ -107,6 +191,64 @@ Engineer EngineerRepository::findById(const QString& id)
     return Engineer();
 }
 
+ChangeSet<Engineer, QString> EngineerRepository::findChangedSince(qint64 version)
+{
+    lastError_.clear();
+    ChangeSet<Engineer, QString> changes;
+    changes.version = version;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("EngineerRepository", lastError_);
+        return changes;
+    }
+
+    // Upper bound first, so rows committed while we read are caught next time
+    qint64 upTo = ChangeTracking::currentVersion(db, &lastError_);
+    if (upTo < 0) {
+        return changes;
+    }
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, name, shift, created_at, updated_at "
+                  "FROM engineers "
+                  "WHERE row_version > CAST(CAST(? AS BIGINT) AS BINARY(8)) "
+                  "AND row_version <= CAST(CAST(? AS BIGINT) AS BINARY(8))");
+    query.addBindValue(version);
+    query.addBindValue(upTo);
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("EngineerRepository", "findChangedSince failed: " + lastError_);
+        return changes;
+    }
+
+    while (query.next()) {
+        Engineer engineer;
+        engineer.setId(query.value(0).toString());
+        engineer.setName(query.value(1).toString());
+        engineer.setShift(query.value(2).toString());
+        engineer.setCreatedAt(query.value(3).toDateTime());
+        engineer.setUpdatedAt(query.value(4).toDateTime());
+        changes.changed.append(engineer);
+    }
+
+    QStringList deletedKeys;
+    if (!ChangeTracking::findDeletedKeys(db, "engineers", version, upTo, deletedKeys, &lastError_)) {
+        return changes;
+    }
+    for (const QString& key : deletedKeys) {
+        changes.removed.append(key);
+    }
+
+    changes.version = upTo;
+    LOG_DEBUG("EngineerRepository",
+        QString("findChangedSince: %1 changed, %2 removed").arg(changes.changed.size()).arg(changes.removed.size()));
+    return changes;
+}
+
 bool EngineerRepository::save(Engineer& engineer)
 {
     QSqlDatabase& db = DatabaseManager::instance().database();
@@ -134,7 +276,99 @@ bool EngineerRepository::save(Engineer& engineer)
         return false;
     }
 
-    Logger::instance().info("EngineerRepository", "Engineer saved: " + engineer.name());
+    SkillMatrixStore::instance().engineerSaved(engineer);
+    LOG_INFO("EngineerRepository", "Engineer saved: " + engineer.name());
+    return true;
+}
+
+bool EngineerRepository::saveOrUpdateBatch(QList<Engineer>& engineers, bool inCallerTransaction)
+{
+    lastError_.clear();
+
+    if (engineers.isEmpty()) {
+        return true;
+    }
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("EngineerRepository", lastError_);
+        return false;
+    }
+
+    // MERGE rejects a batch that touches the same id twice; the last row wins
+    QHash<QString, int> lastRowForId;
+    lastRowForId.reserve(engineers.size());
+    for (int i = 0; i < engineers.size(); ++i) {
+        if (engineers[i].id().isEmpty()) {
+            engineers[i].setId(Crypto::generateId("eng"));
+        }
+        lastRowForId.insert(engineers[i].id(), i);
+    }
+
+    QList<int> rows;
+    rows.reserve(lastRowForId.size());
+    for (int i = 0; i < engineers.size(); ++i) {
+        if (lastRowForId.value(engineers[i].id()) == i) {
+            rows.append(i);
+        }
+    }
+
+    if (!inCallerTransaction && !db.transaction()) {
+        lastError_ = db.lastError().text();
+        Logger::instance().error("EngineerRepository", "saveOrUpdateBatch begin failed: " + lastError_);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    for (int offset = 0; offset < rows.size(); offset += Constants::DB_UPSERT_BATCH_SIZE) {
+        int end = qMin(offset + Constants::DB_UPSERT_BATCH_SIZE, rows.size());
+
+        QJsonArray batch;
+        for (int r = offset; r < end; ++r) {
+            const Engineer& engineer = engineers[rows[r]];
+            QJsonObject row;
+            row["i"] = engineer.id();
+            row["n"] = engineer.name();
+            row["s"] = engineer.shift();
+            batch.append(row);
+        }
+
+        query.prepare("MERGE engineers WITH (HOLDLOCK) AS target "
+                      "USING (SELECT id, name, shift "
+                      "       FROM OPENJSON(CAST(? AS NVARCHAR(MAX))) WITH ("
+                      "           id NVARCHAR(50) '$.i', name NVARCHAR(200) '$.n', shift NVARCHAR(50) '$.s')) AS source "
+                      "ON target.id = source.id "
+                      "WHEN MATCHED THEN UPDATE SET name = source.name, shift = source.shift, updated_at = GETDATE() "
+                      "WHEN NOT MATCHED THEN INSERT (id, name, shift, created_at, updated_at) "
+                      "VALUES (source.id, source.name, source.shift, GETDATE(), GETDATE());");
+        query.addBindValue(QString::fromUtf8(QJsonDocument(batch).toJson(QJsonDocument::Compact)));
+
+        if (!query.exec()) {
+            lastError_ = query.lastError().text();
+            Logger::instance().error("EngineerRepository", "saveOrUpdateBatch merge failed: " + lastError_);
+            if (!inCallerTransaction) {
+                db.rollback();
+            }
+            return false;
+        }
+    }
+
+    if (inCallerTransaction) {
+        LOG_INFO("EngineerRepository", QString("Wrote %1 engineers into the open transaction").arg(rows.size()));
+        return true;
+    }
+
+    if (!db.commit()) {
+        lastError_ = db.lastError().text();
+        Logger::instance().error("EngineerRepository", "saveOrUpdateBatch commit failed: " + lastError_);
+        db.rollback();
+        return false;
+    }
+
+    SkillMatrixStore::instance().engineersSaved(engineers);
+
+    LOG_INFO("EngineerRepository", QString("Upserted %1 engineers").arg(rows.size()));
     return true;
 }
 
@@ -159,7 +393,8 @@ bool EngineerRepository::update(const Engineer& engineer)
         return false;
     }
 
-    Logger::instance().info("EngineerRepository", "Engineer updated: " + engineer.name());
+    SkillMatrixStore::instance().engineerSaved(engineer);
+    LOG_INFO("EngineerRepository", "Engineer updated: " + engineer.name());
     return true;
 }
 
@@ -182,6 +417,7 @@ bool EngineerRepository::remove(const QString& id)
         return false;
     }
 
-    Logger::instance().info("EngineerRepository", "Engineer removed: " + id);
+    SkillMatrixStore::instance().engineerRemoved(id);
+    LOG_INFO("EngineerRepository", "Engineer removed: " + id);
     return true;
 }
@@ -2,19 +2,45 @@
 #define ENGINEERREPOSITORY_H
 
 #include "../models/Engineer.h"
+#include "ChangeTracking.h"
+#include "Pagination.h"
 #include <QList>
 
 class EngineerRepository
 {
 public:
+    struct PageFilter {
+        QString shift;          // exact match; empty = any
+        QString namePrefix;     // empty = any
+    };
+
     EngineerRepository();
     ~EngineerRepository();
 
     QList<Engineer> findAll();
+
+    /**
+     * @brief Up to pageSize engineers after a cursor, ordered by name then id
+     *
+     * Keyset pagination backed by IX_engineers_name_id / IX_engineers_shift_name_id
+     * (see resources/database/add-keyset-indexes.sql).
+     */
+    Page<Engineer> findPage(int pageSize, const PageCursor& after = PageCursor(),
+                            const PageFilter& filter = PageFilter());
+    ChangeSet<Engineer, QString> findChangedSince(qint64 version); // Delta since a rowversion mark (see ChangeTracking)
     QList<Engineer> findByShift(const QString& shift);
     Engineer findById(const QString& id);
     bool save(Engineer& engineer);
     bool update(const Engineer& engineer);
+
+    /**
+     * @brief Insert or update by id in one transaction; empty ids are generated
+     *
+     * With inCallerTransaction the rows join a transaction the caller has
+     * begun; committing it and syncing SkillMatrixStore are then the caller's.
+     */
+    bool saveOrUpdateBatch(QList<Engineer>& engineers, bool inCallerTransaction = false);
+
     bool remove(const QString& id);
 
     QString lastError() const { return lastError_; }
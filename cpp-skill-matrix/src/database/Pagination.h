@@ -0,0 +1,63 @@
+#ifndef PAGINATION_H
+#define PAGINATION_H
+
+#include "../core/Constants.h"
+#include <QList>
+#include <QString>
+#include <QVariant>
+#include <QtGlobal>
+
+/**
+ * @brief Position after the last row of a keyset page
+ *
+ * Holds the sort key and id of the last row returned. Repositories seek past it
+ * with an indexed range predicate instead of OFFSET, so every page costs the
+ * same however deep into the table it is. A default-constructed cursor means
+ * "from the start".
+ */
+struct PageCursor
+{
+    QVariant sortKey;   // value of the ORDER BY column (unused when ordering by id)
+    QVariant id;        // primary key; tie-breaker for non-unique sort keys
+
+    bool isStart() const { return !id.isValid(); }
+};
+
+/**
+ * @brief One bounded page of rows from a findPage() call
+ *
+ * Pass next back as the cursor to continue; hasMore is false on the last page.
+ */
+template <typename T>
+struct Page
+{
+    QList<T> items;
+    PageCursor next;
+    bool hasMore = false;
+};
+
+namespace Pagination {
+
+/**
+ * @brief Clamp a requested page size to 1..Constants::MAX_PAGE_SIZE
+ */
+inline int boundedPageSize(int pageSize)
+{
+    return qBound(1, pageSize, Constants::MAX_PAGE_SIZE);
+}
+
+/**
+ * @brief LIKE pattern matching values that start with prefix (wildcards escaped)
+ *
+ * A prefix pattern can still seek on an index over the column.
+ */
+inline QString likePrefix(const QString& prefix)
+{
+    QString escaped = prefix;
+    escaped.replace("[", "[[]").replace("%", "[%]").replace("_", "[_]");
+    return escaped + "%";
+}
+
+} // namespace Pagination
+
+#endif // PAGINATION_H
@@ -1,13 +1,161 @@
 #include "ProductionRepository.h"
 #include "DatabaseManager.h"
+#include "SkillMatrixStore.h"
 #include "../utils/Logger.h"
+#include "../core/Constants.h"
 #include <QSqlQuery>
 #include <QSqlError>
+#include <QSqlDriver>
 #include <QVariant>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <functional>
+
+namespace {
+
+/**
+ * @brief Run a statement over rows sent as one OPENJSON parameter per batch
+ *
+ * rowJson builds row i; each result row (row index, id) goes to onResult.
+ */
+bool execJsonBatches(QSqlDatabase& db, int rowCount, const QString& sql,
+                     const std::function<QJsonObject(int)>& rowJson,
+                     const std::function<void(int, int)>& onResult, QString& error)
+{
+    QSqlQuery query(db);
+    for (int offset = 0; offset < rowCount; offset += Constants::DB_UPSERT_BATCH_SIZE) {
+        int end = qMin(offset + Constants::DB_UPSERT_BATCH_SIZE, rowCount);
+
+        QJsonArray batch;
+        for (int i = offset; i < end; ++i) {
+            batch.append(rowJson(i));
+        }
+
+        query.prepare(sql);
+        query.addBindValue(QString::fromUtf8(QJsonDocument(batch).toJson(QJsonDocument::Compact)));
+        if (!query.exec()) {
+            error = query.lastError().text();
+            return false;
+        }
+        while (onResult && query.next()) {
+            onResult(query.value(0).toInt(), query.value(1).toInt());
+        }
+    }
+    return true;
+}
+
+} // namespace
 
 ProductionRepository::ProductionRepository() : lastError_("") {}
 ProductionRepository::~ProductionRepository() {}
 
+// ============================================================================
+// Hierarchy
+// ============================================================================
+
+ProductionHierarchy ProductionRepository::loadHierarchy()
+{
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("ProductionRepository", lastError_);
+        return ProductionHierarchy();
+    }
+
+    // Three set-based SELECTs; sent as one batch when the driver returns multiple result sets
+    const QStringList statements = {
+        "SELECT id, name, created_at, updated_at FROM production_areas ORDER BY name, id",
+
+        "SELECT m.id, m.production_area_id, m.name, m.importance, m.created_at, m.updated_at "
+        "FROM machines m JOIN production_areas a ON a.id = m.production_area_id "
+        "ORDER BY a.name, a.id, m.name, m.id",
+
+        "SELECT c.id, c.machine_id, c.name, c.max_score, c.created_at, c.updated_at, "
+        "c.safety_impact, c.production_impact, c.frequency, c.complexity, c.future_value "
+        "FROM competencies c "
+        "JOIN machines m ON m.id = c.machine_id "
+        "JOIN production_areas a ON a.id = m.production_area_id "
+        "ORDER BY a.name, a.id, m.name, m.id, c.name, c.id"
+    };
+
+    QList<ProductionArea> areas;
+    QList<Machine> machines;
+    QList<Competency> competencies;
+
+    auto readResultSet = [&](QSqlQuery& query, int index) {
+        while (query.next()) {
+            if (index == 0) {
+                ProductionArea area;
+                area.setId(query.value(0).toInt());
+                area.setName(query.value(1).toString());
+                area.setCreatedAt(query.value(2).toDateTime());
+                area.setUpdatedAt(query.value(3).toDateTime());
+                areas.append(area);
+            } else if (index == 1) {
+                Machine machine;
+                machine.setId(query.value(0).toInt());
+                machine.setProductionAreaId(query.value(1).toInt());
+                machine.setName(query.value(2).toString());
+                machine.setImportance(query.value(3).toInt());
+                machine.setCreatedAt(query.value(4).toDateTime());
+                machine.setUpdatedAt(query.value(5).toDateTime());
+                machines.append(machine);
+            } else {
+                Competency competency;
+                competency.setId(query.value(0).toInt());
+                competency.setMachineId(query.value(1).toInt());
+                competency.setName(query.value(2).toString());
+                competency.setMaxScore(query.value(3).toInt());
+                competency.setCreatedAt(query.value(4).toDateTime());
+                competency.setUpdatedAt(query.value(5).toDateTime());
+
+                // Multi-Criteria Weighting
+                competency.setSafetyImpact(query.value(6).toDouble());
+                competency.setProductionImpact(query.value(7).toDouble());
+                competency.setFrequency(query.value(8).toDouble());
+                competency.setComplexity(query.value(9).toDouble());
+                competency.setFutureValue(query.value(10).toDouble());
+                competencies.append(competency);
+            }
+        }
+    };
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    if (db.driver()->hasFeature(QSqlDriver::MultipleResultSets)) {
+        if (!query.exec(statements.join("; "))) {
+            lastError_ = query.lastError().text();
+            Logger::instance().error("ProductionRepository", "loadHierarchy failed: " + lastError_);
+            return ProductionHierarchy();
+        }
+
+        for (int index = 0; index < statements.size(); ++index) {
+            if (index > 0 && !query.nextResult()) {
+                lastError_ = "Missing result set in hierarchy batch";
+                Logger::instance().error("ProductionRepository", "loadHierarchy failed: " + lastError_);
+                return ProductionHierarchy();
+            }
+            readResultSet(query, index);
+        }
+    } else {
+        for (int index = 0; index < statements.size(); ++index) {
+            if (!query.exec(statements[index])) {
+                lastError_ = query.lastError().text();
+                Logger::instance().error("ProductionRepository", "loadHierarchy failed: " + lastError_);
+                return ProductionHierarchy();
+            }
+            readResultSet(query, index);
+        }
+    }
+
+    LOG_DEBUG("ProductionRepository",
+        QString("Loaded hierarchy: %1 areas, %2 machines, %3 competencies")
+        .arg(areas.size()).arg(machines.size()).arg(competencies.size()));
+    return ProductionHierarchy(areas, machines, competencies);
+}
+
 // ============================================================================
 // Production Areas
 // ============================================================================
@@ -41,7 +189,7 @@ QList<ProductionArea> ProductionRepository::findAllAreas()
         areas.append(area);
     }
 
-    Logger::instance().debug("ProductionRepository", QString("Found %1 production areas").arg(areas.size()));
+    LOG_DEBUG("ProductionRepository", QString("Found %1 production areas").arg(areas.size()));
     return areas;
 }
 
@@ -71,11 +219,11 @@ ProductionArea ProductionRepository::findAreaById(int id)
         area.setCreatedAt(query.value(2).toDateTime());
         area.setUpdatedAt(query.value(3).toDateTime());
 
-        Logger::instance().debug("ProductionRepository", "Found production area: " + area.name());
+        LOG_DEBUG("ProductionRepository", "Found production area: " + area.name());
         return area;
     }
 
-    Logger::instance().debug("ProductionRepository", QString("Production area not found with id: %1").arg(id));
+    LOG_DEBUG("ProductionRepository", QString("Production area not found with id: %1").arg(id));
     return ProductionArea();
 }
 
@@ -104,7 +252,8 @@ bool ProductionRepository::saveArea(ProductionArea& area)
     if (query.next()) {
         int newId = query.value(0).toInt();
         area.setId(newId);
-        Logger::instance().info("ProductionRepository", QString("Production area saved: %1 (ID: %2)").arg(area.name()).arg(newId));
+        SkillMatrixStore::instance().hierarchyModified();
+        LOG_INFO("ProductionRepository", QString("Production area saved: %1 (ID: %2)").arg(area.name()).arg(newId));
         return true;
     }
 
@@ -133,7 +282,8 @@ bool ProductionRepository::updateArea(const ProductionArea& area)
         return false;
     }
 
-    Logger::instance().info("ProductionRepository", QString("Production area updated: %1").arg(area.name()));
+    SkillMatrixStore::instance().hierarchyModified();
+    LOG_INFO("ProductionRepository", QString("Production area updated: %1").arg(area.name()));
     return true;
 }
 
@@ -156,7 +306,8 @@ bool ProductionRepository::removeArea(int id)
         return false;
     }
 
-    Logger::instance().info("ProductionRepository", QString("Production area removed: %1").arg(id));
+    SkillMatrixStore::instance().hierarchyModified(true);
+    LOG_INFO("ProductionRepository", QString("Production area removed: %1").arg(id));
     return true;
 }
 
@@ -197,7 +348,7 @@ QList<Machine> ProductionRepository::findMachinesByArea(int areaId)
         machines.append(machine);
     }
 
-    Logger::instance().debug("ProductionRepository", QString("Found %1 machines for area %2").arg(machines.size()).arg(areaId));
+    LOG_DEBUG("ProductionRepository", QString("Found %1 machines for area %2").arg(machines.size()).arg(areaId));
     return machines;
 }
 
@@ -230,11 +381,11 @@ Machine ProductionRepository::findMachineById(int id)
         machine.setCreatedAt(query.value(4).toDateTime());
         machine.setUpdatedAt(query.value(5).toDateTime());
 
-        Logger::instance().debug("ProductionRepository", "Found machine: " + machine.name());
+        LOG_DEBUG("ProductionRepository", "Found machine: " + machine.name());
         return machine;
     }
 
-    Logger::instance().debug("ProductionRepository", QString("Machine not found with id: %1").arg(id));
+    LOG_DEBUG("ProductionRepository", QString("Machine not found with id: %1").arg(id));
     return Machine();
 }
 
@@ -265,7 +416,8 @@ bool ProductionRepository::saveMachine(Machine& machine)
     if (query.next()) {
         int newId = query.value(0).toInt();
         machine.setId(newId);
-        Logger::instance().info("ProductionRepository", QString("Machine saved: %1 (ID: %2)").arg(machine.name()).arg(newId));
+        SkillMatrixStore::instance().hierarchyModified();
+        LOG_INFO("ProductionRepository", QString("Machine saved: %1 (ID: %2)").arg(machine.name()).arg(newId));
         return true;
     }
 
@@ -295,7 +447,8 @@ bool ProductionRepository::updateMachine(const Machine& machine)
         return false;
     }
 
-    Logger::instance().info("ProductionRepository", QString("Machine updated: %1").arg(machine.name()));
+    SkillMatrixStore::instance().hierarchyModified();
+    LOG_INFO("ProductionRepository", QString("Machine updated: %1").arg(machine.name()));
     return true;
 }
 
@@ -318,7 +471,8 @@ bool ProductionRepository::removeMachine(int id)
         return false;
     }
 
-    Logger::instance().info("ProductionRepository", QString("Machine removed: %1").arg(id));
+    SkillMatrixStore::instance().hierarchyModified(true);
+    LOG_INFO("ProductionRepository", QString("Machine removed: %1").arg(id));
     return true;
 }
 
@@ -368,7 +522,7 @@ QList<Competency> ProductionRepository::findCompetenciesByMachine(int machineId)
         competencies.append(competency);
     }
 
-    Logger::instance().debug("ProductionRepository", QString("Found %1 competencies for machine %2").arg(competencies.size()).arg(machineId));
+    LOG_DEBUG("ProductionRepository", QString("Found %1 competencies for machine %2").arg(competencies.size()).arg(machineId));
     return competencies;
 }
 
@@ -409,11 +563,11 @@ Competency ProductionRepository::findCompetencyById(int id)
         competency.setComplexity(query.value(9).toDouble());
         competency.setFutureValue(query.value(10).toDouble());
 
-        Logger::instance().debug("ProductionRepository", "Found competency: " + competency.name());
+        LOG_DEBUG("ProductionRepository", "Found competency: " + competency.name());
         return competency;
     }
 
-    Logger::instance().debug("ProductionRepository", QString("Competency not found with id: %1").arg(id));
+    LOG_DEBUG("ProductionRepository", QString("Competency not found with id: %1").arg(id));
     return Competency();
 }
 
@@ -451,7 +605,8 @@ bool ProductionRepository::saveCompetency(Competency& competency)
     if (query.next()) {
         int newId = query.value(0).toInt();
         competency.setId(newId);
-        Logger::instance().info("ProductionRepository", QString("Competency saved: %1 (ID: %2)").arg(competency.name()).arg(newId));
+        SkillMatrixStore::instance().hierarchyModified();
+        LOG_INFO("ProductionRepository", QString("Competency saved: %1 (ID: %2)").arg(competency.name()).arg(newId));
         return true;
     }
 
@@ -488,7 +643,8 @@ bool ProductionRepository::updateCompetency(const Competency& competency)
         return false;
     }
 
-    Logger::instance().info("ProductionRepository", QString("Competency updated: %1").arg(competency.name()));
+    SkillMatrixStore::instance().hierarchyModified();
+    LOG_INFO("ProductionRepository", QString("Competency updated: %1").arg(competency.name()));
     return true;
 }
 
@@ -511,6 +667,230 @@ bool ProductionRepository::removeCompetency(int id)
         return false;
     }
 
-    Logger::instance().info("ProductionRepository", QString("Competency removed: %1").arg(id));
+    SkillMatrixStore::instance().hierarchyModified(true);
+    LOG_INFO("ProductionRepository", QString("Competency removed: %1").arg(id));
+    return true;
+}
+
+// ============================================================================
+// Batch writes
+// ============================================================================
+
+bool ProductionRepository::insertAreas(QList<ProductionArea>& areas)
+{
+    lastError_.clear();
+    if (areas.isEmpty()) {
+        return true;
+    }
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("ProductionRepository", lastError_);
+        return false;
+    }
+
+    // MERGE on a false condition inserts every row and, unlike INSERT ... OUTPUT,
+    // can return the source row index alongside the generated id
+    bool ok = execJsonBatches(db, areas.size(),
+        "MERGE production_areas AS target "
+        "USING (SELECT row_index, name FROM OPENJSON(CAST(? AS NVARCHAR(MAX))) WITH ("
+        "           row_index INT '$.i', name NVARCHAR(200) '$.n')) AS source "
+        "ON 1 = 0 "
+        "WHEN NOT MATCHED THEN INSERT (name, created_at, updated_at) "
+        "VALUES (source.name, GETDATE(), GETDATE()) "
+        "OUTPUT source.row_index, inserted.id;",
+        [&areas](int i) {
+            QJsonObject row;
+            row["i"] = i;
+            row["n"] = areas[i].name();
+            return row;
+        },
+        [&areas](int i, int id) { areas[i].setId(id); },
+        lastError_);
+
+    if (!ok) {
+        Logger::instance().error("ProductionRepository", "insertAreas failed: " + lastError_);
+        return false;
+    }
+
+    SkillMatrixStore::instance().hierarchyModified();
+    LOG_INFO("ProductionRepository", QString("Inserted %1 production areas").arg(areas.size()));
+    return true;
+}
+
+bool ProductionRepository::insertMachines(QList<Machine>& machines)
+{
+    lastError_.clear();
+    if (machines.isEmpty()) {
+        return true;
+    }
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("ProductionRepository", lastError_);
+        return false;
+    }
+
+    bool ok = execJsonBatches(db, machines.size(),
+        "MERGE machines AS target "
+        "USING (SELECT row_index, production_area_id, name, importance "
+        "       FROM OPENJSON(CAST(? AS NVARCHAR(MAX))) WITH ("
+        "           row_index INT '$.i', production_area_id INT '$.a', "
+        "           name NVARCHAR(200) '$.n', importance INT '$.p')) AS source "
+        "ON 1 = 0 "
+        "WHEN NOT MATCHED THEN INSERT (production_area_id, name, importance, created_at, updated_at) "
+        "VALUES (source.production_area_id, source.name, source.importance, GETDATE(), GETDATE()) "
+        "OUTPUT source.row_index, inserted.id;",
+        [&machines](int i) {
+            QJsonObject row;
+            row["i"] = i;
+            row["a"] = machines[i].productionAreaId();
+            row["n"] = machines[i].name();
+            row["p"] = machines[i].importance();
+            return row;
+        },
+        [&machines](int i, int id) { machines[i].setId(id); },
+        lastError_);
+
+    if (!ok) {
+        Logger::instance().error("ProductionRepository", "insertMachines failed: " + lastError_);
+        return false;
+    }
+
+    SkillMatrixStore::instance().hierarchyModified();
+    LOG_INFO("ProductionRepository", QString("Inserted %1 machines").arg(machines.size()));
+    return true;
+}
+
+bool ProductionRepository::insertCompetencies(QList<Competency>& competencies)
+{
+    lastError_.clear();
+    if (competencies.isEmpty()) {
+        return true;
+    }
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("ProductionRepository", lastError_);
+        return false;
+    }
+
+    bool ok = execJsonBatches(db, competencies.size(),
+        "MERGE competencies AS target "
+        "USING (SELECT row_index, machine_id, name, max_score, "
+        "              safety_impact, production_impact, frequency, complexity, future_value "
+        "       FROM OPENJSON(CAST(? AS NVARCHAR(MAX))) WITH ("
+        "           row_index INT '$.i', machine_id INT '$.m', name NVARCHAR(200) '$.n', "
+        "           max_score INT '$.s', safety_impact DECIMAL(3,1) '$.si', "
+        "           production_impact DECIMAL(3,1) '$.pi', frequency DECIMAL(3,1) '$.f', "
+        "           complexity DECIMAL(3,1) '$.c', future_value DECIMAL(3,1) '$.fv')) AS source "
+        "ON 1 = 0 "
+        "WHEN NOT MATCHED THEN INSERT (machine_id, name, max_score, "
+        "    safety_impact, production_impact, frequency, complexity, future_value, created_at, updated_at) "
+        "VALUES (source.machine_id, source.name, source.max_score, source.safety_impact, "
+        "    source.production_impact, source.frequency, source.complexity, source.future_value, "
+        "    GETDATE(), GETDATE()) "
+        "OUTPUT source.row_index, inserted.id;",
+        [&competencies](int i) {
+            const Competency& competency = competencies[i];
+            QJsonObject row;
+            row["i"] = i;
+            row["m"] = competency.machineId();
+            row["n"] = competency.name();
+            row["s"] = competency.maxScore();
+            row["si"] = competency.safetyImpact();
+            row["pi"] = competency.productionImpact();
+            row["f"] = competency.frequency();
+            row["c"] = competency.complexity();
+            row["fv"] = competency.futureValue();
+            return row;
+        },
+        [&competencies](int i, int id) { competencies[i].setId(id); },
+        lastError_);
+
+    if (!ok) {
+        Logger::instance().error("ProductionRepository", "insertCompetencies failed: " + lastError_);
+        return false;
+    }
+
+    SkillMatrixStore::instance().hierarchyModified();
+    LOG_INFO("ProductionRepository", QString("Inserted %1 competencies").arg(competencies.size()));
+    return true;
+}
+
+bool ProductionRepository::updateMachineImportance(const QList<Machine>& machines)
+{
+    lastError_.clear();
+    if (machines.isEmpty()) {
+        return true;
+    }
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("ProductionRepository", lastError_);
+        return false;
+    }
+
+    bool ok = execJsonBatches(db, machines.size(),
+        "UPDATE target SET importance = source.importance, updated_at = GETDATE() "
+        "FROM machines AS target "
+        "JOIN OPENJSON(CAST(? AS NVARCHAR(MAX))) WITH (id INT '$.id', importance INT '$.p') AS source "
+        "ON target.id = source.id;",
+        [&machines](int i) {
+            QJsonObject row;
+            row["id"] = machines[i].id();
+            row["p"] = machines[i].importance();
+            return row;
+        },
+        nullptr, lastError_);
+
+    if (!ok) {
+        Logger::instance().error("ProductionRepository", "updateMachineImportance failed: " + lastError_);
+        return false;
+    }
+
+    SkillMatrixStore::instance().hierarchyModified();
+    LOG_INFO("ProductionRepository", QString("Updated importance of %1 machines").arg(machines.size()));
+    return true;
+}
+
+bool ProductionRepository::updateCompetencyMaxScores(const QList<Competency>& competencies)
+{
+    lastError_.clear();
+    if (competencies.isEmpty()) {
+        return true;
+    }
+
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("ProductionRepository", lastError_);
+        return false;
+    }
+
+    bool ok = execJsonBatches(db, competencies.size(),
+        "UPDATE target SET max_score = source.max_score, updated_at = GETDATE() "
+        "FROM competencies AS target "
+        "JOIN OPENJSON(CAST(? AS NVARCHAR(MAX))) WITH (id INT '$.id', max_score INT '$.s') AS source "
+        "ON target.id = source.id;",
+        [&competencies](int i) {
+            QJsonObject row;
+            row["id"] = competencies[i].id();
+            row["s"] = competencies[i].maxScore();
+            return row;
+        },
+        nullptr, lastError_);
+
+    if (!ok) {
+        Logger::instance().error("ProductionRepository", "updateCompetencyMaxScores failed: " + lastError_);
+        return false;
+    }
+
+    SkillMatrixStore::instance().hierarchyModified();
+    LOG_INFO("ProductionRepository", QString("Updated max score of %1 competencies").arg(competencies.size()));
     return true;
 }
@@ -4,6 +4,7 @@
 #include "../models/ProductionArea.h"
 #include "../models/Machine.h"
 #include "../models/Competency.h"
+#include "../models/ProductionHierarchy.h"
 #include <QList>
 
 class ProductionRepository
@@ -12,6 +13,15 @@ public:
     ProductionRepository();
     ~ProductionRepository();
 
+    /**
+     * @brief Load the whole area/machine/competency tree in one round trip
+     *
+     * Replaces walking findAllAreas() -> findMachinesByArea() -> findCompetenciesByMachine(),
+     * which costs 1 + A + M queries. Rows come back in hierarchy order
+     * (area name, machine name, competency name) with weighting columns.
+     */
+    ProductionHierarchy loadHierarchy();
+
     // Production Areas
     QList<ProductionArea> findAllAreas();
     ProductionArea findAreaById(int id);
@@ -33,6 +43,25 @@ public:
     bool updateCompetency(const Competency& competency);
     bool removeCompetency(int id);
 
+    /**
+     * @brief Insert many rows of one level with set-based INSERTs (OPENJSON)
+     *
+     * Up to Constants::DB_UPSERT_BATCH_SIZE rows per statement; generated ids
+     * are written back into the list. These open no transaction of their own:
+     * run them inside the caller's, so a whole tree lands or none of it does.
+     */
+    bool insertAreas(QList<ProductionArea>& areas);
+    bool insertMachines(QList<Machine>& machines);
+    bool insertCompetencies(QList<Competency>& competencies);
+
+    /**
+     * @brief Set importance / max score of many existing rows in one statement per batch
+     *
+     * Same batching as insertAreas(); no transaction of their own.
+     */
+    bool updateMachineImportance(const QList<Machine>& machines);
+    bool updateCompetencyMaxScores(const QList<Competency>& competencies);
+
     QString lastError() const { return lastError_; }
 
 private:
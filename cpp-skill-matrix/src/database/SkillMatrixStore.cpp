@@ -0,0 +1,671 @@
+#include "SkillMatrixStore.h"
+#include "DatabaseManager.h"
+#include "EngineerRepository.h"
+#include "ProductionRepository.h"
+#include "AssessmentRepository.h"
+#include "CoreSkillsRepository.h"
+#include "CertificationRepository.h"
+#include "ChangeTracking.h"
+#include "../utils/Logger.h"
+#include <QCoreApplication>
+
+SkillMatrixStore& SkillMatrixStore::instance()
+{
+    static SkillMatrixStore instance;
+    return instance;
+}
+
+SkillMatrixStore::SkillMatrixStore(QObject* parent)
+    : QObject(parent)
+    , engineers_(&Engineer::shift)
+    , assessments_(&Assessment::engineerId)
+    , skills_(&CoreSkill::categoryId)
+    , coreSkillAssessments_(&CoreSkillAssessment::engineerId)
+    , certifications_(&Certification::engineerId)
+    , competencyScoresValid_(false)
+    , coreSkillScoresValid_(false)
+{
+    // The first caller may be a pool worker; queued slots such as the
+    // connectionChanged one below need the GUI thread's event loop
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        moveToThread(app->thread());
+    }
+
+    // A new connection may point at a different database
+    connect(&DatabaseManager::instance(), &DatabaseManager::connectionChanged,
+            this, [this]() { invalidate(); });
+
+    // Drop derived score matrices whenever one of their inputs changes. Direct
+    // connections so the matrix is stale no longer than the snapshot it came from.
+    auto dropCompetencyScores = [this]() {
+        competencyScoresGeneration_.fetchAndAddOrdered(1);
+        QWriteLocker locker(&lock_);
+        competencyScoresValid_ = false;
+    };
+    auto dropCoreSkillScores = [this]() {
+        coreSkillScoresGeneration_.fetchAndAddOrdered(1);
+        QWriteLocker locker(&lock_);
+        coreSkillScoresValid_ = false;
+    };
+    connect(this, &SkillMatrixStore::engineersChanged, this, dropCompetencyScores, Qt::DirectConnection);
+    connect(this, &SkillMatrixStore::engineersChanged, this, dropCoreSkillScores, Qt::DirectConnection);
+    connect(this, &SkillMatrixStore::hierarchyChanged, this, dropCompetencyScores, Qt::DirectConnection);
+    connect(this, &SkillMatrixStore::assessmentsChanged, this, dropCompetencyScores, Qt::DirectConnection);
+    connect(this, &SkillMatrixStore::coreSkillCatalogUpdated, this, dropCoreSkillScores, Qt::DirectConnection);
+    connect(this, &SkillMatrixStore::coreSkillAssessmentsChanged, this, dropCoreSkillScores, Qt::DirectConnection);
+    connect(this, &SkillMatrixStore::datasetsReloaded, this, [=](Datasets datasets) {
+        if (datasets & (Engineers | Hierarchy | Assessments)) {
+            dropCompetencyScores();
+        }
+        if (datasets & (Engineers | CoreSkills | CoreSkillAssessments)) {
+            dropCoreSkillScores();
+        }
+    }, Qt::DirectConnection);
+}
+
+SkillMatrixStore::~SkillMatrixStore()
+{
+}
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+EngineerSnapshot SkillMatrixStore::engineers()
+{
+    ensureLoaded(Engineers);
+    QReadLocker locker(&lock_);
+    return engineers_;
+}
+
+ProductionHierarchy SkillMatrixStore::hierarchy()
+{
+    ensureLoaded(Hierarchy);
+    QReadLocker locker(&lock_);
+    return hierarchy_;
+}
+
+AssessmentSnapshot SkillMatrixStore::assessments()
+{
+    ensureLoaded(Assessments);
+    QReadLocker locker(&lock_);
+    return assessments_;
+}
+
+CoreSkillCategorySnapshot SkillMatrixStore::coreSkillCategories()
+{
+    ensureLoaded(CoreSkills);
+    QReadLocker locker(&lock_);
+    return categories_;
+}
+
+CoreSkillSnapshot SkillMatrixStore::coreSkills()
+{
+    ensureLoaded(CoreSkills);
+    QReadLocker locker(&lock_);
+    return skills_;
+}
+
+CoreSkillAssessmentSnapshot SkillMatrixStore::coreSkillAssessments()
+{
+    ensureLoaded(CoreSkillAssessments);
+    QReadLocker locker(&lock_);
+    return coreSkillAssessments_;
+}
+
+CertificationSnapshot SkillMatrixStore::certifications()
+{
+    ensureLoaded(Certifications);
+    QReadLocker locker(&lock_);
+    return certifications_;
+}
+
+CompetencyScoreMatrix SkillMatrixStore::competencyScores()
+{
+    {
+        QReadLocker locker(&lock_);
+        if (competencyScoresValid_) {
+            return competencyScores_;
+        }
+    }
+
+    quint32 generation = competencyScoresGeneration_.loadAcquire();
+    CompetencyScoreMatrix matrix = ScoreMatrices::fromAssessments(engineers().items(),
+                                                                  hierarchy().competencies(),
+                                                                  assessments().items());
+
+    QWriteLocker locker(&lock_);
+    if (generation == competencyScoresGeneration_.loadAcquire()) {
+        competencyScores_ = matrix;
+        competencyScoresValid_ = true;
+    }
+    return matrix;
+}
+
+CoreSkillScoreMatrix SkillMatrixStore::coreSkillScores()
+{
+    {
+        QReadLocker locker(&lock_);
+        if (coreSkillScoresValid_) {
+            return coreSkillScores_;
+        }
+    }
+
+    quint32 generation = coreSkillScoresGeneration_.loadAcquire();
+    CoreSkillScoreMatrix matrix = ScoreMatrices::fromCoreSkillAssessments(engineers().items(),
+                                                                          coreSkills().items(),
+                                                                          coreSkillAssessments().items());
+
+    QWriteLocker locker(&lock_);
+    if (generation == coreSkillScoresGeneration_.loadAcquire()) {
+        coreSkillScores_ = matrix;
+        coreSkillScoresValid_ = true;
+    }
+    return matrix;
+}
+
+bool SkillMatrixStore::isLoaded(Dataset dataset) const
+{
+    QReadLocker locker(&lock_);
+    return loaded_.testFlag(dataset);
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+void SkillMatrixStore::invalidate(Datasets datasets)
+{
+    {
+        QWriteLocker locker(&lock_);
+        dropLoaded(datasets);
+    }
+
+    LOG_DEBUG("SkillMatrixStore", QString("Invalidated datasets 0x%1").arg(int(datasets), 0, 16));
+    emit datasetsReloaded(datasets);
+}
+
+bool SkillMatrixStore::reload(Datasets datasets)
+{
+    bool ok = true;
+    const Dataset all[] = { Engineers, Hierarchy, Assessments, CoreSkills, CoreSkillAssessments, Certifications };
+    for (Dataset dataset : all) {
+        if (datasets.testFlag(dataset)) {
+            ok = loadSingleFlight(dataset, true) && ok;
+        }
+    }
+
+    emit datasetsReloaded(datasets);
+    return ok;
+}
+
+bool SkillMatrixStore::sync(Datasets datasets)
+{
+    bool ok = true;
+    Datasets reloaded;
+    const Dataset all[] = { Engineers, Hierarchy, Assessments, CoreSkills, CoreSkillAssessments, Certifications };
+    for (Dataset dataset : all) {
+        if (!datasets.testFlag(dataset) || !isLoaded(dataset)) {
+            continue;
+        }
+        if (!syncDataset(dataset)) {
+            ok = loadSingleFlight(dataset, true) && ok;
+            reloaded |= dataset;
+        }
+    }
+
+    if (reloaded) {
+        emit datasetsReloaded(reloaded);
+    }
+    return ok;
+}
+
+bool SkillMatrixStore::syncDataset(Dataset dataset)
+{
+    qint64 version;
+    {
+        QReadLocker locker(&lock_);
+        version = versions_.value(dataset, -1);
+    }
+    if (version < 0) {
+        return false;
+    }
+
+    switch (dataset) {
+        case Engineers: {
+            EngineerRepository repo;
+            ChangeSet<Engineer, QString> changes = repo.findChangedSince(version);
+            if (!repo.lastError().isEmpty()) {
+                return false;
+            }
+            {
+                QWriteLocker locker(&lock_);
+                // Removals first: a row deleted and re-created under the same id
+                // since the last sync is in both lists and must stay
+                engineers_.remove(changes.removed);
+                for (const Engineer& engineer : changes.changed) {
+                    engineers_.upsert(engineer);
+                }
+                versions_.insert(dataset, changes.version);
+            }
+            if (!changes.isEmpty()) {
+                emit engineersChanged();
+            }
+            return true;
+        }
+        case Assessments: {
+            AssessmentRepository repo;
+            ChangeSet<Assessment, int> changes = repo.findChangedSince(version);
+            if (!repo.lastError().isEmpty()) {
+                return false;
+            }
+            QSet<QString> engineerIds;
+            {
+                QWriteLocker locker(&lock_);
+                for (int id : changes.removed) {
+                    if (assessments_.contains(id)) {
+                        engineerIds.insert(assessments_.value(id).engineerId());
+                    }
+                }
+                assessments_.remove(changes.removed);
+                for (const Assessment& assessment : changes.changed) {
+                    engineerIds.insert(assessment.engineerId());
+                    assessments_.upsert(assessment);
+                }
+                versions_.insert(dataset, changes.version);
+            }
+            if (!engineerIds.isEmpty()) {
+                emit assessmentsChanged(engineerIds.values());
+            }
+            return true;
+        }
+        case CoreSkillAssessments: {
+            CoreSkillsRepository repo;
+            ChangeSet<CoreSkillAssessment, int> changes = repo.findAssessmentsChangedSince(version);
+            if (!repo.lastError().isEmpty()) {
+                return false;
+            }
+            QSet<QString> engineerIds;
+            {
+                QWriteLocker locker(&lock_);
+                for (int id : changes.removed) {
+                    if (coreSkillAssessments_.contains(id)) {
+                        engineerIds.insert(coreSkillAssessments_.value(id).engineerId());
+                    }
+                }
+                coreSkillAssessments_.remove(changes.removed);
+                for (const CoreSkillAssessment& assessment : changes.changed) {
+                    engineerIds.insert(assessment.engineerId());
+                    coreSkillAssessments_.upsert(assessment);
+                }
+                versions_.insert(dataset, changes.version);
+            }
+            if (!engineerIds.isEmpty()) {
+                emit coreSkillAssessmentsChanged(engineerIds.values());
+            }
+            return true;
+        }
+        case Certifications: {
+            CertificationRepository repo;
+            ChangeSet<Certification, int> changes = repo.findChangedSince(version);
+            if (!repo.lastError().isEmpty()) {
+                return false;
+            }
+            QSet<QString> engineerIds;
+            {
+                QWriteLocker locker(&lock_);
+                for (int id : changes.removed) {
+                    if (certifications_.contains(id)) {
+                        engineerIds.insert(certifications_.value(id).engineerId());
+                    }
+                }
+                certifications_.remove(changes.removed);
+                for (const Certification& certification : changes.changed) {
+                    engineerIds.insert(certification.engineerId());
+                    certifications_.upsert(certification);
+                }
+                versions_.insert(dataset, changes.version);
+            }
+            for (const QString& engineerId : engineerIds) {
+                emit certificationsChanged(engineerId);
+            }
+            return true;
+        }
+        default:
+            // Hierarchy and core skill catalog are not change-tracked
+            return false;
+    }
+}
+
+void SkillMatrixStore::ensureLoaded(Dataset dataset)
+{
+    {
+        QReadLocker locker(&lock_);
+        if (loaded_.testFlag(dataset)) {
+            return;
+        }
+    }
+
+    loadSingleFlight(dataset, false);
+}
+
+bool SkillMatrixStore::loadSingleFlight(Dataset dataset, bool force)
+{
+    // One load per dataset at a time: concurrent readers wait for it instead of
+    // each running the full query, and a reload never overlaps an older load
+    {
+        QMutexLocker locker(&loadMutex_);
+        for (;;) {
+            if (!force && isLoaded(dataset)) {
+                return true;
+            }
+            if (!loading_.testFlag(dataset)) {
+                break;
+            }
+            loadFinished_.wait(&loadMutex_);
+        }
+        loading_ |= dataset;
+    }
+
+    bool ok = loadDataset(dataset);
+
+    {
+        QMutexLocker locker(&loadMutex_);
+        loading_ &= ~Datasets(dataset);
+    }
+    loadFinished_.wakeAll();
+    return ok;
+}
+
+bool SkillMatrixStore::loadDataset(Dataset dataset)
+{
+    // Query outside the lock so readers of other datasets are not blocked. An
+    // invalidation while the query runs bumps the generation; the result is
+    // then discarded rather than marked loaded.
+    QString error;
+    quint64 generation;
+    {
+        QReadLocker locker(&lock_);
+        generation = generations_.value(dataset);
+    }
+
+    // Take the change-tracking mark before reading, so rows written during the
+    // load are fetched again by the next sync rather than missed
+    qint64 version = -1;
+    if (dataset != Hierarchy && dataset != CoreSkills) {
+        version = ChangeTracking::currentVersion(DatabaseManager::instance().database());
+    }
+
+    switch (dataset) {
+        case Engineers: {
+            EngineerRepository repo;
+            QList<Engineer> engineers = repo.findAll();
+            error = repo.lastError();
+            QWriteLocker locker(&lock_);
+            if (generations_.value(dataset) == generation) {
+                engineers_.reset(engineers);
+            }
+            break;
+        }
+        case Hierarchy: {
+            ProductionRepository repo;
+            ProductionHierarchy hierarchy = repo.loadHierarchy();
+            error = repo.lastError();
+            QWriteLocker locker(&lock_);
+            if (generations_.value(dataset) == generation) {
+                hierarchy_ = hierarchy;
+            }
+            break;
+        }
+        case Assessments: {
+            AssessmentRepository repo;
+            QList<Assessment> assessments = repo.findAll();
+            error = repo.lastError();
+            QWriteLocker locker(&lock_);
+            if (generations_.value(dataset) == generation) {
+                assessments_.reset(assessments);
+            }
+            break;
+        }
+        case CoreSkills: {
+            CoreSkillsRepository repo;
+            QList<CoreSkillCategory> categories = repo.findAllCategories();
+            QList<CoreSkill> skills = repo.findAllSkills();
+            error = repo.lastError();
+            QWriteLocker locker(&lock_);
+            if (generations_.value(dataset) == generation) {
+                categories_.reset(categories);
+                skills_.reset(skills);
+            }
+            break;
+        }
+        case CoreSkillAssessments: {
+            CoreSkillsRepository repo;
+            QList<CoreSkillAssessment> assessments = repo.findAllAssessments();
+            error = repo.lastError();
+            QWriteLocker locker(&lock_);
+            if (generations_.value(dataset) == generation) {
+                coreSkillAssessments_.reset(assessments);
+            }
+            break;
+        }
+        case Certifications: {
+            CertificationRepository repo;
+            QList<Certification> certifications = repo.findAll();
+            error = repo.lastError();
+            QWriteLocker locker(&lock_);
+            if (generations_.value(dataset) == generation) {
+                certifications_.reset(certifications);
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+
+    // A failed load is served empty but retried on the next read
+    QWriteLocker locker(&lock_);
+    if (generations_.value(dataset) != generation) {
+        LOG_DEBUG("SkillMatrixStore", QString("Dataset 0x%1 changed while loading; left for the next read")
+            .arg(int(dataset), 0, 16));
+        return error.isEmpty();
+    }
+    if (error.isEmpty()) {
+        loaded_ |= dataset;
+        versions_.insert(dataset, version);
+    } else {
+        loaded_ &= ~Datasets(dataset);
+        Logger::instance().warning("SkillMatrixStore", QString("Loading dataset 0x%1 failed: %2")
+            .arg(int(dataset), 0, 16).arg(error));
+    }
+
+    return error.isEmpty();
+}
+
+void SkillMatrixStore::dropLoaded(Datasets datasets)
+{
+    loaded_ &= ~datasets;
+    const Dataset all[] = { Engineers, Hierarchy, Assessments, CoreSkills, CoreSkillAssessments, Certifications };
+    for (Dataset dataset : all) {
+        if (datasets.testFlag(dataset)) {
+            generations_[dataset]++;
+        }
+    }
+}
+
+// ============================================================================
+// Write-through
+// ============================================================================
+
+void SkillMatrixStore::engineerSaved(const Engineer& engineer)
+{
+    {
+        QWriteLocker locker(&lock_);
+        if (loaded_.testFlag(Engineers)) {
+            engineers_.upsert(engineer);
+        } else {
+            dropLoaded(Engineers);  // a load in flight may have read before this write
+        }
+    }
+
+    emit engineersChanged();
+}
+
+void SkillMatrixStore::engineersSaved(const QList<Engineer>& engineers)
+{
+    if (engineers.isEmpty()) {
+        return;
+    }
+
+    {
+        QWriteLocker locker(&lock_);
+        if (loaded_.testFlag(Engineers)) {
+            for (const Engineer& engineer : engineers) {
+                engineers_.upsert(engineer);
+            }
+        } else {
+            dropLoaded(Engineers);
+        }
+    }
+
+    emit engineersChanged();
+}
+
+void SkillMatrixStore::engineerRemoved(const QString& engineerId)
+{
+    // Assessments and certifications are deleted with the engineer (ON DELETE CASCADE)
+    {
+        QWriteLocker locker(&lock_);
+        Datasets unloaded = Engineers | Assessments | CoreSkillAssessments | Certifications;
+        unloaded &= ~loaded_;
+        dropLoaded(unloaded);   // discard loads in flight that read the removed rows
+        engineers_.remove(engineerId);
+        assessments_.removeGroup(engineerId);
+        coreSkillAssessments_.removeGroup(engineerId);
+        certifications_.removeGroup(engineerId);
+    }
+
+    emit engineersChanged();
+    emit assessmentsChanged({engineerId});
+    emit coreSkillAssessmentsChanged({engineerId});
+    emit certificationsChanged(engineerId);
+}
+
+void SkillMatrixStore::assessmentsSaved(const QList<Assessment>& assessments)
+{
+    if (assessments.isEmpty()) {
+        return;
+    }
+
+    QSet<QString> engineerIds;
+    {
+        QWriteLocker locker(&lock_);
+        for (const Assessment& assessment : assessments) {
+            engineerIds.insert(assessment.engineerId());
+
+            // Without a database id the row cannot be placed; reload on next read.
+            // Unloaded, a load in flight may have read before this write: discard it.
+            if (assessment.id() <= 0 || !loaded_.testFlag(Assessments)) {
+                dropLoaded(Assessments);
+            } else {
+                assessments_.upsert(assessment);
+            }
+        }
+    }
+
+    emit assessmentsChanged(engineerIds.values());
+}
+
+void SkillMatrixStore::assessmentRemoved(int assessmentId)
+{
+    QString engineerId;
+    {
+        QWriteLocker locker(&lock_);
+        if (!loaded_.testFlag(Assessments)) {
+            dropLoaded(Assessments);
+        }
+        engineerId = assessments_.value(assessmentId).engineerId();
+        assessments_.remove(assessmentId);
+    }
+
+    emit assessmentsChanged(engineerId.isEmpty() ? QStringList() : QStringList{engineerId});
+}
+
+void SkillMatrixStore::coreSkillAssessmentsSaved(const QList<CoreSkillAssessment>& assessments)
+{
+    if (assessments.isEmpty()) {
+        return;
+    }
+
+    QSet<QString> engineerIds;
+    {
+        QWriteLocker locker(&lock_);
+        for (const CoreSkillAssessment& assessment : assessments) {
+            engineerIds.insert(assessment.engineerId());
+
+            if (assessment.id() <= 0 || !loaded_.testFlag(CoreSkillAssessments)) {
+                dropLoaded(CoreSkillAssessments);
+            } else {
+                coreSkillAssessments_.upsert(assessment);
+            }
+        }
+    }
+
+    emit coreSkillAssessmentsChanged(engineerIds.values());
+}
+
+void SkillMatrixStore::coreSkillCatalogChanged()
+{
+    // Catalog edits are rare and may cascade (category -> skills), so reload lazily
+    {
+        QWriteLocker locker(&lock_);
+        dropLoaded(CoreSkills);
+    }
+
+    emit coreSkillCatalogUpdated();
+}
+
+void SkillMatrixStore::certificationSaved(const Certification& certification)
+{
+    {
+        QWriteLocker locker(&lock_);
+        if (certification.id() <= 0 || !loaded_.testFlag(Certifications)) {
+            dropLoaded(Certifications);
+        } else {
+            certifications_.upsert(certification);
+        }
+    }
+
+    emit certificationsChanged(certification.engineerId());
+}
+
+void SkillMatrixStore::certificationRemoved(int certificationId)
+{
+    QString engineerId;
+    {
+        QWriteLocker locker(&lock_);
+        if (!loaded_.testFlag(Certifications)) {
+            dropLoaded(Certifications);
+        }
+        engineerId = certifications_.value(certificationId).engineerId();
+        certifications_.remove(certificationId);
+    }
+
+    emit certificationsChanged(engineerId);
+}
+
+void SkillMatrixStore::hierarchyModified(bool removed)
+{
+    {
+        QWriteLocker locker(&lock_);
+        dropLoaded(Hierarchy);
+        if (removed) {
+            dropLoaded(Assessments);
+        }
+    }
+
+    emit hierarchyChanged();
+    if (removed) {
+        emit datasetsReloaded(Assessments);
+    }
+}
@@ -0,0 +1,318 @@
+#ifndef SKILLMATRIXSTORE_H
+#define SKILLMATRIXSTORE_H
+
+#include "../models/Engineer.h"
+#include "../models/Assessment.h"
+#include "../models/CoreSkillCategory.h"
+#include "../models/CoreSkill.h"
+#include "../models/CoreSkillAssessment.h"
+#include "../models/Certification.h"
+#include "../models/ProductionHierarchy.h"
+#include "../models/ScoreMatrix.h"
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <QSet>
+#include <QReadWriteLock>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInteger>
+#include <algorithm>
+
+/**
+ * @brief Implicitly shared, id-indexed list of model objects
+ *
+ * Copies are cheap (Qt implicit sharing) and a copy handed out by the store never
+ * changes afterwards; the store detaches its own copy when applying a write.
+ * Optionally grouped by engineer for per-engineer lookups.
+ */
+template <typename T, typename Key>
+class IndexedSnapshot
+{
+public:
+    using GroupKey = QString (T::*)() const;
+
+    explicit IndexedSnapshot(GroupKey groupKey = nullptr) : groupKey_(groupKey) {}
+
+    const QList<T>& items() const { return items_; }
+    int size() const { return items_.size(); }
+    bool isEmpty() const { return items_.isEmpty(); }
+
+    bool contains(const Key& id) const { return index_.contains(id); }
+
+    T value(const Key& id) const
+    {
+        auto it = index_.constFind(id);
+        return it != index_.constEnd() ? items_[it.value()] : T();
+    }
+
+    QList<T> group(const QString& groupId) const
+    {
+        QList<T> result;
+        const QList<int> positions = groups_.value(groupId);
+        result.reserve(positions.size());
+        for (int position : positions) {
+            result.append(items_[position]);
+        }
+        return result;
+    }
+
+    int groupSize(const QString& groupId) const { return groups_.value(groupId).size(); }
+
+    void reset(const QList<T>& items)
+    {
+        items_ = items;
+        reindex();
+    }
+
+    void upsert(const T& item)
+    {
+        auto it = index_.constFind(item.id());
+        if (it == index_.constEnd()) {
+            int position = items_.size();
+            items_.append(item);
+            index_.insert(item.id(), position);
+            if (groupKey_) {
+                groups_[(item.*groupKey_)()].append(position);
+            }
+            return;
+        }
+
+        int position = it.value();
+        bool regroup = groupKey_ && (items_[position].*groupKey_)() != (item.*groupKey_)();
+        items_[position] = item;
+        if (regroup) {
+            reindex();
+        }
+    }
+
+    bool remove(const Key& id)
+    {
+        auto it = index_.constFind(id);
+        if (it == index_.constEnd()) {
+            return false;
+        }
+        items_.removeAt(it.value());
+        reindex();
+        return true;
+    }
+
+    int remove(const QList<Key>& ids)
+    {
+        if (ids.isEmpty()) {
+            return 0;
+        }
+        QSet<Key> doomed(ids.begin(), ids.end());
+        int before = items_.size();
+        items_.erase(std::remove_if(items_.begin(), items_.end(),
+                                    [&](const T& item) { return doomed.contains(item.id()); }),
+                     items_.end());
+        if (items_.size() != before) {
+            reindex();
+        }
+        return before - items_.size();
+    }
+
+    int removeGroup(const QString& groupId)
+    {
+        int before = items_.size();
+        items_.erase(std::remove_if(items_.begin(), items_.end(),
+                                    [&](const T& item) { return groupKey_ && (item.*groupKey_)() == groupId; }),
+                     items_.end());
+        if (items_.size() != before) {
+            reindex();
+        }
+        return before - items_.size();
+    }
+
+private:
+    void reindex()
+    {
+        index_.clear();
+        groups_.clear();
+        index_.reserve(items_.size());
+        for (int i = 0; i < items_.size(); ++i) {
+            index_.insert(items_[i].id(), i);
+            if (groupKey_) {
+                groups_[(items_[i].*groupKey_)()].append(i);
+            }
+        }
+    }
+
+private:
+    QList<T> items_;
+    QHash<Key, int> index_;
+    QHash<QString, QList<int>> groups_;
+    GroupKey groupKey_;
+};
+
+using EngineerSnapshot = IndexedSnapshot<Engineer, QString>;           // grouped by shift
+using AssessmentSnapshot = IndexedSnapshot<Assessment, int>;            // grouped by engineer
+using CoreSkillCategorySnapshot = IndexedSnapshot<CoreSkillCategory, QString>;
+using CoreSkillSnapshot = IndexedSnapshot<CoreSkill, QString>;          // grouped by category
+using CoreSkillAssessmentSnapshot = IndexedSnapshot<CoreSkillAssessment, int>; // grouped by engineer
+using CertificationSnapshot = IndexedSnapshot<Certification, int>;      // grouped by engineer
+
+/**
+ * @brief Process-wide in-memory copy of the skill matrix (Singleton)
+ *
+ * Each dataset is loaded from its repository the first time it is read and then
+ * served from memory, so switching views costs no database traffic. Repositories
+ * report successful writes back to the store (write-through), which patches the
+ * affected snapshot in place (or, if it is not loaded yet, discards any load in
+ * flight) and emits a change signal naming what changed.
+ * Readers receive immutable copies and may use them from any thread.
+ */
+class SkillMatrixStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Dataset {
+        Engineers            = 0x01,
+        Hierarchy            = 0x02,
+        Assessments          = 0x04,
+        CoreSkills           = 0x08,   // categories and skills
+        CoreSkillAssessments = 0x10,
+        Certifications       = 0x20,
+        AllDatasets          = 0x3F
+    };
+    Q_DECLARE_FLAGS(Datasets, Dataset)
+    Q_FLAG(Datasets)
+
+    /**
+     * @brief Get singleton instance
+     */
+    static SkillMatrixStore& instance();
+
+    // Readers (load on first use)
+    EngineerSnapshot engineers();
+    ProductionHierarchy hierarchy();
+    AssessmentSnapshot assessments();
+    CoreSkillCategorySnapshot coreSkillCategories();
+    CoreSkillSnapshot coreSkills();
+    CoreSkillAssessmentSnapshot coreSkillAssessments();
+    CertificationSnapshot certifications();
+
+    /**
+     * @brief Dense engineer x competency scores (rows follow engineers(), columns hierarchy().competencies())
+     *
+     * Built on first use from the cached snapshots and kept until engineers,
+     * the hierarchy or assessments change.
+     */
+    CompetencyScoreMatrix competencyScores();
+
+    /**
+     * @brief Dense engineer x core skill scores (rows follow engineers(), columns coreSkills())
+     */
+    CoreSkillScoreMatrix coreSkillScores();
+
+    /**
+     * @brief Drop cached datasets so the next read reloads them
+     * @param datasets Datasets to drop
+     */
+    void invalidate(Datasets datasets = AllDatasets);
+
+    /**
+     * @brief Reload datasets from the database now
+     * @return false if any repository reported an error
+     */
+    bool reload(Datasets datasets = AllDatasets);
+
+    /**
+     * @brief Bring loaded datasets up to date with the database
+     *
+     * Engineers, assessments, core skill assessments and certifications fetch only
+     * rows changed or deleted since the last sync (rowversion high-water mark);
+     * other datasets, or any dataset whose delta query fails (e.g. the change
+     * tracking migration is not installed), are reloaded in full.
+     * Datasets that were never loaded are left to load on first read.
+     * @return false if any repository reported an error
+     */
+    bool sync(Datasets datasets = AllDatasets);
+
+    bool isLoaded(Dataset dataset) const;
+
+    // Write-through notifications from the repositories
+    void engineerSaved(const Engineer& engineer);
+    void engineersSaved(const QList<Engineer>& engineers);
+    void engineerRemoved(const QString& engineerId);
+    void assessmentsSaved(const QList<Assessment>& assessments);
+    void assessmentRemoved(int assessmentId);
+    void coreSkillAssessmentsSaved(const QList<CoreSkillAssessment>& assessments);
+    void coreSkillCatalogChanged();
+    void certificationSaved(const Certification& certification);
+    void certificationRemoved(int certificationId);
+
+    /**
+     * @brief Production areas, machines or competencies were written
+     * @param removed true if rows were deleted (cascades to assessments)
+     */
+    void hierarchyModified(bool removed = false);
+
+signals:
+    void engineersChanged();
+    void hierarchyChanged();
+    void coreSkillCatalogUpdated();
+
+    /**
+     * @brief Emitted after machine assessments of the given engineers changed
+     */
+    void assessmentsChanged(const QStringList& engineerIds);
+
+    /**
+     * @brief Emitted after core skill assessments of the given engineers changed
+     */
+    void coreSkillAssessmentsChanged(const QStringList& engineerIds);
+
+    void certificationsChanged(const QString& engineerId);
+
+    /**
+     * @brief Emitted after datasets were reloaded or invalidated wholesale
+     */
+    void datasetsReloaded(SkillMatrixStore::Datasets datasets);
+
+private:
+    SkillMatrixStore(QObject* parent = nullptr);
+    ~SkillMatrixStore();
+
+    SkillMatrixStore(const SkillMatrixStore&) = delete;
+    SkillMatrixStore& operator=(const SkillMatrixStore&) = delete;
+
+    void ensureLoaded(Dataset dataset);
+    bool loadSingleFlight(Dataset dataset, bool force);
+    bool loadDataset(Dataset dataset);
+    bool syncDataset(Dataset dataset);
+    void dropLoaded(Datasets datasets);  // lock_ held for writing
+
+private:
+    mutable QReadWriteLock lock_;
+    Datasets loaded_;
+    QHash<int, qint64> versions_;   // Dataset -> rowversion high-water mark
+    QHash<int, quint64> generations_;  // Dataset -> bumped on every invalidation
+
+    // Single-flight loading (loadMutex_ is never taken while holding lock_)
+    QMutex loadMutex_;
+    QWaitCondition loadFinished_;
+    Datasets loading_;
+
+    EngineerSnapshot engineers_;
+    ProductionHierarchy hierarchy_;
+    AssessmentSnapshot assessments_;
+    CoreSkillCategorySnapshot categories_;
+    CoreSkillSnapshot skills_;
+    CoreSkillAssessmentSnapshot coreSkillAssessments_;
+    CertificationSnapshot certifications_;
+
+    // Derived score matrices; a bumped generation discards a build that raced a write
+    CompetencyScoreMatrix competencyScores_;
+    CoreSkillScoreMatrix coreSkillScores_;
+    bool competencyScoresValid_;
+    bool coreSkillScoresValid_;
+    QAtomicInteger<quint32> competencyScoresGeneration_;
+    QAtomicInteger<quint32> coreSkillScoresGeneration_;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(SkillMatrixStore::Datasets)
+
+#endif // SKILLMATRIXSTORE_H
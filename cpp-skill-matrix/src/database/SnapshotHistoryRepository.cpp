@@ -0,0 +1,175 @@
+#include "SnapshotHistoryRepository.h"
+#include "DatabaseManager.h"
+#include "../utils/Logger.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QVariant>
+
+template <typename Key>
+static double average(const QHash<Key, int>& scores)
+{
+    if (scores.isEmpty()) {
+        return 0.0;
+    }
+
+    double total = 0.0;
+    for (int score : scores) {
+        total += score;
+    }
+    return total / scores.size();
+}
+
+SnapshotHistoryRepository::SnapshotHistoryRepository() : lastError_("") {}
+SnapshotHistoryRepository::~SnapshotHistoryRepository() {}
+
+bool SnapshotHistoryRepository::saveSnapshot(const QString& snapshotId, const QDateTime& timestamp,
+                                             const SnapshotCodec::SnapshotState& state)
+{
+    lastError_.clear();
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("SnapshotHistoryRepository", lastError_);
+        return false;
+    }
+
+    QSqlQuery clear(db);
+    clear.prepare("DELETE FROM snapshot_engineer_history WHERE snapshot_id = ?");
+    clear.addBindValue(snapshotId);
+    if (!clear.exec()) {
+        lastError_ = clear.lastError().text();
+        Logger::instance().error("SnapshotHistoryRepository", "saveSnapshot failed: " + lastError_);
+        return false;
+    }
+
+    // One batch for the whole plant; each row's scores are a one-engineer checkpoint
+    if (!state.isEmpty()) {
+        QVariantList engineerIds, snapshotIds, timestamps, scores;
+        QVariantList competencyCounts, competencyAverages, coreSkillCounts, coreSkillAverages;
+        for (auto it = state.constBegin(); it != state.constEnd(); ++it) {
+            SnapshotCodec::SnapshotState single;
+            single.insert(it.key(), it.value());
+
+            engineerIds << it.key();
+            snapshotIds << snapshotId;
+            timestamps << timestamp;
+            competencyCounts << it.value().competencies.size();
+            competencyAverages << average(it.value().competencies);
+            coreSkillCounts << it.value().coreSkills.size();
+            coreSkillAverages << average(it.value().coreSkills);
+            scores << SnapshotCodec::encodeState(single, SnapshotCodec::Checkpoint);
+        }
+
+        QSqlQuery insert(db);
+        insert.prepare("INSERT INTO snapshot_engineer_history (engineer_id, snapshot_id, timestamp, "
+                       "competency_count, competency_avg, core_skill_count, core_skill_avg, scores) "
+                       "VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+        insert.addBindValue(engineerIds);
+        insert.addBindValue(snapshotIds);
+        insert.addBindValue(timestamps);
+        insert.addBindValue(competencyCounts);
+        insert.addBindValue(competencyAverages);
+        insert.addBindValue(coreSkillCounts);
+        insert.addBindValue(coreSkillAverages);
+        insert.addBindValue(scores);
+
+        if (!insert.execBatch()) {
+            lastError_ = insert.lastError().text();
+            Logger::instance().error("SnapshotHistoryRepository", "saveSnapshot failed: " + lastError_);
+            return false;
+        }
+    }
+
+    QSqlQuery mark(db);
+    mark.prepare("UPDATE snapshots SET history_indexed = 1 WHERE id = ?");
+    mark.addBindValue(snapshotId);
+    if (!mark.exec()) {
+        lastError_ = mark.lastError().text();
+        Logger::instance().error("SnapshotHistoryRepository", "saveSnapshot failed: " + lastError_);
+        return false;
+    }
+
+    LOG_DEBUG("SnapshotHistoryRepository",
+        QString("Indexed snapshot %1: %2 engineers").arg(snapshotId).arg(state.size()));
+    return true;
+}
+
+QList<SnapshotHistoryPoint> SnapshotHistoryRepository::findByEngineer(const QString& engineerId, int limit)
+{
+    lastError_.clear();
+    QList<SnapshotHistoryPoint> points;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("SnapshotHistoryRepository", lastError_);
+        return points;
+    }
+
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT TOP (?) h.snapshot_id, s.description, h.timestamp, h.competency_count, h.competency_avg, "
+        "h.core_skill_count, h.core_skill_avg "
+        "FROM snapshot_engineer_history h INNER JOIN snapshots s ON s.id = h.snapshot_id "
+        "WHERE h.engineer_id = ? ORDER BY h.timestamp DESC");
+    QSqlQuery& query = statement.query();
+    query.addBindValue(limit);
+    query.addBindValue(engineerId);
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("SnapshotHistoryRepository", "findByEngineer failed: " + lastError_);
+        return points;
+    }
+
+    while (query.next()) {
+        SnapshotHistoryPoint point;
+        point.snapshotId = query.value(0).toString();
+        point.description = query.value(1).toString();
+        point.timestamp = query.value(2).toDateTime();
+        point.competencyCount = query.value(3).toInt();
+        point.competencyAverage = query.value(4).toDouble();
+        point.coreSkillCount = query.value(5).toInt();
+        point.coreSkillAverage = query.value(6).toDouble();
+        points.append(point);
+    }
+
+    return points;
+}
+
+SnapshotCodec::EngineerScores SnapshotHistoryRepository::findScores(const QString& snapshotId,
+                                                                    const QString& engineerId, bool* found)
+{
+    lastError_.clear();
+    if (found) {
+        *found = false;
+    }
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("SnapshotHistoryRepository", lastError_);
+        return SnapshotCodec::EngineerScores();
+    }
+
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT scores FROM snapshot_engineer_history WHERE engineer_id = ? AND snapshot_id = ?");
+    QSqlQuery& query = statement.query();
+    query.addBindValue(engineerId);
+    query.addBindValue(snapshotId);
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("SnapshotHistoryRepository", "findScores failed: " + lastError_);
+        return SnapshotCodec::EngineerScores();
+    }
+
+    if (!query.next()) {
+        return SnapshotCodec::EngineerScores();
+    }
+
+    if (found) {
+        *found = true;
+    }
+    return SnapshotReader(query.value(0).toByteArray()).engineer(engineerId);
+}
@@ -0,0 +1,58 @@
+#ifndef SNAPSHOTHISTORYREPOSITORY_H
+#define SNAPSHOTHISTORYREPOSITORY_H
+
+#include "../models/SnapshotCodec.h"
+#include <QList>
+#include <QString>
+#include <QDateTime>
+
+/**
+ * @brief One engineer's averages in one snapshot
+ */
+struct SnapshotHistoryPoint
+{
+    QString snapshotId;
+    QString description;
+    QDateTime timestamp;
+    int competencyCount = 0;
+    double competencyAverage = 0.0;
+    int coreSkillCount = 0;
+    double coreSkillAverage = 0.0;
+};
+
+/**
+ * @brief Per-engineer time series of snapshot scores (snapshot_engineer_history)
+ *
+ * Rows are written once per snapshot from its materialised state and removed
+ * with the snapshot (ON DELETE CASCADE).
+ */
+class SnapshotHistoryRepository
+{
+public:
+    SnapshotHistoryRepository();
+    ~SnapshotHistoryRepository();
+
+    /**
+     * @brief Write a snapshot's rows, replacing any already written, and mark it indexed
+     */
+    bool saveSnapshot(const QString& snapshotId, const QDateTime& timestamp,
+                      const SnapshotCodec::SnapshotState& state);
+
+    /**
+     * @brief An engineer's most recent points, newest first
+     */
+    QList<SnapshotHistoryPoint> findByEngineer(const QString& engineerId, int limit = 50);
+
+    /**
+     * @brief An engineer's full scores in one snapshot
+     * @param found Set to whether the snapshot has a row for the engineer
+     */
+    SnapshotCodec::EngineerScores findScores(const QString& snapshotId, const QString& engineerId, bool* found = nullptr);
+
+    QString lastError() const { return lastError_; }
+
+private:
+    QString lastError_;
+};
+
+#endif // SNAPSHOTHISTORYREPOSITORY_H
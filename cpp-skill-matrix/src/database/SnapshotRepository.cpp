@@ -1,15 +1,21 @@
 #include "SnapshotRepository.h"
 #include "DatabaseManager.h"
+#include "../core/Constants.h"
 #include "../utils/Logger.h"
 #include "../utils/Crypto.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
 
+// Column list shared by every snapshot read; %1 is the payload column or a NULL placeholder
+static const char* SNAPSHOT_COLUMNS = "id, description, timestamp, created_at, checkpoint_id, source, %1";
+static const char* WITH_PAYLOAD = "payload";
+static const char* WITHOUT_PAYLOAD = "CAST(NULL AS VARBINARY(1))";
+
 SnapshotRepository::SnapshotRepository() : lastError_("") {}
 SnapshotRepository::~SnapshotRepository() {}
 
-QList<Snapshot> SnapshotRepository::findAll(int limit)
+QList<Snapshot> SnapshotRepository::readSnapshots(const QString& sql, const QVariantList& values, const char* operation)
 {
     lastError_.clear();
     QList<Snapshot> snapshots;
@@ -22,13 +28,15 @@ QList<Snapshot> SnapshotRepository::findAll(int limit)
     }
 
     QSqlQuery query(db);
-    query.prepare("SELECT TOP (?) id, description, timestamp, data, created_at "
-                  "FROM snapshots ORDER BY timestamp DESC");
-    query.addBindValue(limit);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    for (const QVariant& value : values) {
+        query.addBindValue(value);
+    }
 
     if (!query.exec()) {
         lastError_ = query.lastError().text();
-        Logger::instance().error("SnapshotRepository", "findAll failed: " + lastError_);
+        Logger::instance().error("SnapshotRepository", QString("%1 failed: %2").arg(operation).arg(lastError_));
         return snapshots;
     }
 
@@ -37,16 +45,75 @@ QList<Snapshot> SnapshotRepository::findAll(int limit)
         snapshot.setId(query.value(0).toString());
         snapshot.setDescription(query.value(1).toString());
         snapshot.setTimestamp(query.value(2).toDateTime());
-        snapshot.setData(query.value(3).toString());
-        snapshot.setCreatedAt(query.value(4).toDateTime());
+        snapshot.setCreatedAt(query.value(3).toDateTime());
+        snapshot.setCheckpointId(query.value(4).toString());
+        snapshot.setSource(query.value(5).toString());
+        snapshot.setPayload(query.value(6).toByteArray());
         snapshots.append(snapshot);
     }
 
-    Logger::instance().debug("SnapshotRepository", QString("Found %1 snapshots").arg(snapshots.size()));
+    LOG_DEBUG("SnapshotRepository", QString("%1: %2 snapshots").arg(operation).arg(snapshots.size()));
     return snapshots;
 }
 
+QList<Snapshot> SnapshotRepository::findAll(int limit, bool includePayload)
+{
+    QString columns = QString(SNAPSHOT_COLUMNS).arg(includePayload ? WITH_PAYLOAD : WITHOUT_PAYLOAD);
+    return readSnapshots(QString("SELECT TOP (?) %1 FROM snapshots ORDER BY timestamp DESC").arg(columns),
+                         {limit}, "findAll");
+}
+
 Snapshot SnapshotRepository::findById(const QString& id)
+{
+    QString columns = QString(SNAPSHOT_COLUMNS).arg(WITH_PAYLOAD);
+    QList<Snapshot> snapshots = readSnapshots(QString("SELECT %1 FROM snapshots WHERE id = ?").arg(columns),
+                                              {id}, "findById");
+    return snapshots.isEmpty() ? Snapshot() : snapshots.first();
+}
+
+Snapshot SnapshotRepository::findLatest(const QString& source)
+{
+    QString columns = QString(SNAPSHOT_COLUMNS).arg(WITH_PAYLOAD);
+    QList<Snapshot> snapshots;
+    if (source.isEmpty()) {
+        snapshots = readSnapshots(QString("SELECT TOP (1) %1 FROM snapshots ORDER BY timestamp DESC").arg(columns),
+                                  {}, "findLatest");
+    } else {
+        snapshots = readSnapshots(QString("SELECT TOP (1) %1 FROM snapshots WHERE source = ? "
+                                          "ORDER BY timestamp DESC").arg(columns),
+                                  {source}, "findLatest");
+    }
+    return snapshots.isEmpty() ? Snapshot() : snapshots.first();
+}
+
+QList<Snapshot> SnapshotRepository::findChain(const QString& checkpointId, const QDateTime& upTo)
+{
+    QString columns = QString(SNAPSHOT_COLUMNS).arg(WITH_PAYLOAD);
+    return readSnapshots(QString("SELECT %1 FROM snapshots "
+                                 "WHERE (id = ? OR checkpoint_id = ?) AND timestamp <= ? "
+                                 "ORDER BY CASE WHEN checkpoint_id IS NULL THEN 0 ELSE 1 END, timestamp").arg(columns),
+                         {checkpointId, checkpointId, upTo}, "findChain");
+}
+
+Snapshot SnapshotRepository::findNextInChain(const Snapshot& snapshot)
+{
+    QString columns = QString(SNAPSHOT_COLUMNS).arg(WITH_PAYLOAD);
+    QList<Snapshot> snapshots = readSnapshots(QString("SELECT TOP (1) %1 FROM snapshots "
+                                                      "WHERE checkpoint_id = ? AND timestamp > ? "
+                                                      "ORDER BY timestamp").arg(columns),
+                                              {snapshot.chainId(), snapshot.timestamp()}, "findNextInChain");
+    return snapshots.isEmpty() ? Snapshot() : snapshots.first();
+}
+
+QList<Snapshot> SnapshotRepository::findUnindexed(int limit)
+{
+    QString columns = QString(SNAPSHOT_COLUMNS).arg(WITHOUT_PAYLOAD);
+    return readSnapshots(QString("SELECT TOP (?) %1 FROM snapshots WHERE history_indexed = 0 "
+                                 "ORDER BY timestamp").arg(columns),
+                         {limit}, "findUnindexed");
+}
+
+int SnapshotRepository::countDeltas(const QString& checkpointId)
 {
     lastError_.clear();
     QSqlDatabase& db = DatabaseManager::instance().database();
@@ -54,34 +121,20 @@ Snapshot SnapshotRepository::findById(const QString& id)
     if (!db.isOpen()) {
         lastError_ = "Database not connected";
         Logger::instance().error("SnapshotRepository", lastError_);
-        return Snapshot();
+        return -1;
     }
 
     QSqlQuery query(db);
-    query.prepare("SELECT id, description, timestamp, data, created_at "
-                  "FROM snapshots WHERE id = ?");
-    query.addBindValue(id);
+    query.prepare("SELECT COUNT(*) FROM snapshots WHERE checkpoint_id = ?");
+    query.addBindValue(checkpointId);
 
-    if (!query.exec()) {
+    if (!query.exec() || !query.next()) {
         lastError_ = query.lastError().text();
-        Logger::instance().error("SnapshotRepository", "findById failed: " + lastError_);
-        return Snapshot();
-    }
-
-    if (query.next()) {
-        Snapshot snapshot;
-        snapshot.setId(query.value(0).toString());
-        snapshot.setDescription(query.value(1).toString());
-        snapshot.setTimestamp(query.value(2).toDateTime());
-        snapshot.setData(query.value(3).toString());
-        snapshot.setCreatedAt(query.value(4).toDateTime());
-
-        Logger::instance().debug("SnapshotRepository", "Found snapshot: " + id);
-        return snapshot;
+        Logger::instance().error("SnapshotRepository", "countDeltas failed: " + lastError_);
+        return -1;
     }
 
-    Logger::instance().debug("SnapshotRepository", "Snapshot not found: " + id);
-    return Snapshot();
+    return query.value(0).toInt();
 }
 
 bool SnapshotRepository::save(Snapshot& snapshot)
@@ -106,12 +159,15 @@ bool SnapshotRepository::save(Snapshot& snapshot)
     }
 
     QSqlQuery query(db);
-    query.prepare("INSERT INTO snapshots (id, description, timestamp, data, created_at) "
-                  "VALUES (?, ?, ?, ?, GETDATE())");
+    query.prepare("INSERT INTO snapshots (id, description, timestamp, data, payload, checkpoint_id, source, created_at) "
+                  "VALUES (?, ?, ?, ?, ?, ?, ?, GETDATE())");
     query.addBindValue(snapshot.id());
     query.addBindValue(snapshot.description().isEmpty() ? QVariant() : snapshot.description());
     query.addBindValue(snapshot.timestamp());
-    query.addBindValue(snapshot.data());
+    query.addBindValue(snapshot.data().isEmpty() ? QVariant() : snapshot.data());
+    query.addBindValue(snapshot.payload().isEmpty() ? QVariant(QMetaType(QMetaType::QByteArray)) : snapshot.payload());
+    query.addBindValue(snapshot.isCheckpoint() ? QVariant(QMetaType(QMetaType::QString)) : snapshot.checkpointId());
+    query.addBindValue(snapshot.source().isEmpty() ? QString(Constants::SNAPSHOT_SOURCE_MANUAL) : snapshot.source());
 
     if (!query.exec()) {
         lastError_ = query.lastError().text();
@@ -119,7 +175,63 @@ bool SnapshotRepository::save(Snapshot& snapshot)
         return false;
     }
 
-    Logger::instance().info("SnapshotRepository", "Snapshot saved: " + snapshot.description());
+    LOG_INFO("SnapshotRepository",
+        QString("Snapshot saved: %1 (%2, %3 bytes)")
+        .arg(snapshot.description())
+        .arg(snapshot.isCheckpoint() ? "checkpoint" : "delta")
+        .arg(snapshot.payload().size()));
+    return true;
+}
+
+bool SnapshotRepository::updateChainLink(const Snapshot& snapshot)
+{
+    lastError_.clear();
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("SnapshotRepository", lastError_);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("UPDATE snapshots SET payload = ?, checkpoint_id = ? WHERE id = ?");
+    query.addBindValue(snapshot.payload());
+    query.addBindValue(snapshot.isCheckpoint() ? QVariant(QMetaType(QMetaType::QString)) : snapshot.checkpointId());
+    query.addBindValue(snapshot.id());
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("SnapshotRepository", "updateChainLink failed: " + lastError_);
+        return false;
+    }
+
+    return true;
+}
+
+bool SnapshotRepository::reassignCheckpoint(const QString& fromCheckpointId, const QString& toCheckpointId)
+{
+    lastError_.clear();
+    QSqlDatabase& db = DatabaseManager::instance().database();
+
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("SnapshotRepository", lastError_);
+        return false;
+    }
+
+    QSqlQuery query(db);
+    query.prepare("UPDATE snapshots SET checkpoint_id = ? WHERE checkpoint_id = ? AND id <> ?");
+    query.addBindValue(toCheckpointId);
+    query.addBindValue(fromCheckpointId);
+    query.addBindValue(toCheckpointId);
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("SnapshotRepository", "reassignCheckpoint failed: " + lastError_);
+        return false;
+    }
+
     return true;
 }
 
@@ -144,6 +256,6 @@ bool SnapshotRepository::remove(const QString& id)
         return false;
     }
 
-    Logger::instance().info("SnapshotRepository", "Snapshot removed: " + id);
+    LOG_INFO("SnapshotRepository", "Snapshot removed: " + id);
     return true;
 }
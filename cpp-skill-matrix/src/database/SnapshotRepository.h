@@ -3,6 +3,8 @@
 
 #include "../models/Snapshot.h"
 #include <QList>
+#include <QDateTime>
+#include <QVariant>
 
 class SnapshotRepository
 {
@@ -10,13 +12,58 @@ public:
     SnapshotRepository();
     ~SnapshotRepository();
 
-    QList<Snapshot> findAll(int limit = 50);
+    /**
+     * @brief Newest snapshots first
+     * @param limit Maximum number of snapshots
+     * @param includePayload Also fetch the encoded payloads (lists do not need them)
+     */
+    QList<Snapshot> findAll(int limit = 50, bool includePayload = false);
     Snapshot findById(const QString& id);
+
+    /**
+     * @brief Most recent snapshot, optionally of one source only (with payload)
+     */
+    Snapshot findLatest(const QString& source = QString());
+
+    /**
+     * @brief A chain's checkpoint and its deltas up to a point in time, oldest first (with payloads)
+     */
+    QList<Snapshot> findChain(const QString& checkpointId, const QDateTime& upTo);
+
+    /**
+     * @brief The snapshot that follows one in its chain (with payload), or an invalid snapshot
+     */
+    Snapshot findNextInChain(const Snapshot& snapshot);
+
+    /**
+     * @brief Snapshots not yet in the per-engineer history, oldest first (without payloads)
+     */
+    QList<Snapshot> findUnindexed(int limit);
+
+    /**
+     * @brief Number of delta snapshots in a chain
+     */
+    int countDeltas(const QString& checkpointId);
+
     bool save(Snapshot& snapshot);
+
+    /**
+     * @brief Rewrite a snapshot's payload and chain link (used when folding chains)
+     */
+    bool updateChainLink(const Snapshot& snapshot);
+
+    /**
+     * @brief Move the deltas of one checkpoint onto another
+     */
+    bool reassignCheckpoint(const QString& fromCheckpointId, const QString& toCheckpointId);
+
     bool remove(const QString& id);
 
     QString lastError() const { return lastError_; }
 
+private:
+    QList<Snapshot> readSnapshots(const QString& sql, const QVariantList& values, const char* operation);
+
 private:
     QString lastError_;
 };
@@ -0,0 +1,167 @@
+#include "StatementCache.h"
+#include "../utils/Logger.h"
+#include <QSqlError>
+
+QAtomicInteger<quint64> StatementCache::hits_(0);
+QAtomicInteger<quint64> StatementCache::misses_(0);
+
+// ============================================================================
+// CachedQuery
+// ============================================================================
+
+CachedQuery::CachedQuery(StatementCache* cache, QSqlQuery* query, QSqlQuery* owned, bool prepared)
+    : cache_(cache)
+    , query_(query)
+    , owned_(owned)
+    , prepared_(prepared)
+{
+}
+
+CachedQuery::CachedQuery(CachedQuery&& other) noexcept
+    : cache_(other.cache_)
+    , query_(other.query_)
+    , owned_(other.owned_)
+    , prepared_(other.prepared_)
+{
+    other.cache_ = nullptr;
+    other.query_ = nullptr;
+    other.owned_ = nullptr;
+}
+
+CachedQuery::~CachedQuery()
+{
+    if (cache_) {
+        cache_->release(query_);
+    }
+    delete owned_;
+}
+
+bool CachedQuery::exec()
+{
+    if (!prepared_) {
+        return false;
+    }
+    return query_->exec();
+}
+
+// ============================================================================
+// StatementCache
+// ============================================================================
+
+StatementCache::StatementCache(int capacity)
+    : capacity_(qMax(1, capacity))
+    , clock_(0)
+{
+}
+
+StatementCache::~StatementCache()
+{
+    clear();
+}
+
+CachedQuery StatementCache::acquire(const QSqlDatabase& db, const QString& sql)
+{
+    auto it = entries_.find(sql);
+    if (it != entries_.end()) {
+        if (!it->inUse) {
+            hits_.fetchAndAddRelaxed(1);
+            it->inUse = true;
+            it->lastUsed = ++clock_;
+            return CachedQuery(this, it->query, nullptr, true);
+        }
+        // Same statement still being read further up the stack
+        return uncached(db, sql);
+    }
+
+    misses_.fetchAndAddRelaxed(1);
+
+    QSqlQuery* query = new QSqlQuery(db);
+    query->setForwardOnly(true);
+    bool prepared = query->prepare(sql);
+
+    // Failed statements are not cached; the lease owns them so the caller sees the error
+    if (!prepared || (entries_.size() >= capacity_ && !evictOne())) {
+        if (!prepared) {
+            Logger::instance().warning("StatementCache", "Prepare failed: " + query->lastError().text());
+        }
+        return CachedQuery(nullptr, query, query, prepared);
+    }
+
+    Entry entry;
+    entry.query = query;
+    entry.inUse = true;
+    entry.lastUsed = ++clock_;
+    entries_.insert(sql, entry);
+    sqlByQuery_.insert(query, sql);
+    return CachedQuery(this, query, nullptr, true);
+}
+
+CachedQuery StatementCache::uncached(const QSqlDatabase& db, const QString& sql)
+{
+    misses_.fetchAndAddRelaxed(1);
+    QSqlQuery* query = new QSqlQuery(db);
+    query->setForwardOnly(true);
+    bool prepared = query->prepare(sql);
+    return CachedQuery(nullptr, query, query, prepared);
+}
+
+void StatementCache::release(QSqlQuery* query)
+{
+    // Close the cursor but keep the prepared handle; the statement is idle again
+    query->finish();
+
+    auto sql = sqlByQuery_.constFind(query);
+    if (sql == sqlByQuery_.constEnd()) {
+        delete query;   // dropped by clear() while leased
+        return;
+    }
+    entries_[*sql].inUse = false;
+}
+
+bool StatementCache::evictOne()
+{
+    auto victim = entries_.end();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->inUse) {
+            continue;
+        }
+        if (victim == entries_.end() || it->lastUsed < victim->lastUsed) {
+            victim = it;
+        }
+    }
+
+    if (victim == entries_.end()) {
+        return false;
+    }
+
+    sqlByQuery_.remove(victim->query);
+    delete victim->query;
+    entries_.erase(victim);
+    return true;
+}
+
+void StatementCache::clear()
+{
+    for (const Entry& entry : entries_) {
+        if (!entry.inUse) {
+            delete entry.query;
+        }
+        // Leased statements are deleted when their lease ends (see release())
+    }
+    entries_.clear();
+    sqlByQuery_.clear();
+}
+
+StatementCache::Statistics StatementCache::statistics()
+{
+    Statistics stats;
+    stats.hits = hits_.loadRelaxed();
+    stats.misses = misses_.loadRelaxed();
+    return stats;
+}
+
+void StatementCache::resetStatistics()
+{
+    hits_.storeRelaxed(0);
+    misses_.storeRelaxed(0);
+}
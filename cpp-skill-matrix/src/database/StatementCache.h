@@ -0,0 +1,123 @@
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <QString>
+#include <QHash>
+#include <QSqlQuery>
+#include <QSqlDatabase>
+#include <QAtomicInteger>
+
+class StatementCache;
+
+/**
+ * @brief Lease on a prepared statement from a StatementCache
+ *
+ * Bind values and exec() as with a plain QSqlQuery. On destruction the
+ * statement's cursor is closed (finish()) and it goes back to the cache still
+ * prepared, so the next caller with the same SQL skips the ODBC prepare.
+ * If the statement could not be prepared, exec() fails and the error is in
+ * query().lastError().
+ */
+class CachedQuery
+{
+public:
+    CachedQuery(CachedQuery&& other) noexcept;
+    ~CachedQuery();
+
+    CachedQuery(const CachedQuery&) = delete;
+    CachedQuery& operator=(const CachedQuery&) = delete;
+    CachedQuery& operator=(CachedQuery&&) = delete;
+
+    QSqlQuery& query() { return *query_; }
+    QSqlQuery* operator->() { return query_; }
+
+    bool isPrepared() const { return prepared_; }
+    bool isCached() const { return cache_ != nullptr; }
+
+    /**
+     * @brief Execute with the values bound since the lease was taken
+     */
+    bool exec();
+
+private:
+    friend class StatementCache;
+
+    CachedQuery(StatementCache* cache, QSqlQuery* query, QSqlQuery* owned, bool prepared);
+
+    StatementCache* cache_;     // null for one-off statements
+    QSqlQuery* query_;
+    QSqlQuery* owned_;          // one-off statement owned by the lease
+    bool prepared_;
+};
+
+/**
+ * @brief Prepared statements of one connection, keyed by SQL text
+ *
+ * Every connection (the primary one and each pooled worker connection) owns a
+ * cache; like the connection, it is only used from the connection's thread, so
+ * it needs no locking. A statement already leased out (e.g. a nested call with
+ * the same SQL while the outer result is still being read) is served as an
+ * uncached one-off instead. The least recently used idle statement is dropped
+ * when the cache is full. Hit/miss counters are process-wide.
+ */
+class StatementCache
+{
+public:
+    struct Statistics {
+        quint64 hits = 0;       // reused a prepared statement
+        quint64 misses = 0;     // had to prepare (new SQL, evicted, or already leased)
+        double hitRate() const { return hits + misses > 0 ? double(hits) / double(hits + misses) : 0.0; }
+    };
+
+    explicit StatementCache(int capacity);
+    ~StatementCache();
+
+    StatementCache(const StatementCache&) = delete;
+    StatementCache& operator=(const StatementCache&) = delete;
+
+    /**
+     * @brief Lease the prepared statement for sql on db, preparing it on first use
+     *
+     * Statements are forward-only.
+     */
+    CachedQuery acquire(const QSqlDatabase& db, const QString& sql);
+
+    /**
+     * @brief Lease a one-off statement that bypasses every cache (counted as a miss)
+     */
+    static CachedQuery uncached(const QSqlDatabase& db, const QString& sql);
+
+    /**
+     * @brief Drop every statement (call before the connection closes or reopens)
+     */
+    void clear();
+
+    int size() const { return entries_.size(); }
+    int capacity() const { return capacity_; }
+
+    static Statistics statistics();
+    static void resetStatistics();
+
+private:
+    friend class CachedQuery;
+
+    struct Entry {
+        QSqlQuery* query = nullptr;
+        bool inUse = false;
+        quint64 lastUsed = 0;
+    };
+
+    void release(QSqlQuery* query);
+    bool evictOne();
+
+private:
+    QHash<QString, Entry> entries_;
+    QHash<QSqlQuery*, QString> sqlByQuery_;
+    int capacity_;
+    quint64 clock_;
+
+    static QAtomicInteger<quint64> hits_;
+    static QAtomicInteger<quint64> misses_;
+};
+
+#endif // STATEMENTCACHE_H
@@ -4,6 +4,7 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QVariant>
+#include <QStringList>
 
 UserRepository::UserRepository() : lastError_("") {}
 UserRepository::~UserRepository() {}
@@ -41,10 +42,81 @@ QList<User> UserRepository::findAll()
         users.append(user);
     }
 
-    Logger::instance().debug("UserRepository", QString("Found %1 users").arg(users.size()));
+    LOG_DEBUG("UserRepository", QString("Found %1 users").arg(users.size()));
     return users;
 }
 
+Page<User> UserRepository::findPage(int pageSize, const PageCursor& after, const PageFilter& filter)
+{
+    lastError_.clear();
+    Page<User> page;
+    page.next = after;
+    QSqlDatabase& db = DatabaseManager::instance().database();
+    if (!db.isOpen()) {
+        lastError_ = "Database not connected";
+        Logger::instance().error("UserRepository", lastError_);
+        return page;
+    }
+
+    pageSize = Pagination::boundedPageSize(pageSize);
+
+    QStringList conditions;
+    QVariantList values;
+    if (!filter.role.isEmpty()) {
+        conditions << "role = ?";
+        values << filter.role;
+    }
+    if (!after.isStart()) {
+        // username is unique, so it is the whole key
+        conditions << "username > ?";
+        values << after.sortKey;
+    }
+
+    QString sql = "SELECT TOP (?) id, username, password, role, engineer_id, created_at, updated_at FROM users";
+    if (!conditions.isEmpty()) {
+        sql += " WHERE " + conditions.join(" AND ");
+    }
+    sql += " ORDER BY username";
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    query.addBindValue(pageSize + 1);   // one extra row tells whether another page follows
+    for (const QVariant& value : values) {
+        query.addBindValue(value);
+    }
+
+    if (!query.exec()) {
+        lastError_ = query.lastError().text();
+        Logger::instance().error("UserRepository", "findPage failed: " + lastError_);
+        return page;
+    }
+
+    while (query.next()) {
+        if (page.items.size() == pageSize) {
+            page.hasMore = true;
+            break;
+        }
+        User user;
+        user.setId(query.value(0).toString());
+        user.setUsername(query.value(1).toString());
+        user.setPassword(query.value(2).toString());
+        user.setRole(query.value(3).toString());
+        user.setEngineerId(query.value(4).toString());
+        user.setCreatedAt(query.value(5).toDateTime());
+        user.setUpdatedAt(query.value(6).toDateTime());
+        page.items.append(user);
+    }
+
+    if (!page.items.isEmpty()) {
+        page.next.sortKey = page.items.last().username();
+        page.next.id = page.items.last().id();
+    }
+
+    LOG_DEBUG("UserRepository", QString("Found %1 users (page)").arg(page.items.size()));
+    return page;
+}
+
 User UserRepository::findById(const QString& id)
 {
     lastError_.clear();  // Clear any previous errors
@@ -55,9 +127,10 @@ User UserRepository::findById(const QString& id)
         return User();
     }
 
-    QSqlQuery query(db);
-    query.prepare("SELECT id, username, password, role, engineer_id, created_at, updated_at "
-                  "FROM users WHERE id = ?");
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT id, username, password, role, engineer_id, created_at, updated_at "
+        "FROM users WHERE id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(id);
 
     if (!query.exec()) {
@@ -76,11 +149,11 @@ User UserRepository::findById(const QString& id)
         user.setCreatedAt(query.value(5).toDateTime());
         user.setUpdatedAt(query.value(6).toDateTime());
 
-        Logger::instance().debug("UserRepository", "Found user by ID: " + id);
+        LOG_DEBUG("UserRepository", "Found user by ID: " + id);
         return user;
     }
 
-    Logger::instance().debug("UserRepository", "User not found by ID: " + id);
+    LOG_DEBUG("UserRepository", "User not found by ID: " + id);
     return User();
 }
 
@@ -93,9 +166,10 @@ User UserRepository::findByUsername(const QString& username)
         return User();
     }
 
-    QSqlQuery query(db);
-    query.prepare("SELECT id, username, password, role, engineer_id, created_at, updated_at "
-                  "FROM users WHERE username = ?");
+    CachedQuery statement = DatabaseManager::instance().prepared(
+        "SELECT id, username, password, role, engineer_id, created_at, updated_at "
+        "FROM users WHERE username = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(username);
 
     if (!query.exec()) {
@@ -114,11 +188,11 @@ User UserRepository::findByUsername(const QString& username)
         user.setCreatedAt(query.value(5).toDateTime());
         user.setUpdatedAt(query.value(6).toDateTime());
 
-        Logger::instance().debug("UserRepository", "Found user: " + username);
+        LOG_DEBUG("UserRepository", "Found user: " + username);
         return user;
     }
 
-    Logger::instance().debug("UserRepository", "User not found: " + username);
+    LOG_DEBUG("UserRepository", "User not found: " + username);
     return User();
 }
 
@@ -145,7 +219,7 @@ bool UserRepository::save(User& user)
         return false;
     }
 
-    Logger::instance().info("UserRepository", "User saved: " + user.username());
+    LOG_INFO("UserRepository", "User saved: " + user.username());
     return true;
 }
 
@@ -171,7 +245,7 @@ bool UserRepository::update(const User& user)
         return false;
     }
 
-    Logger::instance().info("UserRepository", "User updated: " + user.username());
+    LOG_INFO("UserRepository", "User updated: " + user.username());
     return true;
 }
 
@@ -193,7 +267,7 @@ bool UserRepository::remove(const QString& id)
         return false;
     }
 
-    Logger::instance().info("UserRepository", "User removed: " + id);
+    LOG_INFO("UserRepository", "User removed: " + id);
     return true;
 }
 
@@ -216,7 +290,7 @@ bool UserRepository::updatePassword(const QString& id, const QString& newPasswor
         return false;
     }
 
-    Logger::instance().info("UserRepository", "Password updated for user: " + id);
+    LOG_INFO("UserRepository", "Password updated for user: " + id);
     return true;
 }
 
@@ -234,6 +308,6 @@ User UserRepository::authenticate(const QString& username, const QString& passwo
         return User();
     }
 
-    Logger::instance().info("UserRepository", "Authentication successful: " + username);
+    LOG_INFO("UserRepository", "Authentication successful: " + username);
     return user;
 }
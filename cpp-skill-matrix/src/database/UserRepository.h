@@ -2,6 +2,7 @@
 #define USERREPOSITORY_H
 
 #include "../models/User.h"
+#include "Pagination.h"
 #include <QList>
 #include <QString>
 
@@ -13,11 +14,23 @@ class QSqlDatabase;
 class UserRepository
 {
 public:
+    struct PageFilter {
+        QString role;   // "admin" / "engineer"; empty = any
+    };
+
     UserRepository();
     ~UserRepository();
 
     // CRUD operations
     QList<User> findAll();
+
+    /**
+     * @brief Up to pageSize users after a cursor, ordered by username
+     *
+     * Keyset pagination backed by IX_users_username / IX_users_role_username.
+     */
+    Page<User> findPage(int pageSize, const PageCursor& after = PageCursor(),
+                        const PageFilter& filter = PageFilter());
     User findById(const QString& id);
     User findByUsername(const QString& username);
     bool save(User& user);
@@ -0,0 +1,119 @@
+#include "ProductionHierarchy.h"
+
+ProductionHierarchy::ProductionHierarchy()
+{
+}
+
+ProductionHierarchy::ProductionHierarchy(const QList<ProductionArea>& areas,
+                                         const QList<Machine>& machines,
+                                         const QList<Competency>& competencies)
+    : areas_(areas)
+    , machines_(machines)
+    , competencies_(competencies)
+{
+    buildIndexes();
+}
+
+ProductionHierarchy::~ProductionHierarchy()
+{
+}
+
+void ProductionHierarchy::buildIndexes()
+{
+    areaIndex_.reserve(areas_.size());
+    machineIndex_.reserve(machines_.size());
+    competencyIndex_.reserve(competencies_.size());
+
+    for (int i = 0; i < areas_.size(); ++i) {
+        areaIndex_.insert(areas_[i].id(), i);
+    }
+
+    for (int i = 0; i < machines_.size(); ++i) {
+        const Machine& machine = machines_[i];
+        machineIndex_.insert(machine.id(), i);
+        machinesByArea_[machine.productionAreaId()].append(i);
+    }
+
+    for (int i = 0; i < competencies_.size(); ++i) {
+        const Competency& competency = competencies_[i];
+        competencyIndex_.insert(competency.id(), i);
+        competenciesByMachine_[competency.machineId()].append(i);
+    }
+}
+
+ProductionArea ProductionHierarchy::area(int areaId) const
+{
+    auto it = areaIndex_.constFind(areaId);
+    return it != areaIndex_.constEnd() ? areas_[it.value()] : ProductionArea();
+}
+
+Machine ProductionHierarchy::machine(int machineId) const
+{
+    auto it = machineIndex_.constFind(machineId);
+    return it != machineIndex_.constEnd() ? machines_[it.value()] : Machine();
+}
+
+Competency ProductionHierarchy::competency(int competencyId) const
+{
+    auto it = competencyIndex_.constFind(competencyId);
+    return it != competencyIndex_.constEnd() ? competencies_[it.value()] : Competency();
+}
+
+int ProductionHierarchy::areaIdForMachine(int machineId) const
+{
+    auto it = machineIndex_.constFind(machineId);
+    return it != machineIndex_.constEnd() ? machines_[it.value()].productionAreaId() : 0;
+}
+
+int ProductionHierarchy::machineIdForCompetency(int competencyId) const
+{
+    auto it = competencyIndex_.constFind(competencyId);
+    return it != competencyIndex_.constEnd() ? competencies_[it.value()].machineId() : 0;
+}
+
+int ProductionHierarchy::areaIdForCompetency(int competencyId) const
+{
+    return areaIdForMachine(machineIdForCompetency(competencyId));
+}
+
+QList<Machine> ProductionHierarchy::machinesByArea(int areaId) const
+{
+    QList<Machine> result;
+    const QList<int> positions = machinesByArea_.value(areaId);
+    result.reserve(positions.size());
+    for (int position : positions) {
+        result.append(machines_[position]);
+    }
+    return result;
+}
+
+QList<Competency> ProductionHierarchy::competenciesByMachine(int machineId) const
+{
+    QList<Competency> result;
+    const QList<int> positions = competenciesByMachine_.value(machineId);
+    result.reserve(positions.size());
+    for (int position : positions) {
+        result.append(competencies_[position]);
+    }
+    return result;
+}
+
+QList<Competency> ProductionHierarchy::competenciesByArea(int areaId) const
+{
+    QList<Competency> result;
+    for (int machinePosition : machinesByArea_.value(areaId)) {
+        for (int position : competenciesByMachine_.value(machines_[machinePosition].id())) {
+            result.append(competencies_[position]);
+        }
+    }
+    return result;
+}
+
+int ProductionHierarchy::competencyCountByArea(int areaId) const
+{
+    int count = 0;
+    for (int machinePosition : machinesByArea_.value(areaId)) {
+        count += competenciesByMachine_.value(machines_[machinePosition].id()).size();
+    }
+    return count;
+}
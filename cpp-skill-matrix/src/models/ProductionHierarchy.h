@@ -0,0 +1,74 @@
+#ifndef PRODUCTIONHIERARCHY_H
+#define PRODUCTIONHIERARCHY_H
+
+#include "ProductionArea.h"
+#include "Machine.h"
+#include "Competency.h"
+#include <QList>
+#include <QHash>
+
+/**
+ * @brief In-memory Production Area -> Machine -> Competency tree
+ *
+ * Built in one pass from flat lists (see ProductionRepository::loadHierarchy)
+ * and indexed by id, so lookups and per-parent listings never touch the database.
+ * Areas, machines and competencies keep the order they were loaded in.
+ */
+class ProductionHierarchy
+{
+public:
+    ProductionHierarchy();
+    ProductionHierarchy(const QList<ProductionArea>& areas,
+                        const QList<Machine>& machines,
+                        const QList<Competency>& competencies);
+    ~ProductionHierarchy();
+
+    // Flat views
+    const QList<ProductionArea>& areas() const { return areas_; }
+    const QList<Machine>& machines() const { return machines_; }
+    const QList<Competency>& competencies() const { return competencies_; }
+
+    int areaCount() const { return areas_.size(); }
+    int machineCount() const { return machines_.size(); }
+    int competencyCount() const { return competencies_.size(); }
+    bool isEmpty() const { return areas_.isEmpty(); }
+
+    // O(1) lookups (return a default-constructed, invalid object if not found)
+    ProductionArea area(int areaId) const;
+    Machine machine(int machineId) const;
+    Competency competency(int competencyId) const;
+
+    bool containsArea(int areaId) const { return areaIndex_.contains(areaId); }
+    bool containsMachine(int machineId) const { return machineIndex_.contains(machineId); }
+    bool containsCompetency(int competencyId) const { return competencyIndex_.contains(competencyId); }
+
+    // Parent lookups (0 if not found)
+    int areaIdForMachine(int machineId) const;
+    int machineIdForCompetency(int competencyId) const;
+    int areaIdForCompetency(int competencyId) const;
+
+    // Children
+    QList<Machine> machinesByArea(int areaId) const;
+    QList<Competency> competenciesByMachine(int machineId) const;
+    QList<Competency> competenciesByArea(int areaId) const;
+    int competencyCountByArea(int areaId) const;
+
+private:
+    void buildIndexes();
+
+private:
+    QList<ProductionArea> areas_;
+    QList<Machine> machines_;
+    QList<Competency> competencies_;
+
+    // id -> position in the flat lists
+    QHash<int, int> areaIndex_;
+    QHash<int, int> machineIndex_;
+    QHash<int, int> competencyIndex_;
+
+    // parent id -> child positions
+    QHash<int, QList<int>> machinesByArea_;
+    QHash<int, QList<int>> competenciesByMachine_;
+};
+
+#endif // PRODUCTIONHIERARCHY_H
@@ -0,0 +1,242 @@
+#include "ScoreMatrix.h"
+
+ScoreStats& ScoreStats::operator+=(const ScoreStats& other)
+{
+    assessed += other.assessed;
+    totalScore += other.totalScore;
+    for (int level = 0; level <= Constants::SCORE_MAX; ++level) {
+        counts[level] += other.counts[level];
+    }
+    return *this;
+}
+
+// ============================================================================
+// ScoreGrid
+// ============================================================================
+
+ScoreGrid::ScoreGrid()
+    : rows_(0)
+    , columns_(0)
+    , stride_(0)
+{
+}
+
+ScoreGrid::ScoreGrid(int rows, int columns)
+    : rows_(qMax(0, rows))
+    , columns_(qMax(0, columns))
+    , stride_((columns_ + 63) / 64)
+{
+    qsizetype words = qsizetype(rows_) * stride_;
+    low_.fill(0, words);
+    high_.fill(0, words);
+    present_.fill(0, words);
+}
+
+bool ScoreGrid::inRange(int row, int column) const
+{
+    return row >= 0 && row < rows_ && column >= 0 && column < columns_;
+}
+
+bool ScoreGrid::isAssessed(int row, int column) const
+{
+    if (!inRange(row, column)) {
+        return false;
+    }
+    qsizetype word = qsizetype(row) * stride_ + column / 64;
+    return (present_[word] >> (column % 64)) & 1;
+}
+
+int ScoreGrid::score(int row, int column) const
+{
+    if (!isAssessed(row, column)) {
+        return -1;
+    }
+    qsizetype word = qsizetype(row) * stride_ + column / 64;
+    int bit = column % 64;
+    return int((low_[word] >> bit) & 1) | int(((high_[word] >> bit) & 1) << 1);
+}
+
+void ScoreGrid::setScore(int row, int column, int score)
+{
+    if (!inRange(row, column)) {
+        return;
+    }
+    score = qBound(0, score, Constants::SCORE_MAX);
+    qsizetype word = qsizetype(row) * stride_ + column / 64;
+    quint64 bit = quint64(1) << (column % 64);
+
+    present_[word] |= bit;
+    low_[word] = (score & 1) ? (low_[word] | bit) : (low_[word] & ~bit);
+    high_[word] = (score & 2) ? (high_[word] | bit) : (high_[word] & ~bit);
+}
+
+void ScoreGrid::clearScore(int row, int column)
+{
+    if (!inRange(row, column)) {
+        return;
+    }
+    qsizetype word = qsizetype(row) * stride_ + column / 64;
+    quint64 bit = quint64(1) << (column % 64);
+    present_[word] &= ~bit;
+    low_[word] &= ~bit;
+    high_[word] &= ~bit;
+}
+
+void ScoreGrid::accumulate(ScoreStats& stats, int row, const quint64* mask) const
+{
+    const qsizetype base = qsizetype(row) * stride_;
+    const quint64* low = low_.constData() + base;
+    const quint64* high = high_.constData() + base;
+    const quint64* present = present_.constData() + base;
+
+    for (int w = 0; w < stride_; ++w) {
+        quint64 p = mask ? present[w] & mask[w] : present[w];
+        if (!p) {
+            continue;
+        }
+        quint64 l = low[w] & p;
+        quint64 h = high[w] & p;
+
+        int threes = qPopulationCount(l & h);
+        int twos = qPopulationCount(h & ~l);
+        int ones = qPopulationCount(l & ~h);
+        int assessed = qPopulationCount(p);
+
+        stats.counts[3] += threes;
+        stats.counts[2] += twos;
+        stats.counts[1] += ones;
+        stats.counts[0] += assessed - threes - twos - ones;
+        stats.assessed += assessed;
+        stats.totalScore += ones + 2 * twos + 3 * threes;
+    }
+}
+
+ScoreStats ScoreGrid::rowStats(int row) const
+{
+    ScoreStats stats;
+    if (row >= 0 && row < rows_) {
+        accumulate(stats, row, nullptr);
+    }
+    return stats;
+}
+
+ScoreStats ScoreGrid::rowStats(int row, const ColumnMask& columns) const
+{
+    ScoreStats stats;
+    if (row >= 0 && row < rows_ && columns.size() == stride_) {
+        accumulate(stats, row, columns.constData());
+    }
+    return stats;
+}
+
+ScoreStats ScoreGrid::columnStats(int column) const
+{
+    ScoreStats stats;
+    if (column < 0 || column >= columns_) {
+        return stats;
+    }
+    for (int row = 0; row < rows_; ++row) {
+        int value = score(row, column);
+        if (value >= 0) {
+            stats.assessed++;
+            stats.totalScore += value;
+            stats.counts[value]++;
+        }
+    }
+    return stats;
+}
+
+ScoreStats ScoreGrid::blockStats(const QList<int>& rows, const ColumnMask& columns) const
+{
+    ScoreStats stats;
+    if (columns.size() != stride_) {
+        return stats;
+    }
+    for (int row : rows) {
+        if (row >= 0 && row < rows_) {
+            accumulate(stats, row, columns.constData());
+        }
+    }
+    return stats;
+}
+
+ScoreStats ScoreGrid::totalStats() const
+{
+    ScoreStats stats;
+    for (int row = 0; row < rows_; ++row) {
+        accumulate(stats, row, nullptr);
+    }
+    return stats;
+}
+
+ScoreGrid::ColumnMask ScoreGrid::columnMask(const QList<int>& columns) const
+{
+    ColumnMask mask(stride_, 0);
+    for (int column : columns) {
+        if (column >= 0 && column < columns_) {
+            mask[column / 64] |= quint64(1) << (column % 64);
+        }
+    }
+    return mask;
+}
+
+qsizetype ScoreGrid::memoryUsage() const
+{
+    return (low_.size() + high_.size() + present_.size()) * qsizetype(sizeof(quint64));
+}
+
+// ============================================================================
+// Builders
+// ============================================================================
+
+namespace ScoreMatrices {
+
+static QStringList engineerIds(const QList<Engineer>& engineers)
+{
+    QStringList ids;
+    ids.reserve(engineers.size());
+    for (const Engineer& engineer : engineers) {
+        ids.append(engineer.id());
+    }
+    return ids;
+}
+
+CompetencyScoreMatrix fromAssessments(const QList<Engineer>& engineers,
+                                      const QList<Competency>& competencies,
+                                      const QList<Assessment>& assessments)
+{
+    QList<int> competencyIds;
+    competencyIds.reserve(competencies.size());
+    for (const Competency& competency : competencies) {
+        competencyIds.append(competency.id());
+    }
+
+    CompetencyScoreMatrix matrix(engineerIds(engineers), competencyIds);
+    for (const Assessment& assessment : assessments) {
+        matrix.setScore(matrix.rowIndex(assessment.engineerId()),
+                        matrix.columnIndex(assessment.competencyId()),
+                        assessment.score());
+    }
+    return matrix;
+}
+
+CoreSkillScoreMatrix fromCoreSkillAssessments(const QList<Engineer>& engineers,
+                                              const QList<CoreSkill>& skills,
+                                              const QList<CoreSkillAssessment>& assessments)
+{
+    QList<QString> skillIds;
+    skillIds.reserve(skills.size());
+    for (const CoreSkill& skill : skills) {
+        skillIds.append(skill.id());
+    }
+
+    CoreSkillScoreMatrix matrix(engineerIds(engineers), skillIds);
+    for (const CoreSkillAssessment& assessment : assessments) {
+        matrix.setScore(matrix.rowIndex(assessment.engineerId()),
+                        matrix.columnIndex(assessment.skillId()),
+                        assessment.score());
+    }
+    return matrix;
+}
+
+} // namespace ScoreMatrices
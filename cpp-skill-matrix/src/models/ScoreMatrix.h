@@ -0,0 +1,192 @@
+#ifndef SCOREMATRIX_H
+#define SCOREMATRIX_H
+
+#include "Engineer.h"
+#include "Competency.h"
+#include "Assessment.h"
+#include "CoreSkill.h"
+#include "CoreSkillAssessment.h"
+#include "../core/Constants.h"
+#include <QList>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+#include <QtAlgorithms>
+
+/**
+ * @brief Score totals over a set of matrix cells
+ */
+struct ScoreStats
+{
+    int assessed = 0;                               // cells holding a score
+    int totalScore = 0;                             // sum of those scores
+    int counts[Constants::SCORE_MAX + 1] = {};      // cells per score level
+
+    double average() const { return assessed > 0 ? double(totalScore) / assessed : 0.0; }
+
+    // Share of the maximum achievable score over assessed cells (0-100)
+    double percentage() const
+    {
+        return assessed > 0 ? (totalScore * 100.0) / (assessed * Constants::SCORE_MAX) : 0.0;
+    }
+
+    ScoreStats& operator+=(const ScoreStats& other);
+};
+
+/**
+ * @brief Dense rows x columns grid of 0-3 scores, addressed by index
+ *
+ * Each cell costs three bits, kept as three bit planes (low score bit, high score
+ * bit, assessed flag) with every row padded to whole 64-bit words. Row and block
+ * aggregation are therefore a handful of AND + popcount operations per 64 cells;
+ * a 5,000 x 3,000 grid takes about 5.6 MB.
+ *
+ * Copies are cheap (implicitly shared storage). Out-of-range indexes read as
+ * unassessed and are ignored on write.
+ */
+class ScoreGrid
+{
+public:
+    using ColumnMask = QVector<quint64>;
+
+    ScoreGrid();
+    ScoreGrid(int rows, int columns);
+
+    int rowCount() const { return rows_; }
+    int columnCount() const { return columns_; }
+
+    bool isAssessed(int row, int column) const;
+    int score(int row, int column) const;           // -1 if unassessed
+    void setScore(int row, int column, int score);  // clamped to 0..SCORE_MAX
+    void clearScore(int row, int column);
+
+    // Aggregation
+    ScoreStats rowStats(int row) const;
+    ScoreStats rowStats(int row, const ColumnMask& columns) const;
+    ScoreStats columnStats(int column) const;
+    ScoreStats blockStats(const QList<int>& rows, const ColumnMask& columns) const;
+    ScoreStats totalStats() const;
+
+    /**
+     * @brief Call fn(column, score) for each assessed cell of a row, in column order
+     *
+     * Skips unassessed cells a word at a time, so sparse rows cost little.
+     */
+    template <typename Fn>
+    void forEachInRow(int row, Fn fn) const
+    {
+        if (row < 0 || row >= rows_) {
+            return;
+        }
+        const qsizetype base = qsizetype(row) * stride_;
+        for (int w = 0; w < stride_; ++w) {
+            quint64 p = present_[base + w];
+            while (p) {
+                int bit = qCountTrailingZeroBits(p);
+                p &= p - 1;
+                int score = int((low_[base + w] >> bit) & 1) | int(((high_[base + w] >> bit) & 1) << 1);
+                fn(w * 64 + bit, score);
+            }
+        }
+    }
+
+    /**
+     * @brief Build a column selection for the masked aggregation overloads
+     */
+    ColumnMask columnMask(const QList<int>& columns) const;
+
+    qsizetype memoryUsage() const;
+
+private:
+    bool inRange(int row, int column) const;
+    void accumulate(ScoreStats& stats, int row, const quint64* mask) const;
+
+private:
+    int rows_;
+    int columns_;
+    int stride_;    // 64-bit words per row
+
+    QVector<quint64> low_;
+    QVector<quint64> high_;
+    QVector<quint64> present_;
+};
+
+/**
+ * @brief ScoreGrid with interned engineer ids as rows and typed ids as columns
+ *
+ * Ids map to indexes once; analytics loops then work on indexes only.
+ * rowIndex()/columnIndex() return -1 for unknown ids, which every grid
+ * accessor treats as empty.
+ */
+template <typename ColumnKey>
+class ScoreMatrix : public ScoreGrid
+{
+public:
+    ScoreMatrix() {}
+
+    ScoreMatrix(const QStringList& rowIds, const QList<ColumnKey>& columnIds)
+        : ScoreGrid(rowIds.size(), columnIds.size())
+        , rowIds_(rowIds)
+        , columnIds_(columnIds)
+    {
+        rowIndex_.reserve(rowIds_.size());
+        for (int i = 0; i < rowIds_.size(); ++i) {
+            rowIndex_.insert(rowIds_[i], i);
+        }
+        columnIndex_.reserve(columnIds_.size());
+        for (int i = 0; i < columnIds_.size(); ++i) {
+            columnIndex_.insert(columnIds_[i], i);
+        }
+    }
+
+    const QStringList& rowIds() const { return rowIds_; }
+    const QList<ColumnKey>& columnIds() const { return columnIds_; }
+
+    int rowIndex(const QString& rowId) const { return rowIndex_.value(rowId, -1); }
+    int columnIndex(const ColumnKey& columnId) const { return columnIndex_.value(columnId, -1); }
+
+    QList<int> columnIndexes(const QList<ColumnKey>& columnIds) const
+    {
+        QList<int> result;
+        result.reserve(columnIds.size());
+        for (const ColumnKey& columnId : columnIds) {
+            int column = columnIndex(columnId);
+            if (column >= 0) {
+                result.append(column);
+            }
+        }
+        return result;
+    }
+
+private:
+    QStringList rowIds_;
+    QList<ColumnKey> columnIds_;
+    QHash<QString, int> rowIndex_;
+    QHash<ColumnKey, int> columnIndex_;
+};
+
+using CompetencyScoreMatrix = ScoreMatrix<int>;         // engineer x competency id
+using CoreSkillScoreMatrix = ScoreMatrix<QString>;      // engineer x core skill id
+
+namespace ScoreMatrices {
+
+/**
+ * @brief Build the engineer x competency matrix in one pass over the assessments
+ *
+ * Rows and columns follow the order of the given lists. Assessments for unknown
+ * engineers or competencies are skipped.
+ */
+CompetencyScoreMatrix fromAssessments(const QList<Engineer>& engineers,
+                                      const QList<Competency>& competencies,
+                                      const QList<Assessment>& assessments);
+
+/**
+ * @brief Build the engineer x core skill matrix in one pass over the assessments
+ */
+CoreSkillScoreMatrix fromCoreSkillAssessments(const QList<Engineer>& engineers,
+                                              const QList<CoreSkill>& skills,
+                                              const QList<CoreSkillAssessment>& assessments);
+
+} // namespace ScoreMatrices
+
+#endif // SCOREMATRIX_H
@@ -1,7 +1,9 @@
 #include "Snapshot.h"
+#include "../core/Constants.h"
 
 Snapshot::Snapshot()
-    : id_(""), description_(""), timestamp_(QDateTime::currentDateTime()), data_(""), createdAt_(QDateTime::currentDateTime()) {}
+    : id_(""), description_(""), timestamp_(QDateTime::currentDateTime()), data_(""),
+      source_(Constants::SNAPSHOT_SOURCE_MANUAL), createdAt_(QDateTime::currentDateTime()) {}
 
 Snapshot::~Snapshot() {}
 
@@ -17,6 +19,9 @@ QJsonObject Snapshot::toJson() const
     json["description"] = description_;
     json["timestamp"] = timestamp_.toString(Qt::ISODate);
     json["data"] = data_;
+    json["payload"] = QString::fromLatin1(payload_.toBase64());
+    json["checkpointId"] = checkpointId_;
+    json["source"] = source_;
     json["createdAt"] = createdAt_.toString(Qt::ISODate);
     return json;
 }
@@ -28,6 +33,9 @@ Snapshot Snapshot::fromJson(const QJsonObject& json)
     snapshot.setDescription(json["description"].toString());
     snapshot.setTimestamp(QDateTime::fromString(json["timestamp"].toString(), Qt::ISODate));
     snapshot.setData(json["data"].toString());
+    snapshot.setPayload(QByteArray::fromBase64(json["payload"].toString().toLatin1()));
+    snapshot.setCheckpointId(json["checkpointId"].toString());
+    snapshot.setSource(json["source"].toString(Constants::SNAPSHOT_SOURCE_MANUAL));
     snapshot.setCreatedAt(QDateTime::fromString(json["createdAt"].toString(), Qt::ISODate));
     return snapshot;
 }
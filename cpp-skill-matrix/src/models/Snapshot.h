@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QDateTime>
+#include <QByteArray>
 #include <QJsonObject>
 
 class Snapshot
@@ -15,15 +16,26 @@ public:
     QString description() const { return description_; }
     QDateTime timestamp() const { return timestamp_; }
     QString data() const { return data_; }
+    QByteArray payload() const { return payload_; }
+    QString checkpointId() const { return checkpointId_; }
+    QString source() const { return source_; }
     QDateTime createdAt() const { return createdAt_; }
 
     void setId(const QString& id) { id_ = id; }
     void setDescription(const QString& description) { description_ = description; }
     void setTimestamp(const QDateTime& timestamp) { timestamp_ = timestamp; }
     void setData(const QString& data) { data_ = data; }
+    void setPayload(const QByteArray& payload) { payload_ = payload; }
+    void setCheckpointId(const QString& checkpointId) { checkpointId_ = checkpointId; }
+    void setSource(const QString& source) { source_ = source; }
     void setCreatedAt(const QDateTime& createdAt) { createdAt_ = createdAt; }
 
     bool isValid() const;
+
+    // Checkpoints hold the full state; deltas name the checkpoint of their chain
+    bool isCheckpoint() const { return checkpointId_.isEmpty(); }
+    QString chainId() const { return isCheckpoint() ? id_ : checkpointId_; }
+
     QJsonObject toJson() const;
     static Snapshot fromJson(const QJsonObject& json);
 
@@ -31,7 +43,10 @@ private:
     QString id_;
     QString description_;
     QDateTime timestamp_;
-    QString data_; // JSON string
+    QString data_;          // legacy JSON string (pre-payload snapshots)
+    QByteArray payload_;    // SnapshotCodec encoding
+    QString checkpointId_;  // empty for checkpoints
+    QString source_;        // Constants::SNAPSHOT_SOURCE_*
     QDateTime createdAt_;
 };
 
@@ -0,0 +1,510 @@
+#include "SnapshotCodec.h"
+#include <QDataStream>
+#include <QIODevice>
+#include <QVector>
+#include <QPair>
+#include <algorithm>
+
+// ============================================================================
+// Block encoding helpers
+// ============================================================================
+
+static void appendVarint(QByteArray& out, quint32 value)
+{
+    while (value >= 0x80) {
+        out.append(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+static bool readVarint(const char*& p, const char* end, quint32& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        uchar byte = uchar(*p++);
+        value |= quint32(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+using Cell = QPair<int, int>;   // dictionary position, score
+
+// Positions as deltas from the previous position, then scores two bits each
+static void appendCells(QByteArray& out, QVector<Cell>& cells)
+{
+    std::sort(cells.begin(), cells.end());
+
+    appendVarint(out, quint32(cells.size()));
+    int previous = -1;
+    for (const Cell& cell : cells) {
+        appendVarint(out, quint32(cell.first - previous - 1));
+        previous = cell.first;
+    }
+
+    QByteArray packed((cells.size() + 3) / 4, char(0));
+    for (int i = 0; i < cells.size(); ++i) {
+        packed[i / 4] = char(uchar(packed[i / 4]) | (cells[i].second << (2 * (i % 4))));
+    }
+    out.append(packed);
+}
+
+static void appendPositions(QByteArray& out, QVector<int>& positions)
+{
+    std::sort(positions.begin(), positions.end());
+
+    appendVarint(out, quint32(positions.size()));
+    int previous = -1;
+    for (int position : positions) {
+        appendVarint(out, quint32(position - previous - 1));
+        previous = position;
+    }
+}
+
+template <typename Fn>
+static bool readPositions(const char*& p, const char* end, int dictionarySize, QVector<int>& positions, Fn fn)
+{
+    quint32 count = 0;
+    if (!readVarint(p, end, count) || count > quint32(dictionarySize)) {
+        return false;
+    }
+
+    positions.resize(int(count));
+    int previous = -1;
+    for (quint32 i = 0; i < count; ++i) {
+        quint32 delta = 0;
+        if (!readVarint(p, end, delta) || delta >= quint32(dictionarySize)) {
+            return false;
+        }
+        int position = previous + 1 + int(delta);
+        if (position >= dictionarySize) {
+            return false;
+        }
+        positions[int(i)] = position;
+        previous = position;
+        fn(position);
+    }
+    return true;
+}
+
+template <typename Fn>
+static bool readCells(const char*& p, const char* end, int dictionarySize, Fn fn)
+{
+    QVector<int> positions;
+    if (!readPositions(p, end, dictionarySize, positions, [](int) {})) {
+        return false;
+    }
+
+    qsizetype packedBytes = (qsizetype(positions.size()) + 3) / 4;
+    if (end - p < packedBytes) {
+        return false;
+    }
+    for (int i = 0; i < positions.size(); ++i) {
+        fn(positions[i], (uchar(p[i / 4]) >> (2 * (i % 4))) & 0x3);
+    }
+    p += packedBytes;
+    return true;
+}
+
+// Header, compressed index and the non-empty blocks, compressed one by one
+static QByteArray assemble(SnapshotCodec::Kind kind,
+                           const QList<int>& competencyIds,
+                           const QStringList& coreSkillIds,
+                           const QStringList& engineerIds,
+                           const QList<QByteArray>& blocks)
+{
+    QByteArray index;
+    QByteArray compressedBlocks;
+    {
+        QDataStream indexStream(&index, QIODevice::WriteOnly);
+        indexStream.setVersion(QDataStream::Qt_6_0);
+        indexStream << competencyIds << coreSkillIds << quint32(engineerIds.size());
+
+        for (int i = 0; i < engineerIds.size(); ++i) {
+            quint32 offset = quint32(compressedBlocks.size());
+            quint32 size = 0;
+            if (!blocks[i].isEmpty()) {
+                QByteArray compressed = qCompress(blocks[i]);
+                compressedBlocks.append(compressed);
+                size = quint32(compressed.size());
+            }
+            indexStream << engineerIds[i] << offset << size;
+        }
+    }
+
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << SnapshotCodec::MAGIC << SnapshotCodec::FORMAT_VERSION << quint8(kind) << qCompress(index);
+    payload.append(compressedBlocks);
+    return payload;
+}
+
+static SnapshotCodec::EngineerScores rowScores(const CompetencyScoreMatrix& competencyScores,
+                                               const CoreSkillScoreMatrix& coreSkillScores,
+                                               const QString& engineerId)
+{
+    SnapshotCodec::EngineerScores scores;
+    competencyScores.forEachInRow(competencyScores.rowIndex(engineerId), [&](int column, int score) {
+        scores.competencies.insert(competencyScores.columnIds()[column], score);
+    });
+    coreSkillScores.forEachInRow(coreSkillScores.rowIndex(engineerId), [&](int column, int score) {
+        scores.coreSkills.insert(coreSkillScores.columnIds()[column], score);
+    });
+    return scores;
+}
+
+static QStringList matrixEngineerIds(const CompetencyScoreMatrix& competencyScores,
+                                     const CoreSkillScoreMatrix& coreSkillScores)
+{
+    QStringList engineerIds = competencyScores.rowIds();
+    for (const QString& id : coreSkillScores.rowIds()) {
+        if (competencyScores.rowIndex(id) < 0) {
+            engineerIds.append(id);
+        }
+    }
+    return engineerIds;
+}
+
+// ============================================================================
+// Encoder
+// ============================================================================
+
+namespace SnapshotCodec {
+
+QByteArray encode(const CompetencyScoreMatrix& competencyScores,
+                  const CoreSkillScoreMatrix& coreSkillScores)
+{
+    // Matrix columns are the dictionaries, so cells come out already in position order
+    QStringList engineerIds = matrixEngineerIds(competencyScores, coreSkillScores);
+    QList<QByteArray> blocks;
+    blocks.reserve(engineerIds.size());
+
+    QVector<Cell> competencyCells;
+    QVector<Cell> coreSkillCells;
+    for (const QString& engineerId : engineerIds) {
+        competencyCells.clear();
+        coreSkillCells.clear();
+        competencyScores.forEachInRow(competencyScores.rowIndex(engineerId), [&](int column, int score) {
+            competencyCells.append(Cell(column, score));
+        });
+        coreSkillScores.forEachInRow(coreSkillScores.rowIndex(engineerId), [&](int column, int score) {
+            coreSkillCells.append(Cell(column, score));
+        });
+
+        QByteArray block;
+        if (!competencyCells.isEmpty() || !coreSkillCells.isEmpty()) {
+            appendCells(block, competencyCells);
+            appendCells(block, coreSkillCells);
+        }
+        blocks.append(block);
+    }
+
+    return assemble(Checkpoint, competencyScores.columnIds(), coreSkillScores.columnIds(), engineerIds, blocks);
+}
+
+QByteArray encodeState(const SnapshotState& state, Kind kind)
+{
+    // Dictionaries hold only the ids this state mentions
+    QSet<int> competencySet;
+    QSet<QString> coreSkillSet;
+    for (const EngineerScores& scores : state) {
+        for (auto it = scores.competencies.constBegin(); it != scores.competencies.constEnd(); ++it) {
+            competencySet.insert(it.key());
+        }
+        for (auto it = scores.coreSkills.constBegin(); it != scores.coreSkills.constEnd(); ++it) {
+            coreSkillSet.insert(it.key());
+        }
+        if (kind == Delta) {
+            competencySet.unite(scores.removedCompetencies);
+            coreSkillSet.unite(scores.removedCoreSkills);
+        }
+    }
+
+    QList<int> competencyIds(competencySet.constBegin(), competencySet.constEnd());
+    QStringList coreSkillIds(coreSkillSet.constBegin(), coreSkillSet.constEnd());
+    std::sort(competencyIds.begin(), competencyIds.end());
+    std::sort(coreSkillIds.begin(), coreSkillIds.end());
+
+    QHash<int, int> competencyPosition;
+    QHash<QString, int> coreSkillPosition;
+    for (int i = 0; i < competencyIds.size(); ++i) {
+        competencyPosition.insert(competencyIds[i], i);
+    }
+    for (int i = 0; i < coreSkillIds.size(); ++i) {
+        coreSkillPosition.insert(coreSkillIds[i], i);
+    }
+
+    QStringList engineerIds = state.keys();
+    std::sort(engineerIds.begin(), engineerIds.end());
+
+    QList<QByteArray> blocks;
+    blocks.reserve(engineerIds.size());
+    for (const QString& engineerId : engineerIds) {
+        const EngineerScores& scores = state[engineerId];
+        QByteArray block;
+        if (!scores.isEmpty()) {
+            QVector<Cell> competencyCells;
+            for (auto it = scores.competencies.constBegin(); it != scores.competencies.constEnd(); ++it) {
+                competencyCells.append(Cell(competencyPosition[it.key()], it.value()));
+            }
+            QVector<Cell> coreSkillCells;
+            for (auto it = scores.coreSkills.constBegin(); it != scores.coreSkills.constEnd(); ++it) {
+                coreSkillCells.append(Cell(coreSkillPosition[it.key()], it.value()));
+            }
+            appendCells(block, competencyCells);
+            appendCells(block, coreSkillCells);
+
+            if (kind == Delta) {
+                QVector<int> removedCompetencies;
+                for (int id : scores.removedCompetencies) {
+                    removedCompetencies.append(competencyPosition[id]);
+                }
+                QVector<int> removedCoreSkills;
+                for (const QString& id : scores.removedCoreSkills) {
+                    removedCoreSkills.append(coreSkillPosition[id]);
+                }
+                appendPositions(block, removedCompetencies);
+                appendPositions(block, removedCoreSkills);
+            }
+        }
+        blocks.append(block);
+    }
+
+    return assemble(kind, competencyIds, coreSkillIds, engineerIds, blocks);
+}
+
+SnapshotState capture(const CompetencyScoreMatrix& competencyScores,
+                      const CoreSkillScoreMatrix& coreSkillScores)
+{
+    SnapshotState state;
+    for (const QString& engineerId : matrixEngineerIds(competencyScores, coreSkillScores)) {
+        EngineerScores scores = rowScores(competencyScores, coreSkillScores, engineerId);
+        if (!scores.isEmpty()) {
+            state.insert(engineerId, scores);
+        }
+    }
+    return state;
+}
+
+SnapshotState diff(const SnapshotState& base,
+                   const CompetencyScoreMatrix& competencyScores,
+                   const CoreSkillScoreMatrix& coreSkillScores)
+{
+    SnapshotState changes;
+
+    QStringList engineerIds = matrixEngineerIds(competencyScores, coreSkillScores);
+    QSet<QString> current(engineerIds.constBegin(), engineerIds.constEnd());
+    for (auto it = base.constBegin(); it != base.constEnd(); ++it) {
+        if (!current.contains(it.key())) {
+            engineerIds.append(it.key());   // engineer removed since the base
+        }
+    }
+
+    for (const QString& engineerId : engineerIds) {
+        EngineerScores now = rowScores(competencyScores, coreSkillScores, engineerId);
+        const EngineerScores before = base.value(engineerId);
+        EngineerScores change;
+
+        for (auto it = now.competencies.constBegin(); it != now.competencies.constEnd(); ++it) {
+            if (before.competencies.value(it.key(), -1) != it.value()) {
+                change.competencies.insert(it.key(), it.value());
+            }
+        }
+        for (auto it = before.competencies.constBegin(); it != before.competencies.constEnd(); ++it) {
+            if (!now.competencies.contains(it.key())) {
+                change.removedCompetencies.insert(it.key());
+            }
+        }
+        for (auto it = now.coreSkills.constBegin(); it != now.coreSkills.constEnd(); ++it) {
+            if (before.coreSkills.value(it.key(), -1) != it.value()) {
+                change.coreSkills.insert(it.key(), it.value());
+            }
+        }
+        for (auto it = before.coreSkills.constBegin(); it != before.coreSkills.constEnd(); ++it) {
+            if (!now.coreSkills.contains(it.key())) {
+                change.removedCoreSkills.insert(it.key());
+            }
+        }
+
+        if (!change.isEmpty()) {
+            changes.insert(engineerId, change);
+        }
+    }
+
+    return changes;
+}
+
+void applyDelta(EngineerScores& scores, const EngineerScores& delta)
+{
+    for (int id : delta.removedCompetencies) {
+        scores.competencies.remove(id);
+    }
+    for (const QString& id : delta.removedCoreSkills) {
+        scores.coreSkills.remove(id);
+    }
+    for (auto it = delta.competencies.constBegin(); it != delta.competencies.constEnd(); ++it) {
+        scores.competencies.insert(it.key(), it.value());
+    }
+    for (auto it = delta.coreSkills.constBegin(); it != delta.coreSkills.constEnd(); ++it) {
+        scores.coreSkills.insert(it.key(), it.value());
+    }
+}
+
+void applyDelta(SnapshotState& state, const SnapshotState& delta)
+{
+    for (auto it = delta.constBegin(); it != delta.constEnd(); ++it) {
+        applyDelta(state[it.key()], it.value());
+    }
+}
+
+void composeDelta(SnapshotState& first, const SnapshotState& next)
+{
+    for (auto it = next.constBegin(); it != next.constEnd(); ++it) {
+        EngineerScores& scores = first[it.key()];
+        const EngineerScores& step = it.value();
+
+        for (int id : step.removedCompetencies) {
+            scores.competencies.remove(id);
+            scores.removedCompetencies.insert(id);
+        }
+        for (const QString& id : step.removedCoreSkills) {
+            scores.coreSkills.remove(id);
+            scores.removedCoreSkills.insert(id);
+        }
+        for (auto cell = step.competencies.constBegin(); cell != step.competencies.constEnd(); ++cell) {
+            scores.competencies.insert(cell.key(), cell.value());
+            scores.removedCompetencies.remove(cell.key());
+        }
+        for (auto cell = step.coreSkills.constBegin(); cell != step.coreSkills.constEnd(); ++cell) {
+            scores.coreSkills.insert(cell.key(), cell.value());
+            scores.removedCoreSkills.remove(cell.key());
+        }
+    }
+}
+
+} // namespace SnapshotCodec
+
+// ============================================================================
+// SnapshotReader
+// ============================================================================
+
+SnapshotReader::SnapshotReader(const QByteArray& payload)
+    : payload_(payload)
+    , blocksStart_(0)
+    , version_(0)
+    , kind_(SnapshotCodec::Checkpoint)
+{
+    if (payload_.isEmpty()) {
+        error_ = "Snapshot has no payload";
+        return;
+    }
+
+    QDataStream in(payload_);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    QByteArray compressedIndex;
+    in >> magic >> version_;
+    if (in.status() != QDataStream::Ok || magic != SnapshotCodec::MAGIC) {
+        error_ = "Not a snapshot payload";
+        return;
+    }
+    if (version_ == 0 || version_ > SnapshotCodec::FORMAT_VERSION) {
+        error_ = QString("Unsupported snapshot format version %1").arg(version_);
+        return;
+    }
+
+    // Version 1 payloads predate deltas and are always checkpoints
+    if (version_ >= 2) {
+        quint8 kind = 0;
+        in >> kind;
+        if (kind > SnapshotCodec::Delta) {
+            error_ = QString("Unknown snapshot kind %1").arg(kind);
+            return;
+        }
+        kind_ = SnapshotCodec::Kind(kind);
+    }
+
+    in >> compressedIndex;
+    blocksStart_ = in.device()->pos();
+    QByteArray index = qUncompress(compressedIndex);
+    if (in.status() != QDataStream::Ok || index.isEmpty()) {
+        error_ = "Snapshot index is corrupt";
+        return;
+    }
+
+    QDataStream indexStream(index);
+    indexStream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 engineerCount = 0;
+    indexStream >> competencyIds_ >> coreSkillIds_ >> engineerCount;
+
+    qsizetype blocksSize = payload_.size() - blocksStart_;
+    for (quint32 i = 0; i < engineerCount && indexStream.status() == QDataStream::Ok; ++i) {
+        QString engineerId;
+        BlockRef block;
+        indexStream >> engineerId >> block.offset >> block.size;
+        if (qsizetype(block.offset) + block.size > blocksSize) {
+            break;
+        }
+        engineerIds_.append(engineerId);
+        blocks_.insert(engineerId, block);
+    }
+
+    if (indexStream.status() != QDataStream::Ok || quint32(engineerIds_.size()) != engineerCount) {
+        error_ = "Snapshot index is truncated";
+        engineerIds_.clear();
+        blocks_.clear();
+    }
+}
+
+SnapshotCodec::EngineerScores SnapshotReader::engineer(const QString& engineerId) const
+{
+    SnapshotCodec::EngineerScores scores;
+
+    auto it = blocks_.constFind(engineerId);
+    if (it == blocks_.constEnd() || it->size == 0) {
+        return scores;
+    }
+
+    QByteArray block = qUncompress(reinterpret_cast<const uchar*>(payload_.constData() + blocksStart_ + it->offset),
+                                   qsizetype(it->size));
+    const char* p = block.constData();
+    const char* end = p + block.size();
+
+    bool ok = readCells(p, end, competencyIds_.size(), [&](int position, int score) {
+        scores.competencies.insert(competencyIds_[position], score);
+    });
+    ok = ok && readCells(p, end, coreSkillIds_.size(), [&](int position, int score) {
+        scores.coreSkills.insert(coreSkillIds_[position], score);
+    });
+
+    if (ok && kind_ == SnapshotCodec::Delta) {
+        QVector<int> positions;
+        ok = readPositions(p, end, competencyIds_.size(), positions, [&](int position) {
+            scores.removedCompetencies.insert(competencyIds_[position]);
+        });
+        ok = ok && readPositions(p, end, coreSkillIds_.size(), positions, [&](int position) {
+            scores.removedCoreSkills.insert(coreSkillIds_[position]);
+        });
+    }
+
+    if (!ok) {
+        return SnapshotCodec::EngineerScores();
+    }
+    return scores;
+}
+
+SnapshotCodec::SnapshotState SnapshotReader::decodeAll() const
+{
+    SnapshotCodec::SnapshotState state;
+    state.reserve(engineerIds_.size());
+    for (const QString& engineerId : engineerIds_) {
+        state.insert(engineerId, engineer(engineerId));
+    }
+    return state;
+}
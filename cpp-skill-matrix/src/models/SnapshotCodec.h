@@ -0,0 +1,157 @@
+#ifndef SNAPSHOTCODEC_H
+#define SNAPSHOTCODEC_H
+
+#include "ScoreMatrix.h"
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QSet>
+
+/**
+ * @brief Compact binary encoding of the plant's assessment state
+ *
+ * Layout (QDataStream Qt 6.0 encoding):
+ *   magic | version | kind (version 2+) | qCompress(index) | engineer blocks
+ *
+ * The index holds the competency id and core skill id dictionaries plus, for
+ * every engineer, the offset and length of that engineer's block. Each block
+ * is compressed on its own and is columnar: per score kind, the dictionary
+ * positions as delta varints followed by the scores packed four to a byte.
+ * Reading one engineer therefore decompresses the index and a single block,
+ * never the whole plant.
+ *
+ * A checkpoint holds the full state. A delta holds only the engineers whose
+ * scores changed since the previous snapshot of its chain: the cells set to a
+ * new score, then the positions of cells that were cleared.
+ */
+namespace SnapshotCodec {
+
+constexpr quint32 MAGIC = 0x534D534E;      // "SMSN"
+constexpr quint16 FORMAT_VERSION = 2;      // 2: kind byte and delta blocks
+
+enum Kind : quint8 {
+    Checkpoint = 0,
+    Delta = 1
+};
+
+/**
+ * @brief One engineer's scores as recorded in a snapshot
+ */
+struct EngineerScores
+{
+    QHash<int, int> competencies;       // competency id -> score
+    QHash<QString, int> coreSkills;     // core skill id -> score
+
+    // Delta snapshots only: scores cleared since the previous snapshot
+    QSet<int> removedCompetencies;
+    QSet<QString> removedCoreSkills;
+
+    bool isEmpty() const
+    {
+        return competencies.isEmpty() && coreSkills.isEmpty() &&
+               removedCompetencies.isEmpty() && removedCoreSkills.isEmpty();
+    }
+};
+
+using SnapshotState = QHash<QString, EngineerScores>;   // engineer id -> scores
+
+/**
+ * @brief Encode both score matrices as a checkpoint
+ *
+ * Engineers are taken from the rows of either matrix; engineers without any
+ * score are listed but get no block.
+ */
+QByteArray encode(const CompetencyScoreMatrix& competencyScores,
+                  const CoreSkillScoreMatrix& coreSkillScores);
+
+/**
+ * @brief Encode a decoded state as a checkpoint, or a diff as a delta
+ */
+QByteArray encodeState(const SnapshotState& state, Kind kind);
+
+/**
+ * @brief The matrices as a state (engineers without any score are left out)
+ */
+SnapshotState capture(const CompetencyScoreMatrix& competencyScores,
+                      const CoreSkillScoreMatrix& coreSkillScores);
+
+/**
+ * @brief Cells of the matrices that differ from base, per engineer
+ *
+ * Engineers without changes are left out, so an unchanged plant gives an
+ * empty diff.
+ */
+SnapshotState diff(const SnapshotState& base,
+                   const CompetencyScoreMatrix& competencyScores,
+                   const CoreSkillScoreMatrix& coreSkillScores);
+
+/**
+ * @brief Apply a delta block to an engineer's scores
+ */
+void applyDelta(EngineerScores& scores, const EngineerScores& delta);
+
+/**
+ * @brief Apply a whole delta state (e.g. a decoded delta snapshot) to a state
+ */
+void applyDelta(SnapshotState& state, const SnapshotState& delta);
+
+/**
+ * @brief Fold the next delta of a chain into first, so first alone takes both steps
+ */
+void composeDelta(SnapshotState& first, const SnapshotState& next);
+
+} // namespace SnapshotCodec
+
+/**
+ * @brief Random-access reader over a snapshot payload
+ *
+ * The constructor decodes only the index; engineer() decompresses the one
+ * block it is asked for. A payload that is empty, truncated or of a newer
+ * format version yields an invalid reader that returns no scores.
+ */
+class SnapshotReader
+{
+public:
+    explicit SnapshotReader(const QByteArray& payload);
+
+    bool isValid() const { return error_.isEmpty(); }
+    QString error() const { return error_; }
+    quint16 version() const { return version_; }
+    SnapshotCodec::Kind kind() const { return kind_; }
+    bool isDelta() const { return kind_ == SnapshotCodec::Delta; }
+
+    QStringList engineerIds() const { return engineerIds_; }
+    bool contains(const QString& engineerId) const { return blocks_.contains(engineerId); }
+
+    /**
+     * @brief Decode one engineer's scores (empty if unknown or unassessed)
+     */
+    SnapshotCodec::EngineerScores engineer(const QString& engineerId) const;
+
+    /**
+     * @brief Decode every engineer
+     */
+    SnapshotCodec::SnapshotState decodeAll() const;
+
+private:
+    struct BlockRef {
+        quint32 offset = 0;
+        quint32 size = 0;
+    };
+
+private:
+    QByteArray payload_;
+    qsizetype blocksStart_;
+    quint16 version_;
+    SnapshotCodec::Kind kind_;
+    QString error_;
+
+    QList<int> competencyIds_;
+    QStringList coreSkillIds_;
+    QStringList engineerIds_;
+    QHash<QString, BlockRef> blocks_;
+};
+
+#endif // SNAPSHOTCODEC_H
@@ -1,4 +1,5 @@
 #include "AnalyticsWidget.h"
+#include "../database/ConnectionPool.h"
 #include "../utils/Logger.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -6,6 +7,9 @@
 #include <QGroupBox>
 #include <QScrollArea>
 #include <QShowEvent>
+#include <QHideEvent>
+#include <QSignalBlocker>
+#include <QtConcurrent/QtConcurrent>
 #include <QtCharts/QChart>
 #include <QtCharts/QLineSeries>
 #include <QtCharts/QAreaSeries>
@@ -41,29 +45,56 @@ AnalyticsWidget::AnalyticsWidget(QWidget* parent)
     , shiftFilterCombo_(nullptr)
     , shiftDataTypeCombo_(nullptr)
     , shiftRadarContainer_(nullptr)
-    , isFirstShow_(true)
+    , loadWatcher_(new QFutureWatcher<LoadResult>(this))
+    , needsLoad_(true)
     , engineerRadarChartHeight_(400)
     , shiftOverviewChartHeight_(500)
 {
     setupUI();
 
+    connect(loadWatcher_, &QFutureWatcher<LoadResult>::resultReadyAt,
+            this, &AnalyticsWidget::onLoadResultReady);
+    connect(loadWatcher_, &QFutureWatcher<LoadResult>::finished,
+            this, &AnalyticsWidget::onLoadFinished);
+
     // Don't load analytics here - wait for showEvent() (lazy loading)
     Logger::instance().info("AnalyticsWidget", "Analytics widget initialized");
 }
 
 AnalyticsWidget::~AnalyticsWidget()
 {
+    // The job only touches the store, but must release its pooled connection first
+    cancelLoad();
+    loadWatcher_->waitForFinished();
 }
 
 void AnalyticsWidget::showEvent(QShowEvent* event)
 {
     QWidget::showEvent(event);
 
-    // Lazy loading: only load data on first show
-    if (isFirstShow_) {
-        isFirstShow_ = false;
+    // Lazy loading: load on first show, or if a load was cancelled or requested while hidden
+    if (needsLoad_) {
+        loadAnalytics();
+    }
+}
+
+void AnalyticsWidget::hideEvent(QHideEvent* event)
+{
+    QWidget::hideEvent(event);
+
+    // Navigating away: stop computing views nobody will see
+    if (loadWatcher_->isRunning()) {
+        cancelLoad();
+        needsLoad_ = true;
+    }
+}
+
+void AnalyticsWidget::refresh()
+{
+    if (isVisible()) {
         loadAnalytics();
-        Logger::instance().info("AnalyticsWidget", "Loaded analytics data on first show");
+    } else {
+        needsLoad_ = true;
     }
 }
 
@@ -366,58 +397,157 @@ void AnalyticsWidget::setupAutomatedInsightsTab(QWidget* insightsWidget)
     layout->addWidget(insightsGroup);
 }
 
-void AnalyticsWidget::loadAnalytics()
+// ============================================================================
+// BACKGROUND LOADING
+// ============================================================================
+
+void AnalyticsWidget::loadAnalytics(SkillMatrixStore::Datasets syncFirst)
 {
     Logger::instance().info("AnalyticsWidget", "Loading analytics data...");
 
-    // Load all data once and cache it (optimized for performance)
-    cachedEngineers_ = engineerRepo_.findAll();
-    cachedAssessments_ = assessmentRepo_.findAll();
-    cachedAreas_ = productionRepo_.findAllAreas();
-
-    // Pre-calculate total competencies to avoid repeated queries
-    cachedTotalCompetencies_ = 0;
-    for (const ProductionArea& area : cachedAreas_) {
-        QList<Machine> machines = productionRepo_.findMachinesByArea(area.id());
-        for (const Machine& machine : machines) {
-            QList<Competency> competencies = productionRepo_.findCompetenciesByMachine(machine.id());
-            cachedTotalCompetencies_ += competencies.size();
+    cancelLoad();
+    needsLoad_ = false;
+    setLoading(true);
+
+    loadWatcher_->setFuture(QtConcurrent::run(&AnalyticsWidget::computeAnalytics, syncFirst));
+}
+
+void AnalyticsWidget::cancelLoad()
+{
+    if (loadWatcher_->isRunning()) {
+        loadWatcher_->cancel();
+    }
+}
+
+void AnalyticsWidget::computeAnalytics(QPromise<LoadResult>& promise, SkillMatrixStore::Datasets syncFirst)
+{
+    // Store loads issued from this job use the worker thread's pooled connection
+    ScopedConnection connection;
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+
+    if (syncFirst) {
+        store.sync(syncFirst);
+    }
+    if (promise.isCanceled()) {
+        return;
+    }
+
+    // Selectors first: engineers are a small dataset
+    LoadResult roster;
+    roster.stage = LoadResult::Roster;
+    roster.engineers = store.engineers().items();
+    QSet<QString> uniqueShifts;
+    for (const Engineer& engineer : roster.engineers) {
+        if (!engineer.shift().isEmpty()) {
+            uniqueShifts.insert(engineer.shift());
         }
     }
+    roster.shifts = uniqueShifts.values();
+    std::sort(roster.shifts.begin(), roster.shifts.end());
+    promise.addResult(roster);
+    if (promise.isCanceled()) {
+        return;
+    }
+
+    // Trend figures need only the matrix totals
+    CompetencyScoreMatrix scores = store.competencyScores();
+    LoadResult trends;
+    trends.stage = LoadResult::Trends;
+    trends.prediction = AnalyticsEngine::predictionFor(scores.totalStats());
+    promise.addResult(trends);
+    if (promise.isCanceled()) {
+        return;
+    }
+
+    // Everything else comes from one engine pass
+    LoadResult engine;
+    engine.stage = LoadResult::Engine;
+    engine.engine = AnalyticsEngine(roster.engineers,
+                                    store.hierarchy(),
+                                    scores,
+                                    store.coreSkillCategories().items(),
+                                    store.coreSkills().items(),
+                                    store.coreSkillScores());
+    promise.addResult(engine);
+}
+
+void AnalyticsWidget::onLoadResultReady(int index)
+{
+    const LoadResult result = loadWatcher_->resultAt(index);
+
+    switch (result.stage) {
+        case LoadResult::Roster:
+            populateSelectors(result.engineers, result.shifts);
+            break;
+        case LoadResult::Trends:
+            updateTrendsData(result.prediction);
+            break;
+        case LoadResult::Engine:
+            engine_ = result.engine;
+            updateShiftComparisonData();
+            updateAutomatedInsights();
+
+            // Radar tabs are costly to build; refresh only the one on screen
+            if (contentStack_->currentIndex() == 3) {
+                updateEngineerRadarData();
+            } else if (contentStack_->currentIndex() == 4) {
+                updateShiftOverviewData();
+            }
+            break;
+    }
+}
+
+void AnalyticsWidget::onLoadFinished()
+{
+    if (loadWatcher_->isCanceled()) {
+        LOG_DEBUG("AnalyticsWidget", "Analytics load cancelled");
+        return;
+    }
+
+    Logger::instance().info("AnalyticsWidget", "Analytics views updated");
+    emit dataLoadingFinished();
+}
+
+void AnalyticsWidget::setLoading(bool loading)
+{
+    if (!loading) {
+        return;
+    }
 
-    Logger::instance().info("AnalyticsWidget", "Data loaded. Updating analytics views...");
+    // Placeholders per panel; each is replaced as its stage arrives
+    currentCompletionLabel_->setText("…");
+    predictedCompletionLabel_->setText("…");
+    changeLabel_->setText("…");
 
-    // Update all analytics views
-    updateTrendsData();
-    updateShiftComparisonData();
-    updateAutomatedInsights();
+    insightsList_->clear();
+    insightsList_->addItem("Loading insights...");
+}
 
-    // Populate engineer selector dropdown
+void AnalyticsWidget::populateSelectors(const QList<Engineer>& engineers, const QStringList& shifts)
+{
+    // Charts are redrawn once the engine stage arrives, not on every combo change
     if (engineerSelector_) {
+        QString currentEngineer = engineerSelector_->currentData().toString();
+        QSignalBlocker blocker(engineerSelector_);
         engineerSelector_->clear();
-        for (const Engineer& engineer : cachedEngineers_) {
+        for (const Engineer& engineer : engineers) {
             engineerSelector_->addItem(engineer.name(), engineer.id());
         }
+
+        int index = engineerSelector_->findData(currentEngineer);
+        if (index >= 0) {
+            engineerSelector_->setCurrentIndex(index);
+        }
     }
 
     // Populate shift filter dropdown with unique shifts
     if (shiftFilterCombo_) {
         QString currentShift = shiftFilterCombo_->currentData().toString();
+        QSignalBlocker blocker(shiftFilterCombo_);
         shiftFilterCombo_->clear();
         shiftFilterCombo_->addItem("All Shifts", "ALL");
 
-        QSet<QString> uniqueShifts;
-        for (const Engineer& engineer : cachedEngineers_) {
-            QString shift = engineer.shift();
-            if (!shift.isEmpty()) {
-                uniqueShifts.insert(shift);
-            }
-        }
-
-        QList<QString> shiftList = uniqueShifts.values();
-        std::sort(shiftList.begin(), shiftList.end());
-
-        for (const QString& shift : shiftList) {
+        for (const QString& shift : shifts) {
             shiftFilterCombo_->addItem(shift, shift);
         }
 
@@ -431,10 +561,8 @@ void AnalyticsWidget::loadAnalytics()
     }
 }
 
-void AnalyticsWidget::updateTrendsData()
+void AnalyticsWidget::updateTrendsData(const AnalyticsEngine::Prediction& prediction)
 {
-    PredictionData prediction = calculatePrediction();
-
     // Update labels
     currentCompletionLabel_->setText(QString::number(prediction.current, 'f', 1) + "%");
     predictedCompletionLabel_->setText(QString::number(prediction.predicted, 'f', 1) + "%");
@@ -489,7 +617,7 @@ void AnalyticsWidget::updateTrendsData()
 
 void AnalyticsWidget::updateShiftComparisonData()
 {
-    QList<ShiftStats> shifts = calculateShiftComparison();
+    QList<AnalyticsEngine::ShiftStats> shifts = engine_.shiftComparison();
 
     // Clear existing shift cards
     QLayoutItem* item;
@@ -503,7 +631,7 @@ void AnalyticsWidget::updateShiftComparisonData()
 
     // Create shift cards
     for (int i = 0; i < shifts.size(); i++) {
-        const ShiftStats& shift = shifts[i];
+        const AnalyticsEngine::ShiftStats& shift = shifts[i];
 
         QString borderColor = "#60a5fa";  // Blue
         if (i == 0) borderColor = "#4ade80";  // Green for best
@@ -566,7 +694,7 @@ void AnalyticsWidget::updateShiftComparisonData()
     barSet->setColor(QColor("#ff6b6b"));
 
     QStringList shiftNames;
-    for (const ShiftStats& shift : shifts) {
+    for (const AnalyticsEngine::ShiftStats& shift : shifts) {
         *barSet << shift.averageCompletion;
         shiftNames << shift.shiftName;
     }
@@ -598,9 +726,9 @@ void AnalyticsWidget::updateAutomatedInsights()
 {
     insightsList_->clear();
 
-    QList<Insight> insights = generateAutomatedInsights();
+    QList<AnalyticsEngine::Insight> insights = engine_.insights();
 
-    for (const Insight& insight : insights) {
+    for (const AnalyticsEngine::Insight& insight : insights) {
         QListWidgetItem* item = new QListWidgetItem(insightsList_);
 
         QString backgroundColor, borderColor;
@@ -641,206 +769,6 @@ void AnalyticsWidget::updateAutomatedInsights()
     }
 }
 
-AnalyticsWidget::PredictionData AnalyticsWidget::calculatePrediction()
-{
-    PredictionData result;
-    result.current = 0.0;
-    result.predicted = 0.0;
-    result.change = 0.0;
-    result.trend = "stable";
-
-    // OPTIMIZATION: Use cached data
-    if (cachedAssessments_.isEmpty()) {
-        return result;
-    }
-
-    // Calculate current completion rate
-    int totalScore = 0;
-    int maxPossibleScore = cachedAssessments_.size() * 3;  // Max score is 3 per assessment
-
-    for (const Assessment& assessment : cachedAssessments_) {
-        totalScore += assessment.score();
-    }
-
-    result.current = maxPossibleScore > 0 ? (totalScore * 100.0) / maxPossibleScore : 0.0;
-
-    // Simple prediction: assume 5% improvement
-    // In a real implementation, you'd use historical trend data
-    result.predicted = qMin(100.0, result.current + 5.0);
-    result.change = result.predicted - result.current;
-
-    if (result.change > 0.5) {
-        result.trend = "up";
-    } else if (result.change < -0.5) {
-        result.trend = "down";
-    } else {
-        result.trend = "stable";
-    }
-
-    return result;
-}
-
-QList<AnalyticsWidget::ShiftStats> AnalyticsWidget::calculateShiftComparison()
-{
-    // OPTIMIZATION: Use cached data
-    QMap<QString, ShiftStats> shiftsMap;
-
-    // Group engineers by shift
-    for (const Engineer& engineer : cachedEngineers_) {
-        QString shift = engineer.shift();
-        if (shift.isEmpty()) shift = "Unassigned";
-
-        if (!shiftsMap.contains(shift)) {
-            ShiftStats stats;
-            stats.shiftName = shift;
-            stats.averageCompletion = 0.0;
-            stats.engineerCount = 0;
-            stats.totalScore = 0;
-            stats.maxScore = 0;
-            shiftsMap[shift] = stats;
-        }
-
-        shiftsMap[shift].engineerCount++;
-
-        // Calculate scores for this engineer using cached assessments
-        for (const Assessment& assessment : cachedAssessments_) {
-            if (assessment.engineerId() == engineer.id()) {
-                shiftsMap[shift].totalScore += assessment.score();
-                shiftsMap[shift].maxScore += 3;
-            }
-        }
-    }
-
-    // Calculate average completion for each shift
-    QList<ShiftStats> result;
-    for (auto it = shiftsMap.begin(); it != shiftsMap.end(); ++it) {
-        ShiftStats stats = it.value();
-        if (stats.maxScore > 0) {
-            stats.averageCompletion = (stats.totalScore * 100.0) / stats.maxScore;
-        }
-        result.append(stats);
-    }
-
-    // Sort by average completion (descending)
-    std::sort(result.begin(), result.end(),
-              [](const ShiftStats& a, const ShiftStats& b) {
-                  return a.averageCompletion > b.averageCompletion;
-              });
-
-    return result;
-}
-
-QList<AnalyticsWidget::Insight> AnalyticsWidget::generateAutomatedInsights()
-{
-    // OPTIMIZATION: Use cached data and reuse already calculated results
-    QList<Insight> insights;
-
-    PredictionData prediction = calculatePrediction();
-    QList<ShiftStats> shifts = calculateShiftComparison();
-
-    // Trend insight
-    if (prediction.trend == "up") {
-        Insight insight;
-        insight.type = "positive";
-        insight.icon = "📈";
-        insight.title = "Positive Growth Trend";
-        insight.message = QString("Team competency is projected to increase by %1% based on current progress.")
-            .arg(QString::number(prediction.change, 'f', 1));
-        insights.append(insight);
-    } else if (prediction.trend == "down") {
-        Insight insight;
-        insight.type = "warning";
-        insight.icon = "📉";
-        insight.title = "Declining Trend Detected";
-        insight.message = QString("Team competency is projected to decrease by %1%. Consider additional training initiatives.")
-            .arg(QString::number(qAbs(prediction.change), 'f', 1));
-        insights.append(insight);
-    }
-
-    // Shift performance gap
-    if (shifts.size() > 1) {
-        double gap = shifts[0].averageCompletion - shifts[shifts.size() - 1].averageCompletion;
-        if (gap > 10.0) {
-            Insight insight;
-            insight.type = "alert";
-            insight.icon = "⚠️";
-            insight.title = "Shift Performance Gap";
-            insight.message = QString("%1 outperforms %2 by %3%. Consider cross-shift training programs.")
-                .arg(shifts[0].shiftName)
-                .arg(shifts[shifts.size() - 1].shiftName)
-                .arg(QString::number(gap, 'f', 1));
-            insights.append(insight);
-        }
-    }
-
-    // Low competency alert - use cached assessments
-    int lowScores = 0;
-    for (const Assessment& assessment : cachedAssessments_) {
-        if (assessment.score() < 2) {
-            lowScores++;
-        }
-    }
-
-    if (!cachedAssessments_.isEmpty()) {
-        double lowPercentage = (lowScores * 100.0) / cachedAssessments_.size();
-        if (lowPercentage > 30.0) {
-            Insight insight;
-            insight.type = "warning";
-            insight.icon = "🎯";
-            insight.title = "Training Priority Alert";
-            insight.message = QString("%1% of competencies are below proficient level. Prioritize structured training programs.")
-                .arg(QString::number(lowPercentage, 'f', 0));
-            insights.append(insight);
-        }
-    }
-
-    // Top performer recognition - use cached data
-    if (!cachedEngineers_.isEmpty()) {
-        struct EngineerScore {
-            QString name;
-            double percentage;
-        };
-        QList<EngineerScore> engineerScores;
-
-        for (const Engineer& engineer : cachedEngineers_) {
-            int totalScore = 0;
-            int maxScore = 0;
-
-            for (const Assessment& assessment : cachedAssessments_) {
-                if (assessment.engineerId() == engineer.id()) {
-                    totalScore += assessment.score();
-                    maxScore += 3;
-                }
-            }
-
-            if (maxScore > 0) {
-                EngineerScore score;
-                score.name = engineer.name();
-                score.percentage = (totalScore * 100.0) / maxScore;
-                engineerScores.append(score);
-            }
-        }
-
-        std::sort(engineerScores.begin(), engineerScores.end(),
-                  [](const EngineerScore& a, const EngineerScore& b) {
-                      return a.percentage > b.percentage;
-                  });
-
-        if (!engineerScores.isEmpty() && engineerScores[0].percentage >= 85.0) {
-            Insight insight;
-            insight.type = "positive";
-            insight.icon = "🏆";
-            insight.title = "Top Performer Recognition";
-            insight.message = QString("%1 leads the team with %2% competency mastery.")
-                .arg(engineerScores[0].name)
-                .arg(QString::number(engineerScores[0].percentage, 'f', 0));
-            insights.append(insight);
-        }
-    }
-
-    return insights;
-}
-
 void AnalyticsWidget::onTabChanged(int tabIndex)
 {
     contentStack_->setCurrentIndex(tabIndex);
@@ -888,8 +816,8 @@ void AnalyticsWidget::onTabChanged(int tabIndex)
 
 void AnalyticsWidget::onRefreshClicked()
 {
-    loadAnalytics();
-    Logger::instance().info("AnalyticsWidget", "Refreshed analytics data");
+    // Explicit refresh picks up changes made by other clients (synced in the background job)
+    loadAnalytics(SkillMatrixStore::AllDatasets);
 }
 
 // ============================================================================
@@ -1050,7 +978,7 @@ void AnalyticsWidget::updateEngineerRadarData()
     }
 
     // Calculate and display production areas radar
-    QMap<QString, double> productionData = calculateEngineerProductionRadarData(engineerId);
+    QMap<QString, double> productionData = engine_.engineerProductionRadar(engineerId);
     QPolarChart* productionChart = createRadarChart(
         productionData,
         "Production Areas Performance",
@@ -1059,7 +987,7 @@ void AnalyticsWidget::updateEngineerRadarData()
     engineerProductionRadarView_->setChart(productionChart);
 
     // Calculate and display core skills radar
-    QMap<QString, double> coreSkillsData = calculateEngineerCoreSkillsRadarData(engineerId);
+    QMap<QString, double> coreSkillsData = engine_.engineerCoreSkillsRadar(engineerId);
     QPolarChart* coreSkillsChart = createRadarChart(
         coreSkillsData,
         "Core Skills Performance",
@@ -1268,17 +1196,7 @@ void AnalyticsWidget::updateShiftOverviewData()
     QString dataType = shiftDataTypeCombo_->currentData().toString();
     bool isProductionData = (dataType == "PRODUCTION");
 
-    // Get unique shifts from cached engineers
-    QSet<QString> shifts;
-    for (const Engineer& engineer : cachedEngineers_) {
-        QString shift = engineer.shift();
-        if (!shift.isEmpty()) {
-            shifts.insert(shift);
-        }
-    }
-
-    QList<QString> shiftList = shifts.values();
-    std::sort(shiftList.begin(), shiftList.end());
+    QStringList shiftList = engine_.shifts();
 
     // If filter is not "ALL", only show selected shift
     if (selectedShift != "ALL" && !selectedShift.isEmpty()) {
@@ -1288,13 +1206,7 @@ void AnalyticsWidget::updateShiftOverviewData()
 
     // Create single large radar chart for each shift showing individual engineers
     for (const QString& shift : shiftList) {
-        // Get engineers in this shift
-        QList<Engineer> shiftEngineers;
-        for (const Engineer& engineer : cachedEngineers_) {
-            if (engineer.shift() == shift) {
-                shiftEngineers.append(engineer);
-            }
-        }
+        QList<Engineer> shiftEngineers = engine_.engineersInShift(shift);
 
         if (shiftEngineers.isEmpty()) {
             continue;
@@ -1315,12 +1227,12 @@ void AnalyticsWidget::updateShiftOverviewData()
 
         if (isProductionData) {
             for (const Engineer& engineer : shiftEngineers) {
-                engineerData[engineer.name()] = calculateEngineerProductionRadarData(engineer.id());
+                engineerData[engineer.name()] = engine_.engineerProductionRadar(engineer.id());
             }
             chartTitle = QString("Production Areas - %1").arg(shift);
         } else {
             for (const Engineer& engineer : shiftEngineers) {
-                engineerData[engineer.name()] = calculateEngineerCoreSkillsRadarData(engineer.id());
+                engineerData[engineer.name()] = engine_.engineerCoreSkillsRadar(engineer.id());
             }
             chartTitle = QString("Core Skills - %1").arg(shift);
         }
@@ -1562,210 +1474,6 @@ QPolarChart* AnalyticsWidget::createMultiEngineerRadarChart(const QMap<QString,
     return chart;
 }
 
-QMap<QString, double> AnalyticsWidget::calculateEngineerProductionRadarData(const QString& engineerId)
-{
-    QMap<QString, double> radarData;
-
-    // Get all assessments for this engineer
-    QList<Assessment> engineerAssessments;
-    for (const Assessment& assessment : cachedAssessments_) {
-        if (assessment.engineerId() == engineerId) {
-            engineerAssessments.append(assessment);
-        }
-    }
-
-    if (engineerAssessments.isEmpty()) {
-        return radarData;
-    }
-
-    // Get all competencies and machines
-    QList<Competency> allCompetencies;
-    QList<Machine> allMachines;
-    for (const ProductionArea& area : cachedAreas_) {
-        QList<Machine> areaMachines = productionRepo_.findMachinesByArea(area.id());
-        allMachines.append(areaMachines);
-        for (const Machine& machine : areaMachines) {
-            QList<Competency> machineCompetencies = productionRepo_.findCompetenciesByMachine(machine.id());
-            allCompetencies.append(machineCompetencies);
-        }
-    }
-
-    // Group by production area
-    QMap<QString, double> areaWeightedSum;
-    QMap<QString, double> areaTotalWeights;
-
-    for (const Assessment& assessment : engineerAssessments) {
-        // Find the competency
-        for (const Competency& comp : allCompetencies) {
-            if (comp.id() == assessment.competencyId()) {
-                // Find the machine to get the area
-                for (const Machine& machine : allMachines) {
-                    if (machine.id() == comp.machineId()) {
-                        // Find the area name
-                        for (const ProductionArea& area : cachedAreas_) {
-                            if (area.id() == machine.productionAreaId()) {
-                                QString areaName = area.name();
-                                // Combined weight: competency weight × machine production impact
-                                double competencyWeight = comp.calculatedWeight();
-                                double machineImpact = machine.importance(); // 0-3 scale
-                                double combinedWeight = competencyWeight * (machineImpact + 1); // +1 to avoid zero weight
-                                areaWeightedSum[areaName] += assessment.score() * combinedWeight;
-                                areaTotalWeights[areaName] += combinedWeight;
-                                break;
-                            }
-                        }
-                        break;
-                    }
-                }
-                break;
-            }
-        }
-    }
-
-    // Calculate weighted averages
-    for (auto it = areaWeightedSum.constBegin(); it != areaWeightedSum.constEnd(); ++it) {
-        QString areaName = it.key();
-        if (areaTotalWeights[areaName] > 0) {
-            radarData[areaName] = it.value() / areaTotalWeights[areaName];
-        }
-    }
-
-    return radarData;
-}
-
-QMap<QString, double> AnalyticsWidget::calculateEngineerCoreSkillsRadarData(const QString& engineerId)
-{
-    QMap<QString, double> radarData;
-
-    // Get all core skill assessments for this engineer
-    QList<CoreSkillAssessment> allAssessments = coreSkillsRepo_.findAllAssessments();
-    QList<CoreSkillAssessment> engineerAssessments;
-    for (const CoreSkillAssessment& assessment : allAssessments) {
-        if (assessment.engineerId() == engineerId) {
-            engineerAssessments.append(assessment);
-        }
-    }
-
-    if (engineerAssessments.isEmpty()) {
-        return radarData;
-    }
-
-    // Get all core skills and categories
-    QList<CoreSkill> allSkills = coreSkillsRepo_.findAllSkills();
-    QList<CoreSkillCategory> allCategories = coreSkillsRepo_.findAllCategories();
-
-    // Group by category
-    QMap<QString, double> categoryWeightedSum;
-    QMap<QString, double> categoryTotalWeights;
-
-    for (const CoreSkillAssessment& assessment : engineerAssessments) {
-        // Find the skill
-        for (const CoreSkill& skill : allSkills) {
-            if (skill.id() == assessment.skillId()) {
-                // Find the category
-                for (const CoreSkillCategory& category : allCategories) {
-                    if (category.id() == skill.categoryId()) {
-                        QString categoryName = category.name();
-                        double weight = skill.calculatedWeight();
-                        categoryWeightedSum[categoryName] += assessment.score() * weight;
-                        categoryTotalWeights[categoryName] += weight;
-                        break;
-                    }
-                }
-                break;
-            }
-        }
-    }
-
-    // Calculate weighted averages
-    for (auto it = categoryWeightedSum.constBegin(); it != categoryWeightedSum.constEnd(); ++it) {
-        QString categoryName = it.key();
-        if (categoryTotalWeights[categoryName] > 0) {
-            radarData[categoryName] = it.value() / categoryTotalWeights[categoryName];
-        }
-    }
-
-    return radarData;
-}
-
-QMap<QString, double> AnalyticsWidget::calculateShiftProductionRadarData(const QString& shift)
-{
-    QMap<QString, double> aggregatedData;
-
-    // Get all engineers in this shift
-    QList<Engineer> shiftEngineers;
-    for (const Engineer& engineer : cachedEngineers_) {
-        if (engineer.shift() == shift) {
-            shiftEngineers.append(engineer);
-        }
-    }
-
-    if (shiftEngineers.isEmpty()) {
-        return aggregatedData;
-    }
-
-    // Aggregate data from all engineers in the shift
-    QMap<QString, double> totalScores;
-    QMap<QString, int> areaCounts;
-
-    for (const Engineer& engineer : shiftEngineers) {
-        QMap<QString, double> engineerData = calculateEngineerProductionRadarData(engineer.id());
-        for (auto it = engineerData.constBegin(); it != engineerData.constEnd(); ++it) {
-            totalScores[it.key()] += it.value();
-            areaCounts[it.key()]++;
-        }
-    }
-
-    // Calculate averages
-    for (auto it = totalScores.constBegin(); it != totalScores.constEnd(); ++it) {
-        QString areaName = it.key();
-        if (areaCounts[areaName] > 0) {
-            aggregatedData[areaName] = it.value() / areaCounts[areaName];
-        }
-    }
-
-    return aggregatedData;
-}
-
-QMap<QString, double> AnalyticsWidget::calculateShiftCoreSkillsRadarData(const QString& shift)
-{
-    QMap<QString, double> aggregatedData;
-
-    // Get all engineers in this shift
-    QList<Engineer> shiftEngineers;
-    for (const Engineer& engineer : cachedEngineers_) {
-        if (engineer.shift() == shift) {
-            shiftEngineers.append(engineer);
-        }
-    }
-
-    if (shiftEngineers.isEmpty()) {
-        return aggregatedData;
-    }
-
-    // Aggregate data from all engineers in the shift
-    QMap<QString, double> totalScores;
-    QMap<QString, int> categoryCounts;
-
-    for (const Engineer& engineer : shiftEngineers) {
-        QMap<QString, double> engineerData = calculateEngineerCoreSkillsRadarData(engineer.id());
-        for (auto it = engineerData.constBegin(); it != engineerData.constEnd(); ++it) {
-            totalScores[it.key()] += it.value();
-            categoryCounts[it.key()]++;
-        }
-    }
-
-    // Calculate averages
-    for (auto it = totalScores.constBegin(); it != totalScores.constEnd(); ++it) {
-        QString categoryName = it.key();
-        if (categoryCounts[categoryName] > 0) {
-            aggregatedData[categoryName] = it.value() / categoryCounts[categoryName];
-        }
-    }
-
-    return aggregatedData;
-}
-
 QString AnalyticsWidget::abbreviateLabel(const QString& label) const
 {
     // Production area abbreviations to save space
@@ -9,10 +9,10 @@
 #include <QtCharts/QChartView>
 #include <QtCharts/QPolarChart>
 #include <QComboBox>
-#include "../database/AssessmentRepository.h"
-#include "../database/EngineerRepository.h"
-#include "../database/ProductionRepository.h"
-#include "../database/CoreSkillsRepository.h"
+#include <QFutureWatcher>
+#include <QPromise>
+#include "../controllers/AnalyticsEngine.h"
+#include "../database/SkillMatrixStore.h"
 
 class AnalyticsWidget : public QWidget
 {
@@ -22,16 +22,32 @@ public:
     explicit AnalyticsWidget(QWidget* parent = nullptr);
     ~AnalyticsWidget();
 
+    /**
+     * @brief One stage of a background analytics load, delivered in order
+     */
+    struct LoadResult {
+        enum Stage { Roster, Trends, Engine };
+
+        Stage stage = Roster;
+        QList<Engineer> engineers;              // Roster
+        QStringList shifts;                     // Roster
+        AnalyticsEngine::Prediction prediction; // Trends
+        AnalyticsEngine engine;                 // Engine
+    };
+
 protected:
     void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 
 signals:
     void dataLoadingFinished();
 
 public slots:
-    void refresh() { loadAnalytics(); }  // Public refresh method
+    void refresh();  // Public refresh method
 
 private slots:
+    void onLoadResultReady(int index);
+    void onLoadFinished();
     void onTabChanged(int tabIndex);
     void onRefreshClicked();
     void onEngineerSelected(int index);
@@ -44,7 +60,16 @@ private slots:
 
 private:
     void setupUI();
-    void loadAnalytics();
+
+    /**
+     * @brief Start a background load, replacing any load in flight
+     * @param syncFirst Datasets to sync with the database before computing
+     */
+    void loadAnalytics(SkillMatrixStore::Datasets syncFirst = {});
+    void cancelLoad();
+    void setLoading(bool loading);
+    void populateSelectors(const QList<Engineer>& engineers, const QStringList& shifts);
+    static void computeAnalytics(QPromise<LoadResult>& promise, SkillMatrixStore::Datasets syncFirst);
 
     // Tab setup methods
     void setupTrendsTab(QWidget* trendsWidget);
@@ -54,38 +79,12 @@ private:
     void setupShiftOverviewTab(QWidget* shiftOverviewWidget);
 
     // Data update methods
-    void updateTrendsData();
+    void updateTrendsData(const AnalyticsEngine::Prediction& prediction);
     void updateShiftComparisonData();
     void updateAutomatedInsights();
     void updateEngineerRadarData();
     void updateShiftOverviewData();
 
-    // Helper methods
-    struct PredictionData {
-        double current;
-        double predicted;
-        double change;
-        QString trend;  // "up", "down", "stable"
-    };
-    PredictionData calculatePrediction();
-
-    struct ShiftStats {
-        QString shiftName;
-        double averageCompletion;
-        int engineerCount;
-        int totalScore;
-        int maxScore;
-    };
-    QList<ShiftStats> calculateShiftComparison();
-
-    struct Insight {
-        QString type;  // "positive", "warning", "alert"
-        QString icon;
-        QString title;
-        QString message;
-    };
-    QList<Insight> generateAutomatedInsights();
-
     // Radar chart helper methods
     QPolarChart* createRadarChart(const QMap<QString, double>& data,
                                   const QString& title,
@@ -93,10 +92,6 @@ private:
     QPolarChart* createMultiEngineerRadarChart(const QMap<QString, QMap<QString, double>>& engineerDataMap,
                                                const QString& title,
                                                bool isProductionData);
-    QMap<QString, double> calculateEngineerProductionRadarData(const QString& engineerId);
-    QMap<QString, double> calculateEngineerCoreSkillsRadarData(const QString& engineerId);
-    QMap<QString, double> calculateShiftProductionRadarData(const QString& shift);
-    QMap<QString, double> calculateShiftCoreSkillsRadarData(const QString& shift);
     QString abbreviateLabel(const QString& label) const;
 
 private:
@@ -132,20 +127,12 @@ private:
     QWidget* shiftRadarContainer_;
     QList<QChartView*> shiftRadarViews_;
 
-    // Repositories
-    AssessmentRepository assessmentRepo_;
-    EngineerRepository engineerRepo_;
-    ProductionRepository productionRepo_;
-    CoreSkillsRepository coreSkillsRepo_;
-
-    // Cached data for performance optimization
-    QList<Engineer> cachedEngineers_;
-    QList<Assessment> cachedAssessments_;
-    QList<ProductionArea> cachedAreas_;
-    int cachedTotalCompetencies_;
+    // Results for the current view, computed once per load
+    AnalyticsEngine engine_;
 
-    // Lazy loading state
-    bool isFirstShow_;
+    // Background loading (deferred until shown)
+    QFutureWatcher<LoadResult>* loadWatcher_;
+    bool needsLoad_;
 
     // Chart sizing state
     int engineerRadarChartHeight_;
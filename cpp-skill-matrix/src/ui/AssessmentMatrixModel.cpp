@@ -0,0 +1,216 @@
+#include "AssessmentMatrixModel.h"
+#include "../utils/Logger.h"
+#include <algorithm>
+
+AssessmentMatrixModel::AssessmentMatrixModel(QObject* parent)
+    : QAbstractTableModel(parent)
+    , areaFilter_(0)
+{
+}
+
+AssessmentMatrixModel::~AssessmentMatrixModel()
+{
+}
+
+void AssessmentMatrixModel::setMatrix(const QList<Engineer>& engineers,
+                                      const ProductionHierarchy& hierarchy,
+                                      const CompetencyScoreMatrix& scores)
+{
+    beginResetModel();
+
+    engineers_ = engineers;
+    hierarchy_ = hierarchy;
+    scores_ = scores;
+
+    // Sort engineers by name
+    rows_.clear();
+    rows_.reserve(engineers_.size());
+    for (int i = 0; i < engineers_.size(); ++i) {
+        rows_.append(i);
+    }
+    std::sort(rows_.begin(), rows_.end(), [this](int a, int b) {
+        return engineers_[a].name() < engineers_[b].name();
+    });
+
+    matrixRows_.clear();
+    matrixRows_.reserve(rows_.size());
+    for (int position : rows_) {
+        matrixRows_.append(scores_.rowIndex(engineers_[position].id()));
+    }
+
+    rebuildColumns();
+    endResetModel();
+}
+
+void AssessmentMatrixModel::setAreaFilter(int areaId)
+{
+    if (areaId == areaFilter_) {
+        return;
+    }
+
+    beginResetModel();
+    areaFilter_ = areaId;
+    rebuildColumns();
+    endResetModel();
+}
+
+void AssessmentMatrixModel::rebuildColumns()
+{
+    // Hierarchy order: area -> machine -> competency
+    columns_.clear();
+    for (const ProductionArea& area : hierarchy_.areas()) {
+        if (areaFilter_ != 0 && area.id() != areaFilter_) {
+            continue;
+        }
+        for (const Machine& machine : hierarchy_.machinesByArea(area.id())) {
+            for (const Competency& competency : hierarchy_.competenciesByMachine(machine.id())) {
+                int column = scores_.columnIndex(competency.id());
+                if (column >= 0) {
+                    columns_.append(column);
+                }
+            }
+        }
+    }
+    columnMask_ = scores_.columnMask(columns_);
+}
+
+int AssessmentMatrixModel::trainedCount(int row) const
+{
+    // Trained = scored above "not trained" within the visible columns
+    ScoreStats stats = scores_.rowStats(matrixRows_[row], columnMask_);
+    return stats.assessed - stats.counts[Constants::SCORE_NOT_TRAINED];
+}
+
+// ============================================================================
+// QAbstractTableModel
+// ============================================================================
+
+int AssessmentMatrixModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : rows_.size();
+}
+
+int AssessmentMatrixModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : columns_.size();
+}
+
+QVariant AssessmentMatrixModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows_.size() || index.column() >= columns_.size()) {
+        return QVariant();
+    }
+
+    int score = scores_.score(matrixRows_[index.row()], columns_[index.column()]);
+
+    switch (role) {
+        case Qt::DisplayRole:
+            return score >= 0 ? QVariant(score) : QVariant();
+        case Qt::EditRole:
+            return score;
+        case Qt::ToolTipRole: {
+            const Engineer& engineer = engineers_[rows_[index.row()]];
+            Competency competency = hierarchy_.competency(scores_.columnIds()[columns_[index.column()]]);
+            return QString("%1 — %2: %3")
+                .arg(engineer.name(), competency.name(),
+                     score >= 0 ? QString::number(score) : QString("not assessed"));
+        }
+        case EngineerIdRole:
+            return engineers_[rows_[index.row()]].id();
+        case CompetencyIdRole:
+            return scores_.columnIds()[columns_[index.column()]];
+        default:
+            return QVariant();
+    }
+}
+
+bool AssessmentMatrixModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (!index.isValid() || role != Qt::EditRole) {
+        return false;
+    }
+
+    bool ok = false;
+    int score = value.toInt(&ok);
+    if (!ok || score < 0 || score > Constants::SCORE_MAX) {
+        return false;
+    }
+
+    int matrixRow = matrixRows_[index.row()];
+    int matrixColumn = columns_[index.column()];
+    if (scores_.score(matrixRow, matrixColumn) == score) {
+        return true;
+    }
+
+    const Engineer& engineer = engineers_[rows_[index.row()]];
+    int competencyId = scores_.columnIds()[matrixColumn];
+    int machineId = hierarchy_.machineIdForCompetency(competencyId);
+    int areaId = hierarchy_.areaIdForMachine(machineId);
+
+    Assessment assessment(0, engineer.id(), areaId, machineId, competencyId, score);
+    if (!assessmentRepo_.saveOrUpdate(assessment)) {
+        lastError_ = assessmentRepo_.lastError();
+        Logger::instance().error("AssessmentMatrixModel", "Failed to save assessment: " + lastError_);
+        emit saveFailed(lastError_);
+        return false;
+    }
+
+    Logger::instance().info("AssessmentMatrixModel",
+        QString("Saved score %1 for engineer %2, competency %3")
+            .arg(score).arg(engineer.id()).arg(competencyId));
+
+    scores_.setScore(matrixRow, matrixColumn, score);
+    emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole, Qt::ToolTipRole});
+    emit headerDataChanged(Qt::Vertical, index.row(), index.row());
+    return true;
+}
+
+QVariant AssessmentMatrixModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal) {
+        if (section < 0 || section >= columns_.size()) {
+            return QVariant();
+        }
+        int competencyId = scores_.columnIds()[columns_[section]];
+        if (role == Qt::DisplayRole) {
+            return hierarchy_.competency(competencyId).name();
+        }
+        if (role == Qt::ToolTipRole) {
+            int machineId = hierarchy_.machineIdForCompetency(competencyId);
+            return QString("%1 › %2 › %3")
+                .arg(hierarchy_.area(hierarchy_.areaIdForMachine(machineId)).name(),
+                     hierarchy_.machine(machineId).name(),
+                     hierarchy_.competency(competencyId).name());
+        }
+        return QVariant();
+    }
+
+    if (section < 0 || section >= rows_.size()) {
+        return QVariant();
+    }
+    const Engineer& engineer = engineers_[rows_[section]];
+    if (role == Qt::DisplayRole) {
+        return QString("%1  (%2/%3)").arg(engineer.name()).arg(trainedCount(section)).arg(columns_.size());
+    }
+    if (role == Qt::ToolTipRole) {
+        return QString("%1/%2 competencies trained").arg(trainedCount(section)).arg(columns_.size());
+    }
+    if (role == TrainedCountRole) {
+        return trainedCount(section);
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags AssessmentMatrixModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+
+    Qt::ItemFlags itemFlags = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+    // Engineers added since the matrix was built have no row to write into yet
+    if (matrixRows_[index.row()] >= 0) {
+        itemFlags |= Qt::ItemIsEditable;
+    }
+    return itemFlags;
+}
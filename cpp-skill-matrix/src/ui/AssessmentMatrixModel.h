@@ -0,0 +1,85 @@
+#ifndef ASSESSMENTMATRIXMODEL_H
+#define ASSESSMENTMATRIXMODEL_H
+
+#include <QAbstractTableModel>
+#include <QList>
+#include "../database/AssessmentRepository.h"
+#include "../models/Engineer.h"
+#include "../models/ProductionHierarchy.h"
+#include "../models/ScoreMatrix.h"
+
+/**
+ * @brief Engineer x competency assessment grid for a QTableView
+ *
+ * Rows are engineers (sorted by name), columns the competencies of the
+ * selected production area in hierarchy order. Cells are read straight from a
+ * CompetencyScoreMatrix, so the model holds no per-cell objects and the view
+ * only asks for what is on screen. Writing a score through setData() saves it
+ * with AssessmentRepository (which updates the SkillMatrixStore).
+ */
+class AssessmentMatrixModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        EngineerIdRole = Qt::UserRole + 1,
+        CompetencyIdRole,
+        TrainedCountRole    // vertical header: competencies scored above 0 in the filter
+    };
+
+    explicit AssessmentMatrixModel(QObject* parent = nullptr);
+    ~AssessmentMatrixModel();
+
+    /**
+     * @brief Replace the whole grid
+     */
+    void setMatrix(const QList<Engineer>& engineers,
+                   const ProductionHierarchy& hierarchy,
+                   const CompetencyScoreMatrix& scores);
+
+    /**
+     * @brief Show only competencies of one production area (0 = all areas)
+     */
+    void setAreaFilter(int areaId);
+    int areaFilter() const { return areaFilter_; }
+
+    int engineerCount() const { return rows_.size(); }
+    int competencyCount() const { return columns_.size(); }
+
+    QString lastError() const { return lastError_; }
+
+    // QAbstractTableModel
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+signals:
+    /**
+     * @brief A score could not be saved; the cell keeps its previous value
+     */
+    void saveFailed(const QString& error);
+
+private:
+    void rebuildColumns();
+    int trainedCount(int row) const;
+
+private:
+    QList<Engineer> engineers_;
+    ProductionHierarchy hierarchy_;
+    CompetencyScoreMatrix scores_;
+
+    int areaFilter_;
+    QList<int> rows_;               // view row -> position in engineers_ (sorted by name)
+    QList<int> matrixRows_;         // view row -> matrix row
+    QList<int> columns_;            // view column -> matrix column
+    ScoreGrid::ColumnMask columnMask_;
+
+    AssessmentRepository assessmentRepo_;
+    QString lastError_;
+};
+
+#endif // ASSESSMENTMATRIXMODEL_H
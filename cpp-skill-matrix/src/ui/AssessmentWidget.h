@@ -4,16 +4,19 @@
 #include <QWidget>
 #include <QComboBox>
 #include <QPushButton>
-#include <QScrollArea>
-#include <QVBoxLayout>
+#include <QTableView>
 #include <QLabel>
-#include <QMap>
-#include "../database/EngineerRepository.h"
-#include "../database/ProductionRepository.h"
-#include "../database/AssessmentRepository.h"
-#include "../models/Engineer.h"
-#include "../models/Competency.h"
+#include "../database/SkillMatrixStore.h"
 
+class AssessmentMatrixModel;
+
+/**
+ * @brief Engineer x competency assessment grid
+ *
+ * One QTableView over an AssessmentMatrixModel; cells are painted by a
+ * ScoreDelegate, so the widget count stays constant however many engineers
+ * and competencies there are.
+ */
 class AssessmentWidget : public QWidget
 {
     Q_OBJECT
@@ -30,45 +33,22 @@ signals:
 
 private slots:
     void onAreaFilterChanged(int index);
-    void onScoreButtonClicked();
     void onRefreshClicked();
+    void onSaveFailed(const QString& error);
 
 private:
     void setupUI();
-    void loadEngineerCards();
-    void createScoreButtons(QHBoxLayout* layout, const QString& engineerId, int areaId, int machineId, int competencyId, int currentScore);
-    void updateEngineerSummary(const QString& engineerId, QLabel* summaryLabel);
+    void loadMatrix();
+    void populateAreaFilter(const ProductionHierarchy& hierarchy);
 
 private:
     QComboBox* areaFilterCombo_;
-    QVBoxLayout* engineersLayout_;  // Container for engineer cards
-    QWidget* engineersContainer_;
-
-    // Map to track score button groups
-    struct ScoreButtonGroup {
-        QPushButton* buttons[4];  // 0-3 buttons
-        QString engineerId;
-        QString competencyId;
-    };
-    QList<ScoreButtonGroup> scoreButtonGroups_;
-
-    EngineerRepository engineerRepo_;
-    ProductionRepository productionRepo_;
-    AssessmentRepository assessmentRepo_;
+    QTableView* matrixView_;
+    AssessmentMatrixModel* model_;
 
     // Lazy loading state
     bool isFirstShow_;
     QLabel* loadingLabel_;
-
-    // Cached data for performance
-    QList<Engineer> cachedEngineers_;
-    QMap<QString, int> cachedAssessmentScores_;
-    QMap<int, QString> cachedAreaNames_;  // areaId -> areaName lookup
-    struct MachineData {
-        Machine machine;
-        QList<Competency> competencies;
-    };
-    QMap<int, QList<MachineData>> cachedAreaToMachines_;
 };
 
 #endif // ASSESSMENTWIDGET_H
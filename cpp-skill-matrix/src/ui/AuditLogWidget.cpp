@@ -5,10 +5,15 @@
 #include <QHeaderView>
 #include <QLabel>
 
+namespace {
+constexpr int AUDIT_PAGE_SIZE = 100;
+}
+
 AuditLogWidget::AuditLogWidget(QWidget* parent)
     : QWidget(parent)
     , auditTable_(nullptr)
     , refreshButton_(nullptr)
+    , loadMoreButton_(nullptr)
 {
     setupUI();
     loadAuditLogs();
@@ -48,6 +53,10 @@ void AuditLogWidget::setupUI()
     refreshButton_ = new QPushButton("Refresh", this);
     connect(refreshButton_, &QPushButton::clicked, this, &AuditLogWidget::onRefreshClicked);
 
+    loadMoreButton_ = new QPushButton("Load Older Entries", this);
+    connect(loadMoreButton_, &QPushButton::clicked, this, &AuditLogWidget::onLoadMoreClicked);
+
+    buttonLayout->addWidget(loadMoreButton_);
     buttonLayout->addStretch();
     buttonLayout->addWidget(refreshButton_);
 
@@ -59,24 +68,40 @@ void AuditLogWidget::setupUI()
 void AuditLogWidget::loadAuditLogs()
 {
     auditTable_->setRowCount(0);
+    nextPage_ = PageCursor();
+    appendPage();
+}
 
-    QList<AuditLog> logs = auditLogRepo_.findAll(100); // Last 100 logs
+void AuditLogWidget::appendPage()
+{
+    // Newest first, one bounded page at a time
+    Page<AuditLog> page = auditLogRepo_.findPage(AUDIT_PAGE_SIZE, nextPage_);
+    nextPage_ = page.next;
 
-    auditTable_->setRowCount(logs.size());
+    int firstRow = auditTable_->rowCount();
+    auditTable_->setRowCount(firstRow + page.items.size());
 
-    for (int i = 0; i < logs.size(); ++i) {
-        const AuditLog& log = logs[i];
+    for (int i = 0; i < page.items.size(); ++i) {
+        const AuditLog& log = page.items[i];
+        int row = firstRow + i;
 
-        auditTable_->setItem(i, 0, new QTableWidgetItem(log.timestamp().toString("yyyy-MM-dd hh:mm:ss")));
-        auditTable_->setItem(i, 1, new QTableWidgetItem(log.userId()));
-        auditTable_->setItem(i, 2, new QTableWidgetItem(log.action()));
-        auditTable_->setItem(i, 3, new QTableWidgetItem(log.details()));
+        auditTable_->setItem(row, 0, new QTableWidgetItem(log.timestamp().toString("yyyy-MM-dd hh:mm:ss")));
+        auditTable_->setItem(row, 1, new QTableWidgetItem(log.userId()));
+        auditTable_->setItem(row, 2, new QTableWidgetItem(log.action()));
+        auditTable_->setItem(row, 3, new QTableWidgetItem(log.details()));
     }
 
-    Logger::instance().info("AuditLogWidget", QString("Loaded %1 audit log entries").arg(logs.size()));
+    loadMoreButton_->setEnabled(page.hasMore);
+
+    Logger::instance().info("AuditLogWidget", QString("Loaded %1 audit log entries").arg(page.items.size()));
 }
 
 void AuditLogWidget::onRefreshClicked()
 {
     loadAuditLogs();
 }
+
+void AuditLogWidget::onLoadMoreClicked()
+{
+    appendPage();
+}
@@ -16,14 +16,19 @@ public:
 
 private slots:
     void onRefreshClicked();
+    void onLoadMoreClicked();
 
 private:
     void setupUI();
     void loadAuditLogs();
+    void appendPage();
 
 private:
     QTableWidget* auditTable_;
     QPushButton* refreshButton_;
+    QPushButton* loadMoreButton_;
+
+    PageCursor nextPage_;   // continues after the last row shown
 
     AuditLogRepository auditLogRepo_;
 };
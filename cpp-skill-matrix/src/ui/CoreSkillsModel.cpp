@@ -0,0 +1,237 @@
+#include "CoreSkillsModel.h"
+#include "../core/Constants.h"
+#include <QFont>
+
+CoreSkillsModel::CoreSkillsModel(QObject* parent)
+    : QAbstractTableModel(parent)
+    , modified_(false)
+{
+}
+
+CoreSkillsModel::~CoreSkillsModel()
+{
+}
+
+void CoreSkillsModel::setCatalog(const QList<CoreSkillCategory>& categories, const QList<CoreSkill>& skills)
+{
+    beginResetModel();
+
+    categories_ = categories;
+    skills_ = skills;
+
+    // Group skill positions by category once instead of rescanning per category
+    QHash<QString, QList<int>> skillsByCategory;
+    for (int i = 0; i < skills_.size(); ++i) {
+        skillsByCategory[skills_[i].categoryId()].append(i);
+    }
+
+    rows_.clear();
+    for (int c = 0; c < categories_.size(); ++c) {
+        const QList<int> positions = skillsByCategory.value(categories_[c].id());
+        if (positions.isEmpty()) {
+            continue;
+        }
+        rows_.append({c, -1});
+        for (int position : positions) {
+            rows_.append({c, position});
+        }
+    }
+
+    loadScores();
+    endResetModel();
+}
+
+void CoreSkillsModel::setAssessments(const QList<CoreSkillAssessment>& assessments)
+{
+    scoreIndex_.clear();
+    for (const CoreSkillAssessment& assessment : assessments) {
+        scoreIndex_[assessment.engineerId()].insert(assessment.skillId(), assessment.score());
+    }
+
+    loadScores();
+    if (!rows_.isEmpty()) {
+        emit dataChanged(index(0, ScoreColumn), index(rows_.size() - 1, ScoreColumn));
+    }
+}
+
+void CoreSkillsModel::setEngineer(const QString& engineerId)
+{
+    if (engineerId == engineerId_) {
+        return;
+    }
+
+    engineerId_ = engineerId;
+    loadScores();
+    if (!rows_.isEmpty()) {
+        emit dataChanged(index(0, ScoreColumn), index(rows_.size() - 1, ScoreColumn));
+    }
+}
+
+void CoreSkillsModel::loadScores()
+{
+    // Skills without an assessment show as 0, as they are saved
+    const QHash<QString, int> engineerScores = scoreIndex_.value(engineerId_);
+    scores_.fill(0, skills_.size());
+    for (int i = 0; i < skills_.size(); ++i) {
+        scores_[i] = engineerScores.value(skills_[i].id(), 0);
+    }
+    modified_ = false;
+}
+
+bool CoreSkillsModel::isCategoryRow(int row) const
+{
+    return row >= 0 && row < rows_.size() && rows_[row].skill < 0;
+}
+
+QList<CoreSkillAssessment> CoreSkillsModel::assessments() const
+{
+    QList<CoreSkillAssessment> result;
+    if (engineerId_.isEmpty()) {
+        return result;
+    }
+
+    result.reserve(skills_.size());
+    for (const Row& row : rows_) {
+        if (row.skill < 0) {
+            continue;
+        }
+        CoreSkillAssessment assessment;
+        assessment.setEngineerId(engineerId_);
+        assessment.setCategoryId(skills_[row.skill].categoryId());
+        assessment.setSkillId(skills_[row.skill].id());
+        assessment.setScore(scores_[row.skill]);
+        result.append(assessment);
+    }
+    return result;
+}
+
+void CoreSkillsModel::markSaved()
+{
+    if (engineerId_.isEmpty()) {
+        return;
+    }
+
+    QHash<QString, int>& engineerScores = scoreIndex_[engineerId_];
+    for (int i = 0; i < skills_.size(); ++i) {
+        engineerScores.insert(skills_[i].id(), scores_[i]);
+    }
+    modified_ = false;
+}
+
+// ============================================================================
+// QAbstractTableModel
+// ============================================================================
+
+int CoreSkillsModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : rows_.size();
+}
+
+int CoreSkillsModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant CoreSkillsModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rows_.size()) {
+        return QVariant();
+    }
+
+    const Row& row = rows_[index.row()];
+
+    if (row.skill < 0) {
+        // Category heading
+        if (index.column() != NameColumn) {
+            return QVariant();
+        }
+        switch (role) {
+            case Qt::DisplayRole:
+                return categories_[row.category].name();
+            case Qt::FontRole: {
+                QFont font;
+                font.setPointSize(14);
+                font.setBold(true);
+                return font;
+            }
+            case CategoryRowRole:
+                return true;
+            default:
+                return QVariant();
+        }
+    }
+
+    const CoreSkill& skill = skills_[row.skill];
+
+    if (role == SkillIdRole) {
+        return skill.id();
+    }
+    if (role == CategoryRowRole) {
+        return false;
+    }
+
+    if (index.column() == NameColumn) {
+        if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
+            return skill.name();
+        }
+        return QVariant();
+    }
+
+    switch (role) {
+        case Qt::DisplayRole:
+        case Qt::EditRole:
+            return scores_[row.skill];
+        default:
+            return QVariant();
+    }
+}
+
+bool CoreSkillsModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (!index.isValid() || role != Qt::EditRole || index.column() != ScoreColumn
+        || isCategoryRow(index.row()) || engineerId_.isEmpty()) {
+        return false;
+    }
+
+    bool ok = false;
+    int score = value.toInt(&ok);
+    if (!ok || score < 0 || score > Constants::SCORE_MAX) {
+        return false;
+    }
+
+    int skill = rows_[index.row()].skill;
+    if (scores_[skill] != score) {
+        scores_[skill] = score;
+        modified_ = true;
+        emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+    }
+    return true;
+}
+
+QVariant CoreSkillsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (section) {
+        case NameColumn:  return QString("Skill");
+        case ScoreColumn: return QString("Score");
+        default:          return QVariant();
+    }
+}
+
+Qt::ItemFlags CoreSkillsModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) {
+        return Qt::NoItemFlags;
+    }
+    if (isCategoryRow(index.row())) {
+        return Qt::ItemIsEnabled;
+    }
+
+    Qt::ItemFlags itemFlags = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+    if (index.column() == ScoreColumn && !engineerId_.isEmpty()) {
+        itemFlags |= Qt::ItemIsEditable;
+    }
+    return itemFlags;
+}
@@ -0,0 +1,100 @@
+#ifndef CORESKILLSMODEL_H
+#define CORESKILLSMODEL_H
+
+#include <QAbstractTableModel>
+#include <QList>
+#include <QHash>
+#include <QVector>
+#include "../models/CoreSkillCategory.h"
+#include "../models/CoreSkill.h"
+#include "../models/CoreSkillAssessment.h"
+
+/**
+ * @brief Core skill scores of one engineer, grouped by category, for a QTableView
+ *
+ * Rows are a category heading followed by that category's skills; column 0 is
+ * the name, column 1 the 0-3 score (paint it with ScoreDelegate). Scores are
+ * looked up in an engineer -> skill -> score index built once from the
+ * assessments, so switching engineers is a hash lookup per skill and one
+ * dataChanged() for the score column. Edits stay in the model until the
+ * owner saves assessments() and calls markSaved().
+ */
+class CoreSkillsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Columns {
+        NameColumn = 0,
+        ScoreColumn,
+        ColumnCount
+    };
+
+    enum Roles {
+        SkillIdRole = Qt::UserRole + 1,
+        CategoryRowRole     // true on category heading rows
+    };
+
+    explicit CoreSkillsModel(QObject* parent = nullptr);
+    ~CoreSkillsModel();
+
+    /**
+     * @brief Replace categories and skills (resets the model)
+     */
+    void setCatalog(const QList<CoreSkillCategory>& categories, const QList<CoreSkill>& skills);
+
+    /**
+     * @brief Rebuild the score index; discards unsaved edits
+     */
+    void setAssessments(const QList<CoreSkillAssessment>& assessments);
+
+    /**
+     * @brief Show another engineer's scores (empty = none selected, read-only)
+     */
+    void setEngineer(const QString& engineerId);
+    QString engineerId() const { return engineerId_; }
+
+    const QList<CoreSkill>& skills() const { return skills_; }
+    int score(int skillPosition) const { return scores_.value(skillPosition, 0); }
+    bool isCategoryRow(int row) const;
+    bool isModified() const { return modified_; }
+
+    /**
+     * @brief One assessment per skill with the current scores of the shown engineer
+     */
+    QList<CoreSkillAssessment> assessments() const;
+
+    /**
+     * @brief Record the current scores as saved in the index
+     */
+    void markSaved();
+
+    // QAbstractTableModel
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private:
+    void loadScores();
+
+private:
+    struct Row {
+        int category;   // position in categories_
+        int skill;      // position in skills_, -1 for a category heading
+    };
+
+    QList<CoreSkillCategory> categories_;
+    QList<CoreSkill> skills_;
+    QList<Row> rows_;
+
+    QHash<QString, QHash<QString, int>> scoreIndex_;   // engineer id -> skill id -> score
+
+    QString engineerId_;
+    QVector<int> scores_;   // per skill position, for engineerId_
+    bool modified_;
+};
+
+#endif // CORESKILLSMODEL_H
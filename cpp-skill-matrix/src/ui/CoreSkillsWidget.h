@@ -4,11 +4,10 @@
 #include <QWidget>
 #include <QPushButton>
 #include <QComboBox>
-#include <QHBoxLayout>
-#include <QVBoxLayout>
-#include <QScrollArea>
+#include <QTableView>
 #include "../database/CoreSkillsRepository.h"
-#include "../database/EngineerRepository.h"
+
+class CoreSkillsModel;
 
 class CoreSkillsWidget : public QWidget
 {
@@ -25,35 +24,23 @@ private slots:
     void onEngineerChanged(int index);
     void onSaveClicked();
     void onRefreshClicked();
-    void onScoreButtonClicked();
+    void onScoreChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
 
 private:
     void setupUI();
     void loadCoreSkills();
     void loadEngineers();
     void loadAssessments();
-    void createScoreButtons(QHBoxLayout* layout, const QString& engineerId,
-                           const QString& categoryId, const QString& skillId,
-                           int currentScore);
+    void applyCategorySpans();
 
 private:
     QComboBox* engineerCombo_;
-    QVBoxLayout* skillsLayout_;
-    QWidget* skillsContainer_;
+    QTableView* skillsView_;
+    CoreSkillsModel* model_;
     QPushButton* saveButton_;
     QPushButton* refreshButton_;
 
-    // Map to track score button groups
-    struct ScoreButtonGroup {
-        QPushButton* buttons[4];  // 0-3 buttons
-        QString engineerId;
-        QString categoryId;
-        QString skillId;
-    };
-    QList<ScoreButtonGroup> scoreButtonGroups_;
-
     CoreSkillsRepository coreSkillsRepo_;
-    EngineerRepository engineerRepo_;
 
     bool isFirstShow_ = true;
 };
@@ -1,6 +1,8 @@
 #include "DashboardWidget.h"
 #include "StyleManager.h"
 #include "AptitudeLogoWidget.h"
+#include "../database/ConnectionPool.h"
+#include "../core/Constants.h"
 #include "../utils/Logger.h"
 #include "../utils/IconProvider.h"
 #include "../core/Session.h"
@@ -13,6 +15,9 @@
 #include <QFrame>
 #include <QDateTime>
 #include <QScrollArea>
+#include <QShowEvent>
+#include <QHideEvent>
+#include <QtConcurrent/QtConcurrent>
 
 #include <QtCharts/QChart>
 #include <QtCharts/QChartView>
@@ -42,14 +47,54 @@ DashboardWidget::DashboardWidget(QWidget* parent)
     , fullyTrainedLabel_(nullptr)
     , needTrainingLabel_(nullptr)
     , refreshButton_(nullptr)
+    , statsWatcher_(new QFutureWatcher<StatisticsResult>(this))
+    , needsLoad_(true)
 {
     setupUI();
-    loadStatistics();
+
+    connect(statsWatcher_, &QFutureWatcher<StatisticsResult>::resultReadyAt,
+            this, &DashboardWidget::onStatisticsReady);
+    connect(statsWatcher_, &QFutureWatcher<StatisticsResult>::finished,
+            this, &DashboardWidget::onStatisticsFinished);
+
+    // Statistics load in the background on first show
     Logger::instance().info("DashboardWidget", "Dashboard widget initialized (web app style)");
 }
 
 DashboardWidget::~DashboardWidget()
 {
+    // The job only touches the store, but must release its pooled connection first
+    cancelLoad();
+    statsWatcher_->waitForFinished();
+}
+
+void DashboardWidget::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+
+    if (needsLoad_) {
+        loadStatistics();
+    }
+}
+
+void DashboardWidget::hideEvent(QHideEvent* event)
+{
+    QWidget::hideEvent(event);
+
+    // Navigating away: stop computing panels nobody will see
+    if (statsWatcher_->isRunning()) {
+        cancelLoad();
+        needsLoad_ = true;
+    }
+}
+
+void DashboardWidget::refresh()
+{
+    if (isVisible()) {
+        loadStatistics();
+    } else {
+        needsLoad_ = true;
+    }
 }
 
 void DashboardWidget::setupUI()
@@ -332,112 +377,196 @@ void DashboardWidget::setupUI()
     setLayout(outerLayout);
 }
 
-void DashboardWidget::loadStatistics()
+// ============================================================================
+// Background loading
+// ============================================================================
+
+void DashboardWidget::loadStatistics(SkillMatrixStore::Datasets syncFirst)
+{
+    cancelLoad();
+    needsLoad_ = false;
+    setLoading(true);
+
+    statsWatcher_->setFuture(QtConcurrent::run(&DashboardWidget::computeStatistics, syncFirst));
+}
+
+void DashboardWidget::cancelLoad()
+{
+    if (statsWatcher_->isRunning()) {
+        statsWatcher_->cancel();
+    }
+}
+
+void DashboardWidget::computeStatistics(QPromise<StatisticsResult>& promise, SkillMatrixStore::Datasets syncFirst)
 {
-    // PERFORMANCE FIX: Cache all data upfront to avoid redundant database queries
-    // Previously this was calling findAll() multiple times (3x for assessments alone!)
-    QList<Engineer> engineers = engineerRepo_.findAll();
-    QList<Assessment> assessments = assessmentRepo_.findAll();
-    QList<ProductionArea> areas = productionRepo_.findAllAreas();
-
-    // PERFORMANCE FIX: Cache machines and competencies upfront to avoid nested loop queries
-    // Previously: 10 areas × 10 machines = 110 queries. Now: Just count in memory.
-    QList<Machine> allMachines;
-    int totalCompetencies = 0;
-    for (const ProductionArea& area : areas) {
-        QList<Machine> machines = productionRepo_.findMachinesByArea(area.id());
-        allMachines.append(machines);
-        for (const Machine& machine : machines) {
-            totalCompetencies += productionRepo_.findCompetenciesByMachine(machine.id()).size();
+    // Store loads issued from this job use the worker thread's pooled connection
+    ScopedConnection connection;
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+
+    if (syncFirst) {
+        store.sync(syncFirst);
+    }
+    if (promise.isCanceled()) {
+        return;
+    }
+
+    // Engineers and the hierarchy are small and fill the first cards quickly
+    QList<Engineer> engineers = store.engineers().items();
+    StatisticsResult counts;
+    counts.stage = StatisticsResult::Counts;
+    counts.engineerCount = engineers.size();
+    counts.competencyCount = store.hierarchy().competencyCount();
+    promise.addResult(counts);
+    if (promise.isCanceled()) {
+        return;
+    }
+
+    // Assessments are the expensive dataset
+    CompetencyScoreMatrix scores = store.competencyScores();
+    ScoreStats totals = scores.totalStats();
+
+    StatisticsResult summary;
+    summary.stage = StatisticsResult::Summary;
+    summary.totalAssessments = totals.assessed;
+    summary.competentCount = totals.counts[Constants::SCORE_COMPETENT] + totals.counts[Constants::SCORE_EXPERT];
+    summary.averageScore = totals.average();
+    promise.addResult(summary);
+    if (promise.isCanceled()) {
+        return;
+    }
+
+    StatisticsResult charts;
+    charts.stage = StatisticsResult::Charts;
+    StatisticsResult rankings;
+    rankings.stage = StatisticsResult::Rankings;
+
+    for (int level = 0; level <= Constants::SCORE_MAX; ++level) {
+        charts.scoreCounts[level] = totals.counts[level];
+    }
+    charts.engineerNames.reserve(engineers.size());
+    charts.engineerAverages.reserve(engineers.size());
+    for (const Engineer& engineer : engineers) {
+        ScoreStats stats = scores.rowStats(scores.rowIndex(engineer.id()));
+        charts.engineerNames << engineer.name();
+        charts.engineerAverages << stats.average();
+        if (stats.assessed > 0) {
+            rankings.performances.append({engineer.name(), stats.assessed, stats.average()});
         }
     }
+    promise.addResult(charts);
+    if (promise.isCanceled()) {
+        return;
+    }
+
+    // Sort by average score
+    std::sort(rankings.performances.begin(), rankings.performances.end(),
+              [](const StatisticsResult::Performance& a, const StatisticsResult::Performance& b) {
+                  return a.avgScore > b.avgScore;
+              });
+    promise.addResult(rankings);
+}
+
+void DashboardWidget::onStatisticsReady(int index)
+{
+    const StatisticsResult result = statsWatcher_->resultAt(index);
+
+    switch (result.stage) {
+        case StatisticsResult::Counts:
+            updateCounts(result);
+            break;
+        case StatisticsResult::Summary:
+            updateQuickStats(result);
+            updateKeyInsights(result);
+            break;
+        case StatisticsResult::Charts:
+            createScoreDistributionCharts(result);
+            break;
+        case StatisticsResult::Rankings:
+            createPerformanceLists(result);
+            break;
+    }
+}
 
-    updateQuickStats(engineers, assessments, totalCompetencies);
-    updateKeyInsights(assessments);
-    createScoreDistributionCharts(engineers, assessments);
-    createPerformanceLists();
+void DashboardWidget::onStatisticsFinished()
+{
+    if (statsWatcher_->isCanceled()) {
+        return;
+    }
 
     QString timestamp = QDateTime::currentDateTime().toString("MMMM d, yyyy h:mm AP");
     lastUpdateLabel_->setText("Last updated: " + timestamp);
+    LOG_DEBUG("DashboardWidget", "Statistics loaded");
 }
 
-void DashboardWidget::updateQuickStats(const QList<Engineer>& engineers, const QList<Assessment>& assessments, int totalCompetencies)
+void DashboardWidget::setLoading(bool loading)
 {
-    // Get basic counts
-    int engineerCount = engineers.size();
-
-    // Calculate average skill level and completion rate
-    double totalScore = 0;
-    int scoreCount = 0;
-    int competent = 0;  // Score >= 2
-
-    for (const Assessment& assessment : assessments) {
-        totalScore += assessment.score();
-        scoreCount++;
-        if (assessment.score() >= 2) {
-            competent++;
-        }
+    if (!loading) {
+        return;
     }
 
-    double avgSkill = scoreCount > 0 ? totalScore / scoreCount : 0.0;
-    double completionRate = scoreCount > 0 ? (double)competent / scoreCount * 100.0 : 0.0;
+    // Placeholders per panel; each is replaced as its stage arrives
+    const QString pending = "…";
+    for (QLabel* label : { engineerCountLabel_, competencyCountLabel_, avgSkillLevelLabel_, completionRateLabel_,
+                           totalAssessmentsLabel_, fullyTrainedLabel_, needTrainingLabel_ }) {
+        label->setText(pending);
+    }
 
-    // Update labels
-    engineerCountLabel_->setText(QString::number(engineerCount));
-    competencyCountLabel_->setText(QString::number(totalCompetencies));
-    avgSkillLevelLabel_->setText(QString::number(avgSkill, 'f', 2));
-    completionRateLabel_->setText(QString::number(completionRate, 'f', 1) + "%");
+    pieChart_->setTitle("Loading...");
+    barChart_->setTitle("Loading...");
+
+    topPerformersList_->clear();
+    needsAttentionList_->clear();
+    topPerformersList_->addItem("Loading...");
+    needsAttentionList_->addItem("Loading...");
+
+    lastUpdateLabel_->setText("Updating...");
 }
 
-void DashboardWidget::updateKeyInsights(const QList<Assessment>& assessments)
+// ============================================================================
+// Panels
+// ============================================================================
+
+void DashboardWidget::updateCounts(const StatisticsResult& result)
 {
-    int totalAssessments = assessments.size();
-    int fullyTrained = 0;
-    int needTraining = 0;
-
-    for (const Assessment& assessment : assessments) {
-        if (assessment.score() >= 2) {
-            fullyTrained++;
-        } else {
-            needTraining++;
-        }
-    }
+    engineerCountLabel_->setText(QString::number(result.engineerCount));
+    competencyCountLabel_->setText(QString::number(result.competencyCount));
+}
+
+void DashboardWidget::updateQuickStats(const StatisticsResult& result)
+{
+    double completionRate = result.totalAssessments > 0
+        ? (double)result.competentCount / result.totalAssessments * 100.0 : 0.0;
 
-    totalAssessmentsLabel_->setText(QString::number(totalAssessments));
-    fullyTrainedLabel_->setText(QString::number(fullyTrained));
-    needTrainingLabel_->setText(QString::number(needTraining));
+    avgSkillLevelLabel_->setText(QString::number(result.averageScore, 'f', 2));
+    completionRateLabel_->setText(QString::number(completionRate, 'f', 1) + "%");
 }
 
-void DashboardWidget::createScoreDistributionCharts(const QList<Engineer>& engineers, const QList<Assessment>& assessments)
+void DashboardWidget::updateKeyInsights(const StatisticsResult& result)
 {
-    // Use cached assessments instead of querying again
+    totalAssessmentsLabel_->setText(QString::number(result.totalAssessments));
+    fullyTrainedLabel_->setText(QString::number(result.competentCount));
+    needTrainingLabel_->setText(QString::number(result.totalAssessments - result.competentCount));
+}
 
+void DashboardWidget::createScoreDistributionCharts(const StatisticsResult& result)
+{
     // === PIE CHART: Score Distribution ===
-    QMap<int, int> scoreCounts;
-    scoreCounts[0] = 0;
-    scoreCounts[1] = 0;
-    scoreCounts[2] = 0;
-    scoreCounts[3] = 0;
-
-    for (const Assessment& assessment : assessments) {
-        scoreCounts[assessment.score()]++;
-    }
-
     QPieSeries* pieSeries = new QPieSeries();
 
     // Web app colors for scores
-    QPieSlice* slice0 = pieSeries->append("Not Trained (0)", scoreCounts[0]);
+    QPieSlice* slice0 = pieSeries->append("Not Trained (0)", result.scoreCounts[0]);
     slice0->setColor(QColor("#ff6b6b"));  // Red
 
-    QPieSlice* slice1 = pieSeries->append("Basic (1)", scoreCounts[1]);
+    QPieSlice* slice1 = pieSeries->append("Basic (1)", result.scoreCounts[1]);
     slice1->setColor(QColor("#fbbf24"));  // Yellow
 
-    QPieSlice* slice2 = pieSeries->append("Competent (2)", scoreCounts[2]);
+    QPieSlice* slice2 = pieSeries->append("Competent (2)", result.scoreCounts[2]);
     slice2->setColor(QColor("#60a5fa"));  // Blue
 
-    QPieSlice* slice3 = pieSeries->append("Expert (3)", scoreCounts[3]);
+    QPieSlice* slice3 = pieSeries->append("Expert (3)", result.scoreCounts[3]);
     slice3->setColor(QColor("#4ade80"));  // Green
 
+    pieChart_->setTitle("");
     pieChart_->removeAllSeries();
     pieChart_->addSeries(pieSeries);
 
@@ -445,34 +574,20 @@ void DashboardWidget::createScoreDistributionCharts(const QList<Engineer>& engin
     QBarSeries* barSeries = new QBarSeries();
     QBarSet* barSet = new QBarSet("Avg Score");
     barSet->setColor(QColor("#ff6b6b"));  // Red accent like web app
-
-    QStringList engineerNames;
-    // Use cached engineers instead of querying again
-
-    for (const Engineer& engineer : engineers) {
-        // PERFORMANCE FIX: Filter cached assessments instead of querying per engineer
-        double totalScore = 0;
-        int count = 0;
-        for (const Assessment& assessment : assessments) {
-            if (assessment.engineerId() == engineer.id()) {
-                totalScore += assessment.score();
-                count++;
-            }
-        }
-        double avgScore = count > 0 ? totalScore / count : 0.0;
-
-        *barSet << avgScore;
-        engineerNames << engineer.name();
-    }
-
+    barSet->append(result.engineerAverages);
     barSeries->append(barSet);
 
+    barChart_->setTitle("");
     barChart_->removeAllSeries();
+    for (QAbstractAxis* axis : barChart_->axes()) {
+        barChart_->removeAxis(axis);
+        delete axis;
+    }
     barChart_->addSeries(barSeries);
 
     // Setup axes
     QBarCategoryAxis* axisX = new QBarCategoryAxis();
-    axisX->append(engineerNames);
+    axisX->append(result.engineerNames);
     barChart_->addAxis(axisX, Qt::AlignBottom);
     barSeries->attachAxis(axisX);
 
@@ -483,39 +598,12 @@ void DashboardWidget::createScoreDistributionCharts(const QList<Engineer>& engin
     barSeries->attachAxis(axisY);
 }
 
-void DashboardWidget::createPerformanceLists()
+void DashboardWidget::createPerformanceLists(const StatisticsResult& result)
 {
     topPerformersList_->clear();
     needsAttentionList_->clear();
 
-    // Calculate average score per engineer
-    struct EngineerPerformance {
-        QString name;
-        int assessmentCount;
-        double avgScore;
-    };
-
-    QList<EngineerPerformance> performances;
-    QList<Engineer> engineers = engineerRepo_.findAll();
-
-    for (const Engineer& engineer : engineers) {
-        QList<Assessment> engineerAssessments = assessmentRepo_.findByEngineer(engineer.id());
-        if (engineerAssessments.isEmpty()) continue;
-
-        double totalScore = 0;
-        for (const Assessment& assessment : engineerAssessments) {
-            totalScore += assessment.score();
-        }
-        double avgScore = totalScore / engineerAssessments.size();
-
-        performances.append({engineer.name(), static_cast<int>(engineerAssessments.size()), avgScore});
-    }
-
-    // Sort by average score
-    std::sort(performances.begin(), performances.end(),
-              [](const EngineerPerformance& a, const EngineerPerformance& b) {
-                  return a.avgScore > b.avgScore;
-              });
+    const QList<StatisticsResult::Performance>& performances = result.performances;
 
     // Top 5 performers
     for (int i = 0; i < qMin(5, performances.size()); i++) {
@@ -540,6 +628,7 @@ void DashboardWidget::createPerformanceLists()
 
 void DashboardWidget::onRefreshClicked()
 {
-    loadStatistics();
-    Logger::instance().info("DashboardWidget", "Statistics refreshed");
+    // Explicit refresh picks up changes made by other clients (synced in the background job)
+    loadStatistics(SkillMatrixStore::Engineers | SkillMatrixStore::Hierarchy | SkillMatrixStore::Assessments);
+    Logger::instance().info("DashboardWidget", "Statistics refresh started");
 }
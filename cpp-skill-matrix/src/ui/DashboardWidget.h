@@ -5,13 +5,9 @@
 #include <QLabel>
 #include <QPushButton>
 #include <QListWidget>
-#include "../database/EngineerRepository.h"
-#include "../database/ProductionRepository.h"
-#include "../database/AssessmentRepository.h"
-#include "../database/CoreSkillsRepository.h"
-#include "../models/Engineer.h"
-#include "../models/Assessment.h"
-#include "../models/ProductionArea.h"
+#include <QFutureWatcher>
+#include <QPromise>
+#include "../database/SkillMatrixStore.h"
 #include <QtCharts/QChart>
 #include <QtCharts/QChartView>
 #include <QtCharts/QBarSeries>
@@ -25,19 +21,69 @@ public:
     explicit DashboardWidget(QWidget* parent = nullptr);
     ~DashboardWidget();
 
+    /**
+     * @brief One stage of a background statistics load
+     *
+     * Stages arrive in order; each fills only the fields of its own panel.
+     */
+    struct StatisticsResult {
+        enum Stage { Counts, Summary, Charts, Rankings };
+
+        struct Performance {
+            QString name;
+            int assessmentCount;
+            double avgScore;
+        };
+
+        Stage stage = Counts;
+
+        // Counts
+        int engineerCount = 0;
+        int competencyCount = 0;
+
+        // Summary
+        int totalAssessments = 0;
+        int competentCount = 0;     // score >= 2
+        double averageScore = 0.0;
+
+        // Charts
+        int scoreCounts[4] = {};
+        QStringList engineerNames;
+        QList<double> engineerAverages;
+
+        // Rankings (assessed engineers, best first)
+        QList<Performance> performances;
+    };
+
 public slots:
-    void refresh() { loadStatistics(); }  // Public refresh method
+    void refresh();  // Public refresh method
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 
 private slots:
     void onRefreshClicked();
+    void onStatisticsReady(int index);
+    void onStatisticsFinished();
 
 private:
     void setupUI();
-    void loadStatistics();
-    void createScoreDistributionCharts(const QList<Engineer>& engineers, const QList<Assessment>& assessments);
-    void createPerformanceLists();
-    void updateQuickStats(const QList<Engineer>& engineers, const QList<Assessment>& assessments, int totalCompetencies);
-    void updateKeyInsights(const QList<Assessment>& assessments);
+
+    /**
+     * @brief Start a background load, replacing any load in flight
+     * @param syncFirst Datasets to sync with the database before computing
+     */
+    void loadStatistics(SkillMatrixStore::Datasets syncFirst = {});
+    void cancelLoad();
+    void setLoading(bool loading);
+    static void computeStatistics(QPromise<StatisticsResult>& promise, SkillMatrixStore::Datasets syncFirst);
+
+    void updateCounts(const StatisticsResult& result);
+    void updateQuickStats(const StatisticsResult& result);
+    void updateKeyInsights(const StatisticsResult& result);
+    void createScoreDistributionCharts(const StatisticsResult& result);
+    void createPerformanceLists(const StatisticsResult& result);
 
 private:
     // Stat labels - 4 cards matching web app
@@ -66,11 +112,9 @@ private:
     // Buttons
     QPushButton* refreshButton_;
 
-    // Repositories
-    EngineerRepository engineerRepo_;
-    ProductionRepository productionRepo_;
-    AssessmentRepository assessmentRepo_;
-    CoreSkillsRepository coreSkillsRepo_;
+    // Background loading
+    QFutureWatcher<StatisticsResult>* statsWatcher_;
+    bool needsLoad_;
 };
 
 #endif // DASHBOARDWIDGET_H
@@ -1,5 +1,12 @@
 #include "ImportExportDialog.h"
 #include "../controllers/DataController.h"
+#include "../database/SkillMatrixStore.h"
+#include "../database/ConnectionPool.h"
+#include "../utils/ExcelExporter.h"
+#include "../utils/CsvExporter.h"
+#include "../utils/CsvImporter.h"
+#include "../utils/JsonExporter.h"
+#include "../utils/JsonImporter.h"
 #include "../utils/Logger.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -8,23 +15,41 @@
 #include <QLabel>
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QInputDialog>
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrent>
 
 ImportExportDialog::ImportExportDialog(QWidget* parent)
     : QWidget(parent)
     , exportCSVButton_(nullptr)
     , exportJSONButton_(nullptr)
+    , exportExcelButton_(nullptr)
+    , importExcelButton_(nullptr)
     , importCSVButton_(nullptr)
     , importJSONButton_(nullptr)
+    , importProductionDataButton_(nullptr)
     , backupButton_(nullptr)
     , restoreButton_(nullptr)
     , statusDisplay_(nullptr)
+    , exportWatcher_(new QFutureWatcher<QString>(this))
+    , importWatcher_(new QFutureWatcher<ExcelImporter::ImportResult>(this))
+    , seedWatcher_(new QFutureWatcher<ProductionDataImporter::Report>(this))
 {
+    connect(exportWatcher_, &QFutureWatcher<QString>::finished, this, &ImportExportDialog::onExportFinished);
+    connect(importWatcher_, &QFutureWatcher<ExcelImporter::ImportResult>::finished,
+            this, &ImportExportDialog::onImportFinished);
+    connect(seedWatcher_, &QFutureWatcher<ProductionDataImporter::Report>::finished,
+            this, &ImportExportDialog::onSeedFinished);
+
     setupUI();
     Logger::instance().info("ImportExportDialog", "Import/Export widget initialized");
 }
 
 ImportExportDialog::~ImportExportDialog()
 {
+    exportWatcher_->waitForFinished();
+    importWatcher_->waitForFinished();
+    seedWatcher_->waitForFinished();
 }
 
 void ImportExportDialog::setupUI()
@@ -44,12 +69,15 @@ void ImportExportDialog::setupUI()
 
     exportCSVButton_ = new QPushButton("Export to CSV", this);
     exportJSONButton_ = new QPushButton("Export to JSON", this);
+    exportExcelButton_ = new QPushButton("Export to Excel", this);
 
     connect(exportCSVButton_, &QPushButton::clicked, this, &ImportExportDialog::onExportCSVClicked);
     connect(exportJSONButton_, &QPushButton::clicked, this, &ImportExportDialog::onExportJSONClicked);
+    connect(exportExcelButton_, &QPushButton::clicked, this, &ImportExportDialog::onExportExcelClicked);
 
     exportLayout->addWidget(exportCSVButton_, 0, 0);
     exportLayout->addWidget(exportJSONButton_, 0, 1);
+    exportLayout->addWidget(exportExcelButton_, 0, 2);
 
     mainLayout->addWidget(exportGroup);
 
@@ -59,12 +87,20 @@ void ImportExportDialog::setupUI()
 
     importCSVButton_ = new QPushButton("Import from CSV", this);
     importJSONButton_ = new QPushButton("Import from JSON", this);
+    importExcelButton_ = new QPushButton("Import from Excel", this);
+    importProductionDataButton_ = new QPushButton("Import Production Data", this);
+    importProductionDataButton_->setToolTip("Seed areas, machines, competencies, engineers and assessments "
+                                            "from the web app's production-data-import.json");
 
     connect(importCSVButton_, &QPushButton::clicked, this, &ImportExportDialog::onImportCSVClicked);
     connect(importJSONButton_, &QPushButton::clicked, this, &ImportExportDialog::onImportJSONClicked);
+    connect(importExcelButton_, &QPushButton::clicked, this, &ImportExportDialog::onImportExcelClicked);
+    connect(importProductionDataButton_, &QPushButton::clicked, this, &ImportExportDialog::onImportProductionDataClicked);
 
     importLayout->addWidget(importCSVButton_, 0, 0);
     importLayout->addWidget(importJSONButton_, 0, 1);
+    importLayout->addWidget(importExcelButton_, 0, 2);
+    importLayout->addWidget(importProductionDataButton_, 1, 0, 1, 3);
 
     mainLayout->addWidget(importGroup);
 
@@ -113,13 +149,29 @@ void ImportExportDialog::setupUI()
 
 void ImportExportDialog::onExportCSVClicked()
 {
+    // A CSV file holds one table
+    bool chosen = false;
+    QString table = QInputDialog::getItem(this, "Export to CSV", "Data to export:",
+        {"Assessments", "Engineers"}, 0, false, &chosen);
+    if (!chosen) {
+        return;
+    }
+
     QString fileName = QFileDialog::getSaveFileName(this,
         "Export to CSV", "", "CSV Files (*.csv);;All Files (*)");
 
     if (!fileName.isEmpty()) {
-        statusDisplay_->setPlainText(QString("Exporting data to CSV: %1\n\n[Implementation placeholder - use ExcelExporter utility]").arg(fileName));
+        if (!fileName.endsWith(".csv", Qt::CaseInsensitive)) {
+            fileName += ".csv";
+        }
+
+        operationFormat_ = "CSV";
+        operationFile_ = fileName;
+        setBusy(true);
+        statusDisplay_->setPlainText(QString("Exporting %1 to CSV: %2\n\nWriting rows...").arg(table.toLower(), fileName));
         Logger::instance().info("ImportExportDialog", "Exporting to CSV: " + fileName);
-        QMessageBox::information(this, "Export", "CSV export functionality coming soon!");
+
+        exportWatcher_->setFuture(QtConcurrent::run(&ImportExportDialog::exportCsv, fileName, table == "Assessments"));
     }
 }
 
@@ -129,9 +181,200 @@ void ImportExportDialog::onExportJSONClicked()
         "Export to JSON", "", "JSON Files (*.json);;All Files (*)");
 
     if (!fileName.isEmpty()) {
-        statusDisplay_->setPlainText(QString("Exporting data to JSON: %1\n\n[Implementation placeholder - use JsonHelper utility]").arg(fileName));
+        if (!fileName.endsWith(".json", Qt::CaseInsensitive)) {
+            fileName += ".json";
+        }
+
+        operationFormat_ = "JSON";
+        operationFile_ = fileName;
+        setBusy(true);
+        statusDisplay_->setPlainText(QString("Exporting data to JSON: %1\n\nWriting records...").arg(fileName));
         Logger::instance().info("ImportExportDialog", "Exporting to JSON: " + fileName);
-        QMessageBox::information(this, "Export", "JSON export functionality coming soon!");
+
+        exportWatcher_->setFuture(QtConcurrent::run(&ImportExportDialog::exportJson, fileName));
+    }
+}
+
+void ImportExportDialog::onExportExcelClicked()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+        "Export to Excel", "", "Excel Workbooks (*.xlsx);;All Files (*)");
+
+    if (!fileName.isEmpty()) {
+        if (!fileName.endsWith(".xlsx", Qt::CaseInsensitive)) {
+            fileName += ".xlsx";
+        }
+
+        operationFormat_ = "Excel";
+        operationFile_ = fileName;
+        setBusy(true);
+        statusDisplay_->setPlainText(QString("Exporting data to Excel: %1\n\nWriting sheets...").arg(fileName));
+        Logger::instance().info("ImportExportDialog", "Exporting to Excel: " + fileName);
+
+        exportWatcher_->setFuture(QtConcurrent::run(&ImportExportDialog::exportWorkbook, fileName));
+    }
+}
+
+QString ImportExportDialog::exportWorkbook(const QString& filePath)
+{
+    // Repositories used by the exporter run on this worker's pooled connection
+    ScopedConnection connection;
+
+    ExcelExporter exporter;
+    return exporter.exportAll(filePath) ? QString() : exporter.lastError();
+}
+
+QString ImportExportDialog::exportCsv(const QString& filePath, bool assessments)
+{
+    ScopedConnection connection;
+
+    CsvExporter exporter;
+    bool ok = assessments ? exporter.exportAssessments(filePath) : exporter.exportEngineers(filePath);
+    return ok ? QString() : exporter.lastError();
+}
+
+QString ImportExportDialog::exportJson(const QString& filePath)
+{
+    ScopedConnection connection;
+
+    JsonExporter exporter;
+    return exporter.exportAll(filePath) ? QString() : exporter.lastError();
+}
+
+void ImportExportDialog::onExportFinished()
+{
+    setBusy(false);
+
+    QString error = exportWatcher_->result();
+    if (error.isEmpty()) {
+        statusDisplay_->setPlainText(QString("Exported data to %1: %2").arg(operationFormat_, operationFile_));
+        QMessageBox::information(this, "Export", "Data exported successfully.");
+    } else {
+        statusDisplay_->setPlainText(QString("%1 export failed: %2").arg(operationFormat_, error));
+        QMessageBox::critical(this, "Export Failed", operationFormat_ + " export failed: " + error);
+    }
+}
+
+void ImportExportDialog::onImportExcelClicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(this,
+        "Import from Excel", "", "Excel Workbooks (*.xlsx);;All Files (*)");
+
+    if (!fileName.isEmpty()) {
+        operationFormat_ = "Excel";
+        operationFile_ = fileName;
+        setBusy(true);
+        statusDisplay_->setPlainText(QString("Importing data from Excel: %1\n\nReading workbook...").arg(fileName));
+        Logger::instance().info("ImportExportDialog", "Importing from Excel: " + fileName);
+
+        importWatcher_->setFuture(QtConcurrent::run(&ImportExportDialog::importWorkbook, this, fileName));
+    }
+}
+
+ExcelImporter::ImportResult ImportExportDialog::importWorkbook(const QString& filePath)
+{
+    ScopedConnection connection;
+
+    // Progress arrives per chunk of rows; post it to the GUI a few times a second
+    QElapsedTimer throttle;
+    throttle.start();
+
+    ExcelImporter importer;
+    importer.setProgressCallback([this, &throttle, filePath](const QString& sheet, int rowsRead, int recordsWritten) {
+        if (throttle.elapsed() < 250) {
+            return;
+        }
+        throttle.restart();
+
+        postStatus(QString("Importing data from Excel: %1\n\n%2: %3 rows read, %4 records saved")
+            .arg(filePath, sheet).arg(rowsRead).arg(recordsWritten));
+    });
+
+    return importer.importAll(filePath);
+}
+
+ExcelImporter::ImportResult ImportExportDialog::importCsv(const QString& filePath)
+{
+    ScopedConnection connection;
+
+    QElapsedTimer throttle;
+    throttle.start();
+
+    CsvImporter importer;
+    importer.setProgressCallback([this, &throttle, filePath](qint64 bytesRead, qint64 totalBytes, int recordsWritten) {
+        if (throttle.elapsed() < 250) {
+            return;
+        }
+        throttle.restart();
+
+        postStatus(QString("Importing data from CSV: %1\n\n%2% read, %3 records saved")
+            .arg(filePath).arg(totalBytes > 0 ? bytesRead * 100 / totalBytes : 0).arg(recordsWritten));
+    });
+
+    return importer.importFile(filePath);
+}
+
+ExcelImporter::ImportResult ImportExportDialog::importJson(const QString& filePath)
+{
+    ScopedConnection connection;
+
+    QElapsedTimer throttle;
+    throttle.start();
+
+    JsonImporter importer;
+    importer.setProgressCallback([this, &throttle, filePath](qint64 bytesRead, qint64 totalBytes, int recordsWritten) {
+        if (throttle.elapsed() < 250) {
+            return;
+        }
+        throttle.restart();
+
+        postStatus(QString("Importing data from JSON: %1\n\n%2% read, %3 records saved")
+            .arg(filePath).arg(totalBytes > 0 ? bytesRead * 100 / totalBytes : 0).arg(recordsWritten));
+    });
+
+    return importer.importFile(filePath);
+}
+
+void ImportExportDialog::postStatus(const QString& text)
+{
+    QMetaObject::invokeMethod(this, [this, text]() {
+        statusDisplay_->setPlainText(text);
+    }, Qt::QueuedConnection);
+}
+
+void ImportExportDialog::setBusy(bool busy)
+{
+    for (QPushButton* button : {exportCSVButton_, exportJSONButton_, exportExcelButton_,
+                                importCSVButton_, importJSONButton_, importExcelButton_,
+                                importProductionDataButton_}) {
+        button->setEnabled(!busy);
+    }
+}
+
+void ImportExportDialog::onImportFinished()
+{
+    setBusy(false);
+
+    ExcelImporter::ImportResult result = importWatcher_->result();
+    QString summary = QString("Imported from %1: %2\n\n%3 of %4 records saved")
+        .arg(operationFormat_, operationFile_).arg(result.recordsSuccessful).arg(result.recordsProcessed);
+    if (!result.errors.isEmpty()) {
+        summary += QString(", %1 problems:\n").arg(result.errors.size()) + result.errors.join("\n");
+    }
+    statusDisplay_->setPlainText(summary);
+
+    if (result.recordsSuccessful > 0) {
+        SkillMatrixStore::instance().sync();
+        emit dataChanged();
+    }
+
+    if (result.success && result.errors.isEmpty()) {
+        QMessageBox::information(this, "Import", QString("%1 records imported successfully.").arg(result.recordsSuccessful));
+    } else if (result.success) {
+        QMessageBox::warning(this, "Import", QString("%1 records imported; %2 rows were skipped. See the status panel for details.")
+            .arg(result.recordsSuccessful).arg(result.errors.size()));
+    } else {
+        QMessageBox::critical(this, "Import Failed", operationFormat_ + " import did not complete. See the status panel for details.");
     }
 }
 
@@ -141,9 +384,13 @@ void ImportExportDialog::onImportCSVClicked()
         "Import from CSV", "", "CSV Files (*.csv);;All Files (*)");
 
     if (!fileName.isEmpty()) {
-        statusDisplay_->setPlainText(QString("Importing data from CSV: %1\n\n[Implementation placeholder - use ExcelImporter utility]").arg(fileName));
+        operationFormat_ = "CSV";
+        operationFile_ = fileName;
+        setBusy(true);
+        statusDisplay_->setPlainText(QString("Importing data from CSV: %1\n\nReading file...").arg(fileName));
         Logger::instance().info("ImportExportDialog", "Importing from CSV: " + fileName);
-        QMessageBox::information(this, "Import", "CSV import functionality coming soon!");
+
+        importWatcher_->setFuture(QtConcurrent::run(&ImportExportDialog::importCsv, this, fileName));
     }
 }
 
@@ -153,12 +400,77 @@ void ImportExportDialog::onImportJSONClicked()
         "Import from JSON", "", "JSON Files (*.json);;All Files (*)");
 
     if (!fileName.isEmpty()) {
-        statusDisplay_->setPlainText(QString("Importing data from JSON: %1\n\n[Implementation placeholder - use JsonHelper utility]").arg(fileName));
+        operationFormat_ = "JSON";
+        operationFile_ = fileName;
+        setBusy(true);
+        statusDisplay_->setPlainText(QString("Importing data from JSON: %1\n\nReading file...").arg(fileName));
         Logger::instance().info("ImportExportDialog", "Importing from JSON: " + fileName);
-        QMessageBox::information(this, "Import", "JSON import functionality coming soon!");
+
+        importWatcher_->setFuture(QtConcurrent::run(&ImportExportDialog::importJson, this, fileName));
+    }
+}
+
+void ImportExportDialog::onImportProductionDataClicked()
+{
+    QString fileName = QFileDialog::getOpenFileName(this,
+        "Import Production Data", "", "JSON Files (*.json);;All Files (*)");
+
+    if (!fileName.isEmpty()) {
+        operationFile_ = fileName;
+        setBusy(true);
+        statusDisplay_->setPlainText(QString("Checking production data: %1\n\nReading file...").arg(fileName));
+        Logger::instance().info("ImportExportDialog", "Dry run of production data import: " + fileName);
+
+        seedWatcher_->setFuture(QtConcurrent::run(&ImportExportDialog::importProductionData, fileName, true));
     }
 }
 
+ProductionDataImporter::Report ImportExportDialog::importProductionData(const QString& filePath, bool dryRun)
+{
+    ScopedConnection connection;
+
+    ProductionDataImporter importer;
+    importer.setDryRun(dryRun);
+    return importer.importFile(filePath);
+}
+
+void ImportExportDialog::onSeedFinished()
+{
+    ProductionDataImporter::Report report = seedWatcher_->result();
+    statusDisplay_->setPlainText(operationFile_ + "\n\n" + report.summary());
+
+    if (!report.success) {
+        setBusy(false);
+        QMessageBox::critical(this, "Import Failed", "Production data import did not complete. See the status panel for details.");
+        return;
+    }
+
+    // Dry run first: show what would change and let the user decide
+    if (report.dryRun) {
+        if (!report.hasChanges()) {
+            setBusy(false);
+            QMessageBox::information(this, "Import Production Data", "The database already matches this file.");
+            return;
+        }
+        QMessageBox::StandardButton reply = QMessageBox::question(this, "Import Production Data",
+            "Apply the changes listed in the status panel?", QMessageBox::Yes | QMessageBox::No);
+        if (reply != QMessageBox::Yes) {
+            setBusy(false);
+            return;
+        }
+
+        statusDisplay_->setPlainText(QString("Importing production data: %1\n\nWriting...").arg(operationFile_));
+        Logger::instance().info("ImportExportDialog", "Importing production data: " + operationFile_);
+        seedWatcher_->setFuture(QtConcurrent::run(&ImportExportDialog::importProductionData, operationFile_, false));
+        return;
+    }
+
+    setBusy(false);
+    SkillMatrixStore::instance().sync();
+    emit dataChanged();
+    QMessageBox::information(this, "Import Production Data", "Production data imported successfully.");
+}
+
 void ImportExportDialog::onBackupClicked()
 {
     QString fileName = QFileDialog::getSaveFileName(this,
@@ -212,7 +524,8 @@ void ImportExportDialog::onGenerateTestDataClicked()
         statusDisplay_->setPlainText(result);
         Logger::instance().info("ImportExportDialog", "Generated test data: " + result);
 
-        // Emit signal to refresh all data-dependent widgets
+        // Pull in only the rows the generator touched, then let widgets re-render
+        SkillMatrixStore::instance().sync();
         emit dataChanged();
 
         QMessageBox::information(this, "Success", result + "\n\nThe Dashboard and Analytics will now refresh automatically.");
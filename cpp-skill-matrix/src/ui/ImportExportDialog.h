@@ -4,6 +4,9 @@
 #include <QWidget>
 #include <QPushButton>
 #include <QTextEdit>
+#include <QFutureWatcher>
+#include "../utils/ExcelImporter.h"
+#include "../utils/ProductionDataImporter.h"
 
 class ImportExportDialog : public QWidget
 {
@@ -19,23 +22,48 @@ signals:
 private slots:
     void onExportCSVClicked();
     void onExportJSONClicked();
+    void onExportExcelClicked();
+    void onExportFinished();
+    void onImportExcelClicked();
+    void onImportFinished();
     void onImportCSVClicked();
     void onImportJSONClicked();
+    void onImportProductionDataClicked();
+    void onSeedFinished();
     void onBackupClicked();
     void onRestoreClicked();
     void onGenerateTestDataClicked();
 
 private:
     void setupUI();
+    void setBusy(bool busy);
+    void postStatus(const QString& text);  // from worker threads
+    static QString exportWorkbook(const QString& filePath);  // worker thread; empty on success
+    static QString exportCsv(const QString& filePath, bool assessments);  // worker thread; empty on success
+    static QString exportJson(const QString& filePath);  // worker thread; empty on success
+    ExcelImporter::ImportResult importWorkbook(const QString& filePath);  // worker thread
+    ExcelImporter::ImportResult importCsv(const QString& filePath);  // worker thread
+    ExcelImporter::ImportResult importJson(const QString& filePath);  // worker thread
+    static ProductionDataImporter::Report importProductionData(const QString& filePath, bool dryRun);  // worker thread
 
 private:
     QPushButton* exportCSVButton_;
     QPushButton* exportJSONButton_;
+    QPushButton* exportExcelButton_;
+    QPushButton* importExcelButton_;
     QPushButton* importCSVButton_;
     QPushButton* importJSONButton_;
+    QPushButton* importProductionDataButton_;
     QPushButton* backupButton_;
     QPushButton* restoreButton_;
     QTextEdit* statusDisplay_;
+
+    // One background import or export at a time
+    QFutureWatcher<QString>* exportWatcher_;
+    QFutureWatcher<ExcelImporter::ImportResult>* importWatcher_;
+    QFutureWatcher<ProductionDataImporter::Report>* seedWatcher_;  // dry run, then the real import
+    QString operationFormat_;  // "Excel" / "CSV" / "JSON"
+    QString operationFile_;
 };
 
 #endif // IMPORTEXPORTDIALOG_H
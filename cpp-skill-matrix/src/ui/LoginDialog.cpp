@@ -4,9 +4,7 @@
 #include "../core/Application.h"
 #include "../core/Constants.h"
 #include "../database/DatabaseManager.h"
-#include "../database/UserRepository.h"
 #include "../utils/Config.h"
-#include "../utils/Crypto.h"
 #include "../utils/Logger.h"
 #include "../utils/ValidationHelper.h"
 
@@ -23,9 +21,13 @@ LoginDialog::LoginDialog(QWidget* parent)
     , loginButton_(nullptr)
     , cancelButton_(nullptr)
     , statusLabel_(nullptr)
+    , authController_(new AuthController(this))
 {
     setupUI();
 
+    connect(authController_, &AuthController::stateChanged, this, &LoginDialog::onAuthStateChanged);
+    connect(authController_, &AuthController::loginFinished, this, &LoginDialog::onLoginFinished);
+
     Logger::instance().info("LoginDialog", "Login dialog created");
 }
 
@@ -174,9 +176,7 @@ void LoginDialog::onLoginClicked()
         return;
     }
 
-    if (attemptLogin()) {
-        accept();
-    }
+    attemptLogin();
 }
 
 void LoginDialog::onCancelClicked()
@@ -208,12 +208,8 @@ bool LoginDialog::validateInput()
     return true;
 }
 
-bool LoginDialog::attemptLogin()
+void LoginDialog::attemptLogin()
 {
-    loginButton_->setEnabled(false);
-    statusLabel_->setText("Logging in...");
-    statusLabel_->setStyleSheet("QLabel { color: blue; }");
-
     QString username = usernameEdit_->text().trimmed();
     QString password = passwordEdit_->text();
 
@@ -221,26 +217,47 @@ bool LoginDialog::attemptLogin()
     if (!DatabaseManager::instance().isConnected()) {
         statusLabel_->setText("Database not connected. Please check connection settings.");
         statusLabel_->setStyleSheet("QLabel { color: red; }");
-        loginButton_->setEnabled(true);
         Logger::instance().error("LoginDialog", "Database not connected");
-        return false;
+        return;
+    }
+
+    // Lookup and password verification run on a worker thread
+    setBusy(true);
+    authController_->loginAsync(username, password);
+}
+
+void LoginDialog::setBusy(bool busy)
+{
+    loginButton_->setEnabled(!busy);
+    cancelButton_->setEnabled(!busy);
+    usernameEdit_->setEnabled(!busy);
+    passwordEdit_->setEnabled(!busy);
+}
+
+void LoginDialog::onAuthStateChanged(AuthController::State state)
+{
+    if (state == AuthController::Succeeded || state == AuthController::Failed) {
+        return;  // reported by onLoginFinished()
     }
 
-    // Fetch user from database
-    UserRepository userRepo;
-    User user = userRepo.findByUsername(username);
+    statusLabel_->setText(AuthController::stateText(state));
+    statusLabel_->setStyleSheet("QLabel { color: blue; }");
+}
+
+void LoginDialog::onLoginFinished(bool success, const User& user, const QString& error)
+{
+    setBusy(false);
+    QString username = usernameEdit_->text().trimmed();
 
-    // Verify user exists and password matches using Crypto::verifyPassword
-    if (!user.isValid() || !Crypto::verifyPassword(password, user.password())) {
+    if (!success) {
         // Failure
-        Logger::instance().warning("LoginDialog", "Login failed for user: " + username);
+        Logger::instance().warning("LoginDialog", QString("Login failed for user: %1 (%2)").arg(username, error));
 
         statusLabel_->setText("Invalid username or password");
         statusLabel_->setStyleSheet("QLabel { color: red; }");
         passwordEdit_->clear();
         passwordEdit_->setFocus();
-        loginButton_->setEnabled(true);
-        return false;
+        return;
     }
 
     // Success
@@ -249,8 +266,7 @@ bool LoginDialog::attemptLogin()
     // Set session with engineerId
     Application::instance().onUserLogin(user.id(), user.username(), user.role(), user.engineerId());
 
-    statusLabel_->setText("Login successful!");
+    statusLabel_->setText(AuthController::stateText(AuthController::Succeeded));
     statusLabel_->setStyleSheet("QLabel { color: green; }");
-    loginButton_->setEnabled(true);
-    return true;
+    accept();
 }
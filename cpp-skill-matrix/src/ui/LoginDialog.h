@@ -5,6 +5,7 @@
 #include <QLineEdit>
 #include <QPushButton>
 #include <QLabel>
+#include "../controllers/AuthController.h"
 
 class LoginDialog : public QDialog
 {
@@ -20,12 +21,15 @@ public:
 private slots:
     void onLoginClicked();
     void onCancelClicked();
+    void onAuthStateChanged(AuthController::State state);
+    void onLoginFinished(bool success, const User& user, const QString& error);
 
 private:
     void setupUI();
     void showDatabaseConnectionDialog();
     bool validateInput();
-    bool attemptLogin();
+    void attemptLogin();
+    void setBusy(bool busy);
 
 private:
     QLineEdit* usernameEdit_;
@@ -33,6 +37,8 @@ private:
     QPushButton* loginButton_;
     QPushButton* cancelButton_;
     QLabel* statusLabel_;
+
+    AuthController* authController_;
 };
 
 #endif // LOGINDIALOG_H
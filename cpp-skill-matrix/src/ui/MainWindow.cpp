@@ -263,49 +263,49 @@ void MainWindow::onNavigationItemClicked(int index)
                     if (!engineersWidget_) {
                         engineersWidget_ = new EngineersWidget(this);
                         newWidget = engineersWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Engineers widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Engineers widget");
                     }
                     break;
                 case 2: // Users
                     if (!usersWidget_) {
                         usersWidget_ = new UsersWidget(this);
                         newWidget = usersWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Users widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Users widget");
                     }
                     break;
                 case 3: // Production Areas
                     if (!productionAreasWidget_) {
                         productionAreasWidget_ = new ProductionAreasWidget(this);
                         newWidget = productionAreasWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Production Areas widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Production Areas widget");
                     }
                     break;
                 case 4: // Production Assessments
                     if (!assessmentWidget_) {
                         assessmentWidget_ = new AssessmentWidget(this);
                         newWidget = assessmentWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Production Assessment widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Production Assessment widget");
                     }
                     break;
                 case 5: // Core Skills
                     if (!coreSkillsWidget_) {
                         coreSkillsWidget_ = new CoreSkillsWidget(this);
                         newWidget = coreSkillsWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Core Skills widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Core Skills widget");
                     }
                     break;
                 case 6: // Core Skills Management
                     if (!coreSkillsManagementWidget_) {
                         coreSkillsManagementWidget_ = new CoreSkillsManagementWidget(this);
                         newWidget = coreSkillsManagementWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Core Skills Management widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Core Skills Management widget");
                     }
                     break;
                 case 7: // Reports
                     if (!reportsWidget_) {
                         reportsWidget_ = new ReportsWidget(this);
                         newWidget = reportsWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Reports widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Reports widget");
                     }
                     break;
                 case 8: // Analytics
@@ -319,28 +319,28 @@ void MainWindow::onNavigationItemClicked(int index)
                         }
 
                         newWidget = analyticsWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Analytics widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Analytics widget");
                     }
                     break;
                 case 9: // Certifications
                     if (!certificationsWidget_) {
                         certificationsWidget_ = new CertificationsWidget(this);
                         newWidget = certificationsWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Certifications widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Certifications widget");
                     }
                     break;
                 case 10: // Snapshots
                     if (!snapshotsWidget_) {
                         snapshotsWidget_ = new SnapshotsWidget(this);
                         newWidget = snapshotsWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Snapshots widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Snapshots widget");
                     }
                     break;
                 case 11: // Audit Log
                     if (!auditLogWidget_) {
                         auditLogWidget_ = new AuditLogWidget(this);
                         newWidget = auditLogWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Audit Log widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Audit Log widget");
                     }
                     break;
                 case 12: // Import/Export
@@ -358,7 +358,7 @@ void MainWindow::onNavigationItemClicked(int index)
                         }
 
                         newWidget = importExportWidget_;
-                        Logger::instance().debug("MainWindow", "Lazy-loaded Import/Export widget");
+                        LOG_DEBUG("MainWindow", "Lazy-loaded Import/Export widget");
                     }
                     break;
             }
@@ -373,7 +373,7 @@ void MainWindow::onNavigationItemClicked(int index)
     }
 
     contentStack_->setCurrentIndex(index);
-    Logger::instance().debug("MainWindow", QString("Navigation changed to index %1").arg(index));
+    LOG_DEBUG("MainWindow", QString("Navigation changed to index %1").arg(index));
 }
 
 void MainWindow::onThemeToggled()
@@ -483,6 +483,6 @@ void MainWindow::saveSettings()
         settings->setValue(Constants::SETTING_THEME, themeSetting);
 
         settings->sync();
-        Logger::instance().debug("MainWindow", QString("Saved theme: %1").arg(themeSetting));
+        LOG_DEBUG("MainWindow", QString("Saved theme: %1").arg(themeSetting));
     }
 }
@@ -105,20 +105,19 @@ void MyAssessmentsWidget::loadAssessments()
     // Load production data
     QList<ProductionArea> areas = productionRepo_.findAllAreas();
 
-    // Load this engineer's assessments
-    QList<Assessment> assessments = assessmentRepo_.findAll();
+    // Stream this engineer's assessments into a key -> score map for quick lookup
+    AssessmentRepository::PageFilter filter;
+    filter.engineerId = engineerId_;
 
-    // Create a map of assessment key -> score for quick lookup
     QMap<QString, int> assessmentScores;
-    for (const Assessment& assessment : assessments) {
-        if (assessment.engineerId() == engineerId_) {
-            QString key = QString("%1_%2_%3")
-                .arg(assessment.productionAreaId())
-                .arg(assessment.machineId())
-                .arg(assessment.competencyId());
-            assessmentScores[key] = assessment.score();
-        }
-    }
+    assessmentRepo_.forEach([&assessmentScores](const Assessment& assessment) {
+        QString key = QString("%1_%2_%3")
+            .arg(assessment.productionAreaId())
+            .arg(assessment.machineId())
+            .arg(assessment.competencyId());
+        assessmentScores[key] = assessment.score();
+        return true;
+    }, filter);
 
     // Track statistics
     int totalCompetencies = 0;
@@ -393,8 +392,7 @@ void MyAssessmentsWidget::onScoreButtonClicked()
 
 void MyAssessmentsWidget::onSaveClicked()
 {
-    int savedCount = 0;
-    int errorCount = 0;
+    QList<Assessment> assessments;
 
     // Loop through all button groups and find selected score for each competency
     for (const ScoreButtonGroup& buttonGroup : scoreButtonGroups_) {
@@ -408,29 +406,25 @@ void MyAssessmentsWidget::onSaveClicked()
             }
         }
 
-        Assessment assessment(0, engineerId_, buttonGroup.areaId, buttonGroup.machineId,
-                            buttonGroup.competencyId, selectedScore);
+        assessments.append(Assessment(0, engineerId_, buttonGroup.areaId, buttonGroup.machineId,
+                                      buttonGroup.competencyId, selectedScore));
+    }
 
-        if (assessmentRepo_.saveOrUpdate(assessment)) {
-            savedCount++;
-        } else {
-            errorCount++;
-            Logger::instance().error("MyAssessmentsWidget",
-                QString("Failed to save assessment: %1").arg(assessmentRepo_.lastError()));
-        }
+    // Saved as one transaction: either every score is stored or none is
+    if (!assessmentRepo_.saveOrUpdateBatch(assessments)) {
+        Logger::instance().error("MyAssessmentsWidget",
+            QString("Failed to save assessments: %1").arg(assessmentRepo_.lastError()));
+        QMessageBox::warning(this, "Save Failed",
+            QString("No assessments were saved:\n%1").arg(assessmentRepo_.lastError()));
+        return;
     }
 
-    if (errorCount > 0) {
-        QMessageBox::warning(this, "Partial Success",
-            QString("Saved %1 assessments, but %2 failed.").arg(savedCount).arg(errorCount));
-    } else {
-        Logger::instance().info("MyAssessmentsWidget", QString("Saved %1 assessments").arg(savedCount));
-        QMessageBox::information(this, "Success",
-            QString("Successfully saved %1 assessments.").arg(savedCount));
+    Logger::instance().info("MyAssessmentsWidget", QString("Saved %1 assessments").arg(assessments.size()));
+    QMessageBox::information(this, "Success",
+        QString("Successfully saved %1 assessments.").arg(assessments.size()));
 
-        // Refresh to update summary statistics
-        loadAssessments();
-    }
+    // Refresh to update summary statistics
+    loadAssessments();
 }
 
 void MyAssessmentsWidget::onRefreshClicked()
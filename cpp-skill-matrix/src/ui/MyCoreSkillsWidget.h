@@ -4,11 +4,11 @@
 #include <QWidget>
 #include <QPushButton>
 #include <QLabel>
-#include <QVBoxLayout>
-#include <QHBoxLayout>
-#include <QScrollArea>
+#include <QTableView>
 #include "../database/CoreSkillsRepository.h"
 
+class CoreSkillsModel;
+
 class MyCoreSkillsWidget : public QWidget
 {
     Q_OBJECT
@@ -20,29 +20,20 @@ public:
 private slots:
     void onRefreshClicked();
     void onSaveClicked();
-    void onScoreButtonClicked();
+    void updateSummary();
 
 private:
     void setupUI();
     void loadCoreSkills();
-    void createScoreButtons(QHBoxLayout* layout, const QString& categoryId,
-                           const QString& skillId, int currentScore);
+    void applyCategorySpans();
 
     QString engineerId_;
-    QVBoxLayout* skillsLayout_;
-    QWidget* skillsContainer_;
+    QTableView* skillsView_;
+    CoreSkillsModel* model_;
     QPushButton* saveButton_;
     QPushButton* refreshButton_;
     QLabel* summaryLabel_;
 
-    // Map to track score button groups
-    struct ScoreButtonGroup {
-        QPushButton* buttons[4];  // 0-3 buttons
-        QString categoryId;
-        QString skillId;
-    };
-    QList<ScoreButtonGroup> scoreButtonGroups_;
-
     CoreSkillsRepository coreSkillsRepo_;
 };
 
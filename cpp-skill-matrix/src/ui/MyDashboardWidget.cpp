@@ -197,26 +197,12 @@ void MyDashboardWidget::loadDashboardData()
 {
     Logger::instance().info("MyDashboardWidget", QString("Loading dashboard for engineer: %1").arg(engineerId_));
 
-    // Load engineer data
-    currentEngineer_ = engineerRepo_.findById(engineerId_);
-
-    // Load assessments
-    QList<Assessment> allAssessments = assessmentRepo_.findAll();
-    assessments_.clear();
-    for (const Assessment& assessment : allAssessments) {
-        if (assessment.engineerId() == engineerId_) {
-            assessments_.append(assessment);
-        }
-    }
-
-    // Load core skill assessments
-    QList<CoreSkillAssessment> allCoreSkillAssessments = coreSkillsRepo_.findAllAssessments();
-    coreSkillAssessments_.clear();
-    for (const CoreSkillAssessment& assessment : allCoreSkillAssessments) {
-        if (assessment.engineerId() == engineerId_) {
-            coreSkillAssessments_.append(assessment);
-        }
-    }
+    // Read this engineer's slice of the shared store (indexed, no table scans)
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    currentEngineer_ = store.engineers().value(engineerId_);
+    hierarchy_ = store.hierarchy();
+    assessments_ = store.assessments().group(engineerId_);
+    coreSkillAssessments_ = store.coreSkillAssessments().group(engineerId_);
 
     // Update all sections
     updatePersonalStats();
@@ -234,29 +220,15 @@ void MyDashboardWidget::updatePersonalStats()
     // Average competency skill level (WEIGHTED)
     double avgCompetency = 0.0;
     if (!assessments_.isEmpty()) {
-        // Load all competencies to get weights
-        QList<ProductionArea> areas = productionRepo_.findAllAreas();
-        QList<Competency> allCompetencies;
-        for (const ProductionArea& area : areas) {
-            QList<Machine> machines = productionRepo_.findMachinesByArea(area.id());
-            for (const Machine& machine : machines) {
-                QList<Competency> machineCompetencies = productionRepo_.findCompetenciesByMachine(machine.id());
-                allCompetencies.append(machineCompetencies);
-            }
-        }
-
         double weightedSum = 0.0;
         double totalWeights = 0.0;
 
         for (const Assessment& assessment : assessments_) {
-            // Find the competency to get its weight
-            for (const Competency& comp : allCompetencies) {
-                if (comp.id() == assessment.competencyId()) {
-                    double weight = comp.calculatedWeight();
-                    weightedSum += assessment.score() * weight;
-                    totalWeights += weight;
-                    break;
-                }
+            // Look up the competency weight in the cached hierarchy
+            if (hierarchy_.containsCompetency(assessment.competencyId())) {
+                double weight = hierarchy_.competency(assessment.competencyId()).calculatedWeight();
+                weightedSum += assessment.score() * weight;
+                totalWeights += weight;
             }
         }
 
@@ -269,7 +241,7 @@ void MyDashboardWidget::updatePersonalStats()
     // Average core skills (WEIGHTED)
     double avgCoreSkills = 0.0;
     if (!coreSkillAssessments_.isEmpty()) {
-        QList<CoreSkill> allCoreSkills = coreSkillsRepo_.findAllSkills();
+        QList<CoreSkill> allCoreSkills = SkillMatrixStore::instance().coreSkills().items();
 
         double weightedSum = 0.0;
         double totalWeights = 0.0;
@@ -301,52 +273,12 @@ void MyDashboardWidget::updateAreasOfWeakness()
     weaknessListWidget_->clear();
 
     // Find competencies with score 0 or 1
-    QList<ProductionArea> areas = productionRepo_.findAllAreas();
-
-    // Build list of all machines and competencies
-    QList<Machine> allMachines;
-    QList<Competency> allCompetencies;
-    for (const ProductionArea& area : areas) {
-        QList<Machine> areaMachines = productionRepo_.findMachinesByArea(area.id());
-        allMachines.append(areaMachines);
-
-        for (const Machine& machine : areaMachines) {
-            QList<Competency> machineCompetencies = productionRepo_.findCompetenciesByMachine(machine.id());
-            allCompetencies.append(machineCompetencies);
-        }
-    }
-
     for (const Assessment& assessment : assessments_) {
         if (assessment.score() <= 1) {
-            // Find the competency name
-            QString competencyName;
-            int machineId = assessment.machineId();
-            int competencyId = assessment.competencyId();
-
-            for (const Competency& comp : allCompetencies) {
-                if (comp.id() == competencyId) {
-                    competencyName = comp.name();
-                    break;
-                }
-            }
-
-            // Find machine and area names
-            QString machineName;
-            int areaId = assessment.productionAreaId();
-            for (const Machine& machine : allMachines) {
-                if (machine.id() == machineId) {
-                    machineName = machine.name();
-                    break;
-                }
-            }
-
-            QString areaName;
-            for (const ProductionArea& area : areas) {
-                if (area.id() == areaId) {
-                    areaName = area.name();
-                    break;
-                }
-            }
+            // Resolve names from the cached hierarchy
+            QString competencyName = hierarchy_.competency(assessment.competencyId()).name();
+            QString machineName = hierarchy_.machine(assessment.machineId()).name();
+            QString areaName = hierarchy_.area(assessment.productionAreaId()).name();
 
             QString weaknessText = QString("%1 - %2 - %3 (Score: %4)")
                 .arg(areaName)
@@ -358,8 +290,8 @@ void MyDashboardWidget::updateAreasOfWeakness()
     }
 
     // Find core skills with score 0 or 1
-    QList<CoreSkill> allCoreSkills = coreSkillsRepo_.findAllSkills();
-    QList<CoreSkillCategory> categories = coreSkillsRepo_.findAllCategories();
+    QList<CoreSkill> allCoreSkills = SkillMatrixStore::instance().coreSkills().items();
+    QList<CoreSkillCategory> categories = SkillMatrixStore::instance().coreSkillCategories().items();
 
     for (const CoreSkillAssessment& assessment : coreSkillAssessments_) {
         if (assessment.score() <= 1) {
@@ -399,43 +331,26 @@ void MyDashboardWidget::createProductionAreaRadarChart()
     QMap<QString, double> areaWeightedScores;
     QMap<QString, double> areaTotalWeights;
 
-    QList<ProductionArea> areas = productionRepo_.findAllAreas();
-
     // Initialize maps
-    for (const ProductionArea& area : areas) {
+    for (const ProductionArea& area : hierarchy_.areas()) {
         areaWeightedScores[area.name()] = 0.0;
         areaTotalWeights[area.name()] = 0.0;
     }
 
-    // Load all competencies to get weights
-    QList<Competency> allCompetencies;
-    for (const ProductionArea& area : areas) {
-        QList<Machine> machines = productionRepo_.findMachinesByArea(area.id());
-        for (const Machine& machine : machines) {
-            QList<Competency> machineCompetencies = productionRepo_.findCompetenciesByMachine(machine.id());
-            allCompetencies.append(machineCompetencies);
-        }
-    }
-
     // Calculate weighted sums
     for (const Assessment& assessment : assessments_) {
         int areaId = assessment.productionAreaId();
 
-        // Find the competency to get its weight
+        // Look up the competency weight
         double weight = 3.0; // Default weight if not found
-        for (const Competency& comp : allCompetencies) {
-            if (comp.id() == assessment.competencyId()) {
-                weight = comp.calculatedWeight();
-                break;
-            }
+        if (hierarchy_.containsCompetency(assessment.competencyId())) {
+            weight = hierarchy_.competency(assessment.competencyId()).calculatedWeight();
         }
 
-        for (const ProductionArea& area : areas) {
-            if (area.id() == areaId) {
-                areaWeightedScores[area.name()] += assessment.score() * weight;
-                areaTotalWeights[area.name()] += weight;
-                break;
-            }
+        if (hierarchy_.containsArea(areaId)) {
+            QString areaName = hierarchy_.area(areaId).name();
+            areaWeightedScores[areaName] += assessment.score() * weight;
+            areaTotalWeights[areaName] += weight;
         }
     }
 
@@ -459,7 +374,7 @@ void MyDashboardWidget::createCoreSkillsRadarChart()
     QMap<QString, double> categoryWeightedScores;
     QMap<QString, double> categoryTotalWeights;
 
-    QList<CoreSkillCategory> categories = coreSkillsRepo_.findAllCategories();
+    QList<CoreSkillCategory> categories = SkillMatrixStore::instance().coreSkillCategories().items();
 
     // Initialize maps
     for (const CoreSkillCategory& category : categories) {
@@ -468,7 +383,7 @@ void MyDashboardWidget::createCoreSkillsRadarChart()
     }
 
     // Load all core skills to get weights
-    QList<CoreSkill> allCoreSkills = coreSkillsRepo_.findAllSkills();
+    QList<CoreSkill> allCoreSkills = SkillMatrixStore::instance().coreSkills().items();
 
     // Calculate weighted sums
     for (const CoreSkillAssessment& assessment : coreSkillAssessments_) {
@@ -571,5 +486,9 @@ QChart* MyDashboardWidget::createRadarChart(const QMap<QString, double>& data, c
 
 void MyDashboardWidget::onRefreshClicked()
 {
+    // Explicit refresh picks up changes made by other clients
+    SkillMatrixStore::instance().sync(SkillMatrixStore::Hierarchy |
+                                      SkillMatrixStore::Assessments |
+                                      SkillMatrixStore::CoreSkillAssessments);
     loadDashboardData();
 }
@@ -8,10 +8,7 @@
 #include <QtCharts/QChart>
 #include <QtCharts/QChartView>
 #include <QtCharts/QPolarChart>
-#include "../database/EngineerRepository.h"
-#include "../database/ProductionRepository.h"
-#include "../database/AssessmentRepository.h"
-#include "../database/CoreSkillsRepository.h"
+#include "../database/SkillMatrixStore.h"
 #include "../models/Engineer.h"
 #include "../models/Assessment.h"
 
@@ -58,14 +55,9 @@ private:
     // Buttons
     QPushButton* refreshButton_;
 
-    // Repositories
-    EngineerRepository engineerRepo_;
-    ProductionRepository productionRepo_;
-    AssessmentRepository assessmentRepo_;
-    CoreSkillsRepository coreSkillsRepo_;
-
     // Cached data
     Engineer currentEngineer_;
+    ProductionHierarchy hierarchy_;
     QList<Assessment> assessments_;
     QList<CoreSkillAssessment> coreSkillAssessments_;
 };
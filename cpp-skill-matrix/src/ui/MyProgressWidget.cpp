@@ -1,4 +1,5 @@
 #include "MyProgressWidget.h"
+#include "../controllers/SnapshotController.h"
 #include "../utils/Logger.h"
 #include "../utils/JsonHelper.h"
 #include <QVBoxLayout>
@@ -11,9 +12,6 @@
 #include <QtCharts/QValueAxis>
 #include <QShowEvent>
 #include <QDateTime>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
 
 MyProgressWidget::MyProgressWidget(const QString& engineerId, QWidget* parent)
     : QWidget(parent)
@@ -228,32 +226,18 @@ void MyProgressWidget::loadProgressData()
 {
     Logger::instance().info("MyProgressWidget", QString("Loading progress for engineer: %1").arg(engineerId_));
 
-    // Load engineer data
-    currentEngineer_ = engineerRepo_.findById(engineerId_);
+    // Read this engineer's slice of the shared store (indexed, no table scans)
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    currentEngineer_ = store.engineers().value(engineerId_);
+    assessments_ = store.assessments().group(engineerId_);
+    coreSkillAssessments_ = store.coreSkillAssessments().group(engineerId_);
 
-    // Load current assessments
-    QList<Assessment> allAssessments = assessmentRepo_.findAll();
-    assessments_.clear();
-    for (const Assessment& assessment : allAssessments) {
-        if (assessment.engineerId() == engineerId_) {
-            assessments_.append(assessment);
-        }
-    }
-
-    // Load core skill assessments
-    QList<CoreSkillAssessment> allCoreSkillAssessments = coreSkillsRepo_.findAllAssessments();
-    coreSkillAssessments_.clear();
-    for (const CoreSkillAssessment& assessment : allCoreSkillAssessments) {
-        if (assessment.engineerId() == engineerId_) {
-            coreSkillAssessments_.append(assessment);
-        }
-    }
-
-    // Load snapshots
-    snapshots_ = snapshotRepo_.findAll();
+    // This engineer's snapshot trend, from the per-engineer history index
+    SnapshotController snapshotController;
+    history_ = snapshotController.engineerHistory(engineerId_, 50);
 
     // Load certifications
-    certifications_ = certificationRepo_.findByEngineer(engineerId_);
+    certifications_ = store.certifications().group(engineerId_);
 
     // Update all sections
     createSkillProgressChart();
@@ -287,16 +271,8 @@ void MyProgressWidget::createSkillProgressChart()
     QLineSeries* series = new QLineSeries();
     series->setName("Weighted Avg Score");
 
-    // Load all competencies to get weights
-    QList<ProductionArea> areas = productionRepo_.findAllAreas();
-    QList<Competency> allCompetencies;
-    for (const ProductionArea& area : areas) {
-        QList<Machine> machines = productionRepo_.findMachinesByArea(area.id());
-        for (const Machine& machine : machines) {
-            QList<Competency> machineCompetencies = productionRepo_.findCompetenciesByMachine(machine.id());
-            allCompetencies.append(machineCompetencies);
-        }
-    }
+    // Load the production hierarchy once to get competency weights
+    ProductionHierarchy hierarchy = SkillMatrixStore::instance().hierarchy();
 
     // Current point (WEIGHTED)
     if (!assessments_.isEmpty()) {
@@ -304,14 +280,10 @@ void MyProgressWidget::createSkillProgressChart()
         double totalWeights = 0.0;
 
         for (const Assessment& assessment : assessments_) {
-            // Find the competency to get its weight
-            for (const Competency& comp : allCompetencies) {
-                if (comp.id() == assessment.competencyId()) {
-                    double weight = comp.calculatedWeight();
-                    weightedSum += assessment.score() * weight;
-                    totalWeights += weight;
-                    break;
-                }
+            if (hierarchy.containsCompetency(assessment.competencyId())) {
+                double weight = hierarchy.competency(assessment.competencyId()).calculatedWeight();
+                weightedSum += assessment.score() * weight;
+                totalWeights += weight;
             }
         }
 
@@ -321,31 +293,10 @@ void MyProgressWidget::createSkillProgressChart()
         series->append(now.toMSecsSinceEpoch(), currentAvg);
     }
 
-    // Parse snapshots for historical data
-    for (const Snapshot& snapshot : snapshots_) {
-        // Parse JSON data
-        QJsonDocument doc = QJsonDocument::fromJson(snapshot.data().toUtf8());
-        if (doc.isObject()) {
-            QJsonObject obj = doc.object();
-            if (obj.contains("assessments")) {
-                QJsonArray assessmentsArray = obj["assessments"].toArray();
-
-                double total = 0.0;
-                int count = 0;
-                for (const QJsonValue& val : assessmentsArray) {
-                    QJsonObject assessment = val.toObject();
-                    if (assessment["engineerId"].toString() == engineerId_) {
-                        total += assessment["score"].toInt();
-                        count++;
-                    }
-                }
-
-                if (count > 0) {
-                    double avg = total / count;
-                    QDateTime timestamp = snapshot.timestamp();
-                    series->append(timestamp.toMSecsSinceEpoch(), avg);
-                }
-            }
+    // Historical points from the history index
+    for (const SnapshotHistoryPoint& point : history_) {
+        if (point.competencyCount > 0) {
+            series->append(point.timestamp.toMSecsSinceEpoch(), point.competencyAverage);
         }
     }
 
@@ -381,7 +332,7 @@ void MyProgressWidget::createCoreSkillProgressChart()
     series->setName("Weighted Avg Core Skills Score");
 
     // Load all core skills to get weights
-    QList<CoreSkill> allCoreSkills = coreSkillsRepo_.findAllSkills();
+    QList<CoreSkill> allCoreSkills = SkillMatrixStore::instance().coreSkills().items();
 
     // Current point (WEIGHTED)
     if (!coreSkillAssessments_.isEmpty()) {
@@ -406,30 +357,10 @@ void MyProgressWidget::createCoreSkillProgressChart()
         series->append(now.toMSecsSinceEpoch(), currentAvg);
     }
 
-    // Parse snapshots for historical data
-    for (const Snapshot& snapshot : snapshots_) {
-        QJsonDocument doc = QJsonDocument::fromJson(snapshot.data().toUtf8());
-        if (doc.isObject()) {
-            QJsonObject obj = doc.object();
-            if (obj.contains("coreSkillAssessments")) {
-                QJsonArray coreSkillsArray = obj["coreSkillAssessments"].toArray();
-
-                double total = 0.0;
-                int count = 0;
-                for (const QJsonValue& val : coreSkillsArray) {
-                    QJsonObject assessment = val.toObject();
-                    if (assessment["engineerId"].toString() == engineerId_) {
-                        total += assessment["score"].toInt();
-                        count++;
-                    }
-                }
-
-                if (count > 0) {
-                    double avg = total / count;
-                    QDateTime timestamp = snapshot.timestamp();
-                    series->append(timestamp.toMSecsSinceEpoch(), avg);
-                }
-            }
+    // Historical points from the history index
+    for (const SnapshotHistoryPoint& point : history_) {
+        if (point.coreSkillCount > 0) {
+            series->append(point.timestamp.toMSecsSinceEpoch(), point.coreSkillAverage);
         }
     }
 
@@ -460,11 +391,11 @@ void MyProgressWidget::updateSnapshotComparison()
     snapshotCombo_->clear();
     snapshotCombo_->addItem("Select a snapshot...");
 
-    for (const Snapshot& snapshot : snapshots_) {
+    for (const SnapshotHistoryPoint& point : history_) {
         QString label = QString("%1 - %2")
-            .arg(snapshot.timestamp().toString("yyyy-MM-dd HH:mm"))
-            .arg(snapshot.description());
-        snapshotCombo_->addItem(label, snapshot.id());
+            .arg(point.timestamp.toString("yyyy-MM-dd HH:mm"))
+            .arg(point.description);
+        snapshotCombo_->addItem(label, point.snapshotId);
     }
 }
 
@@ -517,6 +448,10 @@ void MyProgressWidget::updateGoalsProgress()
 
 void MyProgressWidget::onRefreshClicked()
 {
+    // Explicit refresh picks up changes made by other clients
+    SkillMatrixStore::instance().sync(SkillMatrixStore::Assessments |
+                                      SkillMatrixStore::CoreSkillAssessments |
+                                      SkillMatrixStore::Certifications);
     loadProgressData();
 }
 
@@ -531,71 +466,57 @@ void MyProgressWidget::onSnapshotComparisonChanged(int index)
 
     // Get selected snapshot
     QString snapshotId = snapshotCombo_->itemData(index).toString();
-    Snapshot selectedSnapshot;
-    for (const Snapshot& snapshot : snapshots_) {
-        if (snapshot.id() == snapshotId) {
-            selectedSnapshot = snapshot;
+    SnapshotHistoryPoint selectedPoint;
+    for (const SnapshotHistoryPoint& point : history_) {
+        if (point.snapshotId == snapshotId) {
+            selectedPoint = point;
             break;
         }
     }
 
-    if (selectedSnapshot.id().isEmpty()) {
+    if (selectedPoint.snapshotId.isEmpty()) {
         return;
     }
 
     snapshotComparisonLabel_->setText(QString("Comparing current state with snapshot from %1")
-        .arg(selectedSnapshot.timestamp().toString("yyyy-MM-dd HH:mm")));
-
-    // Parse snapshot data and compare with current
-    QJsonDocument doc = QJsonDocument::fromJson(selectedSnapshot.data().toUtf8());
-    if (!doc.isObject()) {
-        changesListWidget_->addItem("Error: Could not parse snapshot data");
-        return;
-    }
+        .arg(selectedPoint.timestamp.toString("yyyy-MM-dd HH:mm")));
 
-    QJsonObject obj = doc.object();
-
-    // Compare competency assessments
+    // Compare current competency assessments with this engineer's row of the snapshot
+    SnapshotController snapshotController;
+    const QHash<int, int> snapshotScores =
+        snapshotController.engineerScores(selectedPoint.snapshotId, engineerId_).competencies;
     int improvementsCount = 0;
     int declinesCount = 0;
 
-    if (obj.contains("assessments")) {
-        QJsonArray snapshotAssessments = obj["assessments"].toArray();
-
-        for (const Assessment& currentAssessment : assessments_) {
-            // Find matching assessment in snapshot
-            for (const QJsonValue& val : snapshotAssessments) {
-                QJsonObject snapshotAssessment = val.toObject();
-
-                if (snapshotAssessment["engineerId"].toString() == engineerId_ &&
-                    snapshotAssessment["competencyId"].toInt() == currentAssessment.competencyId()) {
-
-                    int oldScore = snapshotAssessment["score"].toInt();
-                    int newScore = currentAssessment.score();
-
-                    if (newScore > oldScore) {
-                        improvementsCount++;
-                        QString change = QString("✓ Competency ID %1: %2 → %3 (+%4)")
-                            .arg(currentAssessment.competencyId())
-                            .arg(oldScore)
-                            .arg(newScore)
-                            .arg(newScore - oldScore);
-                        QListWidgetItem* item = new QListWidgetItem(change);
-                        item->setForeground(QColor(76, 175, 80));  // Green
-                        changesListWidget_->addItem(item);
-                    } else if (newScore < oldScore) {
-                        declinesCount++;
-                        QString change = QString("↓ Competency ID %1: %2 → %3 (%4)")
-                            .arg(currentAssessment.competencyId())
-                            .arg(oldScore)
-                            .arg(newScore)
-                            .arg(newScore - oldScore);
-                        QListWidgetItem* item = new QListWidgetItem(change);
-                        item->setForeground(QColor(244, 67, 54));  // Red
-                        changesListWidget_->addItem(item);
-                    }
-                }
-            }
+    for (const Assessment& currentAssessment : assessments_) {
+        auto snapshotScore = snapshotScores.constFind(currentAssessment.competencyId());
+        if (snapshotScore == snapshotScores.constEnd()) {
+            continue;
+        }
+
+        int oldScore = snapshotScore.value();
+        int newScore = currentAssessment.score();
+
+        if (newScore > oldScore) {
+            improvementsCount++;
+            QString change = QString("✓ Competency ID %1: %2 → %3 (+%4)")
+                .arg(currentAssessment.competencyId())
+                .arg(oldScore)
+                .arg(newScore)
+                .arg(newScore - oldScore);
+            QListWidgetItem* item = new QListWidgetItem(change);
+            item->setForeground(QColor(76, 175, 80));  // Green
+            changesListWidget_->addItem(item);
+        } else if (newScore < oldScore) {
+            declinesCount++;
+            QString change = QString("↓ Competency ID %1: %2 → %3 (%4)")
+                .arg(currentAssessment.competencyId())
+                .arg(oldScore)
+                .arg(newScore)
+                .arg(newScore - oldScore);
+            QListWidgetItem* item = new QListWidgetItem(change);
+            item->setForeground(QColor(244, 67, 54));  // Red
+            changesListWidget_->addItem(item);
         }
     }
 
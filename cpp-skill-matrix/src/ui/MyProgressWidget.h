@@ -8,15 +8,10 @@
 #include <QComboBox>
 #include <QtCharts/QChart>
 #include <QtCharts/QChartView>
-#include "../database/EngineerRepository.h"
-#include "../database/AssessmentRepository.h"
-#include "../database/ProductionRepository.h"
-#include "../database/CoreSkillsRepository.h"
-#include "../database/SnapshotRepository.h"
-#include "../database/CertificationRepository.h"
+#include "../database/SkillMatrixStore.h"
+#include "../database/SnapshotHistoryRepository.h"
 #include "../models/Engineer.h"
 #include "../models/Assessment.h"
-#include "../models/Snapshot.h"
 #include "../models/Certification.h"
 
 class MyProgressWidget : public QWidget
@@ -71,19 +66,11 @@ private:
     // Buttons
     QPushButton* refreshButton_;
 
-    // Repositories
-    EngineerRepository engineerRepo_;
-    AssessmentRepository assessmentRepo_;
-    ProductionRepository productionRepo_;
-    CoreSkillsRepository coreSkillsRepo_;
-    SnapshotRepository snapshotRepo_;
-    CertificationRepository certificationRepo_;
-
     // Cached data
     Engineer currentEngineer_;
     QList<Assessment> assessments_;
     QList<CoreSkillAssessment> coreSkillAssessments_;
-    QList<Snapshot> snapshots_;
+    QList<SnapshotHistoryPoint> history_;       // newest first
     QList<Certification> certifications_;
 };
 
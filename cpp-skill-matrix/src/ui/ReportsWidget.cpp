@@ -2,6 +2,7 @@
 #include "StyleManager.h"
 #include "../utils/Logger.h"
 #include "../utils/IconProvider.h"
+#include "../utils/CsvWriter.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -16,6 +17,7 @@
 #include <QFile>
 #include <QTextStream>
 #include <QMap>
+#include <QHash>
 
 ReportsWidget::ReportsWidget(QWidget* parent)
     : QWidget(parent)
@@ -183,7 +185,10 @@ QString ReportsWidget::generateEngineerSkillsReport()
     stream << "Generated: " << QDateTime::currentDateTime().toString("dddd, MMMM d, yyyy h:mm AP") << "\n";
     stream << "=" << QString("=").repeated(79) << "\n\n";
 
-    QList<Engineer> engineers = engineerRepo_.findAll();
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    QList<Engineer> engineers = store.engineers().items();
+    AssessmentSnapshot assessments = store.assessments();
+    ProductionHierarchy hierarchy = store.hierarchy();
 
     if (engineers.isEmpty()) {
         stream << "No engineers found in the system.\n";
@@ -199,13 +204,7 @@ QString ReportsWidget::generateEngineerSkillsReport()
         stream << QString("-").repeated(79) << "\n";
 
         // Get assessments for this engineer
-        QList<Assessment> assessments = assessmentRepo_.findAll();
-        QList<Assessment> engineerAssessments;
-        for (const Assessment& a : assessments) {
-            if (a.engineerId() == engineer.id()) {
-                engineerAssessments.append(a);
-            }
-        }
+        QList<Assessment> engineerAssessments = assessments.group(engineer.id());
 
         if (engineerAssessments.isEmpty()) {
             stream << "  No assessments recorded.\n\n";
@@ -220,7 +219,7 @@ QString ReportsWidget::generateEngineerSkillsReport()
 
         stream << "  Production Area Competencies:\n";
         for (auto it = areaAssessments.begin(); it != areaAssessments.end(); ++it) {
-            ProductionArea area = productionRepo_.findAreaById(it.key());
+            ProductionArea area = hierarchy.area(it.key());
             stream << "    Area: " << (area.name().isEmpty() ? QString::number(it.key()) : area.name()) << "\n";
 
             for (const Assessment& a : it.value()) {
@@ -268,9 +267,11 @@ QString ReportsWidget::generateProductionAreaCoverageReport()
     stream << "Generated: " << QDateTime::currentDateTime().toString("dddd, MMMM d, yyyy h:mm AP") << "\n";
     stream << "=" << QString("=").repeated(79) << "\n\n";
 
-    QList<ProductionArea> areas = productionRepo_.findAllAreas();
-    QList<Engineer> allEngineers = engineerRepo_.findAll();
-    QList<Assessment> allAssessments = assessmentRepo_.findAll();
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    ProductionHierarchy hierarchy = store.hierarchy();
+    QList<ProductionArea> areas = hierarchy.areas();
+    QList<Engineer> allEngineers = store.engineers().items();
+    QList<Assessment> allAssessments = store.assessments().items();
 
     if (areas.isEmpty()) {
         stream << "No production areas defined in the system.\n";
@@ -286,7 +287,7 @@ QString ReportsWidget::generateProductionAreaCoverageReport()
         stream << QString("-").repeated(79) << "\n";
 
         // Get machines for this area
-        QList<Machine> machines = productionRepo_.findMachinesByArea(area.id());
+        QList<Machine> machines = hierarchy.machinesByArea(area.id());
         stream << "  Machines: " << machines.size() << "\n";
 
         // Count engineers assessed in this area
@@ -363,8 +364,9 @@ QString ReportsWidget::generateComplianceReport()
     stream << "Generated: " << QDateTime::currentDateTime().toString("dddd, MMMM d, yyyy h:mm AP") << "\n";
     stream << "=" << QString("=").repeated(79) << "\n\n";
 
-    QList<Certification> certifications = certificationRepo_.findAll();
-    QList<Engineer> engineers = engineerRepo_.findAll();
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    QList<Certification> certifications = store.certifications().items();
+    QList<Engineer> engineers = store.engineers().items();
 
     if (certifications.isEmpty()) {
         stream << "No certifications found in the system.\n";
@@ -458,13 +460,14 @@ QString ReportsWidget::generateDetailedSkillMatrixReport()
     stream << "Generated: " << QDateTime::currentDateTime().toString("dddd, MMMM d, yyyy h:mm AP") << "\n";
     stream << "=" << QString("=").repeated(79) << "\n\n";
 
-    QList<Engineer> engineers = engineerRepo_.findAll();
-    QList<ProductionArea> areas = productionRepo_.findAllAreas();
-    QList<Assessment> allAssessments = assessmentRepo_.findAll();
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    QList<Engineer> engineers = store.engineers().items();
+    QList<ProductionArea> areas = store.hierarchy().areas();
+    AssessmentSnapshot assessments = store.assessments();
 
     stream << "Total Engineers: " << engineers.size() << "\n";
     stream << "Total Production Areas: " << areas.size() << "\n";
-    stream << "Total Assessments: " << allAssessments.size() << "\n\n";
+    stream << "Total Assessments: " << assessments.size() << "\n\n";
 
     // Build a matrix
     stream << "SKILL MATRIX (Scores: 0=Not Assessed, 1=Basic, 2=Intermediate, 3=Advanced)\n";
@@ -485,12 +488,13 @@ QString ReportsWidget::generateDetailedSkillMatrixReport()
 
         double totalScore = 0;
         int scoreCount = 0;
+        QList<Assessment> engineerAssessments = assessments.group(engineer.id());
 
         for (const ProductionArea& area : areas) {
             // Find assessment for this engineer and area
             int score = -1;  // -1 means no assessment
-            for (const Assessment& a : allAssessments) {
-                if (a.engineerId() == engineer.id() && a.productionAreaId() == area.id()) {
+            for (const Assessment& a : engineerAssessments) {
+                if (a.productionAreaId() == area.id()) {
                     score = a.score();
                     totalScore += score;
                     scoreCount++;
@@ -597,45 +601,44 @@ bool ReportsWidget::exportToPDF(const QString& filename, const QString& content)
 
 bool ReportsWidget::exportToCSV(const QString& filename)
 {
-    QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    CsvWriter writer;
+    if (!writer.open(filename)) {
         return false;
     }
 
-    QTextStream out(&file);
-
-    // Simple CSV export of current report content
-    // In a real application, you'd structure this better
-    out << "Skill Matrix Report\n";
-    out << "Generated," << QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss") << "\n\n";
+    writer.addRow({"Skill Matrix Report"});
+    writer.addRow({"Generated", QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss")});
+    writer.endRow();
 
     // Export engineer data
-    out << "Engineer ID,Name,Shift,Total Assessments,Average Score\n";
-
-    QList<Engineer> engineers = engineerRepo_.findAll();
-    QList<Assessment> allAssessments = assessmentRepo_.findAll();
+    writer.addRow({"Engineer ID", "Name", "Shift", "Total Assessments", "Average Score"});
+
+    SkillMatrixStore& store = SkillMatrixStore::instance();
+    QList<Engineer> engineers = store.engineers().items();
+    AssessmentSnapshot assessments = store.assessments();
+
+    // One pass over the assessments, then one row per engineer
+    QHash<QString, QPair<int, int>> totals;  // engineer id -> (count, score sum)
+    totals.reserve(engineers.size());
+    for (const Assessment& a : assessments.items()) {
+        QPair<int, int>& total = totals[a.engineerId()];
+        ++total.first;
+        total.second += a.score();
+    }
 
     for (const Engineer& engineer : engineers) {
-        QList<Assessment> engineerAssessments;
-        for (const Assessment& a : allAssessments) {
-            if (a.engineerId() == engineer.id()) {
-                engineerAssessments.append(a);
-            }
+        QPair<int, int> total = totals.value(engineer.id());
+        double avgScore = total.first == 0 ? 0 : double(total.second) / total.first;
+
+        writer.addField(engineer.id());
+        writer.addField(engineer.name());
+        writer.addField(engineer.shift());
+        writer.addField(total.first);
+        writer.addField(avgScore, 2);
+        if (!writer.endRow()) {
+            return false;
         }
-
-        double totalScore = 0;
-        for (const Assessment& a : engineerAssessments) {
-            totalScore += a.score();
-        }
-        double avgScore = engineerAssessments.isEmpty() ? 0 : totalScore / engineerAssessments.size();
-
-        out << engineer.id() << ","
-            << engineer.name() << ","
-            << engineer.shift() << ","
-            << engineerAssessments.size() << ","
-            << QString::number(avgScore, 'f', 2) << "\n";
     }
 
-    file.close();
-    return true;
+    return writer.close();
 }
@@ -5,11 +5,7 @@
 #include <QPushButton>
 #include <QTextEdit>
 #include <QComboBox>
-#include "../database/EngineerRepository.h"
-#include "../database/ProductionRepository.h"
-#include "../database/AssessmentRepository.h"
-#include "../database/CoreSkillsRepository.h"
-#include "../database/CertificationRepository.h"
+#include "../database/SkillMatrixStore.h"
 
 class ReportsWidget : public QWidget
 {
@@ -43,13 +39,6 @@ private:
     QPushButton* exportCSVButton_;
     QPushButton* printButton_;
 
-    // Repositories
-    EngineerRepository engineerRepo_;
-    ProductionRepository productionRepo_;
-    AssessmentRepository assessmentRepo_;
-    CoreSkillsRepository coreSkillsRepo_;
-    CertificationRepository certificationRepo_;
-
     QString currentReportContent_;
 };
 
@@ -1,4 +1,8 @@
 #include "SnapshotsWidget.h"
+#include "../controllers/SnapshotController.h"
+#include "../controllers/SnapshotScheduler.h"
+#include "../core/Constants.h"
+#include "../utils/Config.h"
 #include "../utils/Logger.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -12,9 +16,13 @@ SnapshotsWidget::SnapshotsWidget(QWidget* parent)
     , createButton_(nullptr)
     , deleteButton_(nullptr)
     , refreshButton_(nullptr)
+    , scheduleCombo_(nullptr)
 {
     setupUI();
     loadSnapshots();
+
+    // Scheduled snapshots are written in the background
+    connect(&SnapshotScheduler::instance(), &SnapshotScheduler::snapshotCreated, this, &SnapshotsWidget::loadSnapshots);
     Logger::instance().info("SnapshotsWidget", "Snapshots widget initialized");
 }
 
@@ -36,6 +44,19 @@ void SnapshotsWidget::setupUI()
     QLabel* infoLabel = new QLabel("Snapshots capture the current state of all assessments for historical tracking.", this);
     mainLayout->addWidget(infoLabel);
 
+    QHBoxLayout* scheduleLayout = new QHBoxLayout();
+    scheduleLayout->addWidget(new QLabel("Automatic snapshots:", this));
+    scheduleCombo_ = new QComboBox(this);
+    scheduleCombo_->addItem("Off", Constants::SNAPSHOT_SCHEDULE_MANUAL);
+    scheduleCombo_->addItem("Daily", Constants::SNAPSHOT_SCHEDULE_DAILY);
+    scheduleCombo_->addItem("Weekly", Constants::SNAPSHOT_SCHEDULE_WEEKLY);
+    int scheduleIndex = scheduleCombo_->findData(Config::instance().snapshotSchedule());
+    scheduleCombo_->setCurrentIndex(scheduleIndex >= 0 ? scheduleIndex : 0);
+    connect(scheduleCombo_, &QComboBox::currentIndexChanged, this, &SnapshotsWidget::onScheduleChanged);
+    scheduleLayout->addWidget(scheduleCombo_);
+    scheduleLayout->addStretch();
+    mainLayout->addLayout(scheduleLayout);
+
     snapshotList_ = new QListWidget(this);
     mainLayout->addWidget(snapshotList_);
 
@@ -66,9 +87,11 @@ void SnapshotsWidget::loadSnapshots()
     QList<Snapshot> snapshots = snapshotRepo_.findAll();
 
     for (const Snapshot& snapshot : snapshots) {
-        QString displayText = QString("%1 - %2")
+        QString displayText = QString("%1 - %2 [%3, %4]")
             .arg(snapshot.timestamp().toString("yyyy-MM-dd hh:mm:ss"))
-            .arg(snapshot.description());
+            .arg(snapshot.description())
+            .arg(snapshot.isCheckpoint() ? "checkpoint" : "delta")
+            .arg(snapshot.source());
 
         QListWidgetItem* item = new QListWidgetItem(displayText);
         item->setData(Qt::UserRole, snapshot.id());
@@ -85,18 +108,16 @@ void SnapshotsWidget::onCreateSnapshotClicked()
         "Enter snapshot description:", QLineEdit::Normal, "", &ok);
 
     if (ok && !description.isEmpty()) {
-        Snapshot snapshot;
-        snapshot.setDescription(description);
-        snapshot.setTimestamp(QDateTime::currentDateTime());
-        snapshot.setData("{}"); // Placeholder - would contain serialized assessment data
+        SnapshotController controller;
+        QString id = controller.createSnapshot(description);
 
-        if (snapshotRepo_.save(snapshot)) {
+        if (!id.isEmpty()) {
             Logger::instance().info("SnapshotsWidget", "Created snapshot: " + description);
             QMessageBox::information(this, "Success", "Snapshot created successfully.");
             loadSnapshots();
         } else {
-            Logger::instance().error("SnapshotsWidget", "Failed to create snapshot: " + snapshotRepo_.lastError());
-            QMessageBox::critical(this, "Error", "Failed to create snapshot: " + snapshotRepo_.lastError());
+            Logger::instance().error("SnapshotsWidget", "Failed to create snapshot: " + controller.lastError());
+            QMessageBox::critical(this, "Error", "Failed to create snapshot: " + controller.lastError());
         }
     }
 }
@@ -119,13 +140,15 @@ void SnapshotsWidget::onDeleteSnapshotClicked()
     );
 
     if (reply == QMessageBox::Yes) {
-        if (snapshotRepo_.remove(id)) {
+        // Deleting goes through the controller so the snapshot's chain stays replayable
+        SnapshotController controller;
+        if (controller.deleteSnapshot(id)) {
             Logger::instance().info("SnapshotsWidget", "Deleted snapshot: " + id);
             QMessageBox::information(this, "Success", "Snapshot deleted successfully.");
             loadSnapshots();
         } else {
-            Logger::instance().error("SnapshotsWidget", "Failed to delete snapshot: " + snapshotRepo_.lastError());
-            QMessageBox::critical(this, "Error", "Failed to delete snapshot: " + snapshotRepo_.lastError());
+            Logger::instance().error("SnapshotsWidget", "Failed to delete snapshot: " + controller.lastError());
+            QMessageBox::critical(this, "Error", "Failed to delete snapshot: " + controller.lastError());
         }
     }
 }
@@ -134,3 +157,11 @@ void SnapshotsWidget::onRefreshClicked()
 {
     loadSnapshots();
 }
+
+void SnapshotsWidget::onScheduleChanged(int index)
+{
+    Config& config = Config::instance();
+    config.setSnapshotSchedule(scheduleCombo_->itemData(index).toString());
+    config.save();
+    Logger::instance().info("SnapshotsWidget", "Snapshot schedule set to " + config.snapshotSchedule());
+}
@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <QListWidget>
 #include <QPushButton>
+#include <QComboBox>
 #include "../database/SnapshotRepository.h"
 
 class SnapshotsWidget : public QWidget
@@ -18,6 +19,7 @@ private slots:
     void onCreateSnapshotClicked();
     void onDeleteSnapshotClicked();
     void onRefreshClicked();
+    void onScheduleChanged(int index);
 
 private:
     void setupUI();
@@ -28,6 +30,7 @@ private:
     QPushButton* createButton_;
     QPushButton* deleteButton_;
     QPushButton* refreshButton_;
+    QComboBox* scheduleCombo_;
 
     SnapshotRepository snapshotRepo_;
 };
@@ -1,6 +1,7 @@
 #include "UsersWidget.h"
 #include "../utils/Logger.h"
 #include "../utils/Crypto.h"
+#include "../controllers/AuthController.h"
 #include "../core/Constants.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -22,7 +23,10 @@ UsersWidget::UsersWidget(QWidget* parent)
     , deleteButton_(nullptr)
     , resetPasswordButton_(nullptr)
     , refreshButton_(nullptr)
+    , resetWatcher_(new QFutureWatcher<QString>(this))
 {
+    connect(resetWatcher_, &QFutureWatcher<QString>::finished, this, &UsersWidget::onPasswordHashesReady);
+
     setupUI();
     loadUsers();
     Logger::instance().info("UsersWidget", "Users widget initialized");
@@ -30,6 +34,7 @@ UsersWidget::UsersWidget(QWidget* parent)
 
 UsersWidget::~UsersWidget()
 {
+    resetWatcher_->waitForFinished();
 }
 
 void UsersWidget::setupUI()
@@ -53,7 +58,7 @@ void UsersWidget::setupUI()
 
     // Configure table appearance
     tableWidget_->setSelectionBehavior(QAbstractItemView::SelectRows);
-    tableWidget_->setSelectionMode(QAbstractItemView::SingleSelection);
+    tableWidget_->setSelectionMode(QAbstractItemView::ExtendedSelection);  // several users for password resets
     tableWidget_->setEditTriggers(QAbstractItemView::NoEditTriggers);
     tableWidget_->setAlternatingRowColors(true);
     tableWidget_->verticalHeader()->setVisible(false);
@@ -70,6 +75,7 @@ void UsersWidget::setupUI()
     tableWidget_->setColumnWidth(2, 100);  // Role column width
 
     connect(tableWidget_, &QTableWidget::cellDoubleClicked, this, &UsersWidget::onTableDoubleClicked);
+    connect(tableWidget_, &QTableWidget::itemSelectionChanged, this, &UsersWidget::onSelectionChanged);
 
     mainLayout->addWidget(tableWidget_);
 
@@ -288,29 +294,64 @@ void UsersWidget::showUserDialog(const User* user)
     }
 }
 
-void UsersWidget::showPasswordResetDialog(const User& user)
+void UsersWidget::showPasswordResetDialog(const QList<User>& users)
 {
+    QString prompt = users.size() == 1
+        ? QString("Enter new password for user '%1':").arg(users.first().username())
+        : QString("Enter a new temporary password for the %1 selected users:").arg(users.size());
+
     bool ok;
-    QString newPassword = QInputDialog::getText(this, "Reset Password",
-        QString("Enter new password for user '%1':").arg(user.username()),
-        QLineEdit::Password, "", &ok);
+    QString newPassword = QInputDialog::getText(this, "Reset Password", prompt, QLineEdit::Password, "", &ok);
 
     if (ok && !newPassword.isEmpty()) {
-        QString passwordHash = Crypto::hashPassword(newPassword);
-        bool success = userRepository_.updatePassword(user.id(), passwordHash);
+        // One hash per user (each with its own salt), computed in parallel
+        pendingResetUsers_ = users;
+        pendingResetPassword_ = newPassword;
+        resetPasswordButton_->setEnabled(false);
+        setCursor(Qt::BusyCursor);
+
+        QStringList passwords;
+        for (int i = 0; i < users.size(); ++i) {
+            passwords.append(newPassword);
+        }
+        resetWatcher_->setFuture(AuthController::hashPasswordsAsync(passwords));
+    } else if (ok) {
+        QMessageBox::warning(this, "Validation Error", "Password cannot be empty.");
+    }
+}
 
-        if (success) {
+void UsersWidget::onPasswordHashesReady()
+{
+    resetPasswordButton_->setEnabled(true);
+    unsetCursor();
+
+    QList<QString> hashes = resetWatcher_->future().results();
+    QStringList failed;
+    for (int i = 0; i < pendingResetUsers_.size(); ++i) {
+        const User& user = pendingResetUsers_[i];
+        if (i < hashes.size() && userRepository_.updatePassword(user.id(), hashes[i])) {
             Logger::instance().info("UsersWidget", "Password reset for user: " + user.username());
-            QMessageBox::information(this, "Success",
-                QString("Password reset successfully.\n\nUsername: %1\nNew Password: %2\n\nPlease provide this to the user securely.")
-                .arg(user.username()).arg(newPassword));
         } else {
             Logger::instance().error("UsersWidget", "Failed to reset password: " + userRepository_.lastError());
-            QMessageBox::critical(this, "Error", "Failed to reset password: " + userRepository_.lastError());
+            failed.append(user.username());
         }
-    } else if (ok) {
-        QMessageBox::warning(this, "Validation Error", "Password cannot be empty.");
     }
+
+    if (failed.isEmpty()) {
+        QStringList usernames;
+        for (const User& user : pendingResetUsers_) {
+            usernames.append(user.username());
+        }
+        QMessageBox::information(this, "Success",
+            QString("Password reset successfully.\n\nUsername: %1\nNew Password: %2\n\nPlease provide this to the user securely.")
+            .arg(usernames.join(", ")).arg(pendingResetPassword_));
+    } else {
+        QMessageBox::critical(this, "Error",
+            QString("Failed to reset password for: %1\n\n%2").arg(failed.join(", "), userRepository_.lastError()));
+    }
+
+    pendingResetUsers_.clear();
+    pendingResetPassword_.clear();
 }
 
 void UsersWidget::onAddClicked()
@@ -321,8 +362,8 @@ void UsersWidget::onAddClicked()
 void UsersWidget::onEditClicked()
 {
     int currentRow = tableWidget_->currentRow();
-    if (currentRow < 0) {
-        QMessageBox::warning(this, "No Selection", "Please select a user to edit.");
+    if (currentRow < 0 || tableWidget_->selectionModel()->selectedRows().size() > 1) {
+        QMessageBox::warning(this, "No Selection", "Please select one user to edit.");
         return;
     }
 
@@ -340,8 +381,8 @@ void UsersWidget::onEditClicked()
 void UsersWidget::onDeleteClicked()
 {
     int currentRow = tableWidget_->currentRow();
-    if (currentRow < 0) {
-        QMessageBox::warning(this, "No Selection", "Please select a user to delete.");
+    if (currentRow < 0 || tableWidget_->selectionModel()->selectedRows().size() > 1) {
+        QMessageBox::warning(this, "No Selection", "Please select one user to delete.");
         return;
     }
 
@@ -371,21 +412,35 @@ void UsersWidget::onDeleteClicked()
 
 void UsersWidget::onResetPasswordClicked()
 {
-    int currentRow = tableWidget_->currentRow();
-    if (currentRow < 0) {
+    if (resetWatcher_->isRunning()) {
+        return;
+    }
+
+    QList<int> rows;
+    for (const QModelIndex& index : tableWidget_->selectionModel()->selectedRows()) {
+        rows.append(index.row());
+    }
+    if (rows.isEmpty() && tableWidget_->currentRow() >= 0) {
+        rows.append(tableWidget_->currentRow());
+    }
+    if (rows.isEmpty()) {
         QMessageBox::warning(this, "No Selection", "Please select a user to reset password.");
         return;
     }
 
-    QString id = tableWidget_->item(currentRow, 0)->text();
-    User user = userRepository_.findById(id);
+    QList<User> users;
+    for (int row : rows) {
+        QString id = tableWidget_->item(row, 0)->text();
+        User user = userRepository_.findById(id);
 
-    if (user.id().isEmpty()) {
-        QMessageBox::critical(this, "Error", "Failed to load user data.");
-        return;
+        if (user.id().isEmpty()) {
+            QMessageBox::critical(this, "Error", "Failed to load user data.");
+            return;
+        }
+        users.append(user);
     }
 
-    showPasswordResetDialog(user);
+    showPasswordResetDialog(users);
 }
 
 void UsersWidget::onRefreshClicked()
@@ -393,6 +448,14 @@ void UsersWidget::onRefreshClicked()
     loadUsers();
 }
 
+void UsersWidget::onSelectionChanged()
+{
+    // Several rows are only for password resets; edit and delete act on one user
+    bool single = tableWidget_->selectionModel()->selectedRows().size() <= 1;
+    editButton_->setEnabled(single);
+    deleteButton_->setEnabled(single);
+}
+
 void UsersWidget::onTableDoubleClicked(int row, int column)
 {
     QString id = tableWidget_->item(row, 0)->text();
@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <QTableWidget>
 #include <QPushButton>
+#include <QFutureWatcher>
 #include "../database/UserRepository.h"
 #include "../database/EngineerRepository.h"
 
@@ -22,12 +23,14 @@ private slots:
     void onResetPasswordClicked();
     void onRefreshClicked();
     void onTableDoubleClicked(int row, int column);
+    void onSelectionChanged();
+    void onPasswordHashesReady();
 
 private:
     void setupUI();
     void loadUsers();
     void showUserDialog(const User* user = nullptr);
-    void showPasswordResetDialog(const User& user);
+    void showPasswordResetDialog(const QList<User>& users);
     QString getEngineerName(const QString& engineerId);
 
 private:
@@ -40,6 +43,11 @@ private:
 
     UserRepository userRepository_;
     EngineerRepository engineerRepository_;
+
+    // Password reset in flight: hashes are computed in parallel off the GUI thread
+    QFutureWatcher<QString>* resetWatcher_;
+    QList<User> pendingResetUsers_;
+    QString pendingResetPassword_;
 };
 
 #endif // USERSWIDGET_H
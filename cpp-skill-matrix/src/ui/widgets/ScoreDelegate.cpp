@@ -0,0 +1,160 @@
+#include "ScoreDelegate.h"
+#include "ScoreEditor.h"
+#include "../../core/Constants.h"
+#include <QPainter>
+#include <QApplication>
+#include <QMouseEvent>
+#include <QKeyEvent>
+
+ScoreDelegate::ScoreDelegate(QObject* parent)
+    : QStyledItemDelegate(parent)
+    , style_(Badge)
+{
+}
+
+ScoreDelegate::ScoreDelegate(Style style, QObject* parent)
+    : QStyledItemDelegate(parent)
+    , style_(style)
+{
+}
+
+ScoreDelegate::~ScoreDelegate() {}
+
+void ScoreDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    QVariant value = index.data(Qt::EditRole);
+    if (value.isNull()) {
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    opt.text.clear();
+
+    // Selection / hover background from the current style
+    const QWidget* widget = option.widget;
+    QStyle* style = widget ? widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &opt, painter, widget);
+
+    bool ok = false;
+    int score = value.toInt(&ok);
+    if (!ok) {
+        score = -1;
+    }
+
+    if (style_ == Picker) {
+        ScoreEditor::paintPicker(painter, option.rect, score);
+        return;
+    }
+
+    qreal size = qMin(option.rect.width(), option.rect.height()) - 8;
+    QRectF badge(0, 0, size, size);
+    badge.moveCenter(QRectF(option.rect).center());
+    ScoreEditor::paintBadge(painter, badge, score, score >= 0, option.state & QStyle::State_MouseOver);
+}
+
+QSize ScoreDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    if (style_ == Picker) {
+        return ScoreEditor::pickerSize().expandedTo(QStyledItemDelegate::sizeHint(option, index));
+    }
+    return QSize(36, 36);
+}
+
+QWidget* ScoreDelegate::createEditor(QWidget* parent, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    Q_UNUSED(option);
+    Q_UNUSED(index);
+
+    // Picker cells are edited by editorEvent(); no editor widget
+    if (style_ == Picker) {
+        return nullptr;
+    }
+
+    ScoreEditor* editor = new ScoreEditor(parent);
+    connect(editor, &ScoreEditor::scoreSelected,
+            const_cast<ScoreDelegate*>(this), &ScoreDelegate::commitAndCloseEditor);
+    return editor;
+}
+
+void ScoreDelegate::setEditorData(QWidget* editor, const QModelIndex& index) const
+{
+    ScoreEditor* scoreEditor = qobject_cast<ScoreEditor*>(editor);
+    if (!scoreEditor) {
+        QStyledItemDelegate::setEditorData(editor, index);
+        return;
+    }
+
+    bool ok = false;
+    int score = index.data(Qt::EditRole).toInt(&ok);
+    scoreEditor->setScore(ok ? score : -1);
+}
+
+void ScoreDelegate::setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const
+{
+    ScoreEditor* scoreEditor = qobject_cast<ScoreEditor*>(editor);
+    if (!scoreEditor) {
+        QStyledItemDelegate::setModelData(editor, model, index);
+        return;
+    }
+
+    if (scoreEditor->score() >= 0) {
+        model->setData(index, scoreEditor->score(), Qt::EditRole);
+    }
+}
+
+void ScoreDelegate::updateEditorGeometry(QWidget* editor, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+
+    // The picker is wider than a cell; center it over the cell, kept inside the viewport
+    QRect rect(QPoint(0, 0), editor->sizeHint().expandedTo(option.rect.size()));
+    rect.moveCenter(option.rect.center());
+    if (QWidget* viewport = editor->parentWidget()) {
+        if (rect.right() > viewport->width()) {
+            rect.moveRight(viewport->width() - 1);
+        }
+        if (rect.left() < 0) {
+            rect.moveLeft(0);
+        }
+    }
+    editor->setGeometry(rect);
+}
+
+bool ScoreDelegate::editorEvent(QEvent* event, QAbstractItemModel* model,
+                                const QStyleOptionViewItem& option, const QModelIndex& index)
+{
+    if (style_ != Picker || !(index.flags() & Qt::ItemIsEditable)) {
+        return QStyledItemDelegate::editorEvent(event, model, option, index);
+    }
+
+    int score = -1;
+    if (event->type() == QEvent::MouseButtonRelease) {
+        QMouseEvent* mouseEvent = static_cast<QMouseEvent*>(event);
+        if (mouseEvent->button() == Qt::LeftButton) {
+            score = ScoreEditor::pickerScoreAt(option.rect, mouseEvent->position());
+        }
+    } else if (event->type() == QEvent::KeyPress) {
+        int key = static_cast<QKeyEvent*>(event)->key();
+        if (key >= Qt::Key_0 && key <= Qt::Key_0 + Constants::SCORE_MAX) {
+            score = key - Qt::Key_0;
+        }
+    }
+
+    if (score < 0) {
+        return QStyledItemDelegate::editorEvent(event, model, option, index);
+    }
+    model->setData(index, score, Qt::EditRole);
+    return true;
+}
+
+void ScoreDelegate::commitAndCloseEditor()
+{
+    ScoreEditor* editor = qobject_cast<ScoreEditor*>(sender());
+    if (!editor) {
+        return;
+    }
+    emit commitData(editor);
+    emit closeEditor(editor, QAbstractItemDelegate::NoHint);
+}
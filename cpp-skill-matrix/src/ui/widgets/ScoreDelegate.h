@@ -0,0 +1,50 @@
+#ifndef SCOREDELEGATE_H
+#define SCOREDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+/**
+ * @brief Paints 0-3 score cells and edits them without per-cell widgets
+ *
+ * Reads the score from Qt::EditRole (-1 = unassessed; a null value falls back
+ * to default text painting) and writes the picked score back through setData().
+ *
+ * - Badge: one badge per cell, edited in place with a ScoreEditor. For dense
+ *   grids where only the open cell owns a widget.
+ * - Picker: all four levels painted in the cell and picked with a click; no
+ *   editor widget at all. For one-score-per-row lists.
+ */
+class ScoreDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    enum Style {
+        Badge,
+        Picker
+    };
+
+    explicit ScoreDelegate(QObject* parent = nullptr);
+    explicit ScoreDelegate(Style style, QObject* parent = nullptr);
+    ~ScoreDelegate();
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+    QWidget* createEditor(QWidget* parent, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    void setEditorData(QWidget* editor, const QModelIndex& index) const override;
+    void setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const override;
+    void updateEditorGeometry(QWidget* editor, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+
+protected:
+    bool editorEvent(QEvent* event, QAbstractItemModel* model,
+                     const QStyleOptionViewItem& option, const QModelIndex& index) override;
+
+private slots:
+    void commitAndCloseEditor();
+
+private:
+    Style style_;
+};
+
+#endif // SCOREDELEGATE_H
@@ -1,4 +1,154 @@
 #include "ScoreEditor.h"
+#include "../../core/Constants.h"
+#include <QPainter>
+#include <QMouseEvent>
+#include <QKeyEvent>
+
+namespace {
+constexpr int BADGE_SIZE = 24;
+constexpr int BADGE_SPACING = 6;
+constexpr int PADDING = 4;
+}
+
+ScoreEditor::ScoreEditor(QWidget* parent)
+    : QWidget(parent)
+    , score_(-1)
+    , hovered_(-1)
+{
+    setMouseTracking(true);
+    setFocusPolicy(Qt::StrongFocus);
+    setAutoFillBackground(true);
+    setCursor(Qt::PointingHandCursor);
+}
 
-ScoreEditor::ScoreEditor(QWidget* parent) : QWidget(parent) {}
 ScoreEditor::~ScoreEditor() {}
+
+void ScoreEditor::setScore(int score)
+{
+    score_ = (score >= 0 && score <= Constants::SCORE_MAX) ? score : -1;
+    update();
+}
+
+QSize ScoreEditor::sizeHint() const
+{
+    return pickerSize();
+}
+
+QSize ScoreEditor::pickerSize()
+{
+    int levels = Constants::SCORE_MAX + 1;
+    return QSize(2 * PADDING + levels * BADGE_SIZE + (levels - 1) * BADGE_SPACING,
+                 2 * PADDING + BADGE_SIZE);
+}
+
+QColor ScoreEditor::scoreColor(int score)
+{
+    switch (score) {
+        case Constants::SCORE_NOT_TRAINED: return QColor("#ff6b6b");  // Red
+        case Constants::SCORE_BASIC:       return QColor("#fbbf24");  // Yellow
+        case Constants::SCORE_COMPETENT:   return QColor("#60a5fa");  // Blue
+        case Constants::SCORE_EXPERT:      return QColor("#4ade80");  // Green
+        default:                           return QColor("#e2e8f0");  // Unassessed
+    }
+}
+
+void ScoreEditor::paintBadge(QPainter* painter, const QRectF& rect, int score, bool filled, bool hovered)
+{
+    QColor color = scoreColor(score);
+
+    painter->save();
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    QRectF circle = rect.adjusted(1, 1, -1, -1);
+    if (filled) {
+        painter->setPen(QPen(color, 2));
+        painter->setBrush(color);
+    } else {
+        painter->setPen(QPen(hovered ? color : QColor("#e2e8f0"), 2));
+        painter->setBrush(Qt::NoBrush);
+    }
+    painter->drawEllipse(circle);
+
+    QFont font = painter->font();
+    font.setPixelSize(qMax(8, int(rect.height() * 0.5)));
+    font.setBold(filled);
+    painter->setFont(font);
+    painter->setPen(filled ? QColor(Qt::white) : (hovered ? color : QColor("#64748b")));
+    painter->drawText(rect, Qt::AlignCenter, score >= 0 ? QString::number(score) : QString("–"));
+
+    painter->restore();
+}
+
+QRectF ScoreEditor::badgeRect(const QRectF& area, int score)
+{
+    int levels = Constants::SCORE_MAX + 1;
+    qreal totalWidth = levels * BADGE_SIZE + (levels - 1) * BADGE_SPACING;
+    qreal left = area.left() + (area.width() - totalWidth) / 2.0;
+    qreal top = area.top() + (area.height() - BADGE_SIZE) / 2.0;
+    return QRectF(left + score * (BADGE_SIZE + BADGE_SPACING), top, BADGE_SIZE, BADGE_SIZE);
+}
+
+void ScoreEditor::paintPicker(QPainter* painter, const QRectF& area, int selected, int hovered)
+{
+    for (int score = 0; score <= Constants::SCORE_MAX; ++score) {
+        paintBadge(painter, badgeRect(area, score), score, score == selected, score == hovered);
+    }
+}
+
+int ScoreEditor::pickerScoreAt(const QRectF& area, const QPointF& pos)
+{
+    for (int score = 0; score <= Constants::SCORE_MAX; ++score) {
+        if (badgeRect(area, score).contains(pos)) {
+            return score;
+        }
+    }
+    return -1;
+}
+
+void ScoreEditor::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    paintPicker(&painter, rect(), score_, hovered_);
+}
+
+void ScoreEditor::mouseMoveEvent(QMouseEvent* event)
+{
+    int hovered = pickerScoreAt(rect(), event->position());
+    if (hovered != hovered_) {
+        hovered_ = hovered;
+        update();
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+void ScoreEditor::mousePressEvent(QMouseEvent* event)
+{
+    int score = pickerScoreAt(rect(), event->position());
+    if (event->button() == Qt::LeftButton && score >= 0) {
+        setScore(score);
+        emit scoreSelected(score);
+        return;
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void ScoreEditor::keyPressEvent(QKeyEvent* event)
+{
+    int key = event->key();
+    if (key >= Qt::Key_0 && key <= Qt::Key_0 + Constants::SCORE_MAX) {
+        int score = key - Qt::Key_0;
+        setScore(score);
+        emit scoreSelected(score);
+        return;
+    }
+    QWidget::keyPressEvent(event);
+}
+
+void ScoreEditor::leaveEvent(QEvent* event)
+{
+    hovered_ = -1;
+    update();
+    QWidget::leaveEvent(event);
+}
@@ -2,14 +2,80 @@
 #define SCOREEDITOR_H
 
 #include <QWidget>
+#include <QColor>
 
+class QPainter;
+
+/**
+ * @brief Compact 0-3 score picker
+ *
+ * Paints the four score levels as round badges (no child widgets) and lets the
+ * user pick one by click or by typing 0-3. Used as the in-place editor of
+ * ScoreDelegate and shares its badge painting with it.
+ */
 class ScoreEditor : public QWidget
 {
     Q_OBJECT
+    Q_PROPERTY(int score READ score WRITE setScore USER true)
 
 public:
     explicit ScoreEditor(QWidget* parent = nullptr);
     ~ScoreEditor();
+
+    /**
+     * @brief Current score, -1 if none
+     */
+    int score() const { return score_; }
+    void setScore(int score);
+
+    QSize sizeHint() const override;
+
+    /**
+     * @brief Color for a score level (web app palette)
+     */
+    static QColor scoreColor(int score);
+
+    /**
+     * @brief Paint one score badge
+     * @param filled true for the active score, false for an outlined choice
+     */
+    static void paintBadge(QPainter* painter, const QRectF& rect, int score, bool filled, bool hovered = false);
+
+    /**
+     * @brief Paint the full 0-3 row of badges centered in area
+     * @param selected score drawn filled, -1 for none
+     * @param hovered score drawn highlighted, -1 for none
+     */
+    static void paintPicker(QPainter* painter, const QRectF& area, int selected, int hovered = -1);
+
+    /**
+     * @brief Score whose badge (as laid out by paintPicker) contains pos, -1 if none
+     */
+    static int pickerScoreAt(const QRectF& area, const QPointF& pos);
+
+    /**
+     * @brief Size the full picker needs
+     */
+    static QSize pickerSize();
+
+signals:
+    /**
+     * @brief Emitted when the user picks a score (not on setScore)
+     */
+    void scoreSelected(int score);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+
+private:
+    static QRectF badgeRect(const QRectF& area, int score);
+
+    int score_;
+    int hovered_;
 };
 
 #endif // SCOREEDITOR_H
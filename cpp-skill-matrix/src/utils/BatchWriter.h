@@ -0,0 +1,143 @@
+#ifndef BATCHWRITER_H
+#define BATCHWRITER_H
+
+#include "BoundedQueue.h"
+#include "../core/Constants.h"
+#include "../database/ConnectionPool.h"
+#include <QList>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <functional>
+
+/**
+ * @brief Writer stage of an import pipeline
+ *
+ * The producer add()s validated records with the source row they came from;
+ * they are grouped into batches of IMPORT_BATCH_SIZE and handed over a
+ * BoundedQueue to a thread of the writer's own, which writes them in order.
+ * Repositories called by the write function run on that thread's pooled
+ * connection. A batch that fails is reported with its row span and the
+ * following batches are still written.
+ *
+ * add() and close() are for the producing thread; wait() joins the writer.
+ */
+template <typename Record>
+class BatchWriter
+{
+public:
+    // Upsert one batch in a transaction; false (with error) rejects the whole batch
+    using WriteFunction = std::function<bool(QList<Record>& records, QString& error)>;
+    // A rejected batch, reported on the writer thread
+    using FailureFunction = std::function<void(int firstRow, int lastRow, const QString& error)>;
+
+    BatchWriter(const WriteFunction& write, const FailureFunction& failed)
+        : write_(write)
+        , failed_(failed)
+        , batches_(Constants::IMPORT_QUEUE_DEPTH)
+        , written_(0)
+        , closed_(false)
+    {
+        thread_ = QThread::create([this]() { run(); });
+        thread_->start();
+    }
+
+    ~BatchWriter()
+    {
+        close();
+        wait();
+        delete thread_;
+    }
+
+    BatchWriter(const BatchWriter&) = delete;
+    BatchWriter& operator=(const BatchWriter&) = delete;
+
+    /**
+     * @brief Write function calling Repository::saveOrUpdateBatch()
+     */
+    template <typename Repository>
+    static WriteFunction saveOrUpdateBatch()
+    {
+        return [](QList<Record>& records, QString& error) {
+            // saveOrUpdateBatch is one transaction per call
+            Repository repository;
+            if (!repository.saveOrUpdateBatch(records)) {
+                error = repository.lastError();
+                return false;
+            }
+            return true;
+        };
+    }
+
+    /**
+     * @brief Queue a record from a source row, waiting while the queue is full
+     */
+    void add(int row, Record record)
+    {
+        if (batch_.records.isEmpty()) {
+            batch_.firstRow = row;
+        }
+        batch_.lastRow = row;
+        batch_.records.append(std::move(record));
+        if (batch_.records.size() >= Constants::IMPORT_BATCH_SIZE) {
+            batches_.push(std::move(batch_));
+            batch_ = Batch();
+        }
+    }
+
+    /**
+     * @brief Queue the last partial batch; nothing is added after this
+     */
+    void close()
+    {
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        if (!batch_.records.isEmpty()) {
+            batches_.push(std::move(batch_));
+            batch_ = Batch();
+        }
+        batches_.close();
+    }
+
+    /**
+     * @brief Wait until every queued batch is written (after close())
+     */
+    void wait() { thread_->wait(); }
+
+    int written() const { return written_.load(); }
+
+private:
+    struct Batch {
+        int firstRow = 0;
+        int lastRow = 0;
+        QList<Record> records;
+    };
+
+    void run()
+    {
+        ScopedConnection connection;
+        Batch batch;
+
+        while (batches_.pop(batch)) {
+            QString error;
+            if (write_(batch.records, error)) {
+                written_ += batch.records.size();
+            } else {
+                failed_(batch.firstRow, batch.lastRow, error);
+            }
+        }
+    }
+
+private:
+    WriteFunction write_;
+    FailureFunction failed_;
+    BoundedQueue<Batch> batches_;
+    Batch batch_;               // being filled by the producer
+    std::atomic<int> written_;
+    bool closed_;
+    QThread* thread_;
+};
+
+#endif // BATCHWRITER_H
@@ -0,0 +1,104 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * @brief Blocking FIFO of fixed capacity between pipeline stages
+ *
+ * push() waits while the queue is full, so a fast producer is held back to
+ * the pace of its consumer and memory stays bounded. close() marks the end
+ * of input: consumers drain what is left, then pop() returns false.
+ * abort() additionally drops queued items and releases blocked producers,
+ * for stopping a pipeline early.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(int capacity)
+        : capacity_(capacity > 0 ? size_t(capacity) : 1)
+        , closed_(false)
+        , aborted_(false)
+    {
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Append an item, waiting for room
+     * @return false if the queue was closed or aborted (the item is dropped)
+     */
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this] { return items_.size() < capacity_ || closed_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(item));
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest item, waiting for one
+     * @return false once the queue is closed and empty, or aborted
+     */
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return !items_.empty() || closed_; });
+        if (items_.empty() || aborted_) {
+            return false;
+        }
+        item = std::move(items_.front());
+        items_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief No more items will be pushed
+     */
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+    /**
+     * @brief Stop both ends now, discarding anything still queued
+     */
+    void abort()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        aborted_ = true;
+        items_.clear();
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+    bool isAborted() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return aborted_;
+    }
+
+private:
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::deque<T> items_;
+    bool closed_;
+    bool aborted_;
+};
+
+#endif // BOUNDEDQUEUE_H
@@ -1,5 +1,6 @@
 #include "Config.h"
 #include "Logger.h"
+#include "../core/Constants.h"
 #include <QFile>
 #include <QDir>
 #include <QJsonDocument>
@@ -178,6 +179,16 @@ bool Config::databaseTrustServerCertificate() const
     return get("database.trustServerCertificate", true).toBool();
 }
 
+int Config::databasePoolSize() const
+{
+    return get("database.poolSize", Constants::DB_POOL_MAX_SIZE).toInt();
+}
+
+int Config::databasePoolIdleTimeout() const
+{
+    return get("database.poolIdleTimeout", Constants::DB_POOL_IDLE_TIMEOUT).toInt();
+}
+
 void Config::setDatabaseServer(const QString& server)
 {
     set("database.server", server);
@@ -213,6 +224,56 @@ void Config::setDatabaseTrustServerCertificate(bool trust)
     set("database.trustServerCertificate", trust);
 }
 
+void Config::setDatabasePoolSize(int size)
+{
+    set("database.poolSize", size);
+}
+
+void Config::setDatabasePoolIdleTimeout(int milliseconds)
+{
+    set("database.poolIdleTimeout", milliseconds);
+}
+
+int Config::passwordIterations() const
+{
+    return get("security.passwordIterations", 0).toInt();
+}
+
+void Config::setPasswordIterations(int iterations)
+{
+    set("security.passwordIterations", iterations);
+}
+
+QString Config::loggingLevel() const
+{
+    return get("logging.level").toString();
+}
+
+QVariantMap Config::loggingCategoryLevels() const
+{
+    return get("logging.categories").toMap();
+}
+
+QString Config::snapshotSchedule() const
+{
+    return get("snapshots.schedule", Constants::SNAPSHOT_SCHEDULE_MANUAL).toString();
+}
+
+int Config::snapshotCheckpointInterval() const
+{
+    return get("snapshots.checkpointInterval", Constants::SNAPSHOT_CHECKPOINT_INTERVAL).toInt();
+}
+
+void Config::setSnapshotSchedule(const QString& schedule)
+{
+    set("snapshots.schedule", schedule);
+}
+
+void Config::setSnapshotCheckpointInterval(int snapshots)
+{
+    set("snapshots.checkpointInterval", snapshots);
+}
+
 QString Config::getDefaultConfigPath() const
 {
     QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
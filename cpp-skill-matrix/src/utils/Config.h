@@ -76,6 +76,8 @@ public:
     int databasePort() const;
     bool databaseEncrypt() const;
     bool databaseTrustServerCertificate() const;
+    int databasePoolSize() const;
+    int databasePoolIdleTimeout() const;
 
     void setDatabaseServer(const QString& server);
     void setDatabaseName(const QString& name);
@@ -84,6 +86,23 @@ public:
     void setDatabasePort(int port);
     void setDatabaseEncrypt(bool encrypt);
     void setDatabaseTrustServerCertificate(bool trust);
+    void setDatabasePoolSize(int size);
+    void setDatabasePoolIdleTimeout(int milliseconds);
+
+    // Password hashing
+    int passwordIterations() const;             // calibrated PBKDF2 cost, 0 if not calibrated yet
+    void setPasswordIterations(int iterations);
+
+    // Logging
+    QString loggingLevel() const;               // global minimum level name, empty if unset
+    QVariantMap loggingCategoryLevels() const;  // category -> level name
+
+    // Snapshot scheduling
+    QString snapshotSchedule() const;           // "manual", "daily" or "weekly"
+    int snapshotCheckpointInterval() const;     // snapshots per checkpoint chain
+
+    void setSnapshotSchedule(const QString& schedule);
+    void setSnapshotCheckpointInterval(int snapshots);
 
 signals:
     /**
@@ -1,48 +1,76 @@
 #include "Crypto.h"
+#include "../core/Constants.h"
 #include <QCryptographicHash>
+#include <QPasswordDigestor>
+#include <QElapsedTimer>
+#include <QStringList>
 #include <QRandomGenerator>
 #include <QDateTime>
 #include <QUuid>
+#include <atomic>
 
-QString Crypto::hashPassword(const QString& password)
+static const char* PBKDF2_SCHEME = "pbkdf2-sha256";
+static constexpr int PBKDF2_KEY_LENGTH = 32;
+static constexpr int CALIBRATION_SAMPLE = 20000;
+
+static std::atomic<int> s_defaultIterations{Constants::PASSWORD_PBKDF2_DEFAULT_ITERATIONS};
+
+static QByteArray pbkdf2(const QString& password, const QByteArray& salt, int iterations)
+{
+    return QPasswordDigestor::deriveKeyPbkdf2(QCryptographicHash::Sha256, password.toUtf8(),
+                                              salt, iterations, PBKDF2_KEY_LENGTH);
+}
+
+// Compare without returning early, so timing does not reveal matching prefixes
+static bool constantTimeEquals(const QByteArray& a, const QByteArray& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    char difference = 0;
+    for (qsizetype i = 0; i < a.size(); ++i) {
+        difference |= a[i] ^ b[i];
+    }
+    return difference == 0;
+}
+
+QString Crypto::hashPassword(const QString& password, int iterations)
 {
-    // IMPORTANT: For production, use BCrypt or Argon2 libraries
-    // This implementation uses PBKDF2-like approach with SHA-256
-    // It provides better security than plain hashing but is not as strong as BCrypt/Argon2
-
-    // Generate a unique salt per password (stored as prefix in the hash)
-    QString salt = generateSalt(16); // 16 bytes = 32 hex chars
-
-    // Perform PBKDF2-like derivation with 10000 iterations
-    QByteArray derived = password.toUtf8() + QByteArray::fromHex(salt.toUtf8());
-
-    // Apply 10000 rounds of hashing (PBKDF2-like)
-    for (int i = 0; i < 10000; i++) {
-        QCryptographicHash hasher(QCryptographicHash::Sha256);
-        hasher.addData(derived);
-        hasher.addData(QByteArray::number(i)); // Include iteration count
-        derived = hasher.result();
+    if (iterations <= 0) {
+        iterations = defaultIterations();
     }
 
-    // Return format: salt$hash (allows verification with same salt)
-    return salt + "$" + derived.toHex();
+    // Generate a unique salt per password (stored in the hash)
+    QByteArray salt = QByteArray::fromHex(generateSalt(16).toLatin1());
+    QByteArray key = pbkdf2(password, salt, iterations);
+
+    return QString("%1$%2$%3$%4")
+        .arg(PBKDF2_SCHEME)
+        .arg(iterations)
+        .arg(QString::fromLatin1(salt.toHex()), QString::fromLatin1(key.toHex()));
 }
 
 bool Crypto::verifyPassword(const QString& password, const QString& hash)
 {
-    // Check if hash contains salt separator (new format: salt$hash)
-    if (hash.contains("$")) {
-        // New format with salt
-        QStringList parts = hash.split("$");
-        if (parts.size() != 2) {
+    QStringList parts = hash.split("$");
+
+    // Current format: pbkdf2-sha256$iterations$salt$key
+    if (parts.size() == 4 && parts[0] == PBKDF2_SCHEME) {
+        bool ok = false;
+        int iterations = parts[1].toInt(&ok);
+        if (!ok || iterations <= 0) {
             return false;
         }
 
-        QString salt = parts[0];
-        QString storedHash = parts[1];
+        QByteArray salt = QByteArray::fromHex(parts[2].toLatin1());
+        QByteArray storedKey = QByteArray::fromHex(parts[3].toLatin1());
+        return constantTimeEquals(pbkdf2(password, salt, iterations), storedKey);
+    }
 
-        // Derive hash with same salt
-        QByteArray derived = password.toUtf8() + QByteArray::fromHex(salt.toUtf8());
+    // Previous format: salt$hash, 10000 chained SHA-256 rounds
+    if (parts.size() == 2) {
+        QByteArray derived = password.toUtf8() + QByteArray::fromHex(parts[0].toUtf8());
 
         for (int i = 0; i < 10000; i++) {
             QCryptographicHash hasher(QCryptographicHash::Sha256);
@@ -51,18 +79,65 @@ bool Crypto::verifyPassword(const QString& password, const QString& hash)
             derived = hasher.result();
         }
 
-        return derived.toHex() == storedHash;
-    } else {
-        // Legacy format without salt (for backward compatibility)
-        // This is the old insecure method - kept only for existing passwords
-        QString hashed = password;
-        for (int i = 0; i < 10; i++) {
-            QByteArray data = hashed.toUtf8();
-            QByteArray hashBytes = QCryptographicHash::hash(data, QCryptographicHash::Sha256);
-            hashed = hashBytes.toHex();
-        }
-        return hashed == hash;
+        return constantTimeEquals(derived.toHex(), parts[1].toLatin1());
+    }
+
+    if (parts.size() > 1) {
+        return false;
     }
+
+    // Legacy format without salt (for backward compatibility)
+    // This is the old insecure method - kept only for existing passwords
+    QString hashed = password;
+    for (int i = 0; i < 10; i++) {
+        QByteArray data = hashed.toUtf8();
+        QByteArray hashBytes = QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+        hashed = hashBytes.toHex();
+    }
+    return constantTimeEquals(hashed.toLatin1(), hash.toLatin1());
+}
+
+bool Crypto::needsRehash(const QString& hash)
+{
+    return hashIterations(hash) < defaultIterations();
+}
+
+int Crypto::hashIterations(const QString& hash)
+{
+    QStringList parts = hash.split("$");
+    if (parts.size() != 4 || parts[0] != PBKDF2_SCHEME) {
+        return 0;
+    }
+    return parts[1].toInt();
+}
+
+int Crypto::defaultIterations()
+{
+    return s_defaultIterations.load(std::memory_order_relaxed);
+}
+
+void Crypto::setDefaultIterations(int iterations)
+{
+    s_defaultIterations.store(qBound(Constants::PASSWORD_PBKDF2_MIN_ITERATIONS, iterations,
+                                     Constants::PASSWORD_PBKDF2_MAX_ITERATIONS),
+                              std::memory_order_relaxed);
+}
+
+int Crypto::calibrateIterations(int targetMs)
+{
+    QByteArray salt = QByteArray::fromHex(generateSalt(16).toLatin1());
+
+    // Warm up once, then time a fixed sample and scale it to the target
+    pbkdf2("calibration", salt, 1000);
+    QElapsedTimer timer;
+    timer.start();
+    pbkdf2("calibration", salt, CALIBRATION_SAMPLE);
+    qint64 elapsedNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+    qint64 iterations = qint64(CALIBRATION_SAMPLE) * targetMs * 1000000 / elapsedNs;
+    iterations = (iterations / 1000) * 1000;
+    return int(qBound<qint64>(Constants::PASSWORD_PBKDF2_MIN_ITERATIONS, iterations,
+                              Constants::PASSWORD_PBKDF2_MAX_ITERATIONS));
 }
 
 QString Crypto::generateSalt(int length)
@@ -71,7 +146,7 @@ QString Crypto::generateSalt(int length)
     salt.resize(length);
 
     for (int i = 0; i < length; i++) {
-        salt[i] = static_cast<char>(QRandomGenerator::global()->bounded(256));
+        salt[i] = static_cast<char>(QRandomGenerator::system()->bounded(256));
     }
 
     return salt.toHex();
@@ -6,8 +6,13 @@
 /**
  * @brief Cryptography utility class for password hashing and verification
  *
- * Note: This implementation uses Qt's SHA-256 for simplicity.
- * For production, consider using BCrypt or Argon2 for password hashing.
+ * Passwords are hashed with PBKDF2-HMAC-SHA256 (QPasswordDigestor). The hash
+ * string carries its own cost: "pbkdf2-sha256$<iterations>$<salt>$<key>".
+ * Hashes from older versions ("salt$hash" and unsalted) still verify; use
+ * needsRehash() to upgrade them on the next successful login.
+ *
+ * Hashing is deliberately slow (see calibrateIterations()); call it off the
+ * GUI thread.
  */
 class Crypto
 {
@@ -15,9 +20,10 @@ public:
     /**
      * @brief Hash a password
      * @param password Plain text password
-     * @return Hashed password (hex string)
+     * @param iterations PBKDF2 iterations (0 uses defaultIterations())
+     * @return Hash string including algorithm, cost and salt
      */
-    static QString hashPassword(const QString& password);
+    static QString hashPassword(const QString& password, int iterations = 0);
 
     /**
      * @brief Verify a password against a hash
@@ -27,6 +33,30 @@ public:
      */
     static bool verifyPassword(const QString& password, const QString& hash);
 
+    /**
+     * @brief Whether a stored hash uses an old format or less than the current cost
+     */
+    static bool needsRehash(const QString& hash);
+
+    /**
+     * @brief PBKDF2 iterations recorded in a hash (0 for older formats)
+     */
+    static int hashIterations(const QString& hash);
+
+    /**
+     * @brief Iterations used by hashPassword() when none are given
+     */
+    static int defaultIterations();
+    static void setDefaultIterations(int iterations);
+
+    /**
+     * @brief Measure this machine and return the iterations that take targetMs
+     *
+     * Times a short PBKDF2 run and scales it, clamped to
+     * Constants::PASSWORD_PBKDF2_MIN_ITERATIONS..MAX_ITERATIONS.
+     */
+    static int calibrateIterations(int targetMs);
+
     /**
      * @brief Generate a random salt
      * @param length Length of salt in bytes
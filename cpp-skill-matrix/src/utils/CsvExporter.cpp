@@ -0,0 +1,154 @@
+#include "CsvExporter.h"
+#include "CsvWriter.h"
+#include "Logger.h"
+#include "../core/Constants.h"
+#include "../database/EngineerRepository.h"
+#include "../database/ProductionRepository.h"
+#include "../database/AssessmentRepository.h"
+#include <QHash>
+#include <QElapsedTimer>
+
+namespace {
+
+/**
+ * @brief Everything an assessment row prints about its competency
+ */
+struct CompetencyColumns {
+    QString area;
+    QString machine;
+    QString name;
+    int maxScore = 0;
+};
+
+} // namespace
+
+CsvExporter::CsvExporter()
+    : rowsWritten_(0)
+{
+}
+
+CsvExporter::~CsvExporter()
+{
+}
+
+bool CsvExporter::exportEngineers(const QString& filePath)
+{
+    lastError_.clear();
+    rowsWritten_ = 0;
+
+    EngineerRepository engineerRepo;
+    QList<Engineer> engineers = engineerRepo.findAll();
+    if (!engineerRepo.lastError().isEmpty()) {
+        return fail("Failed to load engineers: " + engineerRepo.lastError());
+    }
+
+    CsvWriter writer;
+    if (!writer.open(filePath)) {
+        return fail(writer.lastError());
+    }
+
+    bool ok = writer.addRow({"ID", "Name", "Shift"});
+    for (const Engineer& engineer : engineers) {
+        if (!ok) {
+            break;
+        }
+        writer.addField(engineer.id());
+        writer.addField(engineer.name());
+        writer.addField(engineer.shift());
+        ok = writer.endRow();
+    }
+
+    if (!ok || !writer.close()) {
+        return fail(writer.lastError());
+    }
+
+    rowsWritten_ = engineers.size();
+    Logger::instance().info("CsvExporter", QString("Exported %1 engineers to %2").arg(rowsWritten_).arg(filePath));
+    return true;
+}
+
+bool CsvExporter::exportAssessments(const QString& filePath)
+{
+    lastError_.clear();
+    rowsWritten_ = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    EngineerRepository engineerRepo;
+    QHash<QString, QString> engineerNames;
+    for (const Engineer& engineer : engineerRepo.findAll()) {
+        engineerNames.insert(engineer.id(), engineer.name());
+    }
+    if (!engineerRepo.lastError().isEmpty()) {
+        return fail("Failed to load engineers: " + engineerRepo.lastError());
+    }
+
+    ProductionRepository productionRepo;
+    ProductionHierarchy hierarchy = productionRepo.loadHierarchy();
+    if (!productionRepo.lastError().isEmpty()) {
+        return fail("Failed to load production areas: " + productionRepo.lastError());
+    }
+
+    // One hash lookup per row instead of three hierarchy copies
+    QHash<int, CompetencyColumns> competencies;
+    competencies.reserve(hierarchy.competencies().size());
+    for (const Competency& competency : hierarchy.competencies()) {
+        Machine machine = hierarchy.machine(competency.machineId());
+        CompetencyColumns columns;
+        columns.area = hierarchy.area(machine.productionAreaId()).name();
+        columns.machine = machine.name();
+        columns.name = competency.name();
+        columns.maxScore = competency.maxScore();
+        competencies.insert(competency.id(), columns);
+    }
+
+    CsvWriter writer;
+    if (!writer.open(filePath)) {
+        return fail(writer.lastError());
+    }
+
+    bool written = writer.addRow({"Engineer ID", "Engineer", "Production Area", "Machine",
+                                  "Competency ID", "Competency", "Score", "Max Score", "Updated"});
+
+    AssessmentRepository assessmentRepo;
+    const CompetencyColumns unknown;
+    bool streamed = written && assessmentRepo.forEach([&](const Assessment& assessment) {
+        auto it = competencies.constFind(assessment.competencyId());
+        const CompetencyColumns& competency = it != competencies.constEnd() ? it.value() : unknown;
+
+        writer.addField(assessment.engineerId());
+        writer.addField(engineerNames.value(assessment.engineerId()));
+        writer.addField(competency.area);
+        writer.addField(competency.machine);
+        writer.addField(assessment.competencyId());
+        writer.addField(competency.name);
+        writer.addField(assessment.score());
+        writer.addField(competency.maxScore);
+        writer.addField(assessment.updatedAt().toString(Constants::EXPORT_DATETIME_FORMAT));
+        written = writer.endRow();
+        return written;
+    });
+
+    if (!written) {
+        return fail(writer.lastError());
+    }
+    if (!streamed) {
+        return fail("Failed to read assessments: " + assessmentRepo.lastError());
+    }
+    if (!writer.close()) {
+        return fail(writer.lastError());
+    }
+
+    rowsWritten_ = writer.rowCount() - 1;
+    Logger::instance().info("CsvExporter", QString("Exported %1 assessments to %2 in %3 ms")
+        .arg(rowsWritten_).arg(filePath).arg(timer.elapsed()));
+    return true;
+}
+
+bool CsvExporter::fail(const QString& error)
+{
+    lastError_ = error;
+    Logger::instance().error("CsvExporter", error);
+    return false;
+}
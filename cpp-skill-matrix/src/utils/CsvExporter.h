@@ -0,0 +1,44 @@
+#ifndef CSVEXPORTER_H
+#define CSVEXPORTER_H
+
+#include <QString>
+
+/**
+ * @brief CSV exporter, one table per file
+ *
+ * Assessments are streamed from a forward-only query into CsvWriter, so
+ * the export runs at disk speed and memory stays flat. Names are resolved
+ * from the engineer list and production hierarchy, loaded once per export.
+ * The files carry the ID columns CsvImporter needs to read them back.
+ *
+ * Uses the calling thread's database connection: wrap worker-thread exports
+ * in a ScopedConnection.
+ */
+class CsvExporter
+{
+public:
+    CsvExporter();
+    ~CsvExporter();
+
+    /**
+     * @brief ID, Name, Shift
+     */
+    bool exportEngineers(const QString& filePath);
+
+    /**
+     * @brief One row per assessment, with engineer and competency names
+     */
+    bool exportAssessments(const QString& filePath);
+
+    qint64 rowsWritten() const { return rowsWritten_; }
+    QString lastError() const { return lastError_; }
+
+private:
+    bool fail(const QString& error);
+
+private:
+    qint64 rowsWritten_;
+    QString lastError_;
+};
+
+#endif // CSVEXPORTER_H
@@ -0,0 +1,296 @@
+#include "CsvImporter.h"
+#include "CsvReader.h"
+#include "BatchWriter.h"
+#include "HierarchyUpserter.h"
+#include "ValidationHelper.h"
+#include "Logger.h"
+#include "../core/Constants.h"
+#include "../database/EngineerRepository.h"
+#include "../database/ProductionRepository.h"
+#include "../database/AssessmentRepository.h"
+#include <QThread>
+#include <QHash>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QtConcurrent/QtConcurrent>
+
+namespace {
+
+// ============================================================================
+// Pipeline
+// ============================================================================
+
+template <typename Record>
+using RowValidator = std::function<bool(const CsvRow& row, Record& record, QString& error)>;
+
+/**
+ * @brief What one parallel task makes of its range
+ */
+template <typename Record>
+struct ChunkResult {
+    QList<Record> records;
+    QList<int> rows;                      // record number (within the range) of each record
+    QList<QPair<int, QString>> errors;    // record number, message
+    int recordCount = 0;
+    QString parseError;
+};
+
+/**
+ * @brief Parse and validate ranges in parallel, write batches in file order
+ * @return false if the file is malformed or a batch failed to commit
+ */
+template <typename Record>
+bool runPipeline(const CsvReader& reader, const RowValidator<Record>& validate,
+                 const typename BatchWriter<Record>::WriteFunction& write,
+                 const CsvImporter::ProgressCallback& progress, CsvImporter::ImportResult& result)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const QList<CsvReader::Range> ranges = reader.split(Constants::IMPORT_CSV_CHUNK_BYTES);
+
+    QStringList writeErrors;  // writer thread until joined
+    BatchWriter<Record> writer(write, [&writeErrors](int firstRow, int lastRow, const QString& error) {
+        writeErrors << QString("Rows %1-%2 not saved: %3").arg(firstRow).arg(lastRow).arg(error);
+    });
+
+    // Pure function of its range: reads the mapped file and the caller's
+    // read-only lookups only
+    auto parseChunk = [&reader, &validate](const CsvReader::Range& range) {
+        ChunkResult<Record> chunk;
+        QList<CsvRow> rows;
+        QList<QByteArray> unescaped;
+        if (!reader.parse(range, rows, unescaped, chunk.parseError, &chunk.recordCount)) {
+            return chunk;
+        }
+
+        chunk.records.reserve(rows.size());
+        chunk.rows.reserve(rows.size());
+        Record record;
+        QString error;
+        for (const CsvRow& row : rows) {
+            if (validate(row, record, error)) {
+                chunk.records.append(record);
+                chunk.rows.append(row.number);
+            } else {
+                chunk.errors.append(qMakePair(row.number, error));
+            }
+        }
+        return chunk;
+    };
+
+    // A window of chunks at a time keeps memory bounded; the writer drains
+    // the previous window's batches meanwhile
+    const int window = qMax(2, QThread::idealThreadCount());
+    int recordOffset = 1;  // the header is record 1
+    int recordsValidated = 0;
+    int errorCount = 0;
+    bool parsed = true;
+
+    for (int first = 0; first < ranges.size() && parsed; first += window) {
+        QList<ChunkResult<Record>> chunks =
+            QtConcurrent::blockingMapped<QList<ChunkResult<Record>>>(ranges.mid(first, window), parseChunk);
+
+        for (int i = 0; i < chunks.size(); ++i) {
+            ChunkResult<Record>& chunk = chunks[i];
+            if (!chunk.parseError.isEmpty()) {
+                result.errors << QString("After row %1: %2").arg(recordOffset).arg(chunk.parseError);
+                parsed = false;
+                break;
+            }
+
+            for (const QPair<int, QString>& error : chunk.errors) {
+                if (++errorCount <= Constants::IMPORT_MAX_ERRORS) {
+                    result.errors << QString("Row %1: %2").arg(recordOffset + error.first).arg(error.second);
+                }
+            }
+
+            for (int r = 0; r < chunk.records.size(); ++r) {
+                writer.add(recordOffset + chunk.rows[r], std::move(chunk.records[r]));
+            }
+
+            recordsValidated += chunk.records.size();
+            recordOffset += chunk.recordCount;
+            if (progress) {
+                progress(ranges[first + i].end, reader.size(), writer.written());
+            }
+        }
+    }
+
+    writer.close();
+    writer.wait();
+
+    if (progress) {
+        progress(reader.size(), reader.size(), writer.written());
+    }
+
+    if (errorCount > Constants::IMPORT_MAX_ERRORS) {
+        result.errors << QString("... and %1 more rows with errors").arg(errorCount - Constants::IMPORT_MAX_ERRORS);
+    }
+    result.errors.append(writeErrors);
+    result.recordsProcessed += recordsValidated + errorCount;
+    result.recordsSuccessful += writer.written();
+
+    Logger::instance().info("CsvImporter", QString("%1 bytes in %2 chunks: %3 records saved, %4 rejected in %5 ms")
+        .arg(reader.size()).arg(ranges.size()).arg(writer.written()).arg(errorCount).arg(timer.elapsed()));
+
+    return parsed && writeErrors.isEmpty();
+}
+
+// ============================================================================
+// Field helpers
+// ============================================================================
+
+int headerColumn(const QStringList& header, std::initializer_list<const char*> names)
+{
+    for (const char* name : names) {
+        for (int i = 0; i < header.size(); ++i) {
+            if (header[i].compare(QLatin1String(name), Qt::CaseInsensitive) == 0) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+// ============================================================================
+// CsvImporter
+// ============================================================================
+
+CsvImporter::CsvImporter()
+{
+}
+
+CsvImporter::~CsvImporter()
+{
+}
+
+CsvImporter::ImportResult CsvImporter::importFile(const QString& filePath)
+{
+    ImportResult result;
+    CsvReader reader;
+    if (!reader.open(filePath)) {
+        result.errors << reader.lastError();
+        return result;
+    }
+
+    if (headerColumn(reader.header(), {"score"}) >= 0) {
+        result.success = importAssessments(reader, result);
+    } else if (headerColumn(reader.header(), {"shift"}) >= 0) {
+        result.success = importEngineers(reader, result);
+    } else {
+        result.errors << "Unrecognised CSV columns: expected an engineers (ID, Name, Shift) "
+                         "or assessments (Engineer ID, Competency ID, Score) file";
+    }
+    return result;
+}
+
+CsvImporter::ImportResult CsvImporter::importEngineers(const QString& filePath)
+{
+    ImportResult result;
+    CsvReader reader;
+    if (!reader.open(filePath)) {
+        result.errors << reader.lastError();
+        return result;
+    }
+    result.success = importEngineers(reader, result);
+    return result;
+}
+
+CsvImporter::ImportResult CsvImporter::importAssessments(const QString& filePath)
+{
+    ImportResult result;
+    CsvReader reader;
+    if (!reader.open(filePath)) {
+        result.errors << reader.lastError();
+        return result;
+    }
+    result.success = importAssessments(reader, result);
+    return result;
+}
+
+bool CsvImporter::importEngineers(CsvReader& reader, ImportResult& result)
+{
+    const QStringList header = reader.header();
+    const int idColumn = headerColumn(header, {"id", "engineer id"});
+    const int nameColumn = headerColumn(header, {"name", "engineer name", "engineer"});
+    const int shiftColumn = headerColumn(header, {"shift"});
+    if (nameColumn < 0 || shiftColumn < 0) {
+        result.errors << "Engineers CSV needs Name and Shift columns";
+        return false;
+    }
+
+    RowValidator<Engineer> validate = [=](const CsvRow& row, Engineer& engineer, QString& error) {
+        engineer = Engineer(row.text(idColumn), ValidationHelper::sanitize(row.text(nameColumn)), row.text(shiftColumn));
+        return ValidationHelper::validateRequired(engineer.name(), "Name", error)
+            && ValidationHelper::validateLength(engineer.name(), 1, 100, "Name", error)
+            && ValidationHelper::validateRequired(engineer.shift(), "Shift", error)
+            && ValidationHelper::validateLength(engineer.id(), 0, 50, "ID", error);
+    };
+
+    return runPipeline(reader, validate, BatchWriter<Engineer>::saveOrUpdateBatch<EngineerRepository>(),
+                       progress_, result);
+}
+
+bool CsvImporter::importAssessments(CsvReader& reader, ImportResult& result)
+{
+    const QStringList header = reader.header();
+    const int engineerColumn = headerColumn(header, {"engineer id"});
+    const int competencyColumn = headerColumn(header, {"competency id"});
+    const int scoreColumn = headerColumn(header, {"score"});
+    if (engineerColumn < 0 || competencyColumn < 0 || scoreColumn < 0) {
+        result.errors << "Assessments CSV needs Engineer ID, Competency ID and Score columns";
+        return false;
+    }
+
+    // Read-only lookups shared by the parsing tasks
+    EngineerRepository engineerRepo;
+    QSet<QString> engineerIds;
+    for (const Engineer& engineer : engineerRepo.findAll()) {
+        engineerIds.insert(engineer.id());
+    }
+    ProductionRepository productionRepo;
+    ProductionHierarchy hierarchy = productionRepo.loadHierarchy();
+    if (!engineerRepo.lastError().isEmpty() || !productionRepo.lastError().isEmpty()) {
+        result.errors << "Failed to load reference data: " + engineerRepo.lastError() + productionRepo.lastError();
+        return false;
+    }
+
+    QHash<int, CompetencyRef> competencies;
+    competencies.reserve(hierarchy.competencies().size());
+    for (const Competency& competency : hierarchy.competencies()) {
+        competencies.insert(competency.id(), CompetencyRef::of(hierarchy, competency));
+    }
+
+    RowValidator<Assessment> validate = [&](const CsvRow& row, Assessment& assessment, QString& error) {
+        QString engineerId = row.text(engineerColumn);
+        if (!engineerIds.contains(engineerId)) {
+            error = QString("unknown engineer '%1'").arg(engineerId);
+            return false;
+        }
+
+        int competencyId = 0;
+        auto it = competencies.constEnd();
+        if (ValidationHelper::parseWhole(row.field(competencyColumn), competencyId)) {
+            it = competencies.constFind(competencyId);
+        }
+        if (it == competencies.constEnd()) {
+            error = QString("unknown competency id '%1'").arg(row.text(competencyColumn));
+            return false;
+        }
+
+        int score = 0;
+        if (!ValidationHelper::parseWhole(row.field(scoreColumn), score) || !ValidationHelper::isValidScore(score, it.value().maxScore)) {
+            error = QString("score '%1' must be 0-%2").arg(row.text(scoreColumn)).arg(it.value().maxScore);
+            return false;
+        }
+
+        assessment = Assessment(0, engineerId, it.value().areaId, it.value().machineId, competencyId, score);
+        return true;
+    };
+
+    return runPipeline(reader, validate, BatchWriter<Assessment>::saveOrUpdateBatch<AssessmentRepository>(),
+                       progress_, result);
+}
@@ -0,0 +1,64 @@
+#ifndef CSVIMPORTER_H
+#define CSVIMPORTER_H
+
+#include "ExcelImporter.h"
+#include <QString>
+#include <functional>
+
+class CsvReader;
+
+/**
+ * @brief CSV importer for engineers and assessments
+ *
+ * The file is memory-mapped and split into chunks of IMPORT_CSV_CHUNK_BYTES
+ * at record boundaries (CsvReader). Chunks are parsed and validated in
+ * parallel on the global thread pool, straight from the mapped bytes; the
+ * records are then handed in file order to a writer thread that upserts
+ * IMPORT_BATCH_SIZE of them per transaction on its own pooled connection.
+ * Only a few chunks are in flight at a time, so files of any size import
+ * in bounded memory.
+ *
+ * Reads the files CsvExporter writes; the table is recognised by its
+ * header (a Score column means assessments, a Shift column engineers).
+ */
+class CsvImporter
+{
+public:
+    using ImportResult = ExcelImporter::ImportResult;
+
+    /**
+     * @brief Progress callback, invoked on the importing thread
+     */
+    using ProgressCallback = std::function<void(qint64 bytesRead, qint64 totalBytes, int recordsWritten)>;
+
+    CsvImporter();
+    ~CsvImporter();
+
+    void setProgressCallback(const ProgressCallback& callback) { progress_ = callback; }
+
+    /**
+     * @brief Import engineers or assessments, whichever the header describes
+     */
+    ImportResult importFile(const QString& filePath);
+
+    /**
+     * @brief Import engineers (ID, Name, Shift); known IDs are updated
+     */
+    ImportResult importEngineers(const QString& filePath);
+
+    /**
+     * @brief Import assessments (Engineer ID, Competency ID, Score)
+     *
+     * Engineers and competencies must already exist; scores are upserted.
+     */
+    ImportResult importAssessments(const QString& filePath);
+
+private:
+    bool importEngineers(CsvReader& reader, ImportResult& result);
+    bool importAssessments(CsvReader& reader, ImportResult& result);
+
+private:
+    ProgressCallback progress_;
+};
+
+#endif // CSVIMPORTER_H
@@ -0,0 +1,217 @@
+#include "CsvReader.h"
+#include "Logger.h"
+#include <cstring>
+
+CsvReader::CsvReader()
+    : data_(nullptr)
+    , size_(0)
+    , bodyStart_(0)
+{
+}
+
+CsvReader::~CsvReader()
+{
+    close();
+}
+
+bool CsvReader::open(const QString& filePath)
+{
+    close();
+    lastError_.clear();
+
+    file_.reset(new QFile(filePath));
+    if (!file_->open(QIODevice::ReadOnly)) {
+        QString error = "Cannot open " + filePath + ": " + file_->errorString();
+        file_.reset();
+        return fail(error);
+    }
+
+    size_ = file_->size();
+    if (size_ == 0) {
+        close();
+        return fail(filePath + " is empty");
+    }
+
+    // Mapped pages are shared by all parsing threads and read straight from the page cache
+    uchar* mapped = file_->map(0, size_);
+    if (!mapped) {
+        QString error = "Cannot map " + filePath + ": " + file_->errorString();
+        close();
+        return fail(error);
+    }
+    data_ = reinterpret_cast<const char*>(mapped);
+
+    qint64 start = 0;
+    if (size_ >= 3 && std::memcmp(data_, "\xEF\xBB\xBF", 3) == 0) {
+        start = 3;
+    }
+
+    bodyStart_ = recordEnd(start);
+    QList<CsvRow> rows;
+    QList<QByteArray> unescaped;
+    QString error;
+    if (!parse(Range{start, bodyStart_}, rows, unescaped, error)) {
+        close();
+        return fail(filePath + ": " + error);
+    }
+    if (!rows.isEmpty()) {
+        for (int i = 0; i < rows.first().fields.size(); ++i) {
+            header_ << rows.first().text(i);
+        }
+    }
+
+    LOG_DEBUG("CsvReader", QString("Opened %1: %2 bytes, %3 columns").arg(filePath).arg(size_).arg(header_.size()));
+    return true;
+}
+
+void CsvReader::close()
+{
+    // Closing the file also unmaps it
+    file_.reset();
+    data_ = nullptr;
+    size_ = 0;
+    bodyStart_ = 0;
+    header_.clear();
+}
+
+QList<CsvReader::Range> CsvReader::split(qint64 chunkBytes) const
+{
+    QList<Range> ranges;
+    qint64 begin = bodyStart_;
+
+    while (begin < size_) {
+        qint64 target = begin + qMax<qint64>(chunkBytes, 1);
+        if (target >= size_) {
+            ranges.append(Range{begin, size_});
+            break;
+        }
+
+        // Quote parity up to the target, counted with memchr, decides whether
+        // the next line break (LF, CRLF or a bare CR) really ends a record
+        bool inQuotes = false;
+        const char* p = data_ + begin;
+        const char* stop = data_ + target;
+        while ((p = static_cast<const char*>(std::memchr(p, '"', size_t(stop - p)))) != nullptr) {
+            inQuotes = !inQuotes;
+            ++p;
+        }
+
+        const char* end = data_ + size_;
+        for (p = stop; p < end; ++p) {
+            if (*p == '"') {
+                inQuotes = !inQuotes;
+            } else if ((*p == '\n' || *p == '\r') && !inQuotes) {
+                if (*p == '\r' && p + 1 < end && p[1] == '\n') {
+                    ++p;
+                }
+                break;
+            }
+        }
+
+        qint64 boundary = p < end ? (p - data_) + 1 : size_;
+        ranges.append(Range{begin, boundary});
+        begin = boundary;
+    }
+
+    return ranges;
+}
+
+bool CsvReader::parse(const Range& range, QList<CsvRow>& rows, QList<QByteArray>& unescaped, QString& error,
+                      int* recordCount) const
+{
+    const char* p = data_ + range.begin;
+    const char* end = data_ + range.end;
+    int number = 0;
+
+    while (p < end) {
+        CsvRow row;
+        row.number = ++number;
+
+        for (;;) {
+            if (p < end && *p == '"') {
+                const char* start = ++p;
+                bool doubled = false;
+                for (;;) {
+                    const char* quote = static_cast<const char*>(std::memchr(p, '"', size_t(end - p)));
+                    if (!quote) {
+                        error = QString("record %1: unterminated quoted field").arg(number);
+                        return false;
+                    }
+                    if (quote + 1 < end && quote[1] == '"') {
+                        doubled = true;
+                        p = quote + 2;
+                        continue;
+                    }
+
+                    if (doubled) {
+                        QByteArray field(start, quote - start);
+                        field.replace("\"\"", "\"");
+                        unescaped.append(field);
+                        row.fields.append(QByteArrayView(unescaped.last()));
+                    } else {
+                        row.fields.append(QByteArrayView(start, quote - start));
+                    }
+                    p = quote + 1;
+                    break;
+                }
+
+                if (p < end && *p != ',' && *p != '\n' && *p != '\r') {
+                    error = QString("record %1: unexpected text after a quoted field").arg(number);
+                    return false;
+                }
+            } else {
+                const char* start = p;
+                while (p < end && *p != ',' && *p != '\n' && *p != '\r') {
+                    ++p;
+                }
+                row.fields.append(QByteArrayView(start, p - start));
+            }
+
+            if (p < end && *p == ',') {
+                ++p;
+                continue;
+            }
+            break;
+        }
+
+        if (p < end && *p == '\r') {
+            ++p;
+        }
+        if (p < end && *p == '\n') {
+            ++p;
+        }
+
+        if (row.fields.size() > 1 || !row.fields.first().isEmpty()) {
+            rows.append(std::move(row));
+        }
+    }
+
+    if (recordCount) {
+        *recordCount = number;
+    }
+    return true;
+}
+
+qint64 CsvReader::recordEnd(qint64 from) const
+{
+    bool inQuotes = false;
+    for (qint64 i = from; i < size_; ++i) {
+        char c = data_[i];
+        if (c == '"') {
+            inQuotes = !inQuotes;
+        } else if ((c == '\n' || c == '\r') && !inQuotes) {
+            if (c == '\r' && i + 1 < size_ && data_[i + 1] == '\n') {
+                ++i;
+            }
+            return i + 1;
+        }
+    }
+    return size_;
+}
+
+bool CsvReader::fail(const QString& error)
+{
+    lastError_ = error;
+    Logger::instance().error("CsvReader", error);
+    return false;
+}
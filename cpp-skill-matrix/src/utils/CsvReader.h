@@ -0,0 +1,93 @@
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QVarLengthArray>
+#include <QList>
+#include <QFile>
+#include <memory>
+
+/**
+ * @brief One parsed CSV record
+ *
+ * Fields point into the mapped file (or, for quoted fields with doubled
+ * quotes, into the unescape buffer passed to CsvReader::parse), so a row
+ * is only valid while both are alive. Convert what you keep.
+ */
+struct CsvRow {
+    int number = 0;  // 1-based record number within the parsed range
+    QVarLengthArray<QByteArrayView, 16> fields;
+
+    QByteArrayView field(int column) const
+    {
+        return column >= 0 && column < fields.size() ? fields[column] : QByteArrayView();
+    }
+
+    /**
+     * @brief Field as trimmed text
+     */
+    QString text(int column) const { return QString::fromUtf8(field(column)).trimmed(); }
+};
+
+/**
+ * @brief Memory-mapped RFC 4180 CSV reader
+ *
+ * open() maps the file and reads the header record. split() cuts the body
+ * into ranges that end on record boundaries (tracking quotes, so newlines
+ * inside quoted fields never split a record), and parse() turns a range
+ * into rows without copying field data. parse() is const and touches no
+ * shared state, so ranges can be parsed on as many threads as there are.
+ *
+ * Expects UTF-8 (a byte order mark is skipped) with comma separators;
+ * records may end in LF, CRLF or CR.
+ */
+class CsvReader
+{
+public:
+    struct Range {
+        qint64 begin = 0;
+        qint64 end = 0;
+    };
+
+    CsvReader();
+    ~CsvReader();
+
+    bool open(const QString& filePath);
+    void close();
+
+    QStringList header() const { return header_; }
+    qint64 size() const { return size_; }
+
+    /**
+     * @brief Split the body into ranges of roughly chunkBytes each
+     */
+    QList<Range> split(qint64 chunkBytes) const;
+
+    /**
+     * @brief Parse the records in a range, skipping blank lines
+     * @param unescaped Storage for fields that had to be unescaped
+     * @param recordCount Records in the range, blank ones included (for numbering across ranges)
+     * @return false (with error) on a malformed quoted field
+     */
+    bool parse(const Range& range, QList<CsvRow>& rows, QList<QByteArray>& unescaped, QString& error,
+               int* recordCount = nullptr) const;
+
+    QString lastError() const { return lastError_; }
+
+private:
+    qint64 recordEnd(qint64 from) const;  // offset after the record starting at from
+    bool fail(const QString& error);
+
+private:
+    std::unique_ptr<QFile> file_;
+    const char* data_;
+    qint64 size_;
+    qint64 bodyStart_;
+    QStringList header_;
+    QString lastError_;
+};
+
+#endif // CSVREADER_H
@@ -0,0 +1,166 @@
+#include "CsvWriter.h"
+#include "Logger.h"
+#include "../core/Constants.h"
+#include <charconv>
+
+CsvWriter::CsvWriter()
+    : rowStarted_(false)
+    , failed_(false)
+    , rows_(0)
+{
+}
+
+CsvWriter::~CsvWriter()
+{
+    cancel();
+}
+
+bool CsvWriter::open(const QString& filePath)
+{
+    cancel();
+    lastError_.clear();
+    failed_ = false;
+    rowStarted_ = false;
+    rows_ = 0;
+
+    file_.reset(new QSaveFile(filePath));
+    if (!file_->open(QIODevice::WriteOnly)) {
+        QString error = "Cannot write " + filePath + ": " + file_->errorString();
+        file_.reset();
+        return fail(error);
+    }
+
+    buffer_.clear();
+    buffer_.reserve(Constants::EXPORT_WRITE_BUFFER * 2);
+    buffer_.append("\xEF\xBB\xBF");
+    return true;
+}
+
+void CsvWriter::addField(QStringView text)
+{
+    separate();
+
+    bool quote = false;
+    bool ascii = true;
+    for (QChar c : text) {
+        char16_t u = c.unicode();
+        if (u >= 0x80) {
+            ascii = false;
+        } else if (u == ',' || u == '"' || u == '\n' || u == '\r') {
+            quote = true;
+        }
+    }
+
+    if (ascii && !quote) {
+        qsizetype offset = buffer_.size();
+        buffer_.resize(offset + text.size());
+        char* out = buffer_.data() + offset;
+        for (QChar c : text) {
+            *out++ = char(c.unicode());
+        }
+        return;
+    }
+
+    QByteArray utf8 = text.toUtf8();
+    if (quote) {
+        buffer_.append('"');
+        buffer_.append(utf8.replace('"', "\"\""));
+        buffer_.append('"');
+    } else {
+        buffer_.append(utf8);
+    }
+}
+
+void CsvWriter::addField(qint64 value)
+{
+    separate();
+
+    char digits[24];
+    std::to_chars_result converted = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer_.append(digits, converted.ptr - digits);
+}
+
+void CsvWriter::addField(double value, int decimals)
+{
+    separate();
+    buffer_.append(QByteArray::number(value, 'f', decimals));
+}
+
+bool CsvWriter::endRow()
+{
+    buffer_.append("\r\n", 2);
+    rowStarted_ = false;
+    ++rows_;
+
+    if (buffer_.size() >= Constants::EXPORT_WRITE_BUFFER) {
+        return flush();
+    }
+    return !failed_;
+}
+
+bool CsvWriter::addRow(const QStringList& fields)
+{
+    for (const QString& field : fields) {
+        addField(QStringView(field));
+    }
+    return endRow();
+}
+
+bool CsvWriter::close()
+{
+    if (!file_) {
+        return fail("CSV file is not open");
+    }
+    if (!flush()) {
+        cancel();
+        return false;
+    }
+    if (!file_->commit()) {
+        QString error = "Failed to save " + file_->fileName() + ": " + file_->errorString();
+        file_.reset();
+        return fail(error);
+    }
+
+    LOG_DEBUG("CsvWriter", QString("Wrote %1 rows to %2").arg(rows_).arg(file_->fileName()));
+    file_.reset();
+    return true;
+}
+
+void CsvWriter::cancel()
+{
+    if (file_) {
+        file_->cancelWriting();
+        file_.reset();
+    }
+    buffer_.clear();
+}
+
+void CsvWriter::separate()
+{
+    if (rowStarted_) {
+        buffer_.append(',');
+    }
+    rowStarted_ = true;
+}
+
+bool CsvWriter::flush()
+{
+    if (failed_) {
+        return false;
+    }
+    if (!buffer_.isEmpty()) {
+        if (file_->write(buffer_) != buffer_.size()) {
+            failed_ = true;
+            return fail("Failed to write " + file_->fileName() + ": " + file_->errorString());
+        }
+        buffer_.resize(0);
+    }
+    return true;
+}
+
+bool CsvWriter::fail(const QString& error)
+{
+    lastError_ = error;
+    Logger::instance().error("CsvWriter", error);
+    return false;
+}
@@ -0,0 +1,71 @@
+#ifndef CSVWRITER_H
+#define CSVWRITER_H
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QByteArray>
+#include <QSaveFile>
+#include <memory>
+
+/**
+ * @brief Buffered RFC 4180 CSV writer
+ *
+ * Fields are encoded straight into a byte buffer (ASCII without a detour
+ * through QByteArray, quoting only where needed) which is handed to the
+ * file in EXPORT_WRITE_BUFFER-sized writes. Output goes through QSaveFile,
+ * so a failed or cancelled export leaves any existing file untouched.
+ *
+ * Writes a UTF-8 byte order mark so Excel picks the right encoding, and
+ * ends records with CRLF.
+ */
+class CsvWriter
+{
+public:
+    CsvWriter();
+    ~CsvWriter();
+
+    bool open(const QString& filePath);
+
+    void addField(QStringView text);
+    void addField(const QString& text) { addField(QStringView(text)); }
+    void addField(const char* text) { addField(QString::fromUtf8(text)); }
+    void addField(qint64 value);
+    void addField(int value) { addField(qint64(value)); }
+    void addField(double value, int decimals);
+
+    /**
+     * @brief End the current record
+     * @return false once a write has failed (see lastError)
+     */
+    bool endRow();
+    bool addRow(const QStringList& fields);
+
+    /**
+     * @brief Flush and commit the file
+     */
+    bool close();
+
+    /**
+     * @brief Discard the file being written
+     */
+    void cancel();
+
+    qint64 rowCount() const { return rows_; }
+    QString lastError() const { return lastError_; }
+
+private:
+    void separate();
+    bool flush();
+    bool fail(const QString& error);
+
+private:
+    std::unique_ptr<QSaveFile> file_;
+    QByteArray buffer_;
+    bool rowStarted_;
+    bool failed_;
+    qint64 rows_;
+    QString lastError_;
+};
+
+#endif // CSVWRITER_H
@@ -1,5 +1,38 @@
 #include "ExcelExporter.h"
 #include "Logger.h"
+#include "../database/EngineerRepository.h"
+#include "../database/ProductionRepository.h"
+#include "../database/AssessmentRepository.h"
+#include "../controllers/ReportController.h"
+#include <QHash>
+#include <QSet>
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Report values are formatted strings; numeric ones become numeric cells
+ */
+QVariant reportCell(const QString& value)
+{
+    bool ok = false;
+    double number = value.toDouble(&ok);
+    return ok ? QVariant(number) : QVariant(value);
+}
+
+/**
+ * @brief "total_engineers" -> "Total Engineers"
+ */
+QString reportHeading(const QString& key)
+{
+    QStringList words = key.split('_', Qt::SkipEmptyParts);
+    for (QString& word : words) {
+        word[0] = word[0].toUpper();
+    }
+    return words.join(' ');
+}
+
+} // namespace
 
 ExcelExporter::ExcelExporter()
 {
@@ -11,40 +44,390 @@ ExcelExporter::~ExcelExporter()
 
 bool ExcelExporter::exportAll(const QString& filePath)
 {
-    // TODO: Implement using QXlsx
-    Logger::instance().warning("ExcelExporter", "Export all not yet implemented");
-    lastError_ = "Excel export not yet implemented (Phase 5 feature)";
-    return false;
+    lastError_.clear();
+    if (!loadEngineers() || !loadHierarchy()) {
+        return false;
+    }
+
+    XlsxWriter writer;
+    if (!writer.open(filePath)) {
+        return fail(writer.lastError());
+    }
+
+    bool ok = writeEngineers(writer)
+        && writeProduction(writer)
+        && writeAssessments(writer)
+        && writeMatrix(writer);
+    return finish(writer, ok, "all data", filePath);
 }
 
 bool ExcelExporter::exportEngineers(const QString& filePath)
 {
-    // TODO: Implement using QXlsx
-    Logger::instance().warning("ExcelExporter", "Export engineers not yet implemented");
-    lastError_ = "Excel export not yet implemented (Phase 5 feature)";
-    return false;
+    lastError_.clear();
+    if (!loadEngineers()) {
+        return false;
+    }
+
+    XlsxWriter writer;
+    if (!writer.open(filePath)) {
+        return fail(writer.lastError());
+    }
+    return finish(writer, writeEngineers(writer), "engineers", filePath);
 }
 
 bool ExcelExporter::exportProductionAreas(const QString& filePath)
 {
-    // TODO: Implement using QXlsx
-    Logger::instance().warning("ExcelExporter", "Export production areas not yet implemented");
-    lastError_ = "Excel export not yet implemented (Phase 5 feature)";
-    return false;
+    lastError_.clear();
+    if (!loadHierarchy()) {
+        return false;
+    }
+
+    XlsxWriter writer;
+    if (!writer.open(filePath)) {
+        return fail(writer.lastError());
+    }
+    return finish(writer, writeProduction(writer), "production areas", filePath);
 }
 
 bool ExcelExporter::exportAssessments(const QString& filePath)
 {
-    // TODO: Implement using QXlsx
-    Logger::instance().warning("ExcelExporter", "Export assessments not yet implemented");
-    lastError_ = "Excel export not yet implemented (Phase 5 feature)";
-    return false;
+    lastError_.clear();
+    if (!loadEngineers() || !loadHierarchy()) {
+        return false;
+    }
+
+    XlsxWriter writer;
+    if (!writer.open(filePath)) {
+        return fail(writer.lastError());
+    }
+    return finish(writer, writeAssessments(writer), "assessments", filePath);
 }
 
 bool ExcelExporter::exportReport(const QString& filePath, const QString& reportType)
 {
-    // TODO: Implement using QXlsx
-    Logger::instance().warning("ExcelExporter", "Export report not yet implemented");
-    lastError_ = "Excel export not yet implemented (Phase 5 feature)";
+    lastError_.clear();
+
+    // Build the report rows before touching the file, so an unknown type or
+    // failed query leaves nothing behind
+    QList<QMap<QString, QString>> reports;
+    QString sheetName;
+    ReportController reportController;
+
+    if (reportType == "system") {
+        sheetName = "System Report";
+        reports.append(reportController.generateSystemReport());
+    } else if (reportType == "areas") {
+        if (!loadHierarchy()) {
+            return false;
+        }
+        sheetName = "Area Coverage";
+        for (const ProductionArea& area : hierarchy_.areas()) {
+            reports.append(reportController.generateProductionAreaReport(area.id()));
+        }
+    } else if (reportType == "shifts") {
+        if (!loadEngineers()) {
+            return false;
+        }
+        sheetName = "Shift Summary";
+        QSet<QString> seen;
+        for (const Engineer& engineer : engineers_) {
+            if (!seen.contains(engineer.shift())) {
+                seen.insert(engineer.shift());
+                reports.append(reportController.generateShiftReport(engineer.shift()));
+            }
+        }
+    } else if (reportType == "matrix") {
+        if (!loadEngineers() || !loadHierarchy()) {
+            return false;
+        }
+    } else {
+        return fail("Unknown report type: " + reportType);
+    }
+
+    if (!reportController.lastError().isEmpty()) {
+        return fail("Failed to generate report: " + reportController.lastError());
+    }
+
+    XlsxWriter writer;
+    if (!writer.open(filePath)) {
+        return fail(writer.lastError());
+    }
+
+    bool ok = reportType == "matrix"
+        ? writeMatrix(writer)
+        : writeReportTable(writer, sheetName, reports);
+    return finish(writer, ok, reportType + " report", filePath);
+}
+
+bool ExcelExporter::loadEngineers()
+{
+    EngineerRepository engineerRepo;
+    engineers_ = engineerRepo.findAll();
+    if (!engineerRepo.lastError().isEmpty()) {
+        return fail("Failed to load engineers: " + engineerRepo.lastError());
+    }
+    return true;
+}
+
+bool ExcelExporter::loadHierarchy()
+{
+    ProductionRepository productionRepo;
+    hierarchy_ = productionRepo.loadHierarchy();
+    if (!productionRepo.lastError().isEmpty()) {
+        return fail("Failed to load production areas: " + productionRepo.lastError());
+    }
+    return true;
+}
+
+bool ExcelExporter::writeEngineers(XlsxWriter& writer)
+{
+    if (!writer.beginSheet("Engineers", {14, 30, 14, 20, 20}, 1)
+        || !writer.addRow({"ID", "Name", "Shift", "Created", "Updated"}, XlsxWriter::Header)) {
+        return fail(writer.lastError());
+    }
+
+    for (const Engineer& engineer : engineers_) {
+        if (!writer.addRow({engineer.id(), engineer.name(), engineer.shift(),
+                            engineer.createdAt(), engineer.updatedAt()})) {
+            return fail(writer.lastError());
+        }
+    }
+    return true;
+}
+
+bool ExcelExporter::writeProduction(XlsxWriter& writer)
+{
+    if (!writer.beginSheet("Production Areas", {8, 30}, 1)
+        || !writer.addRow({"ID", "Name"}, XlsxWriter::Header)) {
+        return fail(writer.lastError());
+    }
+    for (const ProductionArea& area : hierarchy_.areas()) {
+        if (!writer.addRow({area.id(), area.name()})) {
+            return fail(writer.lastError());
+        }
+    }
+
+    if (!writer.beginSheet("Machines", {8, 30, 30, 12}, 1)
+        || !writer.addRow({"ID", "Production Area", "Name", "Importance"}, XlsxWriter::Header)) {
+        return fail(writer.lastError());
+    }
+    for (const Machine& machine : hierarchy_.machines()) {
+        if (!writer.addRow({machine.id(), hierarchy_.area(machine.productionAreaId()).name(),
+                            machine.name(), machine.importance()})) {
+            return fail(writer.lastError());
+        }
+    }
+
+    if (!writer.beginSheet("Competencies", {8, 30, 30, 40, 10}, 1)
+        || !writer.addRow({"ID", "Production Area", "Machine", "Name", "Max Score"}, XlsxWriter::Header)) {
+        return fail(writer.lastError());
+    }
+    for (const Competency& competency : hierarchy_.competencies()) {
+        Machine machine = hierarchy_.machine(competency.machineId());
+        if (!writer.addRow({competency.id(), hierarchy_.area(machine.productionAreaId()).name(),
+                            machine.name(), competency.name(), competency.maxScore()})) {
+            return fail(writer.lastError());
+        }
+    }
+    return true;
+}
+
+bool ExcelExporter::writeAssessments(XlsxWriter& writer)
+{
+    if (!writer.beginSheet("Assessments", {10, 14, 30, 25, 25, 40, 8, 10, 20}, 1)
+        || !writer.addRow({"ID", "Engineer ID", "Engineer", "Production Area", "Machine",
+                           "Competency", "Score", "Max Score", "Updated"}, XlsxWriter::Header)) {
+        return fail(writer.lastError());
+    }
+
+    QHash<QString, QString> engineerNames;
+    engineerNames.reserve(engineers_.size());
+    for (const Engineer& engineer : engineers_) {
+        engineerNames.insert(engineer.id(), engineer.name());
+    }
+
+    // Rows go straight from the cursor into the sheet
+    AssessmentRepository assessmentRepo;
+    QVariantList row;
+    bool written = true;
+    bool streamed = assessmentRepo.forEach([&](const Assessment& assessment) {
+        Competency competency = hierarchy_.competency(assessment.competencyId());
+        row = {assessment.id(), assessment.engineerId(), engineerNames.value(assessment.engineerId()),
+               hierarchy_.area(assessment.productionAreaId()).name(),
+               hierarchy_.machine(assessment.machineId()).name(),
+               competency.name(), assessment.score(), competency.maxScore(), assessment.updatedAt()};
+        written = writer.addRow(row);
+        return written;
+    });
+
+    if (!written) {
+        return fail(writer.lastError());
+    }
+    if (!streamed) {
+        return fail("Failed to read assessments: " + assessmentRepo.lastError());
+    }
+    return true;
+}
+
+bool ExcelExporter::writeMatrix(XlsxWriter& writer)
+{
+    // Engineers down, competencies across, grouped under their area and machine
+    const QList<Competency>& competencies = hierarchy_.competencies();
+    const int fixedColumns = 3;
+
+    QList<double> widths = {14, 30, 14};
+    QVariantList areaRow = {"Production Area", QVariant(), QVariant()};
+    QVariantList machineRow = {"Machine", QVariant(), QVariant()};
+    QVariantList competencyRow = {"Engineer ID", "Engineer", "Shift"};
+    QHash<int, int> columnByCompetency;
+    columnByCompetency.reserve(competencies.size());
+
+    for (const Competency& competency : competencies) {
+        Machine machine = hierarchy_.machine(competency.machineId());
+        columnByCompetency.insert(competency.id(), competencyRow.size());
+        areaRow.append(hierarchy_.area(machine.productionAreaId()).name());
+        machineRow.append(machine.name());
+        competencyRow.append(competency.name());
+        widths.append(12);
+    }
+
+    if (!writer.beginSheet("Skill Matrix", widths, 3)
+        || !writer.addRow(areaRow, XlsxWriter::Header)
+        || !writer.addRow(machineRow, XlsxWriter::Header)
+        || !writer.addRow(competencyRow, XlsxWriter::Header)) {
+        return fail(writer.lastError());
+    }
+
+    // Engineers in id order, merged against one stream of assessments grouped by
+    // engineer; the row being filled is reused
+    QList<Engineer> engineers = engineers_;
+    std::sort(engineers.begin(), engineers.end(), [](const Engineer& a, const Engineer& b) {
+        return a.id() < b.id();
+    });
+
+    QVariantList row;
+    row.reserve(fixedColumns + competencies.size());
+    auto startRow = [&](const Engineer& engineer) {
+        row.clear();
+        row << engineer.id() << engineer.name() << engineer.shift();
+        for (int i = 0; i < competencies.size(); ++i) {
+            row.append(QVariant());
+        }
+    };
+
+    int next = 0;           // first engineer whose row is not written yet
+    bool filling = false;   // row holds engineers[next]'s scores so far
+    bool writeFailed = false;
+    auto finishRows = [&](const QString& beforeId, bool all) {
+        if (filling) {
+            filling = false;
+            if (!writer.addRow(row)) {
+                return false;
+            }
+            ++next;
+        }
+        // Engineers sorting before the next assessed one have no scores
+        while (next < engineers.size() && (all || engineers[next].id() < beforeId)) {
+            startRow(engineers[next]);
+            if (!writer.addRow(row)) {
+                return false;
+            }
+            ++next;
+        }
+        return true;
+    };
+
+    AssessmentRepository assessmentRepo;
+    bool streamed = assessmentRepo.forEach([&](const Assessment& assessment) {
+        const QString& engineerId = assessment.engineerId();
+        if (!filling || engineers[next].id() != engineerId) {
+            if (!finishRows(engineerId, false)) {
+                writeFailed = true;
+                return false;
+            }
+            if (next == engineers.size() || engineers[next].id() != engineerId) {
+                return true;    // engineer no longer on file
+            }
+            startRow(engineers[next]);
+            filling = true;
+        }
+
+        int column = columnByCompetency.value(assessment.competencyId(), -1);
+        if (column >= 0) {
+            row[column] = assessment.score();
+        }
+        return true;
+    }, AssessmentRepository::PageFilter(), AssessmentRepository::Order::ByEngineer);
+
+    if (writeFailed || (streamed && !finishRows(QString(), true))) {
+        return fail(writer.lastError());
+    }
+    if (!streamed) {
+        return fail("Failed to read assessments: " + assessmentRepo.lastError());
+    }
+    return true;
+}
+
+bool ExcelExporter::writeReportTable(XlsxWriter& writer, const QString& sheetName,
+                                     const QList<QMap<QString, QString>>& reports)
+{
+    // Single report: key/value pairs down the sheet; several: one row each
+    if (reports.size() == 1) {
+        if (!writer.beginSheet(sheetName, {32, 20}, 1)
+            || !writer.addRow({"Metric", "Value"}, XlsxWriter::Header)) {
+            return fail(writer.lastError());
+        }
+        const QMap<QString, QString>& report = reports.first();
+        for (auto it = report.constBegin(); it != report.constEnd(); ++it) {
+            if (!writer.addRow({reportHeading(it.key()), reportCell(it.value())})) {
+                return fail(writer.lastError());
+            }
+        }
+        return true;
+    }
+
+    QStringList keys = reports.isEmpty() ? QStringList() : reports.first().keys();
+    QVariantList header;
+    QList<double> widths;
+    for (const QString& key : keys) {
+        header.append(reportHeading(key));
+        widths.append(20);
+    }
+
+    if (!writer.beginSheet(sheetName, widths, 1) || !writer.addRow(header, XlsxWriter::Header)) {
+        return fail(writer.lastError());
+    }
+    for (const QMap<QString, QString>& report : reports) {
+        QVariantList row;
+        for (const QString& key : keys) {
+            row.append(reportCell(report.value(key)));
+        }
+        if (!writer.addRow(row)) {
+            return fail(writer.lastError());
+        }
+    }
+    return true;
+}
+
+bool ExcelExporter::finish(XlsxWriter& writer, bool ok, const QString& what, const QString& filePath)
+{
+    // On failure the target file is left as it was
+    if (!ok) {
+        writer.cancel();
+        return false;
+    }
+    if (!writer.close()) {
+        return fail(writer.lastError());
+    }
+
+    Logger::instance().info("ExcelExporter", QString("Exported %1 to %2 (%3 cells)")
+        .arg(what, filePath).arg(writer.cellCount()));
+    return true;
+}
+
+bool ExcelExporter::fail(const QString& error)
+{
+    lastError_ = error;
+    Logger::instance().error("ExcelExporter", error);
     return false;
 }
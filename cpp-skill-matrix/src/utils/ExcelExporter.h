@@ -1,12 +1,23 @@
 #ifndef EXCELEXPORTER_H
 #define EXCELEXPORTER_H
 
+#include "XlsxWriter.h"
+#include "../models/Engineer.h"
+#include "../models/ProductionHierarchy.h"
 #include <QString>
+#include <QList>
+#include <QMap>
 
 /**
- * @brief Excel file exporter (Phase 5 implementation)
+ * @brief Excel (.xlsx) exporter
  *
- * TODO: Implement using QXlsx library
+ * Sheets are streamed through XlsxWriter as rows are read from the
+ * repositories; assessments are never loaded as a list, so memory stays flat
+ * however large the plant matrix is. Engineers and the production hierarchy
+ * are loaded once per export to resolve names.
+ *
+ * Uses the calling thread's database connection: wrap worker-thread exports
+ * in a ScopedConnection.
  */
 class ExcelExporter
 {
@@ -16,6 +27,9 @@ public:
 
     /**
      * @brief Export all data to Excel file
+     *
+     * Engineers, production areas, machines, competencies, assessments and
+     * the skill matrix, one sheet each.
      */
     bool exportAll(const QString& filePath);
 
@@ -36,6 +50,7 @@ public:
 
     /**
      * @brief Export report to Excel file
+     * @param reportType "system", "areas", "shifts" or "matrix" (engineers x competencies)
      */
     bool exportReport(const QString& filePath, const QString& reportType);
 
@@ -44,9 +59,24 @@ public:
      */
     QString lastError() const { return lastError_; }
 
+private:
+    bool loadEngineers();
+    bool loadHierarchy();
+
+    bool writeEngineers(XlsxWriter& writer);
+    bool writeProduction(XlsxWriter& writer);
+    bool writeAssessments(XlsxWriter& writer);
+    bool writeMatrix(XlsxWriter& writer);
+    bool writeReportTable(XlsxWriter& writer, const QString& sheetName,
+                          const QList<QMap<QString, QString>>& reports);
+
+    bool finish(XlsxWriter& writer, bool ok, const QString& what, const QString& filePath);
+    bool fail(const QString& error);
+
 private:
     QString lastError_;
-    // TODO: Add QXlsx members
+    QList<Engineer> engineers_;
+    ProductionHierarchy hierarchy_;
 };
 
 #endif // EXCELEXPORTER_H
@@ -1,5 +1,340 @@
 #include "ExcelImporter.h"
+#include "XlsxReader.h"
+#include "BatchWriter.h"
+#include "HierarchyUpserter.h"
+#include "ValidationHelper.h"
 #include "Logger.h"
+#include "../core/Constants.h"
+#include "../database/DatabaseManager.h"
+#include "../database/EngineerRepository.h"
+#include "../database/ProductionRepository.h"
+#include "../database/AssessmentRepository.h"
+#include <QThread>
+#include <QHash>
+#include <QSet>
+#include <QElapsedTimer>
+
+namespace {
+
+// ============================================================================
+// Pipeline
+// ============================================================================
+
+struct SheetRow {
+    int number = 0;
+    QStringList cells;
+};
+
+/**
+ * @brief What a sheet import does at each stage
+ *
+ * validate and finish run on the validation thread, write on the writer
+ * thread; each may keep state of its own between calls.
+ */
+template <typename Record>
+struct SheetPipeline {
+    // Turn one row into records, or append what is wrong with it
+    std::function<void(const SheetRow& row, QList<Record>& records, QStringList& errors)> validate;
+    // After the last row (e.g. to report a missing header)
+    std::function<void(QStringList& errors)> finish;
+    // Upsert one batch in a transaction (see BatchWriter)
+    typename BatchWriter<Record>::WriteFunction write;
+};
+
+class ErrorLog
+{
+public:
+    explicit ErrorLog(const QString& sheet) : sheet_(sheet), count_(0) {}
+
+    void add(int row, const QString& error)
+    {
+        if (++count_ <= Constants::IMPORT_MAX_ERRORS) {
+            messages_.append(row > 0 ? QString("%1 row %2: %3").arg(sheet_).arg(row).arg(error)
+                                     : QString("%1: %2").arg(sheet_, error));
+        }
+    }
+
+    int count() const { return count_; }
+    const QStringList& messages() const { return messages_; }
+
+private:
+    QString sheet_;
+    int count_;
+    QStringList messages_;
+};
+
+/**
+ * @brief Stream a sheet through parse -> validate -> write
+ * @return false if the sheet could not be read completely or a batch failed to commit
+ */
+template <typename Record>
+bool runPipeline(XlsxReader& reader, const QString& sheet, const SheetPipeline<Record>& pipeline,
+                 const ExcelImporter::ProgressCallback& progress, ExcelImporter::ImportResult& result)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    BoundedQueue<QList<SheetRow>> rows(Constants::IMPORT_QUEUE_DEPTH);
+
+    // Each log is owned by one stage until the threads are joined
+    ErrorLog validationLog(sheet);
+    ErrorLog writeLog(sheet);
+    int recordsValidated = 0;
+
+    BatchWriter<Record> writer(pipeline.write, [&writeLog](int firstRow, int lastRow, const QString& error) {
+        writeLog.add(0, QString("rows %1-%2 not saved: %3").arg(firstRow).arg(lastRow).arg(error));
+    });
+
+    QThread* validator = QThread::create([&]() {
+        QList<SheetRow> chunk;
+        QList<Record> records;
+        QStringList rowErrors;
+
+        while (rows.pop(chunk)) {
+            for (const SheetRow& row : chunk) {
+                records.clear();
+                rowErrors.clear();
+                pipeline.validate(row, records, rowErrors);
+                for (const QString& error : rowErrors) {
+                    validationLog.add(row.number, error);
+                }
+                for (Record& record : records) {
+                    writer.add(row.number, std::move(record));
+                }
+                recordsValidated += records.size();
+            }
+        }
+
+        if (pipeline.finish) {
+            rowErrors.clear();
+            pipeline.finish(rowErrors);
+            for (const QString& error : rowErrors) {
+                validationLog.add(0, error);
+            }
+        }
+        writer.close();
+    });
+
+    validator->start();
+
+    // Parse on this thread, handing rows over in chunks
+    int rowsRead = 0;
+    QList<SheetRow> chunk;
+    chunk.reserve(Constants::IMPORT_CHUNK_ROWS);
+
+    bool readOk = reader.readSheet(sheet, [&](int rowNumber, const QStringList& cells) {
+        bool blank = true;
+        for (const QString& cell : cells) {
+            if (!cell.trimmed().isEmpty()) {
+                blank = false;
+                break;
+            }
+        }
+        ++rowsRead;
+        if (blank) {
+            return true;
+        }
+
+        chunk.append(SheetRow{rowNumber, cells});
+        if (chunk.size() >= Constants::IMPORT_CHUNK_ROWS) {
+            if (!rows.push(std::move(chunk))) {
+                return false;
+            }
+            chunk = QList<SheetRow>();
+            chunk.reserve(Constants::IMPORT_CHUNK_ROWS);
+            if (progress) {
+                progress(sheet, rowsRead, writer.written());
+            }
+        }
+        return true;
+    });
+
+    if (!chunk.isEmpty()) {
+        rows.push(std::move(chunk));
+    }
+    rows.close();
+
+    validator->wait();
+    writer.wait();
+    delete validator;
+
+    if (progress) {
+        progress(sheet, rowsRead, writer.written());
+    }
+
+    result.recordsProcessed += recordsValidated + validationLog.count();
+    result.recordsSuccessful += writer.written();
+    result.errors.append(validationLog.messages());
+    result.errors.append(writeLog.messages());
+    if (!readOk) {
+        result.errors.append(QString("%1: %2").arg(sheet, reader.lastError()));
+    }
+
+    int errorCount = validationLog.count() + writeLog.count();
+    if (errorCount > validationLog.messages().size() + writeLog.messages().size()) {
+        result.errors.append(QString("%1: %2 errors in total").arg(sheet).arg(errorCount));
+    }
+
+    Logger::instance().info("ExcelImporter", QString("%1: %2 rows read, %3 records saved, %4 errors in %5 ms")
+        .arg(sheet).arg(rowsRead).arg(writer.written()).arg(errorCount).arg(timer.elapsed()));
+
+    return readOk && writeLog.count() == 0;
+}
+
+// ============================================================================
+// Cell helpers
+// ============================================================================
+
+/**
+ * @brief Column positions by (lower-case) header text
+ */
+class HeaderMap
+{
+public:
+    void read(const QStringList& cells)
+    {
+        for (int i = 0; i < cells.size(); ++i) {
+            QString key = cells[i].trimmed().toLower();
+            if (!key.isEmpty() && !columns_.contains(key)) {
+                columns_.insert(key, i);
+            }
+        }
+    }
+
+    int column(std::initializer_list<const char*> names) const
+    {
+        for (const char* name : names) {
+            int index = columns_.value(QString::fromLatin1(name), -1);
+            if (index >= 0) {
+                return index;
+            }
+        }
+        return -1;
+    }
+
+private:
+    QHash<QString, int> columns_;
+};
+
+QString cellText(const QStringList& cells, int column)
+{
+    return column >= 0 && column < cells.size() ? cells[column].trimmed() : QString();
+}
+
+QString nameKey(const QString& name)
+{
+    return name.trimmed().toLower();
+}
+
+QString columnLetters(int column)
+{
+    QString letters;
+    for (int n = column + 1; n > 0; n = (n - 1) / 26) {
+        letters.prepend(QChar('A' + (n - 1) % 26));
+    }
+    return letters;
+}
+
+// ============================================================================
+// Production hierarchy
+// ============================================================================
+
+struct ProductionRow {
+    QString area;
+    QString machine;       // empty for an area row
+    QString competency;    // empty for an area or machine row
+    int importance = 0;    // 0 = leave as is / default
+    int maxScore = 0;      // 0 = leave as is / default
+};
+
+bool upsertRow(HierarchyUpserter& upserter, const ProductionRow& row, QString& error)
+{
+    int areaId = upserter.area(row.area, error);
+    if (areaId <= 0 || row.machine.isEmpty()) {
+        return areaId > 0;
+    }
+    int machineId = upserter.machine(areaId, row.machine, row.competency.isEmpty() ? row.importance : 0, error);
+    if (machineId <= 0 || row.competency.isEmpty()) {
+        return machineId > 0;
+    }
+    return upserter.competency(machineId, row.competency, row.maxScore, error) > 0;
+}
+
+/**
+ * @brief Resolves competencies by id or by (area, machine, name) (read-only, any thread)
+ */
+class CompetencyLookup
+{
+public:
+    explicit CompetencyLookup(const ProductionHierarchy& hierarchy)
+        : hierarchy_(hierarchy)
+    {
+        for (const Competency& competency : hierarchy_.competencies()) {
+            Machine machine = hierarchy_.machine(competency.machineId());
+            QString area = nameKey(hierarchy_.area(machine.productionAreaId()).name());
+            byPath_.insert(area + '|' + nameKey(machine.name()) + '|' + nameKey(competency.name()), competency.id());
+            byName_[nameKey(competency.name())].append(competency.id());
+        }
+    }
+
+    /**
+     * @brief Competency id, or 0 with a reason if unknown or ambiguous
+     *
+     * Without area and machine, the name alone must be unique.
+     */
+    int find(const QString& area, const QString& machine, const QString& name, QString& error) const
+    {
+        if (!area.isEmpty() && !machine.isEmpty()) {
+            int id = byPath_.value(nameKey(area) + '|' + nameKey(machine) + '|' + nameKey(name), 0);
+            if (id == 0) {
+                error = QString("unknown competency '%1 / %2 / %3'").arg(area, machine, name);
+            }
+            return id;
+        }
+
+        QList<int> ids = byName_.value(nameKey(name));
+        if (ids.size() == 1) {
+            return ids.first();
+        }
+        error = ids.isEmpty() ? QString("unknown competency '%1'").arg(name)
+                              : QString("competency '%1' exists on several machines; add area and machine").arg(name);
+        return 0;
+    }
+
+    const ProductionHierarchy& hierarchy() const { return hierarchy_; }
+
+private:
+    const ProductionHierarchy& hierarchy_;
+    QHash<QString, int> byPath_;
+    QHash<QString, QList<int>> byName_;
+};
+
+/**
+ * @brief Validate a score cell and build the assessment
+ */
+bool makeAssessment(const QString& engineerId, int competencyId, const QString& scoreText,
+                    const CompetencyLookup& lookup, Assessment& assessment, QString& error)
+{
+    const ProductionHierarchy& hierarchy = lookup.hierarchy();
+    Competency competency = hierarchy.competency(competencyId);
+
+    int score = 0;
+    if (!ValidationHelper::parseWhole(scoreText.toLatin1(), score)
+        || !ValidationHelper::isValidScore(score, competency.maxScore())) {
+        error = QString("score '%1' for %2 must be 0-%3").arg(scoreText, competency.name()).arg(competency.maxScore());
+        return false;
+    }
+
+    assessment = Assessment(0, engineerId, hierarchy.areaIdForCompetency(competencyId),
+                            competency.machineId(), competencyId, score);
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// ExcelImporter
+// ============================================================================
 
 ExcelImporter::ExcelImporter()
 {
@@ -11,44 +346,435 @@ ExcelImporter::~ExcelImporter()
 
 ExcelImporter::ImportResult ExcelImporter::importEngineers(const QString& filePath)
 {
-    // TODO: Implement using QXlsx
-    Logger::instance().warning("ExcelImporter", "Import engineers not yet implemented");
-
     ImportResult result;
-    result.success = false;
-    result.errors << "Excel import not yet implemented (Phase 5 feature)";
+    XlsxReader reader;
+    if (openWorkbook(reader, filePath, result)) {
+        importEngineerSheet(reader, result);
+    }
+    finish(result, "engineers");
     return result;
 }
 
 ExcelImporter::ImportResult ExcelImporter::importProductionAreas(const QString& filePath)
 {
-    // TODO: Implement using QXlsx
-    Logger::instance().warning("ExcelImporter", "Import production areas not yet implemented");
-
     ImportResult result;
-    result.success = false;
-    result.errors << "Excel import not yet implemented (Phase 5 feature)";
+    XlsxReader reader;
+    if (openWorkbook(reader, filePath, result)) {
+        importProductionSheets(reader, result);
+    }
+    finish(result, "production areas");
     return result;
 }
 
 ExcelImporter::ImportResult ExcelImporter::importAssessments(const QString& filePath)
 {
-    // TODO: Implement using QXlsx
-    Logger::instance().warning("ExcelImporter", "Import assessments not yet implemented");
-
     ImportResult result;
-    result.success = false;
-    result.errors << "Excel import not yet implemented (Phase 5 feature)";
+    XlsxReader reader;
+    if (openWorkbook(reader, filePath, result)) {
+        importAssessmentSheet(reader, result);
+    }
+    finish(result, "assessments");
     return result;
 }
 
 ExcelImporter::ImportResult ExcelImporter::importAll(const QString& filePath)
 {
-    // TODO: Implement using QXlsx
-    Logger::instance().warning("ExcelImporter", "Import all not yet implemented");
-
+    // Parents first, so later sheets can refer to what earlier ones created
     ImportResult result;
-    result.success = false;
-    result.errors << "Excel import not yet implemented (Phase 5 feature)";
+    XlsxReader reader;
+    if (openWorkbook(reader, filePath, result)) {
+        if (!reader.findSheet("Engineers").isEmpty()) {
+            importEngineerSheet(reader, result);
+        }
+        importProductionSheets(reader, result);
+        importAssessmentSheet(reader, result);
+    }
+    finish(result, "all data");
     return result;
 }
+
+bool ExcelImporter::openWorkbook(XlsxReader& reader, const QString& filePath, ImportResult& result)
+{
+    result.success = reader.open(filePath);
+    if (!result.success) {
+        result.errors << reader.lastError();
+    }
+    return result.success;
+}
+
+void ExcelImporter::importEngineerSheet(XlsxReader& reader, ImportResult& result)
+{
+    QString sheet = reader.findSheet("Engineers");
+    if (sheet.isEmpty()) {
+        result.errors << "No Engineers sheet in workbook";
+        result.success = false;
+        return;
+    }
+
+    HeaderMap header;
+    bool haveHeader = false;
+    int idColumn = -1;
+    int nameColumn = -1;
+    int shiftColumn = -1;
+
+    SheetPipeline<Engineer> pipeline;
+    pipeline.validate = [&](const SheetRow& row, QList<Engineer>& records, QStringList& errors) {
+        if (!haveHeader) {
+            header.read(row.cells);
+            idColumn = header.column({"id", "engineer id"});
+            nameColumn = header.column({"name", "engineer", "engineer name"});
+            shiftColumn = header.column({"shift"});
+            haveHeader = true;
+            if (nameColumn < 0 || shiftColumn < 0) {
+                errors << "header must have Name and Shift columns";
+            }
+            return;
+        }
+        if (nameColumn < 0 || shiftColumn < 0) {
+            return;
+        }
+
+        Engineer engineer(cellText(row.cells, idColumn),
+                          ValidationHelper::sanitize(cellText(row.cells, nameColumn)),
+                          cellText(row.cells, shiftColumn));
+        QString error;
+        if (!ValidationHelper::validateRequired(engineer.name(), "Name", error)
+            || !ValidationHelper::validateLength(engineer.name(), 1, 100, "Name", error)
+            || !ValidationHelper::validateRequired(engineer.shift(), "Shift", error)
+            || !ValidationHelper::validateLength(engineer.id(), 0, 50, "ID", error)) {
+            errors << error;
+            return;
+        }
+        records.append(engineer);
+    };
+
+    pipeline.write = BatchWriter<Engineer>::saveOrUpdateBatch<EngineerRepository>();
+
+    if (!runPipeline(reader, sheet, pipeline, progress_, result)) {
+        result.success = false;
+    }
+}
+
+void ExcelImporter::importProductionSheets(XlsxReader& reader, ImportResult& result)
+{
+    const QStringList sheetNames = {"Production Areas", "Machines", "Competencies"};
+
+    QStringList sheets;
+    for (const QString& name : sheetNames) {
+        QString sheet = reader.findSheet(name);
+        if (!sheet.isEmpty()) {
+            sheets << sheet;
+        }
+    }
+    if (sheets.isEmpty()) {
+        return;
+    }
+
+    ProductionRepository productionRepo;
+    ProductionHierarchy hierarchy = productionRepo.loadHierarchy();
+    if (!productionRepo.lastError().isEmpty()) {
+        result.errors << "Failed to load production areas: " + productionRepo.lastError();
+        result.success = false;
+        return;
+    }
+
+    // Shared by the sheets' writer stages, which run one after another
+    HierarchyUpserter upserter(hierarchy);
+
+    for (const QString& sheet : sheets) {
+        HeaderMap header;
+        bool haveHeader = false;
+        int areaColumn = -1;
+        int machineColumn = -1;
+        int competencyColumn = -1;
+        int importanceColumn = -1;
+        int maxScoreColumn = -1;
+        bool isAreas = sheet.compare("Production Areas", Qt::CaseInsensitive) == 0;
+        bool isMachines = sheet.compare("Machines", Qt::CaseInsensitive) == 0;
+
+        SheetPipeline<ProductionRow> pipeline;
+        pipeline.validate = [&](const SheetRow& row, QList<ProductionRow>& records, QStringList& errors) {
+            if (!haveHeader) {
+                header.read(row.cells);
+                haveHeader = true;
+                if (isAreas) {
+                    areaColumn = header.column({"name", "production area"});
+                } else if (isMachines) {
+                    areaColumn = header.column({"production area", "area"});
+                    machineColumn = header.column({"name", "machine"});
+                    importanceColumn = header.column({"importance"});
+                } else {
+                    areaColumn = header.column({"production area", "area"});
+                    machineColumn = header.column({"machine"});
+                    competencyColumn = header.column({"name", "competency"});
+                    maxScoreColumn = header.column({"max score"});
+                }
+                if (areaColumn < 0 || (!isAreas && machineColumn < 0) || (!isAreas && !isMachines && competencyColumn < 0)) {
+                    areaColumn = -1;
+                    errors << "header is missing a name column";
+                }
+                return;
+            }
+            if (areaColumn < 0) {
+                return;
+            }
+
+            ProductionRow record;
+            record.area = ValidationHelper::sanitize(cellText(row.cells, areaColumn));
+            record.machine = ValidationHelper::sanitize(cellText(row.cells, machineColumn));
+            record.competency = ValidationHelper::sanitize(cellText(row.cells, competencyColumn));
+
+            QString error;
+            if (!ValidationHelper::validateRequired(record.area, "Production Area", error)
+                || !ValidationHelper::validateLength(record.area, 1, 100, "Production Area", error)
+                || (machineColumn >= 0 && (!ValidationHelper::validateRequired(record.machine, "Machine", error)
+                                           || !ValidationHelper::validateLength(record.machine, 1, 100, "Machine", error)))
+                || (competencyColumn >= 0 && (!ValidationHelper::validateRequired(record.competency, "Competency", error)
+                                              || !ValidationHelper::validateLength(record.competency, 1, 200, "Competency", error)))) {
+                errors << error;
+                return;
+            }
+
+            QString importance = cellText(row.cells, importanceColumn);
+            if (!importance.isEmpty()) {
+                if (!ValidationHelper::parseWhole(importance.toLatin1(), record.importance)
+                    || (record.importance != 0 && !ValidationHelper::isValidImportance(record.importance))) {
+                    errors << QString("importance '%1' must be 1-10").arg(importance);
+                    return;
+                }
+            }
+
+            QString maxScore = cellText(row.cells, maxScoreColumn);
+            if (!maxScore.isEmpty()) {
+                if (!ValidationHelper::parseWhole(maxScore.toLatin1(), record.maxScore)
+                    || !ValidationHelper::validateRange(record.maxScore, 1, Constants::SCORE_MAX, "Max Score", error)) {
+                    errors << (error.isEmpty() ? QString("max score '%1' is not a number").arg(maxScore) : error);
+                    return;
+                }
+            }
+
+            records.append(record);
+        };
+
+        pipeline.write = [&upserter](QList<ProductionRow>& records, QString& error) {
+            DatabaseManager& dbManager = DatabaseManager::instance();
+            if (!dbManager.beginTransaction()) {
+                error = dbManager.lastError();
+                return false;
+            }
+
+            for (const ProductionRow& record : records) {
+                if (!upsertRow(upserter, record, error)) {
+                    dbManager.rollback();
+                    upserter.rollback();
+                    return false;
+                }
+            }
+
+            if (!dbManager.commit()) {
+                error = dbManager.lastError();
+                dbManager.rollback();
+                upserter.rollback();
+                return false;
+            }
+            upserter.commit();
+            return true;
+        };
+
+        if (!runPipeline(reader, sheet, pipeline, progress_, result)) {
+            result.success = false;
+        }
+    }
+}
+
+void ExcelImporter::importAssessmentSheet(XlsxReader& reader, ImportResult& result)
+{
+    // A skill matrix grid wins over the long list (the exporter writes both)
+    QString sheet = reader.findSheet("Skill Matrix");
+    bool isMatrix = !sheet.isEmpty();
+    if (!isMatrix) {
+        sheet = reader.findSheet("Assessments");
+    }
+    if (sheet.isEmpty()) {
+        bool knownSheets = !reader.findSheet("Engineers").isEmpty() || !reader.findSheet("Production Areas").isEmpty()
+            || !reader.findSheet("Machines").isEmpty() || !reader.findSheet("Competencies").isEmpty();
+        if (knownSheets || reader.sheetNames().isEmpty()) {
+            return;
+        }
+        sheet = reader.sheetNames().first();
+        isMatrix = true;
+    }
+
+    // Loaded after engineers and production sheets, so it includes what they created
+    EngineerRepository engineerRepo;
+    QSet<QString> engineerIds;
+    for (const Engineer& engineer : engineerRepo.findAll()) {
+        engineerIds.insert(engineer.id());
+    }
+    ProductionRepository productionRepo;
+    ProductionHierarchy hierarchy = productionRepo.loadHierarchy();
+    if (!engineerRepo.lastError().isEmpty() || !productionRepo.lastError().isEmpty()) {
+        result.errors << "Failed to load reference data: " + engineerRepo.lastError() + productionRepo.lastError();
+        result.success = false;
+        return;
+    }
+    const CompetencyLookup lookup(hierarchy);
+
+    SheetPipeline<Assessment> pipeline;
+
+    // Validation state (validation thread only)
+    bool haveHeader = false;
+    int engineerColumn = -1;
+    int competencyIdColumn = -1;
+    int areaColumn = -1;
+    int machineColumn = -1;
+    int competencyColumn = -1;
+    int scoreColumn = -1;
+    QStringList areaByColumn;
+    QStringList machineByColumn;
+    QHash<int, int> competencyByColumn;
+
+    if (isMatrix) {
+        // Optional "Production Area" / "Machine" rows, then the "Engineer ID" header row
+        auto fillForward = [](const QStringList& cells) {
+            // Merged header cells only carry text in their first column
+            QStringList filled;
+            QString last;
+            for (int i = 1; i < cells.size(); ++i) {
+                QString text = cells[i].trimmed();
+                if (!text.isEmpty()) {
+                    last = text;
+                }
+                filled << last;
+            }
+            filled.prepend(QString());
+            return filled;
+        };
+
+        pipeline.validate = [&, fillForward](const SheetRow& row, QList<Assessment>& records, QStringList& errors) {
+            QString first = nameKey(cellText(row.cells, 0));
+
+            if (!haveHeader) {
+                if (first == "production area" || first == "area") {
+                    areaByColumn = fillForward(row.cells);
+                } else if (first == "machine") {
+                    machineByColumn = fillForward(row.cells);
+                } else if (first == "engineer id" || first == "employee id" || first == "id") {
+                    haveHeader = true;
+                    engineerColumn = 0;
+                    for (int column = 1; column < row.cells.size(); ++column) {
+                        QString name = row.cells[column].trimmed();
+                        QString key = nameKey(name);
+                        if (key.isEmpty() || key == "engineer" || key == "name" || key == "engineer name" || key == "shift") {
+                            continue;
+                        }
+                        QString error;
+                        int id = lookup.find(cellText(areaByColumn, column), cellText(machineByColumn, column), name, error);
+                        if (id > 0) {
+                            competencyByColumn.insert(column, id);
+                        } else {
+                            errors << QString("column %1: %2").arg(columnLetters(column), error);
+                        }
+                    }
+                }
+                return;  // anything above the header (titles, notes) is ignored
+            }
+
+            QString engineerId = cellText(row.cells, engineerColumn);
+            if (!engineerIds.contains(engineerId)) {
+                errors << QString("unknown engineer '%1'").arg(engineerId);
+                return;
+            }
+
+            for (auto it = competencyByColumn.constBegin(); it != competencyByColumn.constEnd(); ++it) {
+                QString scoreText = cellText(row.cells, it.key());
+                if (scoreText.isEmpty()) {
+                    continue;
+                }
+                Assessment assessment;
+                QString error;
+                if (makeAssessment(engineerId, it.value(), scoreText, lookup, assessment, error)) {
+                    records.append(assessment);
+                } else {
+                    errors << QString("column %1: %2").arg(columnLetters(it.key()), error);
+                }
+            }
+        };
+    } else {
+        pipeline.validate = [&](const SheetRow& row, QList<Assessment>& records, QStringList& errors) {
+            if (!haveHeader) {
+                HeaderMap header;
+                header.read(row.cells);
+                haveHeader = true;
+                engineerColumn = header.column({"engineer id"});
+                competencyIdColumn = header.column({"competency id"});
+                areaColumn = header.column({"production area", "area"});
+                machineColumn = header.column({"machine"});
+                competencyColumn = header.column({"competency"});
+                scoreColumn = header.column({"score"});
+                if (engineerColumn < 0 || scoreColumn < 0 || (competencyIdColumn < 0 && competencyColumn < 0)) {
+                    engineerColumn = -1;
+                    errors << "header must have Engineer ID, Competency and Score columns";
+                }
+                return;
+            }
+            if (engineerColumn < 0) {
+                return;
+            }
+
+            QString engineerId = cellText(row.cells, engineerColumn);
+            if (!engineerIds.contains(engineerId)) {
+                errors << QString("unknown engineer '%1'").arg(engineerId);
+                return;
+            }
+
+            QString error;
+            int competencyId = 0;
+            QString idText = cellText(row.cells, competencyIdColumn);
+            if (!idText.isEmpty()) {
+                if (!ValidationHelper::parseWhole(idText.toLatin1(), competencyId)
+                    || !hierarchy.containsCompetency(competencyId)) {
+                    errors << QString("unknown competency id '%1'").arg(idText);
+                    return;
+                }
+            } else {
+                competencyId = lookup.find(cellText(row.cells, areaColumn), cellText(row.cells, machineColumn),
+                                           cellText(row.cells, competencyColumn), error);
+                if (competencyId == 0) {
+                    errors << error;
+                    return;
+                }
+            }
+
+            Assessment assessment;
+            if (!makeAssessment(engineerId, competencyId, cellText(row.cells, scoreColumn), lookup, assessment, error)) {
+                errors << error;
+                return;
+            }
+            records.append(assessment);
+        };
+    }
+
+    pipeline.finish = [&](QStringList& errors) {
+        if (!haveHeader) {
+            errors << (isMatrix ? "no header row starting with Engineer ID" : "sheet is empty");
+        }
+    };
+
+    pipeline.write = BatchWriter<Assessment>::saveOrUpdateBatch<AssessmentRepository>();
+
+    if (!runPipeline(reader, sheet, pipeline, progress_, result)) {
+        result.success = false;
+    }
+}
+
+void ExcelImporter::finish(ImportResult& result, const QString& what)
+{
+    QString summary = QString("Imported %1: %2 of %3 records saved, %4 errors")
+        .arg(what).arg(result.recordsSuccessful).arg(result.recordsProcessed).arg(result.errors.size());
+    if (result.success) {
+        Logger::instance().info("ExcelImporter", summary);
+    } else {
+        Logger::instance().warning("ExcelImporter", summary);
+    }
+}
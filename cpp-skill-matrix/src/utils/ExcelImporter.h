@@ -3,11 +3,25 @@
 
 #include <QString>
 #include <QStringList>
+#include <functional>
+
+class XlsxReader;
 
 /**
- * @brief Excel file importer (Phase 5 implementation)
+ * @brief Excel (.xlsx) importer
+ *
+ * Each sheet runs through a three-stage pipeline: the calling thread
+ * streams rows out of the workbook (XlsxReader), a validation thread turns
+ * them into records and checks them with ValidationHelper, and a writer
+ * thread upserts them in batched transactions on its own pooled connection.
+ * The stages are joined by bounded queues, so a large sheet never sits in
+ * memory and parsing overlaps the database round trips.
  *
- * TODO: Implement using QXlsx library
+ * Reads the layouts ExcelExporter writes: "Engineers", "Production Areas",
+ * "Machines", "Competencies", and assessments either as an "Assessments"
+ * list or a "Skill Matrix" grid (engineers down, competencies across,
+ * optionally under area and machine header rows). A workbook with none of
+ * these sheets is read as a skill matrix from its first sheet.
  */
 class ExcelImporter
 {
@@ -19,21 +33,37 @@ public:
         bool success = false;
     };
 
+    /**
+     * @brief Progress callback, invoked on the importing thread
+     * @param rowsRead Sheet rows parsed so far in the current sheet
+     * @param recordsWritten Records committed so far in the current sheet
+     */
+    using ProgressCallback = std::function<void(const QString& sheet, int rowsRead, int recordsWritten)>;
+
     ExcelImporter();
     ~ExcelImporter();
 
+    void setProgressCallback(const ProgressCallback& callback) { progress_ = callback; }
+
     /**
      * @brief Import engineers from Excel file
+     *
+     * Rows with a known ID update the engineer; others are created.
      */
     ImportResult importEngineers(const QString& filePath);
 
     /**
      * @brief Import production areas from Excel file
+     *
+     * Areas, machines and competencies are matched by name within their
+     * parent; missing ones are created, and importance / max score updated.
      */
     ImportResult importProductionAreas(const QString& filePath);
 
     /**
      * @brief Import assessments from Excel file
+     *
+     * Engineers and competencies must already exist; scores are upserted.
      */
     ImportResult importAssessments(const QString& filePath);
 
@@ -43,7 +73,14 @@ public:
     ImportResult importAll(const QString& filePath);
 
 private:
-    // TODO: Add QXlsx members
+    bool openWorkbook(XlsxReader& reader, const QString& filePath, ImportResult& result);
+    void importEngineerSheet(XlsxReader& reader, ImportResult& result);
+    void importProductionSheets(XlsxReader& reader, ImportResult& result);
+    void importAssessmentSheet(XlsxReader& reader, ImportResult& result);
+    static void finish(ImportResult& result, const QString& what);
+
+private:
+    ProgressCallback progress_;
 };
 
 #endif // EXCELIMPORTER_H
@@ -0,0 +1,97 @@
+#include "HierarchyUpserter.h"
+#include "../core/Constants.h"
+
+HierarchyUpserter::HierarchyUpserter(const ProductionHierarchy& hierarchy)
+{
+    for (const ProductionArea& area : hierarchy.areas()) {
+        areas_.insert(nameKey(area.name()), area.id());
+    }
+    for (const Machine& machine : hierarchy.machines()) {
+        machines_.insert(machineKey(machine.productionAreaId(), machine.name()), machine);
+    }
+    for (const Competency& competency : hierarchy.competencies()) {
+        competencies_.insert(competencyKey(competency.machineId(), competency.name()), competency);
+    }
+}
+
+int HierarchyUpserter::area(const QString& name, QString& error)
+{
+    QString key = nameKey(name);
+    int id = pendingAreas_.value(key, areas_.value(key, 0));
+    if (id > 0) {
+        return id;
+    }
+
+    ProductionArea area(0, name.trimmed());
+    if (!repo_.saveArea(area)) {
+        error = repo_.lastError();
+        return 0;
+    }
+    pendingAreas_.insert(key, area.id());
+    return area.id();
+}
+
+int HierarchyUpserter::machine(int areaId, const QString& name, int importance, QString& error)
+{
+    QString key = machineKey(areaId, name);
+    Machine machine = pendingMachines_.value(key, machines_.value(key));
+    if (machine.id() > 0) {
+        if (importance > 0 && importance != machine.importance()) {
+            machine.setImportance(importance);
+            if (!repo_.updateMachine(machine)) {
+                error = repo_.lastError();
+                return 0;
+            }
+            pendingMachines_.insert(key, machine);
+        }
+        return machine.id();
+    }
+
+    machine = Machine(0, areaId, name.trimmed(), importance);
+    if (!repo_.saveMachine(machine)) {
+        error = repo_.lastError();
+        return 0;
+    }
+    pendingMachines_.insert(key, machine);
+    return machine.id();
+}
+
+int HierarchyUpserter::competency(int machineId, const QString& name, int maxScore, QString& error)
+{
+    QString key = competencyKey(machineId, name);
+    Competency competency = pendingCompetencies_.value(key, competencies_.value(key));
+    if (competency.id() > 0) {
+        if (maxScore > 0 && maxScore != competency.maxScore()) {
+            competency.setMaxScore(maxScore);
+            if (!repo_.updateCompetency(competency)) {
+                error = repo_.lastError();
+                return 0;
+            }
+            pendingCompetencies_.insert(key, competency);
+        }
+        return competency.id();
+    }
+
+    competency = Competency(0, machineId, name.trimmed(), maxScore > 0 ? maxScore : Constants::SCORE_MAX);
+    if (!repo_.saveCompetency(competency)) {
+        error = repo_.lastError();
+        return 0;
+    }
+    pendingCompetencies_.insert(key, competency);
+    return competency.id();
+}
+
+void HierarchyUpserter::commit()
+{
+    areas_.insert(pendingAreas_);
+    machines_.insert(pendingMachines_);
+    competencies_.insert(pendingCompetencies_);
+    rollback();
+}
+
+void HierarchyUpserter::rollback()
+{
+    pendingAreas_.clear();
+    pendingMachines_.clear();
+    pendingCompetencies_.clear();
+}
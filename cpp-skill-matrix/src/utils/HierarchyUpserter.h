@@ -0,0 +1,70 @@
+#ifndef HIERARCHYUPSERTER_H
+#define HIERARCHYUPSERTER_H
+
+#include "../models/ProductionHierarchy.h"
+#include "../database/ProductionRepository.h"
+#include <QString>
+#include <QHash>
+
+/**
+ * @brief What an assessment needs from its competency
+ *
+ * Importers resolve file or sheet competency references to one of these.
+ */
+struct CompetencyRef {
+    int areaId = 0;
+    int machineId = 0;
+    int competencyId = 0;
+    int maxScore = 0;
+
+    static CompetencyRef of(const ProductionHierarchy& hierarchy, const Competency& competency)
+    {
+        CompetencyRef ref;
+        ref.areaId = hierarchy.areaIdForCompetency(competency.id());
+        ref.machineId = competency.machineId();
+        ref.competencyId = competency.id();
+        ref.maxScore = competency.maxScore();
+        return ref;
+    }
+};
+
+/**
+ * @brief Finds or creates areas, machines and competencies by name
+ *
+ * Names are matched case-insensitively within their parent. Missing rows
+ * are created through ProductionRepository on the calling thread's
+ * connection; importance / max score are updated when given (> 0) and
+ * different. Meant to run inside the caller's transaction: ids created or
+ * changed since the last commit() are held apart, so rollback() after a
+ * rolled-back transaction leaves no references to rows that do not exist.
+ *
+ * Each method returns the id, or 0 with error set.
+ */
+class HierarchyUpserter
+{
+public:
+    explicit HierarchyUpserter(const ProductionHierarchy& hierarchy);
+
+    int area(const QString& name, QString& error);
+    int machine(int areaId, const QString& name, int importance, QString& error);
+    int competency(int machineId, const QString& name, int maxScore, QString& error);
+
+    void commit();
+    void rollback();
+
+    // Match keys: case-insensitive name within the parent
+    static QString nameKey(const QString& name) { return name.trimmed().toLower(); }
+    static QString machineKey(int areaId, const QString& name) { return QString::number(areaId) + '|' + nameKey(name); }
+    static QString competencyKey(int machineId, const QString& name) { return QString::number(machineId) + '|' + nameKey(name); }
+
+private:
+    ProductionRepository repo_;
+    QHash<QString, int> areas_;
+    QHash<QString, Machine> machines_;
+    QHash<QString, Competency> competencies_;
+    QHash<QString, int> pendingAreas_;
+    QHash<QString, Machine> pendingMachines_;
+    QHash<QString, Competency> pendingCompetencies_;
+};
+
+#endif // HIERARCHYUPSERTER_H
@@ -0,0 +1,245 @@
+#include "JsonExporter.h"
+#include "JsonStreamWriter.h"
+#include "Logger.h"
+#include "../core/Constants.h"
+#include "../database/EngineerRepository.h"
+#include "../database/ProductionRepository.h"
+#include "../database/AssessmentRepository.h"
+#include "../database/CertificationRepository.h"
+#include "../database/CoreSkillsRepository.h"
+#include <QSaveFile>
+#include <QHash>
+#include <QElapsedTimer>
+
+JsonExporter::JsonExporter()
+    : recordsWritten_(0)
+{
+}
+
+JsonExporter::~JsonExporter()
+{
+}
+
+bool JsonExporter::exportAll(const QString& filePath)
+{
+    lastError_.clear();
+    recordsWritten_ = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Reference data is small; the per-engineer tables are streamed below
+    EngineerRepository engineerRepo;
+    QList<Engineer> engineers = engineerRepo.findAll();
+    if (!engineerRepo.lastError().isEmpty()) {
+        return fail("Failed to load engineers: " + engineerRepo.lastError());
+    }
+
+    ProductionRepository productionRepo;
+    ProductionHierarchy hierarchy = productionRepo.loadHierarchy();
+    if (!productionRepo.lastError().isEmpty()) {
+        return fail("Failed to load production areas: " + productionRepo.lastError());
+    }
+
+    CoreSkillsRepository coreSkillsRepo;
+    QList<CoreSkillCategory> categories = coreSkillsRepo.findAllCategories();
+    QList<CoreSkill> skills = coreSkillsRepo.findAllSkills();
+    if (!coreSkillsRepo.lastError().isEmpty()) {
+        return fail("Failed to load core skills: " + coreSkillsRepo.lastError());
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return fail(QString("Cannot write %1: %2").arg(filePath, file.errorString()));
+    }
+
+    JsonStreamWriter json(&file);
+    qint64 records = 0;
+
+    json.beginObject();
+    json.key(u"version");
+    json.value(Constants::EXPORT_JSON_VERSION);
+    json.key(u"exportedAt");
+    json.value(QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs));
+
+    json.key(u"productionAreas");
+    json.beginArray();
+    for (const ProductionArea& area : hierarchy.areas()) {
+        json.beginObject();
+        json.key(u"id");
+        json.value(area.id());
+        json.key(u"name");
+        json.value(area.name());
+        json.key(u"machines");
+        json.beginArray();
+        for (const Machine& machine : hierarchy.machinesByArea(area.id())) {
+            json.beginObject();
+            json.key(u"id");
+            json.value(machine.id());
+            json.key(u"name");
+            json.value(machine.name());
+            json.key(u"importance");
+            json.value(machine.importance());
+            json.key(u"competencies");
+            json.beginArray();
+            for (const Competency& competency : hierarchy.competenciesByMachine(machine.id())) {
+                json.beginObject();
+                json.key(u"id");
+                json.value(competency.id());
+                json.key(u"name");
+                json.value(competency.name());
+                json.key(u"maxScore");
+                json.value(competency.maxScore());
+                json.endObject();
+            }
+            json.endArray();
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+    }
+    json.endArray();
+    records += hierarchy.areaCount() + hierarchy.machineCount() + hierarchy.competencyCount();
+
+    json.key(u"engineers");
+    json.beginArray();
+    for (const Engineer& engineer : engineers) {
+        json.beginObject();
+        json.key(u"id");
+        json.value(engineer.id());
+        json.key(u"name");
+        json.value(engineer.name());
+        json.key(u"shift");
+        json.value(engineer.shift());
+        json.endObject();
+    }
+    json.endArray();
+    records += engineers.size();
+
+    // Keyed like the web app: "engineerId-areaId-machineId-competencyId"
+    json.key(u"assessments");
+    json.beginObject();
+    AssessmentRepository assessmentRepo;
+    bool streamed = assessmentRepo.forEach([&](const Assessment& assessment) {
+        json.key(assessment.getKey());
+        json.beginObject();
+        json.key(u"score");
+        json.value(assessment.score());
+        json.key(u"lastUpdated");
+        json.value(assessment.updatedAt().toUTC().toString(Qt::ISODateWithMs));
+        json.endObject();
+        ++records;
+        return !json.hasError();
+    });
+    json.endObject();
+    if (!streamed) {
+        file.cancelWriting();
+        return fail("Failed to read assessments: " + assessmentRepo.lastError());
+    }
+
+    json.key(u"certifications");
+    json.beginArray();
+    CertificationRepository certificationRepo;
+    Page<Certification> page;
+    do {
+        page = certificationRepo.findPage(Constants::MAX_PAGE_SIZE, page.next);
+        if (!certificationRepo.lastError().isEmpty()) {
+            file.cancelWriting();
+            return fail("Failed to read certifications: " + certificationRepo.lastError());
+        }
+        for (const Certification& certification : page.items) {
+            json.beginObject();
+            json.key(u"id");
+            json.value(certification.id());
+            json.key(u"engineerId");
+            json.value(certification.engineerId());
+            json.key(u"name");
+            json.value(certification.name());
+            json.key(u"dateEarned");
+            json.value(certification.dateEarned().toString(Qt::ISODate));
+            json.key(u"expiryDate");
+            if (certification.expiryDate().isValid()) {
+                json.value(certification.expiryDate().toString(Qt::ISODate));
+            } else {
+                json.null();
+            }
+            json.endObject();
+        }
+        records += page.items.size();
+    } while (page.hasMore && !json.hasError());
+    json.endArray();
+
+    json.key(u"coreSkills");
+    json.beginObject();
+    json.key(u"categories");
+    json.beginArray();
+    for (const CoreSkillCategory& category : categories) {
+        json.beginObject();
+        json.key(u"id");
+        json.value(category.id());
+        json.key(u"name");
+        json.value(category.name());
+        json.key(u"skills");
+        json.beginArray();
+        for (const CoreSkill& skill : skills) {
+            if (skill.categoryId() != category.id()) {
+                continue;
+            }
+            json.beginObject();
+            json.key(u"id");
+            json.value(skill.id());
+            json.key(u"name");
+            json.value(skill.name());
+            json.key(u"maxScore");
+            json.value(skill.maxScore());
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+    }
+    json.endArray();
+    records += categories.size() + skills.size();
+
+    // Keyed like the web app: "engineerId-categoryId-skillId"
+    json.key(u"assessments");
+    json.beginObject();
+    streamed = coreSkillsRepo.forEachAssessment([&](const CoreSkillAssessment& assessment) {
+        json.key(assessment.engineerId() + '-' + assessment.categoryId() + '-' + assessment.skillId());
+        json.beginObject();
+        json.key(u"score");
+        json.value(assessment.score());
+        json.key(u"lastUpdated");
+        json.value(assessment.updatedAt().toUTC().toString(Qt::ISODateWithMs));
+        json.endObject();
+        ++records;
+        return !json.hasError();
+    });
+    json.endObject();
+    json.endObject();
+    if (!streamed) {
+        file.cancelWriting();
+        return fail("Failed to read core skill assessments: " + coreSkillsRepo.lastError());
+    }
+
+    json.endObject();
+
+    if (!json.flush()) {
+        file.cancelWriting();
+        return fail(QString("Failed to write %1: %2").arg(filePath, json.errorString()));
+    }
+    if (!file.commit()) {
+        return fail(QString("Failed to save %1: %2").arg(filePath, file.errorString()));
+    }
+
+    recordsWritten_ = records;
+    Logger::instance().info("JsonExporter", QString("Exported %1 records to %2 in %3 ms")
+        .arg(recordsWritten_).arg(filePath).arg(timer.elapsed()));
+    return true;
+}
+
+bool JsonExporter::fail(const QString& error)
+{
+    lastError_ = error;
+    Logger::instance().error("JsonExporter", error);
+    return false;
+}
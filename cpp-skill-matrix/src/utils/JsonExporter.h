@@ -0,0 +1,40 @@
+#ifndef JSONEXPORTER_H
+#define JSONEXPORTER_H
+
+#include <QString>
+
+/**
+ * @brief Full-dataset JSON exporter in the web app's data shape
+ *
+ * Writes the document production-data-import.json uses (productionAreas
+ * with nested machines and competencies, engineers, assessments keyed
+ * "engineer-area-machine-competency", certifications) plus the web app's
+ * coreSkills section. Users and snapshots are left out.
+ *
+ * Rows go from forward-only queries straight through JsonStreamWriter,
+ * so no QJsonDocument is built and memory does not grow with the data.
+ * Ids are the database ids; JsonImporter reads the file back.
+ *
+ * Uses the calling thread's database connection: wrap worker-thread exports
+ * in a ScopedConnection.
+ */
+class JsonExporter
+{
+public:
+    JsonExporter();
+    ~JsonExporter();
+
+    bool exportAll(const QString& filePath);
+
+    qint64 recordsWritten() const { return recordsWritten_; }
+    QString lastError() const { return lastError_; }
+
+private:
+    bool fail(const QString& error);
+
+private:
+    qint64 recordsWritten_;
+    QString lastError_;
+};
+
+#endif // JSONEXPORTER_H
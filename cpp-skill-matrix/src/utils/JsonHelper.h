@@ -10,6 +10,10 @@
 
 /**
  * @brief Helper class for JSON operations
+ *
+ * Builds and parses whole QJsonDocuments: meant for small documents such as
+ * settings and single records. Datasets go through JsonStreamWriter and
+ * JsonPullParser (JsonExporter / JsonImporter).
  */
 class JsonHelper
 {
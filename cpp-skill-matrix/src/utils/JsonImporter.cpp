@@ -0,0 +1,742 @@
+#include "JsonImporter.h"
+#include "JsonPullParser.h"
+#include "WebDataReader.h"
+#include "HierarchyUpserter.h"
+#include "ValidationHelper.h"
+#include "Logger.h"
+#include "../core/Constants.h"
+#include "../database/DatabaseManager.h"
+#include "../database/EngineerRepository.h"
+#include "../database/ProductionRepository.h"
+#include "../database/AssessmentRepository.h"
+#include "../database/CertificationRepository.h"
+#include "../database/CoreSkillsRepository.h"
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QElapsedTimer>
+
+namespace {
+
+using AreaRecord = WebDataReader::AreaRecord;
+using MachineRecord = WebDataReader::MachineRecord;
+using CompetencyRecord = WebDataReader::CompetencyRecord;
+
+struct SkillRecord {
+    QString id;
+    QString name;
+    int maxScore = 0;
+};
+
+struct CategoryRecord {
+    QString id;
+    QString name;
+    QList<SkillRecord> skills;
+};
+
+/**
+ * @brief Parser, result and the file id -> database id maps of one import
+ */
+struct ImportContext {
+    explicit ImportContext(QIODevice* device, JsonImporter::ImportResult& importResult)
+        : parser(device)
+        , result(importResult)
+    {
+    }
+
+    JsonPullParser parser;
+    JsonImporter::ImportResult& result;
+    JsonImporter::ProgressCallback progress;
+    qint64 fileSize = 0;
+    int errorCount = 0;
+    bool writeFailed = false;
+
+    ProductionHierarchy hierarchy;
+    QHash<QString, CompetencyRef> competencies;        // file competency id -> database refs
+    bool hasProductionAreas = false;                   // else assessments use database ids
+    QSet<QString> engineerIds;
+    QHash<QString, CoreSkill> coreSkills;              // skill id -> stored skill
+    QHash<QString, CoreSkill> coreSkillKeys;           // "categoryId-skillId" -> skill
+
+    void addError(const QString& error)
+    {
+        if (++errorCount <= Constants::IMPORT_MAX_ERRORS) {
+            result.errors << error;
+        }
+    }
+
+    void addErrors(const QStringList& errors)
+    {
+        for (const QString& error : errors) {
+            addError(error);
+        }
+    }
+
+    void writeError(const QString& error)
+    {
+        result.errors << error;
+        writeFailed = true;
+    }
+
+    void reportProgress()
+    {
+        if (progress) {
+            progress(parser.bytesRead(), fileSize, result.recordsSuccessful);
+        }
+    }
+};
+
+// ============================================================================
+// Token helpers
+// ============================================================================
+
+QString readScalar(JsonPullParser& parser)
+{
+    return WebDataReader::readScalar(parser);
+}
+
+bool nextKey(JsonPullParser& parser)
+{
+    return parser.next() == JsonPullParser::Key;
+}
+
+bool nextObject(ImportContext& context, const QString& section)
+{
+    QStringList problems;
+    bool found = WebDataReader::nextObject(context.parser, section, problems);
+    context.addErrors(problems);
+    return found;
+}
+
+bool expectContainer(ImportContext& context, JsonPullParser::Token token, const QString& section)
+{
+    QStringList problems;
+    bool found = WebDataReader::expectContainer(context.parser, token, section, problems);
+    context.addErrors(problems);
+    return found;
+}
+
+// ============================================================================
+// Sections
+// ============================================================================
+
+/**
+ * @brief Upsert one area with its machines and competencies in one transaction
+ */
+void writeArea(ImportContext& context, HierarchyUpserter& upserter, const AreaRecord& area)
+{
+    int records = 1;
+    for (const MachineRecord& machine : area.machines) {
+        records += 1 + machine.competencies.size();
+    }
+    context.result.recordsProcessed += records;
+
+    if (area.name.isEmpty()) {
+        context.addError(QString("Production area '%1' has no name; skipped with its machines").arg(area.id));
+        return;
+    }
+
+    // Ids are published to the map only once the transaction has committed
+    QHash<QString, CompetencyRef> competencies;
+    QStringList rejected;
+    int written = 1;
+    QString error;
+
+    DatabaseManager& dbManager = DatabaseManager::instance();
+    if (!dbManager.beginTransaction()) {
+        context.writeError(QString("Production area '%1' not saved: %2").arg(area.name, dbManager.lastError()));
+        return;
+    }
+
+    int areaId = upserter.area(area.name, error);
+    for (int m = 0; areaId > 0 && m < area.machines.size(); ++m) {
+        const MachineRecord& machine = area.machines[m];
+        int importance = machine.importance;
+        if (machine.name.isEmpty() || (importance != 0 && !ValidationHelper::isValidImportance(importance))) {
+            rejected << QString("Machine '%1' in '%2': %3").arg(machine.id, area.name,
+                machine.name.isEmpty() ? QString("no name") : QString("importance %1 must be 1-10").arg(importance));
+            continue;
+        }
+
+        int machineId = upserter.machine(areaId, machine.name, importance, error);
+        if (machineId <= 0) {
+            areaId = 0;
+            break;
+        }
+        ++written;
+
+        for (const CompetencyRecord& competency : machine.competencies) {
+            if (competency.name.isEmpty() || competency.maxScore < 0 || competency.maxScore > Constants::SCORE_MAX) {
+                rejected << QString("Competency '%1' in '%2': %3").arg(competency.id, machine.name,
+                    competency.name.isEmpty() ? QString("no name")
+                                              : QString("max score %1 must be 1-%2").arg(competency.maxScore).arg(Constants::SCORE_MAX));
+                continue;
+            }
+
+            CompetencyRef ref;
+            ref.areaId = areaId;
+            ref.machineId = machineId;
+            ref.competencyId = upserter.competency(machineId, competency.name, competency.maxScore, error);
+            if (ref.competencyId <= 0) {
+                areaId = 0;
+                break;
+            }
+            ref.maxScore = competency.maxScore > 0 ? competency.maxScore
+                         : context.hierarchy.containsCompetency(ref.competencyId)
+                             ? context.hierarchy.competency(ref.competencyId).maxScore()
+                             : Constants::SCORE_MAX;
+            competencies.insert(competency.id, ref);
+            ++written;
+        }
+    }
+
+    if (areaId <= 0 || !dbManager.commit()) {
+        if (error.isEmpty()) {
+            error = dbManager.lastError();
+        }
+        dbManager.rollback();
+        upserter.rollback();
+        context.writeError(QString("Production area '%1' not saved: %2").arg(area.name, error));
+        return;
+    }
+    upserter.commit();
+
+    context.competencies.insert(competencies);
+    context.result.recordsSuccessful += written;
+    for (const QString& problem : rejected) {
+        context.addError(problem);
+    }
+}
+
+bool readProductionAreas(ImportContext& context)
+{
+    if (!expectContainer(context, JsonPullParser::BeginArray, "productionAreas")) {
+        return !context.parser.hasError();
+    }
+
+    context.hasProductionAreas = true;
+    HierarchyUpserter upserter(context.hierarchy);
+    while (nextObject(context, "productionAreas")) {
+        AreaRecord area;
+        QStringList problems;
+        bool read = WebDataReader::readArea(context.parser, area, problems);
+        context.addErrors(problems);
+        if (!read) {
+            return false;
+        }
+        writeArea(context, upserter, area);
+        context.reportProgress();
+    }
+    return !context.parser.hasError();
+}
+
+void writeEngineers(ImportContext& context, QList<Engineer>& engineers)
+{
+    EngineerRepository engineerRepo;
+    if (!engineerRepo.saveOrUpdateBatch(engineers)) {
+        context.writeError(QString("%1 engineers not saved: %2").arg(engineers.size()).arg(engineerRepo.lastError()));
+    } else {
+        for (const Engineer& engineer : engineers) {
+            context.engineerIds.insert(engineer.id());
+        }
+        context.result.recordsSuccessful += engineers.size();
+    }
+    engineers.clear();
+    context.reportProgress();
+}
+
+bool readEngineers(ImportContext& context)
+{
+    if (!expectContainer(context, JsonPullParser::BeginArray, "engineers")) {
+        return !context.parser.hasError();
+    }
+
+    JsonPullParser& parser = context.parser;
+    QList<Engineer> batch;
+    while (nextObject(context, "engineers")) {
+        Engineer engineer;
+        if (!WebDataReader::readEngineer(parser, engineer)) {
+            break;
+        }
+        ++context.result.recordsProcessed;
+
+        QString error;
+        if (!ValidationHelper::validateRequired(engineer.name(), "Name", error)
+            || !ValidationHelper::validateLength(engineer.name(), 1, 100, "Name", error)
+            || !ValidationHelper::validateRequired(engineer.shift(), "Shift", error)
+            || !ValidationHelper::validateLength(engineer.id(), 0, 50, "ID", error)) {
+            context.addError(QString("Engineer '%1': %2").arg(engineer.id().isEmpty() ? engineer.name() : engineer.id(), error));
+            continue;
+        }
+
+        batch.append(engineer);
+        if (batch.size() >= Constants::IMPORT_BATCH_SIZE) {
+            writeEngineers(context, batch);
+        }
+    }
+    if (!batch.isEmpty()) {
+        writeEngineers(context, batch);
+    }
+    return !parser.hasError();
+}
+
+void writeAssessments(ImportContext& context, QList<Assessment>& assessments)
+{
+    AssessmentRepository assessmentRepo;
+    if (!assessmentRepo.saveOrUpdateBatch(assessments)) {
+        context.writeError(QString("%1 assessments not saved: %2").arg(assessments.size()).arg(assessmentRepo.lastError()));
+    } else {
+        context.result.recordsSuccessful += assessments.size();
+    }
+    assessments.clear();
+    context.reportProgress();
+}
+
+/**
+ * @brief Resolve an assessment's competency id
+ *
+ * With a productionAreas section, ids are the file's own and resolve only
+ * through the rows that section wrote: a skipped or rolled-back area must not
+ * fall through to an unrelated competency with the same database id. A file
+ * without one (assessments only) refers to this database's ids.
+ */
+bool findCompetency(const ImportContext& context, const QString& competencyId, CompetencyRef& ref)
+{
+    if (context.hasProductionAreas) {
+        auto it = context.competencies.constFind(competencyId);
+        if (it == context.competencies.constEnd()) {
+            return false;
+        }
+        ref = it.value();
+        return true;
+    }
+
+    bool ok = false;
+    int id = competencyId.toInt(&ok);
+    if (!ok || !context.hierarchy.containsCompetency(id)) {
+        return false;
+    }
+    ref = CompetencyRef::of(context.hierarchy, context.hierarchy.competency(id));
+    return true;
+}
+
+bool readAssessments(ImportContext& context)
+{
+    if (!expectContainer(context, JsonPullParser::BeginObject, "assessments")) {
+        return !context.parser.hasError();
+    }
+
+    JsonPullParser& parser = context.parser;
+    QList<Assessment> batch;
+    batch.reserve(Constants::IMPORT_BATCH_SIZE);
+    while (nextKey(parser)) {
+        QString key = parser.string();
+        int score = 0;
+        bool scored = WebDataReader::readScore(parser, score);
+        ++context.result.recordsProcessed;
+
+        QString engineerId;
+        QString competencyId;
+        if (!WebDataReader::splitAssessmentKey(key, engineerId, competencyId)) {
+            context.addError(QString("Assessment '%1': key is not engineer-area-machine-competency").arg(key));
+            continue;
+        }
+
+        if (!context.engineerIds.contains(engineerId)) {
+            context.addError(QString("Assessment '%1': unknown engineer '%2'").arg(key, engineerId));
+            continue;
+        }
+
+        CompetencyRef ref;
+        if (!findCompetency(context, competencyId, ref)) {
+            context.addError(QString("Assessment '%1': unknown competency").arg(key));
+            continue;
+        }
+
+        if (!scored || !ValidationHelper::isValidScore(score, ref.maxScore)) {
+            context.addError(QString("Assessment '%1': score must be 0-%2").arg(key).arg(ref.maxScore));
+            continue;
+        }
+
+        batch.append(Assessment(0, engineerId, ref.areaId, ref.machineId, ref.competencyId, score));
+        if (batch.size() >= Constants::IMPORT_BATCH_SIZE) {
+            writeAssessments(context, batch);
+        }
+    }
+    if (!batch.isEmpty()) {
+        writeAssessments(context, batch);
+    }
+    return !parser.hasError();
+}
+
+void writeCertifications(ImportContext& context, QList<Certification>& certifications)
+{
+    CertificationRepository certificationRepo;
+    if (!certificationRepo.insertMissing(certifications)) {
+        context.writeError(QString("%1 certifications not saved: %2").arg(certifications.size()).arg(certificationRepo.lastError()));
+    } else {
+        for (const Certification& certification : certifications) {
+            if (certification.id() > 0) {
+                ++context.result.recordsSuccessful;
+            }
+        }
+    }
+    certifications.clear();
+    context.reportProgress();
+}
+
+bool readCertifications(ImportContext& context)
+{
+    if (!expectContainer(context, JsonPullParser::BeginArray, "certifications")) {
+        return !context.parser.hasError();
+    }
+
+    // Certifications carry no natural key; the repository skips ones already on file
+    QList<Certification> batch;
+    batch.reserve(Constants::IMPORT_BATCH_SIZE);
+
+    JsonPullParser& parser = context.parser;
+    int catalogEntries = 0;
+    while (nextObject(context, "certifications")) {
+        Certification certification;
+        while (nextKey(parser)) {
+            QString key = parser.string();
+            if (key == QLatin1String("engineerId")) {
+                certification.setEngineerId(readScalar(parser));
+            } else if (key == QLatin1String("name")) {
+                certification.setName(ValidationHelper::sanitize(readScalar(parser)));
+            } else if (key == QLatin1String("dateEarned")) {
+                certification.setDateEarned(QDate::fromString(readScalar(parser).left(10), Qt::ISODate));
+            } else if (key == QLatin1String("expiryDate")) {
+                certification.setExpiryDate(QDate::fromString(readScalar(parser).left(10), Qt::ISODate));
+            } else {
+                parser.skipValue();
+            }
+        }
+
+        // The web app's certification catalog ({id, name, validityDays}) has no table here
+        if (certification.engineerId().isEmpty()) {
+            ++catalogEntries;
+            continue;
+        }
+
+        ++context.result.recordsProcessed;
+        if (!context.engineerIds.contains(certification.engineerId())) {
+            context.addError(QString("Certification '%1': unknown engineer '%2'")
+                .arg(certification.name(), certification.engineerId()));
+            continue;
+        }
+        if (certification.name().isEmpty() || !certification.dateEarned().isValid()) {
+            context.addError(QString("Certification '%1' for '%2': name and dateEarned are required")
+                .arg(certification.name(), certification.engineerId()));
+            continue;
+        }
+
+        batch.append(certification);
+        if (batch.size() >= Constants::IMPORT_BATCH_SIZE) {
+            writeCertifications(context, batch);
+        }
+    }
+    if (!batch.isEmpty()) {
+        writeCertifications(context, batch);
+    }
+
+    if (catalogEntries > 0) {
+        context.addError(QString("%1 certification catalog entries (no engineerId) were skipped").arg(catalogEntries));
+    }
+    return !parser.hasError();
+}
+
+bool readCategory(ImportContext& context, CategoryRecord& category)
+{
+    JsonPullParser& parser = context.parser;
+    while (nextKey(parser)) {
+        QString key = parser.string();
+        if (key == QLatin1String("id")) {
+            category.id = readScalar(parser);
+        } else if (key == QLatin1String("name")) {
+            category.name = ValidationHelper::sanitize(readScalar(parser));
+        } else if (key == QLatin1String("skills")) {
+            if (!expectContainer(context, JsonPullParser::BeginArray, "skills")) {
+                continue;
+            }
+            while (nextObject(context, "skills")) {
+                SkillRecord skill;
+                while (nextKey(parser)) {
+                    QString skillKey = parser.string();
+                    if (skillKey == QLatin1String("id")) {
+                        skill.id = readScalar(parser);
+                    } else if (skillKey == QLatin1String("name")) {
+                        skill.name = ValidationHelper::sanitize(readScalar(parser));
+                    } else if (skillKey == QLatin1String("maxScore")) {
+                        WebDataReader::toWhole(readScalar(parser), skill.maxScore);
+                    } else {
+                        parser.skipValue();
+                    }
+                }
+                category.skills.append(skill);
+            }
+        } else {
+            parser.skipValue();
+        }
+    }
+    return !parser.hasError();
+}
+
+/**
+ * @brief Save one category with its skills in one transaction
+ */
+void writeCategory(ImportContext& context, const CategoryRecord& category)
+{
+    context.result.recordsProcessed += 1 + category.skills.size();
+    if (category.id.isEmpty() || category.name.isEmpty()) {
+        context.addError(QString("Core skill category '%1' needs an id and a name; skipped with its skills")
+            .arg(category.id.isEmpty() ? category.name : category.id));
+        return;
+    }
+
+    // Weights are not part of the file: existing skills keep theirs
+    QList<CoreSkill> skills;
+    for (const SkillRecord& record : category.skills) {
+        if (record.id.isEmpty() || record.name.isEmpty() || record.maxScore < 0 || record.maxScore > Constants::SCORE_MAX) {
+            context.addError(QString("Core skill '%1' in '%2': needs an id, a name and a max score of 1-%3")
+                .arg(record.id, category.name).arg(Constants::SCORE_MAX));
+            continue;
+        }
+        CoreSkill skill = context.coreSkills.value(record.id);
+        skill.setId(record.id);
+        skill.setCategoryId(category.id);
+        skill.setName(record.name);
+        if (record.maxScore > 0) {
+            skill.setMaxScore(record.maxScore);
+        }
+        skills.append(skill);
+    }
+
+    CoreSkillsRepository coreSkillsRepo;
+    DatabaseManager& dbManager = DatabaseManager::instance();
+    bool saved = dbManager.beginTransaction() && coreSkillsRepo.saveCategory(CoreSkillCategory(category.id, category.name));
+    for (int i = 0; saved && i < skills.size(); ++i) {
+        saved = coreSkillsRepo.saveSkill(skills[i]);
+    }
+    if (!saved || !dbManager.commit()) {
+        QString error = coreSkillsRepo.lastError().isEmpty() ? dbManager.lastError() : coreSkillsRepo.lastError();
+        dbManager.rollback();
+        context.writeError(QString("Core skill category '%1' not saved: %2").arg(category.name, error));
+        return;
+    }
+
+    for (const CoreSkill& skill : skills) {
+        context.coreSkills.insert(skill.id(), skill);
+        context.coreSkillKeys.insert(skill.categoryId() + '-' + skill.id(), skill);
+    }
+    context.result.recordsSuccessful += 1 + skills.size();
+}
+
+void writeCoreSkillAssessments(ImportContext& context, QList<CoreSkillAssessment>& assessments)
+{
+    CoreSkillsRepository coreSkillsRepo;
+    if (!coreSkillsRepo.saveOrUpdateAssessmentBatch(assessments)) {
+        context.writeError(QString("%1 core skill assessments not saved: %2")
+            .arg(assessments.size()).arg(coreSkillsRepo.lastError()));
+    } else {
+        context.result.recordsSuccessful += assessments.size();
+    }
+    assessments.clear();
+    context.reportProgress();
+}
+
+bool readCoreSkillAssessments(ImportContext& context)
+{
+    if (!expectContainer(context, JsonPullParser::BeginObject, "coreSkills.assessments")) {
+        return !context.parser.hasError();
+    }
+
+    JsonPullParser& parser = context.parser;
+    QList<CoreSkillAssessment> batch;
+    while (nextKey(parser)) {
+        QString key = parser.string();
+        int score = 0;
+        bool scored = WebDataReader::readScore(parser, score);
+        ++context.result.recordsProcessed;
+
+        // "engineerId-categoryId-skillId", where category and skill ids contain
+        // hyphens of their own: the first suffix naming a known skill wins
+        const CoreSkill* skill = nullptr;
+        int split = key.indexOf('-');
+        for (; split > 0; split = key.indexOf('-', split + 1)) {
+            auto it = context.coreSkillKeys.constFind(key.mid(split + 1));
+            if (it != context.coreSkillKeys.constEnd()) {
+                skill = &it.value();
+                break;
+            }
+        }
+        if (!skill) {
+            context.addError(QString("Core skill assessment '%1': unknown skill").arg(key));
+            continue;
+        }
+
+        QString engineerId = key.left(split);
+        if (!context.engineerIds.contains(engineerId)) {
+            context.addError(QString("Core skill assessment '%1': unknown engineer '%2'").arg(key, engineerId));
+            continue;
+        }
+        if (!scored || !ValidationHelper::isValidScore(score, skill->maxScore())) {
+            context.addError(QString("Core skill assessment '%1': score must be 0-%2").arg(key).arg(skill->maxScore()));
+            continue;
+        }
+
+        CoreSkillAssessment assessment;
+        assessment.setEngineerId(engineerId);
+        assessment.setCategoryId(skill->categoryId());
+        assessment.setSkillId(skill->id());
+        assessment.setScore(score);
+        batch.append(assessment);
+        if (batch.size() >= Constants::IMPORT_BATCH_SIZE) {
+            writeCoreSkillAssessments(context, batch);
+        }
+    }
+    if (!batch.isEmpty()) {
+        writeCoreSkillAssessments(context, batch);
+    }
+    return !parser.hasError();
+}
+
+bool readCoreSkills(ImportContext& context)
+{
+    if (!expectContainer(context, JsonPullParser::BeginObject, "coreSkills")) {
+        return !context.parser.hasError();
+    }
+
+    JsonPullParser& parser = context.parser;
+    while (nextKey(parser)) {
+        QString key = parser.string();
+        if (key == QLatin1String("categories")) {
+            if (!expectContainer(context, JsonPullParser::BeginArray, "coreSkills.categories")) {
+                continue;
+            }
+            while (nextObject(context, "coreSkills.categories")) {
+                CategoryRecord category;
+                if (!readCategory(context, category)) {
+                    return false;
+                }
+                writeCategory(context, category);
+            }
+        } else if (key == QLatin1String("assessments")) {
+            if (!readCoreSkillAssessments(context)) {
+                return false;
+            }
+        } else {
+            parser.skipValue();
+        }
+    }
+    return !parser.hasError();
+}
+
+/**
+ * @brief Seed the id maps from the database, so files carrying database ids
+ *        (JsonExporter's) resolve even before their hierarchy is read
+ */
+bool loadReferenceData(ImportContext& context)
+{
+    EngineerRepository engineerRepo;
+    for (const Engineer& engineer : engineerRepo.findAll()) {
+        context.engineerIds.insert(engineer.id());
+    }
+
+    ProductionRepository productionRepo;
+    context.hierarchy = productionRepo.loadHierarchy();
+
+    CoreSkillsRepository coreSkillsRepo;
+    for (const CoreSkill& skill : coreSkillsRepo.findAllSkills()) {
+        context.coreSkills.insert(skill.id(), skill);
+        context.coreSkillKeys.insert(skill.categoryId() + '-' + skill.id(), skill);
+    }
+
+    if (!engineerRepo.lastError().isEmpty() || !productionRepo.lastError().isEmpty()
+        || !coreSkillsRepo.lastError().isEmpty()) {
+        context.result.errors << "Failed to load reference data: " + engineerRepo.lastError()
+                                 + productionRepo.lastError() + coreSkillsRepo.lastError();
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// JsonImporter
+// ============================================================================
+
+JsonImporter::JsonImporter()
+{
+}
+
+JsonImporter::~JsonImporter()
+{
+}
+
+JsonImporter::ImportResult JsonImporter::importFile(const QString& filePath)
+{
+    ImportResult result;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.errors << QString("Cannot open %1: %2").arg(filePath, file.errorString());
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    ImportContext context(&file, result);
+    context.progress = progress_;
+    context.fileSize = file.size();
+    if (!loadReferenceData(context)) {
+        return result;
+    }
+
+    JsonPullParser& parser = context.parser;
+    if (parser.next() != JsonPullParser::BeginObject) {
+        result.errors << (parser.hasError() ? "Invalid JSON: " + parser.errorString()
+                                            : QString("Expected a JSON object at the top level"));
+        return result;
+    }
+
+    // Sections are handled in file order; the web app writes the hierarchy
+    // and engineers before the assessments that refer to them
+    bool ok = true;
+    while (ok && nextKey(parser)) {
+        QString section = parser.string();
+        if (section == QLatin1String("productionAreas")) {
+            ok = readProductionAreas(context);
+        } else if (section == QLatin1String("engineers")) {
+            ok = readEngineers(context);
+        } else if (section == QLatin1String("assessments")) {
+            ok = readAssessments(context);
+        } else if (section == QLatin1String("certifications")) {
+            ok = readCertifications(context);
+        } else if (section == QLatin1String("coreSkills")) {
+            ok = readCoreSkills(context);
+        } else {
+            LOG_DEBUG("JsonImporter", "Skipping '" + section + "'");
+            ok = parser.skipValue();
+        }
+    }
+    if (!parser.hasError()) {
+        parser.next();
+    }
+    if (parser.hasError()) {
+        result.errors << "Invalid JSON: " + parser.errorString();
+    }
+
+    if (context.errorCount > Constants::IMPORT_MAX_ERRORS) {
+        result.errors << QString("... and %1 more records with errors").arg(context.errorCount - Constants::IMPORT_MAX_ERRORS);
+    }
+    result.success = !parser.hasError() && !context.writeFailed;
+    context.reportProgress();
+
+    Logger::instance().info("JsonImporter", QString("%1 bytes: %2 of %3 records saved in %4 ms")
+        .arg(context.fileSize).arg(result.recordsSuccessful).arg(result.recordsProcessed).arg(timer.elapsed()));
+    return result;
+}
@@ -0,0 +1,49 @@
+#ifndef JSONIMPORTER_H
+#define JSONIMPORTER_H
+
+#include "ExcelImporter.h"
+#include <QString>
+#include <functional>
+
+/**
+ * @brief JSON importer for the web app's data file
+ *
+ * Reads the shape JsonExporter writes and production-data-import.json
+ * uses: productionAreas (nested machines and competencies), engineers,
+ * assessments keyed "engineer-area-machine-competency", certifications
+ * and coreSkills. Other members (users, snapshots) are skipped.
+ *
+ * The file is pull-parsed (JsonPullParser) and written as it is read:
+ * one production area or core skill category per transaction, engineers
+ * and assessments in batches of IMPORT_BATCH_SIZE. Only the id maps from
+ * file ids to database ids are kept, so memory does not grow with the
+ * number of assessments.
+ *
+ * Areas, machines and competencies are matched by name within their parent,
+ * like ExcelImporter; engineers and core skills by id. Assessment competency
+ * ids are the file's own when it has productionAreas, database ids otherwise.
+ * Certifications already on file are skipped in the database, per batch.
+ * Uses the calling thread's database connection.
+ */
+class JsonImporter
+{
+public:
+    using ImportResult = ExcelImporter::ImportResult;
+
+    /**
+     * @brief Progress callback, invoked on the importing thread
+     */
+    using ProgressCallback = std::function<void(qint64 bytesRead, qint64 totalBytes, int recordsWritten)>;
+
+    JsonImporter();
+    ~JsonImporter();
+
+    void setProgressCallback(const ProgressCallback& callback) { progress_ = callback; }
+
+    ImportResult importFile(const QString& filePath);
+
+private:
+    ProgressCallback progress_;
+};
+
+#endif // JSONIMPORTER_H
@@ -0,0 +1,377 @@
+#include "JsonPullParser.h"
+#include <cstring>
+
+namespace {
+
+constexpr qint64 READ_CHUNK = 65536;
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+} // namespace
+
+JsonPullParser::JsonPullParser(QIODevice* device)
+    : device_(device)
+    , position_(0)
+    , consumed_(0)
+    , expect_(ExpectValue)
+    , token_(None)
+    , number_(0)
+    , integer_(0)
+    , isInteger_(false)
+    , boolean_(false)
+{
+}
+
+JsonPullParser::~JsonPullParser()
+{
+}
+
+JsonPullParser::Token JsonPullParser::next()
+{
+    if (token_ == Error || token_ == EndDocument) {
+        return token_;
+    }
+
+    for (;;) {
+        if (!skipWhitespace()) {
+            if (expect_ == ExpectDone) {
+                return token_ = EndDocument;
+            }
+            return fail(token_ == None ? "Empty document" : "Unexpected end of document");
+        }
+
+        char c = buffer_[position_];
+        switch (expect_) {
+        case ExpectDone:
+            return fail("Unexpected data after the document");
+
+        case ExpectColon:
+            if (c != ':') {
+                return fail("Expected ':' after an object key");
+            }
+            ++position_;
+            expect_ = ExpectValue;
+            continue;
+
+        case ExpectCommaOrEnd:
+            if (c == ',') {
+                ++position_;
+                expect_ = containers_.last() == '{' ? ExpectKey : ExpectValue;
+                continue;
+            }
+            if (c == (containers_.last() == '{' ? '}' : ']')) {
+                ++position_;
+                Token end = containers_.last() == '{' ? EndObject : EndArray;
+                containers_.removeLast();
+                afterValue();
+                return token_ = end;
+            }
+            return fail("Expected ',' or the end of the container");
+
+        case ExpectKeyOrEnd:
+            if (c == '}') {
+                ++position_;
+                containers_.removeLast();
+                afterValue();
+                return token_ = EndObject;
+            }
+            Q_FALLTHROUGH();
+        case ExpectKey:
+            if (c != '"') {
+                return fail("Expected an object key");
+            }
+            ++position_;
+            if (!readString()) {
+                return token_;
+            }
+            expect_ = ExpectColon;
+            return token_ = Key;
+
+        case ExpectValueOrEnd:
+            if (c == ']') {
+                ++position_;
+                containers_.removeLast();
+                afterValue();
+                return token_ = EndArray;
+            }
+            Q_FALLTHROUGH();
+        case ExpectValue:
+            return token_ = readValue(c);
+        }
+    }
+}
+
+bool JsonPullParser::skipValue()
+{
+    if (token_ == Key) {
+        next();
+    }
+    if (token_ == BeginObject || token_ == BeginArray) {
+        int outer = depth() - 1;
+        while (depth() > outer) {
+            if (next() == Error) {
+                return false;
+            }
+        }
+    }
+    return token_ != Error;
+}
+
+bool JsonPullParser::fill()
+{
+    if (position_ < buffer_.size()) {
+        return true;
+    }
+
+    consumed_ += buffer_.size();
+    position_ = 0;
+    buffer_.resize(READ_CHUNK);
+    qint64 got = device_->read(buffer_.data(), READ_CHUNK);
+    buffer_.resize(got > 0 ? got : 0);
+    return got > 0;
+}
+
+bool JsonPullParser::skipWhitespace()
+{
+    for (;;) {
+        if (!fill()) {
+            return false;
+        }
+        const char* data = buffer_.constData();
+        while (position_ < buffer_.size()) {
+            char c = data[position_];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                return true;
+            }
+            ++position_;
+        }
+    }
+}
+
+JsonPullParser::Token JsonPullParser::readValue(char c)
+{
+    switch (c) {
+    case '{':
+        ++position_;
+        containers_.append('{');
+        expect_ = ExpectKeyOrEnd;
+        return BeginObject;
+
+    case '[':
+        ++position_;
+        containers_.append('[');
+        expect_ = ExpectValueOrEnd;
+        return BeginArray;
+
+    case '"':
+        ++position_;
+        if (!readString()) {
+            return token_;
+        }
+        afterValue();
+        return String;
+
+    case 't':
+    case 'f':
+        if (!readLiteral(c == 't' ? "true" : "false")) {
+            return token_;
+        }
+        boolean_ = c == 't';
+        afterValue();
+        return Bool;
+
+    case 'n':
+        if (!readLiteral("null")) {
+            return token_;
+        }
+        afterValue();
+        return Null;
+
+    default:
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            if (!readNumber()) {
+                return token_;
+            }
+            afterValue();
+            return Number;
+        }
+        return fail(QString("Unexpected character '%1'").arg(QChar(c)));
+    }
+}
+
+bool JsonPullParser::readString()
+{
+    text_.clear();
+
+    for (;;) {
+        if (!fill()) {
+            fail("Unterminated string");
+            return false;
+        }
+
+        // Copy the run up to the next quote or escape in one append
+        const char* data = buffer_.constData() + position_;
+        qsizetype available = buffer_.size() - position_;
+        qsizetype run = 0;
+        while (run < available && data[run] != '"' && data[run] != '\\') {
+            if (uchar(data[run]) < 0x20) {
+                fail("Control character in string");
+                return false;
+            }
+            ++run;
+        }
+        text_.append(data, run);
+        position_ += run;
+        if (run == available) {
+            continue;
+        }
+
+        char c = buffer_[position_++];
+        if (c == '"') {
+            return true;
+        }
+
+        // Escape sequence
+        if (!fill()) {
+            fail("Unterminated string");
+            return false;
+        }
+        char escape = buffer_[position_++];
+        switch (escape) {
+        case '"':  text_.append('"'); break;
+        case '\\': text_.append('\\'); break;
+        case '/':  text_.append('/'); break;
+        case 'b':  text_.append('\b'); break;
+        case 'f':  text_.append('\f'); break;
+        case 'n':  text_.append('\n'); break;
+        case 'r':  text_.append('\r'); break;
+        case 't':  text_.append('\t'); break;
+        case 'u': {
+            auto readHex = [this](uint& value) {
+                value = 0;
+                for (int i = 0; i < 4; ++i) {
+                    int digit = fill() ? hexValue(buffer_[position_++]) : -1;
+                    if (digit < 0) {
+                        return false;
+                    }
+                    value = (value << 4) | uint(digit);
+                }
+                return true;
+            };
+
+            uint codePoint = 0;
+            if (!readHex(codePoint)) {
+                fail("Invalid \\u escape");
+                return false;
+            }
+            // A high surrogate must be followed by an escaped low surrogate
+            if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                uint low = 0;
+                bool paired = fill() && buffer_[position_] == '\\';
+                if (paired) {
+                    ++position_;
+                    paired = fill() && buffer_[position_++] == 'u' && readHex(low) && low >= 0xDC00 && low <= 0xDFFF;
+                }
+                if (!paired) {
+                    fail("Unpaired surrogate in \\u escape");
+                    return false;
+                }
+                codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+            } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                fail("Unpaired surrogate in \\u escape");
+                return false;
+            }
+            appendCodePoint(codePoint);
+            break;
+        }
+        default:
+            fail(QString("Invalid escape '\\%1'").arg(QChar(escape)));
+            return false;
+        }
+    }
+}
+
+bool JsonPullParser::readNumber()
+{
+    text_.clear();
+    while (fill()) {
+        char c = buffer_[position_];
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+            text_.append(c);
+            ++position_;
+        } else {
+            break;
+        }
+    }
+
+    bool ok = false;
+    isInteger_ = text_.indexOf('.') < 0 && text_.indexOf('e') < 0 && text_.indexOf('E') < 0;
+    if (isInteger_) {
+        integer_ = text_.toLongLong(&ok);
+        number_ = double(integer_);
+    }
+    if (!ok) {
+        isInteger_ = false;
+        number_ = text_.toDouble(&ok);
+        integer_ = qint64(number_);
+    }
+    if (!ok) {
+        fail("Invalid number '" + QString::fromLatin1(text_) + "'");
+        return false;
+    }
+    return true;
+}
+
+bool JsonPullParser::readLiteral(const char* literal)
+{
+    for (const char* p = literal; *p; ++p) {
+        if (!fill() || buffer_[position_] != *p) {
+            fail(QString("Invalid literal, expected %1").arg(QLatin1String(literal)));
+            return false;
+        }
+        ++position_;
+    }
+    return true;
+}
+
+void JsonPullParser::appendCodePoint(uint codePoint)
+{
+    if (codePoint < 0x80) {
+        text_.append(char(codePoint));
+    } else if (codePoint < 0x800) {
+        text_.append(char(0xC0 | (codePoint >> 6)));
+        text_.append(char(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        text_.append(char(0xE0 | (codePoint >> 12)));
+        text_.append(char(0x80 | ((codePoint >> 6) & 0x3F)));
+        text_.append(char(0x80 | (codePoint & 0x3F)));
+    } else {
+        text_.append(char(0xF0 | (codePoint >> 18)));
+        text_.append(char(0x80 | ((codePoint >> 12) & 0x3F)));
+        text_.append(char(0x80 | ((codePoint >> 6) & 0x3F)));
+        text_.append(char(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+void JsonPullParser::afterValue()
+{
+    expect_ = containers_.isEmpty() ? ExpectDone : ExpectCommaOrEnd;
+}
+
+JsonPullParser::Token JsonPullParser::fail(const QString& error)
+{
+    errorString_ = QString("%1 at byte %2").arg(error).arg(bytesRead());
+    return token_ = Error;
+}
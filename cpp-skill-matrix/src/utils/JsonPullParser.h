@@ -0,0 +1,123 @@
+#ifndef JSONPULLPARSER_H
+#define JSONPULLPARSER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QIODevice>
+#include <QList>
+
+/**
+ * @brief Streaming (pull) JSON parser
+ *
+ * Reads a document from a device in fixed-size chunks and returns it one
+ * token at a time, so the caller decides what to keep and memory does not
+ * grow with the document. Object members arrive as a Key token followed by
+ * the value's tokens; skipValue() passes over a value the caller does not
+ * want, however deep.
+ *
+ * Strict RFC 8259: no comments, trailing commas or unquoted keys.
+ *
+ *     while (parser.next() == JsonPullParser::Key) {
+ *         if (parser.string() == "engineers") { ... } else parser.skipValue();
+ *     }
+ */
+class JsonPullParser
+{
+public:
+    enum Token {
+        None,
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        Key,
+        String,
+        Number,
+        Bool,
+        Null,
+        EndDocument,
+        Error
+    };
+
+    explicit JsonPullParser(QIODevice* device);
+    ~JsonPullParser();
+
+    /**
+     * @brief Advance to the next token
+     */
+    Token next();
+    Token token() const { return token_; }
+
+    /**
+     * @brief Text of the current Key or String token
+     */
+    QString string() const { return QString::fromUtf8(text_); }
+
+    /**
+     * @brief Value of the current Number token
+     */
+    double number() const { return number_; }
+    qint64 integer() const { return integer_; }
+    bool isInteger() const { return isInteger_; }
+
+    /**
+     * @brief Value of the current Bool token
+     */
+    bool boolean() const { return boolean_; }
+
+    /**
+     * @brief Skip the value at the current position
+     *
+     * On a Key, skips that member's value; on BeginObject/BeginArray, skips
+     * to the matching end; on a scalar, does nothing.
+     * @return false on a parse error
+     */
+    bool skipValue();
+
+    /**
+     * @brief Open objects and arrays around the current position
+     */
+    int depth() const { return containers_.size(); }
+
+    qint64 bytesRead() const { return consumed_ + position_; }
+    bool hasError() const { return token_ == Error; }
+    QString errorString() const { return errorString_; }
+
+private:
+    enum Expect {
+        ExpectValue,
+        ExpectValueOrEnd,   // just after [
+        ExpectKeyOrEnd,     // just after {
+        ExpectKey,
+        ExpectColon,
+        ExpectCommaOrEnd,
+        ExpectDone
+    };
+
+    bool fill();  // make at least one unread byte available; false at end of input
+    bool skipWhitespace();
+    Token readValue(char c);
+    bool readString();
+    bool readNumber();
+    bool readLiteral(const char* literal);
+    void appendCodePoint(uint codePoint);
+    void afterValue();
+    Token fail(const QString& error);
+
+private:
+    QIODevice* device_;
+    QByteArray buffer_;
+    qsizetype position_;
+    qint64 consumed_;       // bytes of input before buffer_
+    QList<char> containers_;
+    Expect expect_;
+    Token token_;
+    QByteArray text_;
+    double number_;
+    qint64 integer_;
+    bool isInteger_;
+    bool boolean_;
+    QString errorString_;
+};
+
+#endif // JSONPULLPARSER_H
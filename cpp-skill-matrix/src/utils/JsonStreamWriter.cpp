@@ -0,0 +1,198 @@
+#include "JsonStreamWriter.h"
+#include "../core/Constants.h"
+#include <charconv>
+#include <cmath>
+
+JsonStreamWriter::JsonStreamWriter(QIODevice* device)
+    : device_(device)
+    , afterKey_(false)
+    , failed_(false)
+{
+    buffer_.reserve(Constants::EXPORT_WRITE_BUFFER * 2);
+}
+
+JsonStreamWriter::~JsonStreamWriter()
+{
+}
+
+void JsonStreamWriter::beginObject()
+{
+    separate();
+    buffer_.append('{');
+    needsComma_.append(false);
+}
+
+void JsonStreamWriter::endObject()
+{
+    buffer_.append('}');
+    if (!needsComma_.isEmpty()) {
+        needsComma_.removeLast();
+    }
+    written();
+}
+
+void JsonStreamWriter::beginArray()
+{
+    separate();
+    buffer_.append('[');
+    needsComma_.append(false);
+}
+
+void JsonStreamWriter::endArray()
+{
+    buffer_.append(']');
+    if (!needsComma_.isEmpty()) {
+        needsComma_.removeLast();
+    }
+    written();
+}
+
+void JsonStreamWriter::key(QStringView name)
+{
+    separate();
+    appendString(name);
+    buffer_.append(':');
+    afterKey_ = true;
+}
+
+void JsonStreamWriter::value(QStringView text)
+{
+    separate();
+    appendString(text);
+    written();
+}
+
+void JsonStreamWriter::value(qint64 number)
+{
+    separate();
+    char digits[24];
+    std::to_chars_result converted = std::to_chars(digits, digits + sizeof(digits), number);
+    buffer_.append(digits, converted.ptr - digits);
+    written();
+}
+
+void JsonStreamWriter::value(double number)
+{
+    separate();
+    if (std::isfinite(number)) {
+        buffer_.append(QByteArray::number(number, 'g', 17));
+    } else {
+        buffer_.append("null", 4);  // JSON has no NaN or infinity
+    }
+    written();
+}
+
+void JsonStreamWriter::value(bool flag)
+{
+    separate();
+    if (flag) {
+        buffer_.append("true", 4);
+    } else {
+        buffer_.append("false", 5);
+    }
+    written();
+}
+
+void JsonStreamWriter::null()
+{
+    separate();
+    buffer_.append("null", 4);
+    written();
+}
+
+bool JsonStreamWriter::flush()
+{
+    if (failed_) {
+        return false;
+    }
+    if (!buffer_.isEmpty()) {
+        if (device_->write(buffer_) != buffer_.size()) {
+            failed_ = true;
+            errorString_ = device_->errorString();
+            return false;
+        }
+        buffer_.resize(0);
+    }
+    return true;
+}
+
+void JsonStreamWriter::separate()
+{
+    // A member value follows its key directly; anything else after a sibling needs a comma
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (!needsComma_.isEmpty()) {
+        if (needsComma_.last()) {
+            buffer_.append(',');
+        }
+        needsComma_.last() = true;
+    }
+}
+
+void JsonStreamWriter::appendString(QStringView text)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    buffer_.append('"');
+
+    // Unescaped runs are copied in one go: ASCII byte by byte, the rest via UTF-8
+    qsizetype runStart = 0;
+    bool runAscii = true;
+    auto flushRun = [&](qsizetype end) {
+        if (end <= runStart) {
+            return;
+        }
+        QStringView run = text.mid(runStart, end - runStart);
+        if (runAscii) {
+            qsizetype offset = buffer_.size();
+            buffer_.resize(offset + run.size());
+            char* out = buffer_.data() + offset;
+            for (QChar ch : run) {
+                *out++ = char(ch.unicode());
+            }
+        } else {
+            buffer_.append(run.toUtf8());
+        }
+        runAscii = true;
+    };
+
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        char16_t c = text[i].unicode();
+        if (c >= 0x80) {
+            runAscii = false;
+            continue;
+        }
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        flushRun(i);
+        runStart = i + 1;
+        switch (c) {
+        case '"':  buffer_.append("\\\"", 2); break;
+        case '\\': buffer_.append("\\\\", 2); break;
+        case '\n': buffer_.append("\\n", 2); break;
+        case '\r': buffer_.append("\\r", 2); break;
+        case '\t': buffer_.append("\\t", 2); break;
+        case '\b': buffer_.append("\\b", 2); break;
+        case '\f': buffer_.append("\\f", 2); break;
+        default: {
+            char escape[6] = {'\\', 'u', '0', '0', hex[(c >> 4) & 0xf], hex[c & 0xf]};
+            buffer_.append(escape, 6);
+            break;
+        }
+        }
+    }
+    flushRun(text.size());
+
+    buffer_.append('"');
+}
+
+void JsonStreamWriter::written()
+{
+    if (buffer_.size() >= Constants::EXPORT_WRITE_BUFFER) {
+        flush();
+    }
+}
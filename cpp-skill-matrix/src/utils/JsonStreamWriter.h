@@ -0,0 +1,66 @@
+#ifndef JSONSTREAMWRITER_H
+#define JSONSTREAMWRITER_H
+
+#include <QString>
+#include <QStringView>
+#include <QByteArray>
+#include <QIODevice>
+#include <QList>
+
+/**
+ * @brief Incremental JSON writer
+ *
+ * Emits a document token by token into a byte buffer that is written to
+ * the device whenever it passes EXPORT_WRITE_BUFFER, so a document of any
+ * size is produced without building a QJsonDocument. Commas are placed
+ * automatically; keys are given with key() before each member value.
+ *
+ * The writer does not check structure beyond what comma placement needs:
+ * callers are expected to balance begin/end calls.
+ */
+class JsonStreamWriter
+{
+public:
+    explicit JsonStreamWriter(QIODevice* device);
+    ~JsonStreamWriter();
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    void key(QStringView name);
+
+    void value(QStringView text);
+    void value(const QString& text) { value(QStringView(text)); }
+    void value(const char* text) { value(QString::fromUtf8(text)); }
+    void value(qint64 number);
+    void value(int number) { value(qint64(number)); }
+    void value(double number);
+    void value(bool flag);
+    void null();
+
+    /**
+     * @brief Write out what is buffered
+     * @return false once a write has failed
+     */
+    bool flush();
+
+    bool hasError() const { return failed_; }
+    QString errorString() const { return errorString_; }
+
+private:
+    void separate();
+    void appendString(QStringView text);
+    void written();
+
+private:
+    QIODevice* device_;
+    QByteArray buffer_;
+    QList<bool> needsComma_;  // per open container
+    bool afterKey_;
+    bool failed_;
+    QString errorString_;
+};
+
+#endif // JSONSTREAMWRITER_H
@@ -1,7 +1,10 @@
 #include "Logger.h"
+#include "../core/Constants.h"
 #include <QDir>
 #include <QStandardPaths>
 #include <iostream>
+#include <string>
+#include <utility>
 
 Logger& Logger::instance()
 {
@@ -11,16 +14,35 @@ Logger& Logger::instance()
 
 Logger::Logger(QObject* parent)
     : QObject(parent)
-    , stream_(nullptr)
+    , ring_(Constants::LOG_RING_CAPACITY)
+    , dropped_(0)
+    , reportedDropped_(0)
+    , writer_(nullptr)
+    , stopping_(false)
+    , lastFlush_(QDateTime::currentMSecsSinceEpoch())
     , minLevel_(Info)
+    , lowestLevel_(Info)
+    , categoryLevels_(nullptr)
     , consoleOutput_(true)
     , initialized_(false)
 {
+    writer_ = QThread::create([this] { writerLoop(); });
+    writer_->setObjectName("Logger");
+    writer_->start(QThread::LowPriority);
 }
 
 Logger::~Logger()
 {
+    stopping_.store(true, std::memory_order_release);
+    wake_.wakeAll();
+    writer_->wait();
+    delete writer_;
+    writer_ = nullptr;
+
     close();
+
+    delete categoryLevels_.load(std::memory_order_relaxed);
+    qDeleteAll(retiredLevels_);
 }
 
 bool Logger::initialize(const QString& logPath)
@@ -43,15 +65,18 @@ bool Logger::initialize(const QString& logPath)
         path = dir.filePath(QString("skillmatrix_%1.log").arg(timestamp));
     }
 
-    // Open log file
-    logFile_.setFileName(path);
-    if (!logFile_.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-        std::cerr << "Failed to open log file: " << path.toStdString() << std::endl;
-        return false;
-    }
+    {
+        QMutexLocker locker(&fileMutex_);
+
+        // Open log file
+        logFile_.setFileName(path);
+        if (!logFile_.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+            std::cerr << "Failed to open log file: " << path.toStdString() << std::endl;
+            return false;
+        }
 
-    stream_ = new QTextStream(&logFile_);
-    initialized_ = true;
+        initialized_ = true;
+    }
 
     info("Logger", "Log file initialized: " + path);
     return true;
@@ -63,12 +88,9 @@ void Logger::close()
         return;
     }
 
-    if (stream_) {
-        stream_->flush();
-        delete stream_;
-        stream_ = nullptr;
-    }
+    flush();
 
+    QMutexLocker locker(&fileMutex_);
     if (logFile_.isOpen()) {
         logFile_.close();
     }
@@ -76,6 +98,70 @@ void Logger::close()
     initialized_ = false;
 }
 
+void Logger::flush()
+{
+    drain(true);
+}
+
+void Logger::setLevel(LogLevel level)
+{
+    QMutexLocker locker(&levelMutex_);
+    minLevel_.store(level, std::memory_order_relaxed);
+    publishLevels(levelsByName_);
+}
+
+void Logger::setCategoryLevel(const QString& category, LogLevel level)
+{
+    QMutexLocker locker(&levelMutex_);
+    levelsByName_.insert(category, level);
+    publishLevels(levelsByName_);
+}
+
+void Logger::clearCategoryLevel(const QString& category)
+{
+    QMutexLocker locker(&levelMutex_);
+    levelsByName_.remove(category);
+    publishLevels(levelsByName_);
+}
+
+void Logger::publishLevels(const QHash<QString, int>& levels)
+{
+    int lowest = minLevel_.load(std::memory_order_relaxed);
+    CategoryLevels* snapshot = nullptr;
+    if (!levels.isEmpty()) {
+        snapshot = new CategoryLevels;
+        snapshot->byName = levels;
+        for (auto it = levels.constBegin(); it != levels.constEnd(); ++it) {
+            snapshot->byUtf8.insert(it.key().toUtf8(), it.value());
+            lowest = qMin(lowest, it.value());
+        }
+    }
+
+    const CategoryLevels* previous = categoryLevels_.exchange(snapshot, std::memory_order_acq_rel);
+    if (previous) {
+        retiredLevels_.append(previous);
+    }
+    lowestLevel_.store(lowest, std::memory_order_relaxed);
+}
+
+Logger::LogLevel Logger::levelFromString(const QString& name, bool* ok)
+{
+    static const QHash<QString, LogLevel> levels = {
+        {"debug", Debug},
+        {"info", Info},
+        {"warning", Warning},
+        {"warn", Warning},
+        {"error", Error},
+        {"critical", Critical}
+    };
+
+    auto it = levels.constFind(name.trimmed().toLower());
+    if (ok) {
+        *ok = it != levels.constEnd();
+    }
+    return it != levels.constEnd() ? it.value() : Info;
+}
+
 void Logger::debug(const QString& category, const QString& message)
 {
     log(Debug, category, message);
@@ -103,39 +189,39 @@ void Logger::critical(const QString& category, const QString& message)
 
 void Logger::log(LogLevel level, const QString& category, const QString& message)
 {
-    // Check if level is sufficient
-    if (level < minLevel_) {
-        return;
+    // Check if level is sufficient (global and per-category thresholds)
+    if (isEnabled(level, category)) {
+        write(level, category, message);
     }
+}
 
-    QMutexLocker locker(&mutex_);
-
-    QString formattedMessage = formatMessage(level, category, message);
+void Logger::write(LogLevel level, const QString& category, const QString& message)
+{
+    // Formatting and I/O happen on the writer thread
+    Record record;
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.level = level;
+    record.category = category;
+    record.message = message;
 
-    // Write to file
-    if (initialized_) {
-        writeToFile(formattedMessage);
+    if (!ring_.push(std::move(record))) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
 
-    // Write to console
-    if (consoleOutput_) {
-        writeToConsole(formattedMessage);
+    // Errors are written out promptly; otherwise only wake the writer before the ring fills
+    if (level >= Error || ring_.size() >= ring_.capacity() / 2) {
+        wake_.wakeOne();
     }
-
-    // Emit signal
-    emit messageLogged(level, category, message);
 }
 
-QString Logger::formatMessage(LogLevel level, const QString& category, const QString& message)
+QString Logger::formatMessage(const Record& record) const
 {
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss.zzz");
-    QString levelStr = levelToString(level);
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(record.timestamp).toString("yyyy-MM-dd HH:mm:ss.zzz");
+    QString levelStr = levelToString(record.level);
 
     return QString("[%1] [%2] [%3] %4")
-        .arg(timestamp)
-        .arg(levelStr)
-        .arg(category)
-        .arg(message);
+        .arg(timestamp, levelStr, record.category, record.message);
 }
 
 QString Logger::levelToString(LogLevel level) const
@@ -150,15 +236,79 @@ QString Logger::levelToString(LogLevel level) const
     }
 }
 
-void Logger::writeToFile(const QString& formattedMessage)
+void Logger::writerLoop()
+{
+    while (!stopping_.load(std::memory_order_acquire)) {
+        if (ring_.size() == 0) {
+            QMutexLocker locker(&wakeMutex_);
+            wake_.wait(&wakeMutex_, Constants::LOG_FLUSH_INTERVAL);
+        }
+        drain(false);
+    }
+
+    drain(true);
+}
+
+void Logger::drain(bool force)
 {
-    if (stream_) {
-        *stream_ << formattedMessage << "\n";
-        stream_->flush();
+    // Serialises consumers: the writer thread, and flush() from any other thread
+    QMutexLocker locker(&fileMutex_);
+
+    std::string console;
+    bool urgent = false;
+    Record record;
+
+    auto append = [&](const Record& entry) {
+        QString line = formatMessage(entry);
+        if (initialized_) {
+            fileBuffer_.append(line.toUtf8());
+            fileBuffer_.append('\n');
+        }
+        if (consoleOutput_) {
+            console.append(line.toStdString());
+            console.push_back('\n');
+        }
+    };
+
+    while (ring_.pop(record)) {
+        append(record);
+        if (record.level >= Error) {
+            urgent = true;
+        }
+        emit messageLogged(record.level, record.category, record.message);
+    }
+
+    quint64 dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reportedDropped_) {
+        Record notice;
+        notice.timestamp = QDateTime::currentMSecsSinceEpoch();
+        notice.level = Warning;
+        notice.category = "Logger";
+        notice.message = QString("%1 messages dropped (log buffer full), %2 in total")
+            .arg(dropped - reportedDropped_)
+            .arg(dropped);
+        append(notice);
+        reportedDropped_ = dropped;
+    }
+
+    if (!console.empty()) {
+        std::cout << console;
+        std::cout.flush();
+    }
+
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (force || urgent || fileBuffer_.size() >= Constants::LOG_FLUSH_BYTES ||
+        now - lastFlush_ >= Constants::LOG_FLUSH_INTERVAL) {
+        flushFile();
+        lastFlush_ = now;
     }
 }
 
-void Logger::writeToConsole(const QString& formattedMessage)
+void Logger::flushFile()
 {
-    std::cout << formattedMessage.toStdString() << std::endl;
+    if (!fileBuffer_.isEmpty() && logFile_.isOpen()) {
+        logFile_.write(fileBuffer_);
+        logFile_.flush();
+    }
+    fileBuffer_.clear();
 }
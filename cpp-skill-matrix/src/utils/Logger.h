@@ -4,14 +4,35 @@
 #include <QObject>
 #include <QString>
 #include <QFile>
-#include <QTextStream>
 #include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+#include <QList>
+#include <QByteArray>
+#include <QThread>
 #include <QDateTime>
+#include <atomic>
+#include "MpscRing.h"
 
 /**
  * @brief Logger class for application-wide logging
  *
- * Singleton logger that writes to file and optionally to console
+ * Singleton logger that writes to file and optionally to console.
+ *
+ * log() only stamps the record and pushes it onto a lock-free ring; a writer
+ * thread formats records in batches and writes them to the file and console.
+ * The file is flushed every Constants::LOG_FLUSH_INTERVAL milliseconds, once
+ * Constants::LOG_FLUSH_BYTES are buffered, or straight away for errors. When
+ * the ring is full the record is dropped and counted (droppedMessages()), and
+ * the writer notes the drop count in the log.
+ *
+ * Besides the global minimum level, each category can have its own threshold
+ * (setCategoryLevel()). Use the LOG_DEBUG/LOG_INFO/... macros on hot paths:
+ * they check isEnabled() before the message expression is evaluated, so a
+ * filtered-out call costs no formatting or allocation. The check takes no
+ * lock: below every threshold it is one atomic load, otherwise a lookup in
+ * an immutable snapshot of the category thresholds, keyed so that neither a
+ * literal nor a QString category is converted.
  */
 class Logger : public QObject
 {
@@ -39,20 +60,73 @@ public:
     bool initialize(const QString& logPath = QString());
 
     /**
-     * @brief Close logger
+     * @brief Close logger (writes out everything queued so far)
      */
     void close();
 
+    /**
+     * @brief Block until every record queued so far has been written
+     */
+    void flush();
+
+    /**
+     * @brief Records dropped because the ring was full
+     */
+    quint64 droppedMessages() const { return dropped_.load(std::memory_order_relaxed); }
+
     /**
      * @brief Set minimum log level
-     * @param level Minimum level to log
+     * @param level Minimum level to log (categories without their own threshold)
      */
-    void setLevel(LogLevel level) { minLevel_ = level; }
+    void setLevel(LogLevel level);
 
     /**
      * @brief Get current log level
      */
-    LogLevel level() const { return minLevel_; }
+    LogLevel level() const { return LogLevel(minLevel_.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Give one category its own minimum level, above or below the global one
+     */
+    void setCategoryLevel(const QString& category, LogLevel level);
+
+    /**
+     * @brief Make a category follow the global level again
+     */
+    void clearCategoryLevel(const QString& category);
+
+    /**
+     * @brief Whether a message of this level and category would be logged
+     */
+    bool isEnabled(LogLevel level, const char* category) const
+    {
+        if (level < lowestLevel_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        const CategoryLevels* levels = categoryLevels_.load(std::memory_order_acquire);
+        if (!levels) {
+            return level >= minLevel_.load(std::memory_order_relaxed);
+        }
+        return level >= levels->byUtf8.value(QByteArray::fromRawData(category, int(qstrlen(category))),
+                                             minLevel_.load(std::memory_order_relaxed));
+    }
+
+    bool isEnabled(LogLevel level, const QString& category) const
+    {
+        if (level < lowestLevel_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        const CategoryLevels* levels = categoryLevels_.load(std::memory_order_acquire);
+        if (!levels) {
+            return level >= minLevel_.load(std::memory_order_relaxed);
+        }
+        return level >= levels->byName.value(category, minLevel_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Parse a level name ("debug", "info", "warning", "error", "critical")
+     */
+    static LogLevel levelFromString(const QString& name, bool* ok = nullptr);
 
     /**
      * @brief Enable/disable console output
@@ -89,13 +163,30 @@ public:
      */
     void log(LogLevel level, const QString& category, const QString& message);
 
+    /**
+     * @brief Queue a message without checking the filters
+     *
+     * For the LOG_* macros, which have already called isEnabled().
+     */
+    void write(LogLevel level, const QString& category, const QString& message);
+
 signals:
     /**
-     * @brief Emitted when a message is logged
+     * @brief Emitted when a message is logged (from the writer thread)
      */
     void messageLogged(Logger::LogLevel level, const QString& category, const QString& message);
 
 private:
+    /**
+     * @brief A log call as queued for the writer thread
+     */
+    struct Record {
+        qint64 timestamp = 0;   // milliseconds since epoch
+        LogLevel level = Info;
+        QString category;
+        QString message;
+    };
+
     Logger(QObject* parent = nullptr);
     ~Logger();
 
@@ -105,7 +196,7 @@ private:
     /**
      * @brief Format log message
      */
-    QString formatMessage(LogLevel level, const QString& category, const QString& message);
+    QString formatMessage(const Record& record) const;
 
     /**
      * @brief Get level string
@@ -113,22 +204,82 @@ private:
     QString levelToString(LogLevel level) const;
 
     /**
-     * @brief Write message to file
+     * @brief Per-category thresholds, never modified once published
+     */
+    struct CategoryLevels {
+        QHash<QByteArray, int> byUtf8;  // looked up from literals without a copy
+        QHash<QString, int> byName;
+    };
+
+    /**
+     * @brief Publish new category thresholds and recompute lowestLevel_ (levelMutex_ held)
+     * @param levels Thresholds by category name; empty = none
+     */
+    void publishLevels(const QHash<QString, int>& levels);
+
+    /**
+     * @brief Writer thread body
+     */
+    void writerLoop();
+
+    /**
+     * @brief Format queued records and write them out (writer thread)
+     * @param force Flush the file even if the flush policy does not ask for it
      */
-    void writeToFile(const QString& formattedMessage);
+    void drain(bool force);
 
     /**
-     * @brief Write message to console
+     * @brief Write buffered file output and flush the file (fileMutex_ held)
      */
-    void writeToConsole(const QString& formattedMessage);
+    void flushFile();
 
 private:
+    MpscRing<Record> ring_;
+    std::atomic<quint64> dropped_;
+    quint64 reportedDropped_;
+
+    QThread* writer_;
+    std::atomic<bool> stopping_;
+    QMutex wakeMutex_;
+    QWaitCondition wake_;
+
+    // Writer-side state, guarded by fileMutex_
+    QMutex fileMutex_;
     QFile logFile_;
-    QTextStream* stream_;
-    QMutex mutex_;
-    LogLevel minLevel_;
+    QByteArray fileBuffer_;
+    qint64 lastFlush_;
+
+    // Level filters, read lock-free on the caller's thread
+    std::atomic<int> minLevel_;
+    std::atomic<int> lowestLevel_;          // lowest of the global and category thresholds
+    std::atomic<const CategoryLevels*> categoryLevels_;    // nullptr = no category thresholds
+
+    // Setters only: replaced snapshots are kept until destruction, since a
+    // reader may still be looking at one (thresholds change rarely)
+    QMutex levelMutex_;
+    QHash<QString, int> levelsByName_;
+    QList<const CategoryLevels*> retiredLevels_;
+
     bool consoleOutput_;
     bool initialized_;
 };
 
+/**
+ * @brief Log only if the level and category pass the filters
+ *
+ * The message expression is not evaluated when the call is filtered out.
+ */
+#define LOG_AT(level, category, message)                                  \
+    do {                                                                  \
+        if (Logger::instance().isEnabled(level, category)) {              \
+            Logger::instance().write(level, category, message);           \
+        }                                                                 \
+    } while (0)
+
+#define LOG_DEBUG(category, message)    LOG_AT(Logger::Debug, category, message)
+#define LOG_INFO(category, message)     LOG_AT(Logger::Info, category, message)
+#define LOG_WARNING(category, message)  LOG_AT(Logger::Warning, category, message)
+#define LOG_ERROR(category, message)    LOG_AT(Logger::Error, category, message)
+#define LOG_CRITICAL(category, message) LOG_AT(Logger::Critical, category, message)
+
 #endif // LOGGER_H
@@ -0,0 +1,111 @@
+#ifndef MPSCRING_H
+#define MPSCRING_H
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief Bounded lock-free ring buffer for many producers and one consumer
+ *
+ * Each slot carries a sequence number that tells whether it is free for the
+ * producer that claimed its position or ready for the consumer. Producers
+ * claim positions with a compare-and-swap and never wait: push() on a full
+ * ring fails straight away. Only one thread may call pop().
+ */
+template <typename T>
+class MpscRing
+{
+public:
+    /**
+     * @param capacity Slot count, rounded up to a power of two
+     */
+    explicit MpscRing(int capacity)
+    {
+        size_t size = 2;
+        while (size < size_t(capacity)) {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        slots_.reset(new Slot[size]);
+        for (size_t i = 0; i < size; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    /**
+     * @brief Append a value (any thread)
+     * @return false if the ring is full
+     */
+    bool push(T value)
+    {
+        size_t position = enqueuePos_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[position & mask_];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = std::ptrdiff_t(sequence - position);
+            if (difference == 0) {
+                if (enqueuePos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = std::move(value);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest value (consumer thread only)
+     * @return false if the ring is empty
+     */
+    bool pop(T& value)
+    {
+        size_t position = dequeuePos_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[position & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+
+        value = std::move(slot.value);
+        slot.value = T();
+        slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+        dequeuePos_.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of queued values
+     */
+    size_t size() const
+    {
+        size_t enqueued = enqueuePos_.load(std::memory_order_relaxed);
+        size_t dequeued = dequeuePos_.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    // Producers and the consumer touch different positions; keep them on separate cache lines
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) std::atomic<size_t> dequeuePos_{0};
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+};
+
+#endif // MPSCRING_H
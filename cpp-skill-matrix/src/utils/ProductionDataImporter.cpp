@@ -0,0 +1,621 @@
+#include "ProductionDataImporter.h"
+#include "JsonPullParser.h"
+#include "WebDataReader.h"
+#include "HierarchyUpserter.h"
+#include "ValidationHelper.h"
+#include "Logger.h"
+#include "../core/Constants.h"
+#include "../database/DatabaseManager.h"
+#include "../database/EngineerRepository.h"
+#include "../database/ProductionRepository.h"
+#include "../database/AssessmentRepository.h"
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <QElapsedTimer>
+
+namespace {
+
+using Report = ProductionDataImporter::Report;
+
+// Rows planned but not inserted yet are referred to as -(index + 1) into
+// their plan list; resolve() turns that into the generated id once written
+int placeholder(int index)
+{
+    return -(index + 1);
+}
+
+template <typename T>
+int resolve(int id, const QList<T>& planned)
+{
+    return id > 0 ? id : planned[-id - 1].id();
+}
+
+/**
+ * @brief In-memory id maps and the rows still to be written
+ *
+ * Matches like HierarchyUpserter (same keys) but plans set-based writes
+ * instead of writing row by row, so a dry run can report without writing.
+ * CompetencyRef ids of rows not written yet are placeholders.
+ */
+class SeedPlan
+{
+public:
+    SeedPlan(Report& report, bool dryRun)
+        : report_(report)
+        , dryRun_(dryRun)
+        , inTransaction_(false)
+        , writtenAreas_(0)
+        , writtenMachines_(0)
+        , writtenCompetencies_(0)
+        , noteCount_(0)
+    {
+    }
+
+    /**
+     * @brief One read of the current hierarchy and engineers
+     */
+    bool loadDatabase()
+    {
+        ProductionRepository productionRepo;
+        ProductionHierarchy hierarchy = productionRepo.loadHierarchy();
+        EngineerRepository engineerRepo;
+        QList<Engineer> engineers = engineerRepo.findAll();
+        if (!productionRepo.lastError().isEmpty() || !engineerRepo.lastError().isEmpty()) {
+            report_.errors << "Failed to load the current data: " + productionRepo.lastError() + engineerRepo.lastError();
+            return false;
+        }
+
+        for (const ProductionArea& area : hierarchy.areas()) {
+            areas_.insert(HierarchyUpserter::nameKey(area.name()), area.id());
+        }
+        for (const Machine& machine : hierarchy.machines()) {
+            machines_.insert(HierarchyUpserter::machineKey(machine.productionAreaId(), machine.name()), machine);
+        }
+        for (const Competency& competency : hierarchy.competencies()) {
+            competencies_.insert(HierarchyUpserter::competencyKey(competency.machineId(), competency.name()), competency);
+        }
+        for (const Engineer& engineer : engineers) {
+            engineers_.insert(engineer.id(), engineer);
+        }
+
+        // Only scores, so a dry run can tell changes from rows already as in the file
+        AssessmentRepository assessmentRepo;
+        bool ok = assessmentRepo.forEach([this](const Assessment& assessment) {
+            scores_.insert(scoreKey(assessment.engineerId(), assessment.competencyId()), assessment.score());
+            return true;
+        });
+        if (!ok) {
+            report_.errors << "Failed to load the current assessments: " + assessmentRepo.lastError();
+            return false;
+        }
+        return true;
+    }
+
+    void planArea(const WebDataReader::AreaRecord& record)
+    {
+        if (record.name.isEmpty()) {
+            note(QString("Production area '%1' has no name; skipped with its machines").arg(record.id));
+            return;
+        }
+
+        int areaId = areas_.value(HierarchyUpserter::nameKey(record.name), 0);
+        if (areaId == 0) {
+            newAreas_.append(ProductionArea(0, record.name));
+            areaId = placeholder(newAreas_.size() - 1);
+            areas_.insert(HierarchyUpserter::nameKey(record.name), areaId);
+            ++report_.areasAdded;
+        } else if (areaId > 0) {
+            ++report_.areasMatched;
+        }
+
+        for (const WebDataReader::MachineRecord& machine : record.machines) {
+            planMachine(areaId, record.name, machine);
+        }
+    }
+
+    void planEngineer(Engineer engineer)
+    {
+        QString error;
+        if (!ValidationHelper::validateRequired(engineer.name(), "Name", error)
+            || !ValidationHelper::validateLength(engineer.name(), 1, 100, "Name", error)
+            || !ValidationHelper::validateRequired(engineer.shift(), "Shift", error)
+            || !ValidationHelper::validateLength(engineer.id(), 0, 50, "ID", error)) {
+            note(QString("Engineer '%1': %2").arg(engineer.id().isEmpty() ? engineer.name() : engineer.id(), error));
+            return;
+        }
+
+        auto it = engineers_.constFind(engineer.id());
+        if (engineer.id().isEmpty() || it == engineers_.constEnd()) {
+            ++report_.engineersAdded;
+        } else if (it.value().name() != engineer.name() || it.value().shift() != engineer.shift()) {
+            ++report_.engineersUpdated;
+        } else {
+            ++report_.engineersMatched;
+            return;
+        }
+
+        if (!engineer.id().isEmpty()) {
+            engineers_.insert(engineer.id(), engineer);
+        }
+        engineerWrites_.append(engineer);
+    }
+
+    /**
+     * @brief Resolve one assessment and, unless dry running, queue it for the open transaction
+     * @return false if writing a full batch failed
+     */
+    bool planAssessment(const QString& key, bool scored, int score)
+    {
+        QString engineerId;
+        QString competencyId;
+        if (!WebDataReader::splitAssessmentKey(key, engineerId, competencyId)) {
+            note(QString("Assessment '%1': key is not engineer-area-machine-competency").arg(key));
+            return true;
+        }
+        if (!engineers_.contains(engineerId)) {
+            note(QString("Assessment '%1': unknown engineer '%2'").arg(key, engineerId));
+            return true;
+        }
+        auto it = competencyByFileId_.constFind(competencyId);
+        if (it == competencyByFileId_.constEnd()) {
+            note(QString("Assessment '%1': unknown competency '%2'").arg(key, competencyId));
+            return true;
+        }
+        if (!scored || !ValidationHelper::isValidScore(score, it.value().maxScore)) {
+            note(QString("Assessment '%1': score must be 0-%2").arg(key).arg(it.value().maxScore));
+            return true;
+        }
+
+        // Placeholder ids key new competencies, so repeats within the file compare too
+        const CompetencyRef& ref = it.value();
+        QString cellKey = scoreKey(engineerId, ref.competencyId);
+        auto existing = scores_.constFind(cellKey);
+        if (existing != scores_.constEnd() && existing.value() == score) {
+            ++report_.assessmentsMatched;
+            return true;
+        }
+        scores_.insert(cellKey, score);
+
+        ++report_.assessments;
+        if (dryRun_) {
+            return true;
+        }
+
+        // Hierarchy and engineers are in the transaction by now (see flush())
+        assessments_.append(Assessment(0, engineerId, resolve(ref.areaId, newAreas_), resolve(ref.machineId, newMachines_),
+                                       resolve(ref.competencyId, newCompetencies_), score));
+        return assessments_.size() < Constants::IMPORT_BATCH_SIZE || writeAssessments();
+    }
+
+    /**
+     * @brief Write what has been planned so far into the (lazily begun) transaction
+     *
+     * Called before the first assessment and at the end; a no-op in a dry run.
+     */
+    bool flush()
+    {
+        if (dryRun_) {
+            return true;
+        }
+
+        DatabaseManager& dbManager = DatabaseManager::instance();
+        if (!inTransaction_) {
+            if (!dbManager.beginTransaction()) {
+                report_.errors << "Failed to begin the import transaction: " + dbManager.lastError();
+                return false;
+            }
+            inTransaction_ = true;
+        }
+
+        ProductionRepository productionRepo;
+        EngineerRepository engineerRepo;
+
+        QList<ProductionArea> areas = newAreas_.mid(writtenAreas_);
+        if (!productionRepo.insertAreas(areas)) {
+            return writeFailed("production areas", productionRepo.lastError());
+        }
+        for (int i = 0; i < areas.size(); ++i) {
+            newAreas_[writtenAreas_ + i].setId(areas[i].id());
+        }
+        writtenAreas_ = newAreas_.size();
+
+        QList<Machine> machines = newMachines_.mid(writtenMachines_);
+        for (Machine& machine : machines) {
+            machine.setProductionAreaId(resolve(machine.productionAreaId(), newAreas_));
+        }
+        if (!productionRepo.insertMachines(machines)) {
+            return writeFailed("machines", productionRepo.lastError());
+        }
+        for (int i = 0; i < machines.size(); ++i) {
+            newMachines_[writtenMachines_ + i].setId(machines[i].id());
+        }
+        writtenMachines_ = newMachines_.size();
+
+        QList<Competency> competencies = newCompetencies_.mid(writtenCompetencies_);
+        for (Competency& competency : competencies) {
+            competency.setMachineId(resolve(competency.machineId(), newMachines_));
+        }
+        if (!productionRepo.insertCompetencies(competencies)) {
+            return writeFailed("competencies", productionRepo.lastError());
+        }
+        for (int i = 0; i < competencies.size(); ++i) {
+            newCompetencies_[writtenCompetencies_ + i].setId(competencies[i].id());
+        }
+        writtenCompetencies_ = newCompetencies_.size();
+
+        if (!productionRepo.updateMachineImportance(machineUpdates_.values())) {
+            return writeFailed("machine importance", productionRepo.lastError());
+        }
+        machineUpdates_.clear();
+        if (!productionRepo.updateCompetencyMaxScores(competencyUpdates_.values())) {
+            return writeFailed("competency max scores", productionRepo.lastError());
+        }
+        competencyUpdates_.clear();
+
+        if (!engineerRepo.saveOrUpdateBatch(engineerWrites_, true)) {
+            return writeFailed("engineers", engineerRepo.lastError());
+        }
+        engineerWrites_.clear();
+
+        return writeAssessments();
+    }
+
+    bool commit()
+    {
+        if (!inTransaction_) {
+            return true;
+        }
+        inTransaction_ = false;
+
+        DatabaseManager& dbManager = DatabaseManager::instance();
+        if (!dbManager.commit()) {
+            report_.errors << "Failed to commit the import: " + dbManager.lastError();
+            dbManager.rollback();
+            return false;
+        }
+        return true;
+    }
+
+    void rollback()
+    {
+        if (inTransaction_) {
+            DatabaseManager::instance().rollback();
+            inTransaction_ = false;
+        }
+    }
+
+    void note(const QString& text)
+    {
+        if (++noteCount_ <= Constants::IMPORT_MAX_ERRORS) {
+            report_.notes << text;
+        } else if (noteCount_ == Constants::IMPORT_MAX_ERRORS + 1) {
+            report_.notes << "... further rejected records are not listed";
+        }
+    }
+
+private:
+    static QString scoreKey(const QString& engineerId, int competencyId)
+    {
+        return engineerId + '|' + QString::number(competencyId);
+    }
+
+    void planMachine(int areaId, const QString& areaName, const WebDataReader::MachineRecord& record)
+    {
+        if (record.name.isEmpty()) {
+            note(QString("Machine '%1' in '%2' has no name; skipped with its competencies").arg(record.id, areaName));
+            return;
+        }
+        int importance = record.importance;
+        if (importance != 0 && !ValidationHelper::isValidImportance(importance)) {
+            note(QString("Machine '%1' in '%2': importance %3 must be 1-10; left as is")
+                .arg(record.name, areaName).arg(importance));
+            importance = 0;
+        }
+
+        QString key = HierarchyUpserter::machineKey(areaId, record.name);
+        Machine machine = machines_.value(key);
+        if (machine.id() == 0) {
+            newMachines_.append(Machine(0, areaId, record.name, importance > 0 ? importance : 1));
+            machine = newMachines_.last();
+            machine.setId(placeholder(newMachines_.size() - 1));
+            ++report_.machinesAdded;
+        } else if (machine.id() < 0) {
+            if (importance > 0) {
+                newMachines_[-machine.id() - 1].setImportance(importance);
+            }
+        } else if (importance > 0 && importance != machine.importance()) {
+            machine.setImportance(importance);
+            if (!machineUpdates_.contains(machine.id())) {
+                ++report_.machinesUpdated;
+            }
+            machineUpdates_.insert(machine.id(), machine);
+        } else {
+            ++report_.machinesMatched;
+        }
+        machines_.insert(key, machine);
+
+        for (const WebDataReader::CompetencyRecord& competency : record.competencies) {
+            planCompetency(areaId, machine.id(), record.name, competency);
+        }
+    }
+
+    void planCompetency(int areaId, int machineId, const QString& machineName,
+                        const WebDataReader::CompetencyRecord& record)
+    {
+        if (record.name.isEmpty()) {
+            note(QString("Competency '%1' in '%2' has no name; skipped").arg(record.id, machineName));
+            return;
+        }
+        int maxScore = record.maxScore;
+        if (maxScore < 0 || maxScore > Constants::SCORE_MAX) {
+            note(QString("Competency '%1' in '%2': max score %3 must be 1-%4; left as is")
+                .arg(record.name, machineName).arg(maxScore).arg(Constants::SCORE_MAX));
+            maxScore = 0;
+        }
+
+        QString key = HierarchyUpserter::competencyKey(machineId, record.name);
+        Competency competency = competencies_.value(key);
+        if (competency.id() == 0) {
+            competency = Competency();
+            competency.setMachineId(machineId);
+            competency.setName(record.name);
+            competency.setMaxScore(maxScore > 0 ? maxScore : Constants::SCORE_MAX);
+            newCompetencies_.append(competency);
+            competency.setId(placeholder(newCompetencies_.size() - 1));
+            ++report_.competenciesAdded;
+        } else if (competency.id() < 0) {
+            if (maxScore > 0) {
+                competency.setMaxScore(maxScore);
+                newCompetencies_[-competency.id() - 1].setMaxScore(maxScore);
+            }
+        } else if (maxScore > 0 && maxScore != competency.maxScore()) {
+            competency.setMaxScore(maxScore);
+            if (!competencyUpdates_.contains(competency.id())) {
+                ++report_.competenciesUpdated;
+            }
+            competencyUpdates_.insert(competency.id(), competency);
+        } else {
+            ++report_.competenciesMatched;
+        }
+        competencies_.insert(key, competency);
+
+        if (!record.id.isEmpty()) {
+            CompetencyRef ref;
+            ref.areaId = areaId;
+            ref.machineId = machineId;
+            ref.competencyId = competency.id();
+            ref.maxScore = competency.maxScore();
+            competencyByFileId_.insert(record.id, ref);
+        }
+    }
+
+    bool writeAssessments()
+    {
+        AssessmentRepository assessmentRepo;
+        if (!assessmentRepo.saveOrUpdateBatch(assessments_, true)) {
+            return writeFailed("assessments", assessmentRepo.lastError());
+        }
+        assessments_.clear();
+        return true;
+    }
+
+    bool writeFailed(const QString& what, const QString& error)
+    {
+        report_.errors << QString("Failed to write %1: %2").arg(what, error);
+        return false;
+    }
+
+private:
+    Report& report_;
+    bool dryRun_;
+    bool inTransaction_;
+
+    // Keyed by lower-case name within the parent; ids may be placeholders
+    QHash<QString, int> areas_;
+    QHash<QString, Machine> machines_;
+    QHash<QString, Competency> competencies_;
+    QHash<QString, Engineer> engineers_;
+    QHash<QString, CompetencyRef> competencyByFileId_;
+    QHash<QString, int> scores_;            // engineer|competency -> score
+
+    QList<ProductionArea> newAreas_;
+    QList<Machine> newMachines_;            // productionAreaId may be a placeholder
+    QList<Competency> newCompetencies_;     // machineId may be a placeholder
+    int writtenAreas_;
+    int writtenMachines_;
+    int writtenCompetencies_;
+    QHash<int, Machine> machineUpdates_;
+    QHash<int, Competency> competencyUpdates_;
+    QList<Engineer> engineerWrites_;
+    QList<Assessment> assessments_;
+    int noteCount_;
+};
+
+/**
+ * @brief Count the elements of an array member without keeping them
+ */
+int countElements(JsonPullParser& parser)
+{
+    if (parser.next() != JsonPullParser::BeginArray) {
+        parser.skipValue();
+        return 0;
+    }
+    int count = 0;
+    for (;;) {
+        JsonPullParser::Token token = parser.next();
+        if (token == JsonPullParser::EndArray || token == JsonPullParser::Error) {
+            return count;
+        }
+        ++count;
+        parser.skipValue();
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Report
+// ============================================================================
+
+bool ProductionDataImporter::Report::hasChanges() const
+{
+    return areasAdded + machinesAdded + machinesUpdated + competenciesAdded + competenciesUpdated
+         + engineersAdded + engineersUpdated + assessments > 0;
+}
+
+QString ProductionDataImporter::Report::summary() const
+{
+    QStringList lines;
+    if (!success) {
+        lines << "Import failed; nothing was written.";
+    } else if (dryRun) {
+        lines << (hasChanges() ? "Dry run: nothing was written. The import would make these changes:"
+                               : "Dry run: the database already matches the file.");
+    } else {
+        lines << QString("Import committed in %1 ms.").arg(elapsedMs);
+    }
+
+    lines << QString("Production areas: %1 new, %2 existing").arg(areasAdded).arg(areasMatched);
+    lines << QString("Machines: %1 new, %2 updated, %3 unchanged").arg(machinesAdded).arg(machinesUpdated).arg(machinesMatched);
+    lines << QString("Competencies: %1 new, %2 updated, %3 unchanged")
+        .arg(competenciesAdded).arg(competenciesUpdated).arg(competenciesMatched);
+    lines << QString("Engineers: %1 new, %2 updated, %3 unchanged").arg(engineersAdded).arg(engineersUpdated).arg(engineersMatched);
+    lines << QString("Assessments: %1 new or changed, %2 unchanged").arg(assessments).arg(assessmentsMatched);
+
+    if (!errors.isEmpty()) {
+        lines << "" << "Errors:";
+        for (const QString& error : errors) {
+            lines << "  " + error;
+        }
+    }
+    if (!notes.isEmpty()) {
+        lines << "" << "Notes:";
+        for (const QString& note : notes) {
+            lines << "  " + note;
+        }
+    }
+    return lines.join('\n');
+}
+
+// ============================================================================
+// ProductionDataImporter
+// ============================================================================
+
+ProductionDataImporter::ProductionDataImporter()
+    : dryRun_(false)
+{
+}
+
+ProductionDataImporter::~ProductionDataImporter()
+{
+}
+
+ProductionDataImporter::Report ProductionDataImporter::importFile(const QString& filePath)
+{
+    Report report;
+    report.dryRun = dryRun_;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        report.errors << QString("Cannot open %1: %2").arg(filePath, file.errorString());
+        return report;
+    }
+
+    SeedPlan plan(report, dryRun_);
+    if (!plan.loadDatabase()) {
+        return report;
+    }
+
+    JsonPullParser parser(&file);
+    if (parser.next() != JsonPullParser::BeginObject) {
+        report.errors << (parser.hasError() ? "Invalid JSON: " + parser.errorString()
+                                            : QString("Expected a JSON object at the top level"));
+        return report;
+    }
+
+    bool ok = true;
+    QStringList problems;
+    while (ok && parser.next() == JsonPullParser::Key) {
+        QString section = parser.string();
+        if (section == QLatin1String("productionAreas")) {
+            if (WebDataReader::expectContainer(parser, JsonPullParser::BeginArray, section, problems)) {
+                while (ok && WebDataReader::nextObject(parser, section, problems)) {
+                    WebDataReader::AreaRecord area;
+                    ok = WebDataReader::readArea(parser, area, problems);
+                    if (ok) {
+                        plan.planArea(area);
+                    }
+                }
+            }
+        } else if (section == QLatin1String("engineers")) {
+            if (WebDataReader::expectContainer(parser, JsonPullParser::BeginArray, section, problems)) {
+                while (ok && WebDataReader::nextObject(parser, section, problems)) {
+                    Engineer engineer;
+                    ok = WebDataReader::readEngineer(parser, engineer);
+                    if (ok) {
+                        plan.planEngineer(engineer);
+                    }
+                }
+            }
+        } else if (section == QLatin1String("assessments")) {
+            if (WebDataReader::expectContainer(parser, JsonPullParser::BeginObject, section, problems)) {
+                ok = plan.flush();
+                while (ok && parser.next() == JsonPullParser::Key) {
+                    QString key = parser.string();
+                    int score = 0;
+                    bool scored = WebDataReader::readScore(parser, score);
+                    ok = plan.planAssessment(key, scored, score);
+                }
+            }
+        } else if (section == QLatin1String("users")) {
+            int users = countElements(parser);
+            if (users > 0) {
+                plan.note(QString("%1 web app user account(s) not imported; desktop accounts are managed in the app").arg(users));
+            }
+        } else if (section == QLatin1String("certifications")) {
+            int certifications = countElements(parser);
+            if (certifications > 0) {
+                plan.note(QString("%1 certification catalog entries not imported; the desktop app records "
+                                  "certifications per engineer").arg(certifications));
+            }
+        } else if (section == QLatin1String("snapshots")) {
+            int snapshots = countElements(parser);
+            if (snapshots > 0) {
+                plan.note(QString("%1 snapshot(s) not imported").arg(snapshots));
+            }
+        } else if (section == QLatin1String("version")) {
+            LOG_INFO("ProductionDataImporter", "Data file version " + WebDataReader::readScalar(parser));
+        } else {
+            ok = parser.skipValue();
+        }
+
+        for (const QString& problem : problems) {
+            plan.note(problem);
+        }
+        problems.clear();
+        ok = ok && !parser.hasError();
+    }
+
+    if (!parser.hasError() && ok) {
+        parser.next();  // past the closing brace: only EndDocument is acceptable
+    }
+    if (parser.hasError()) {
+        report.errors << "Invalid JSON: " + parser.errorString();
+    }
+
+    if (report.errors.isEmpty() && plan.flush() && plan.commit()) {
+        report.success = true;
+    } else {
+        plan.rollback();
+    }
+
+    report.elapsedMs = timer.elapsed();
+    Logger::instance().info("ProductionDataImporter", QString("%1 %2: %3")
+        .arg(dryRun_ ? "Dry run of" : "Import of", filePath,
+             report.success ? QString("%1 ms").arg(report.elapsedMs) : report.errors.join("; ")));
+    return report;
+}
@@ -0,0 +1,65 @@
+#ifndef PRODUCTIONDATAIMPORTER_H
+#define PRODUCTIONDATAIMPORTER_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Native loader for production-data-import.json (replaces import-data.cjs)
+ *
+ * Seeds a site from the web app's data file. The file is pull-parsed;
+ * areas, machines and competencies are matched by name within their parent
+ * and engineers by id through in-memory maps built from one read of the
+ * database, so nothing is looked up row by row. New and changed rows are
+ * then written with set-based OPENJSON statements inside one transaction:
+ * the site is seeded completely or not at all. Assessments (keyed with the
+ * file's ids) resolve through the same maps and stream into that
+ * transaction in IMPORT_BATCH_SIZE batches; the file must list the
+ * hierarchy and engineers before them, as the web app does.
+ *
+ * A dry run parses and resolves everything and reports what would change
+ * without writing. Users (the web app's own accounts), the certification
+ * catalog and snapshots are not imported; the report says so.
+ *
+ * Uses the calling thread's database connection.
+ */
+class ProductionDataImporter
+{
+public:
+    struct Report {
+        bool dryRun = false;
+        bool success = false;
+        int areasAdded = 0;
+        int areasMatched = 0;
+        int machinesAdded = 0;
+        int machinesUpdated = 0;
+        int machinesMatched = 0;
+        int competenciesAdded = 0;
+        int competenciesUpdated = 0;
+        int competenciesMatched = 0;
+        int engineersAdded = 0;
+        int engineersUpdated = 0;
+        int engineersMatched = 0;
+        int assessments = 0;       // inserted or score changed (dry run: would be)
+        int assessmentsMatched = 0;
+        QStringList notes;         // skipped sections and rejected records
+        QStringList errors;        // why the import stopped; nothing was written
+        qint64 elapsedMs = 0;
+
+        bool hasChanges() const;
+        QString summary() const;
+    };
+
+    ProductionDataImporter();
+    ~ProductionDataImporter();
+
+    void setDryRun(bool dryRun) { dryRun_ = dryRun; }
+    bool isDryRun() const { return dryRun_; }
+
+    Report importFile(const QString& filePath);
+
+private:
+    bool dryRun_;
+};
+
+#endif // PRODUCTIONDATAIMPORTER_H
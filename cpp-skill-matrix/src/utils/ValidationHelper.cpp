@@ -92,6 +92,45 @@ bool ValidationHelper::validateRange(int value, int min, int max,
     return true;
 }
 
+bool ValidationHelper::parseWhole(QByteArrayView text, int& value)
+{
+    // Straight from the bytes: this runs for every score cell of an import
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    while (end > p && end[-1] == ' ') {
+        --end;
+    }
+
+    bool negative = p < end && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+
+    qint64 number = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        number = number * 10 + (*p++ - '0');
+        if (number > 1000000000) {
+            return false;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && *p == '0'; ++p) {
+        }
+    }
+    if (p != end) {
+        return false;
+    }
+
+    value = int(negative ? -number : number);
+    return true;
+}
+
 QString ValidationHelper::sanitize(const QString& str)
 {
     QString sanitized = str;
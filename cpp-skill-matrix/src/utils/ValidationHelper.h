@@ -2,6 +2,7 @@
 #define VALIDATIONHELPER_H
 
 #include <QString>
+#include <QByteArrayView>
 #include <QRegularExpression>
 
 /**
@@ -86,6 +87,14 @@ public:
     static bool validateRange(int value, int min, int max,
                              const QString& fieldName, QString& errorMessage);
 
+    /**
+     * @brief Parse a whole number as CSV files and Excel cells hold it
+     * @param text Digits with an optional sign, surrounding spaces and a zero fraction ("3", " 3 ", "3.0")
+     * @param value Output value (unchanged on failure)
+     * @return true if text is a whole number within +-1e9
+     */
+    static bool parseWhole(QByteArrayView text, int& value);
+
     /**
      * @brief Sanitize string (remove dangerous characters)
      * @param str String to sanitize
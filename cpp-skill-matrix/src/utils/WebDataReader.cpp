@@ -0,0 +1,186 @@
+#include "WebDataReader.h"
+#include "ValidationHelper.h"
+#include <cmath>
+
+bool WebDataReader::readArea(JsonPullParser& parser, AreaRecord& area, QStringList& problems)
+{
+    while (parser.next() == JsonPullParser::Key) {
+        QString key = parser.string();
+        if (key == QLatin1String("id")) {
+            area.id = readScalar(parser);
+        } else if (key == QLatin1String("name")) {
+            area.name = ValidationHelper::sanitize(readScalar(parser));
+        } else if (key == QLatin1String("machines")) {
+            if (!expectContainer(parser, JsonPullParser::BeginArray, "machines", problems)) {
+                continue;
+            }
+            while (nextObject(parser, "machines", problems)) {
+                MachineRecord machine;
+                while (parser.next() == JsonPullParser::Key) {
+                    QString machineKey = parser.string();
+                    if (machineKey == QLatin1String("id")) {
+                        machine.id = readScalar(parser);
+                    } else if (machineKey == QLatin1String("name")) {
+                        machine.name = ValidationHelper::sanitize(readScalar(parser));
+                    } else if (machineKey == QLatin1String("importance")) {
+                        toWhole(readScalar(parser), machine.importance);
+                    } else if (machineKey == QLatin1String("competencies")) {
+                        if (!expectContainer(parser, JsonPullParser::BeginArray, "competencies", problems)) {
+                            continue;
+                        }
+                        while (nextObject(parser, "competencies", problems)) {
+                            CompetencyRecord competency;
+                            while (parser.next() == JsonPullParser::Key) {
+                                QString competencyKey = parser.string();
+                                if (competencyKey == QLatin1String("id")) {
+                                    competency.id = readScalar(parser);
+                                } else if (competencyKey == QLatin1String("name")) {
+                                    competency.name = ValidationHelper::sanitize(readScalar(parser));
+                                } else if (competencyKey == QLatin1String("maxScore")) {
+                                    toWhole(readScalar(parser), competency.maxScore);
+                                } else {
+                                    parser.skipValue();
+                                }
+                            }
+                            machine.competencies.append(competency);
+                        }
+                    } else {
+                        parser.skipValue();
+                    }
+                }
+                area.machines.append(machine);
+            }
+        } else {
+            parser.skipValue();
+        }
+    }
+    return !parser.hasError();
+}
+
+bool WebDataReader::readEngineer(JsonPullParser& parser, Engineer& engineer)
+{
+    while (parser.next() == JsonPullParser::Key) {
+        QString key = parser.string();
+        if (key == QLatin1String("id")) {
+            engineer.setId(readScalar(parser));
+        } else if (key == QLatin1String("name")) {
+            engineer.setName(ValidationHelper::sanitize(readScalar(parser)));
+        } else if (key == QLatin1String("shift")) {
+            engineer.setShift(readScalar(parser));
+        } else {
+            parser.skipValue();
+        }
+    }
+    return !parser.hasError();
+}
+
+bool WebDataReader::readScore(JsonPullParser& parser, int& score)
+{
+    JsonPullParser::Token token = parser.next();
+    if (token == JsonPullParser::Number) {
+        return toWhole(QString::number(parser.number(), 'g', 17), score);
+    }
+    if (token != JsonPullParser::BeginObject) {
+        parser.skipValue();
+        return false;
+    }
+
+    bool found = false;
+    while (parser.next() == JsonPullParser::Key) {
+        if (parser.string() == QLatin1String("score")) {
+            found = toWhole(readScalar(parser), score);
+        } else {
+            parser.skipValue();
+        }
+    }
+    return found;
+}
+
+bool WebDataReader::splitAssessmentKey(const QString& key, QString& engineerId, QString& competencyId)
+{
+    int competencyAt = key.lastIndexOf('-');
+    int machineAt = competencyAt > 0 ? key.lastIndexOf('-', competencyAt - 1) : -1;
+    int areaAt = machineAt > 0 ? key.lastIndexOf('-', machineAt - 1) : -1;
+    if (areaAt <= 0) {
+        return false;
+    }
+
+    engineerId = key.left(areaAt);
+    competencyId = key.mid(competencyAt + 1);
+    return true;
+}
+
+QString WebDataReader::readScalar(JsonPullParser& parser)
+{
+    switch (parser.next()) {
+    case JsonPullParser::String:
+        return parser.string();
+    case JsonPullParser::Number:
+        return parser.isInteger() ? QString::number(parser.integer()) : QString::number(parser.number(), 'g', 17);
+    case JsonPullParser::Bool:
+        return parser.boolean() ? "true" : "false";
+    case JsonPullParser::BeginObject:
+    case JsonPullParser::BeginArray:
+        parser.skipValue();
+        return QString();
+    default:
+        return QString();
+    }
+}
+
+bool WebDataReader::toWhole(const QString& text, int& value)
+{
+    bool ok = false;
+    double number = text.toDouble(&ok);
+    if (!ok || number != std::floor(number) || std::fabs(number) > 1e9) {
+        return false;
+    }
+    value = int(number);
+    return true;
+}
+
+bool WebDataReader::nextObject(JsonPullParser& parser, const QString& section, QStringList& problems)
+{
+    for (;;) {
+        JsonPullParser::Token token = parser.next();
+        if (token == JsonPullParser::BeginObject) {
+            return true;
+        }
+        if (token == JsonPullParser::EndArray || token == JsonPullParser::Error) {
+            return false;
+        }
+        problems << QString("%1: skipped a value that is not an object").arg(section);
+        parser.skipValue();
+    }
+}
+
+bool WebDataReader::expectContainer(JsonPullParser& parser, JsonPullParser::Token token,
+                                    const QString& section, QStringList& problems)
+{
+    JsonPullParser::Token actual = parser.next();
+    if (actual == token) {
+        return true;
+    }
+
+    // The web app writes an empty map as [] (e.g. "assessments": [])
+    if (token == JsonPullParser::BeginObject && actual == JsonPullParser::BeginArray) {
+        int arrayDepth = parser.depth();
+        if (parser.next() == JsonPullParser::EndArray) {
+            return false;
+        }
+        while (parser.depth() >= arrayDepth) {
+            if (parser.next() == JsonPullParser::Error) {
+                return false;
+            }
+        }
+        problems << QString("'%1' should be an object; skipped").arg(section);
+        return false;
+    }
+
+    if (!parser.hasError()) {
+        problems << QString("'%1' should be %2; skipped")
+            .arg(section, token == JsonPullParser::BeginArray ? "an array" : "an object");
+        parser.skipValue();
+    }
+    return false;
+}
@@ -0,0 +1,93 @@
+#ifndef WEBDATAREADER_H
+#define WEBDATAREADER_H
+
+#include "JsonPullParser.h"
+#include "../models/Engineer.h"
+#include <QString>
+#include <QStringList>
+#include <QList>
+
+/**
+ * @brief Record readers for the web app's data file (production-data-import.json)
+ *
+ * Each reader takes a JsonPullParser positioned just inside the record's
+ * object and consumes it up to its closing brace. Unknown members are
+ * skipped; values of the wrong kind are reported in problems and skipped.
+ */
+class WebDataReader
+{
+public:
+    struct CompetencyRecord {
+        QString id;
+        QString name;
+        int maxScore = 0;      // 0 = not given
+    };
+
+    struct MachineRecord {
+        QString id;
+        QString name;
+        int importance = 0;    // 0 = not given
+        QList<CompetencyRecord> competencies;
+    };
+
+    /**
+     * @brief One production area with its machines (a few hundred rows at most)
+     */
+    struct AreaRecord {
+        QString id;
+        QString name;
+        QList<MachineRecord> machines;
+    };
+
+    /**
+     * @brief Read a production area with its machines and competencies
+     * @return false on a parse error
+     */
+    static bool readArea(JsonPullParser& parser, AreaRecord& area, QStringList& problems);
+
+    /**
+     * @brief Read an engineer ({id, name, shift})
+     * @return false on a parse error
+     */
+    static bool readEngineer(JsonPullParser& parser, Engineer& engineer);
+
+    /**
+     * @brief Score of an assessment value: {"score": n, ...} or a bare number
+     * @return false if the value has no usable score
+     */
+    static bool readScore(JsonPullParser& parser, int& score);
+
+    /**
+     * @brief Split "engineerId-areaId-machineId-competencyId" from the right
+     *
+     * Engineer ids are the only free-form part and may contain hyphens.
+     */
+    static bool splitAssessmentKey(const QString& key, QString& engineerId, QString& competencyId);
+
+    /**
+     * @brief Read the next value as text; objects and arrays are skipped and read as empty
+     */
+    static QString readScalar(JsonPullParser& parser);
+
+    /**
+     * @brief Whole number from a number or numeric string ("3", 3, 3.0)
+     */
+    static bool toWhole(const QString& text, int& value);
+
+    /**
+     * @brief Advance to the next object of an array
+     * @return false at the end of the array or on a parse error; other values are skipped
+     */
+    static bool nextObject(JsonPullParser& parser, const QString& section, QStringList& problems);
+
+    /**
+     * @brief Read a member value's opening token, skipping the value if it is of another kind
+     * @param token JsonPullParser::BeginArray or JsonPullParser::BeginObject
+     *
+     * An empty array where an object is expected reads as an empty object.
+     */
+    static bool expectContainer(JsonPullParser& parser, JsonPullParser::Token token,
+                                const QString& section, QStringList& problems);
+};
+
+#endif // WEBDATAREADER_H
@@ -0,0 +1,364 @@
+#include "XlsxReader.h"
+#include "Logger.h"
+#include "../core/Constants.h"
+#include <QXmlStreamReader>
+#include <QDir>
+
+namespace {
+
+constexpr int READ_CHUNK = 65536;
+constexpr int MAX_COLUMNS = 16384;
+
+const char* OFFICE_DOCUMENT_TYPE = "/officeDocument";
+const char* SHARED_STRINGS_TYPE = "/sharedStrings";
+
+/**
+ * @brief "AB12" -> 27 (0-based column), -1 if there are no letters
+ */
+int columnIndex(QStringView reference)
+{
+    int column = 0;
+    for (QChar c : reference) {
+        if (c >= QLatin1Char('A') && c <= QLatin1Char('Z')) {
+            column = column * 26 + (c.unicode() - 'A' + 1);
+        } else {
+            break;
+        }
+    }
+    return column - 1;
+}
+
+/**
+ * @brief The relationship id of a <sheet> (r:id, in whichever namespace the file uses)
+ */
+QString relationshipId(const QXmlStreamAttributes& attributes)
+{
+    for (const QXmlStreamAttribute& attribute : attributes) {
+        if (attribute.name() == QLatin1String("id") && !attribute.namespaceUri().isEmpty()) {
+            return attribute.value().toString();
+        }
+    }
+    return QString();
+}
+
+} // namespace
+
+XlsxReader::XlsxReader()
+{
+}
+
+XlsxReader::~XlsxReader()
+{
+    close();
+}
+
+bool XlsxReader::open(const QString& filePath)
+{
+    close();
+    lastError_.clear();
+
+    file_.reset(new QFile(filePath));
+    if (!file_->open(QIODevice::ReadOnly)) {
+        QString error = "Cannot open " + filePath + ": " + file_->errorString();
+        file_.reset();
+        return fail(error);
+    }
+
+    zip_.reset(new ZipReader(file_.get()));
+    if (!zip_->open()) {
+        QString error = filePath + " is not an Excel workbook: " + zip_->lastError();
+        close();
+        return fail(error);
+    }
+
+    if (!readWorkbook()) {
+        close();
+        return false;
+    }
+
+    LOG_DEBUG("XlsxReader", QString("Opened %1: %2 sheets, %3 shared strings")
+        .arg(filePath).arg(sheetNames_.size()).arg(sharedStrings_.size()));
+    return true;
+}
+
+void XlsxReader::close()
+{
+    zip_.reset();
+    file_.reset();
+    sheetNames_.clear();
+    sheetEntries_.clear();
+    sharedStrings_.clear();
+}
+
+QString XlsxReader::findSheet(const QString& name) const
+{
+    for (const QString& sheet : sheetNames_) {
+        if (sheet.compare(name, Qt::CaseInsensitive) == 0) {
+            return sheet;
+        }
+    }
+    return QString();
+}
+
+bool XlsxReader::readSheet(const QString& sheetName, const RowVisitor& visitor)
+{
+    if (!zip_) {
+        return fail("Workbook is not open");
+    }
+    QString entry = sheetEntries_.value(sheetName);
+    if (entry.isEmpty()) {
+        return fail("No sheet named " + sheetName);
+    }
+
+    QStringList cells;
+    int rowNumber = 0;
+    int column = 0;
+    int nextColumn = 0;
+    QString type;
+    QString value;
+    bool inValue = false;
+    bool inInline = false;
+    int phoneticDepth = 0;
+    bool badCell = false;
+
+    bool ok = parseEntry(entry, [&](QXmlStreamReader& xml) {
+        switch (xml.tokenType()) {
+        case QXmlStreamReader::StartElement: {
+            QStringView name = xml.name();
+            if (name == QLatin1String("row")) {
+                QStringView r = xml.attributes().value(QLatin1String("r"));
+                rowNumber = r.isEmpty() ? rowNumber + 1 : r.toInt();
+                cells.clear();
+                nextColumn = 0;
+            } else if (name == QLatin1String("c")) {
+                int index = columnIndex(xml.attributes().value(QLatin1String("r")));
+                column = index >= 0 ? index : nextColumn;
+                type = xml.attributes().value(QLatin1String("t")).toString();
+                value.clear();
+            } else if (name == QLatin1String("v")) {
+                inValue = true;
+            } else if (name == QLatin1String("is")) {
+                inInline = true;
+            } else if (name == QLatin1String("t") && inInline) {
+                inValue = true;
+            } else if (name == QLatin1String("rPh")) {
+                ++phoneticDepth;
+            }
+            break;
+        }
+
+        case QXmlStreamReader::Characters:
+            if (inValue && phoneticDepth == 0) {
+                value.append(xml.text());
+            }
+            break;
+
+        case QXmlStreamReader::EndElement: {
+            QStringView name = xml.name();
+            if (name == QLatin1String("v") || name == QLatin1String("t")) {
+                inValue = false;
+            } else if (name == QLatin1String("rPh")) {
+                --phoneticDepth;
+            } else if (name == QLatin1String("is")) {
+                inInline = false;
+            } else if (name == QLatin1String("c")) {
+                if (column >= MAX_COLUMNS) {
+                    badCell = true;
+                    return false;
+                }
+                if (type == QLatin1String("s")) {
+                    bool isIndex = false;
+                    int index = value.toInt(&isIndex);
+                    if (!isIndex || index < 0 || index >= sharedStrings_.size()) {
+                        badCell = true;
+                        return false;
+                    }
+                    value = sharedStrings_.at(index);
+                }
+                while (cells.size() < column) {
+                    cells.append(QString());
+                }
+                if (cells.size() == column) {
+                    cells.append(value);
+                } else {
+                    cells[column] = value;
+                }
+                nextColumn = column + 1;
+            } else if (name == QLatin1String("row")) {
+                return visitor(rowNumber, cells);
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+        return true;
+    });
+
+    if (badCell) {
+        return fail(QString("Sheet %1 row %2: invalid cell").arg(sheetName).arg(rowNumber));
+    }
+    return ok;
+}
+
+bool XlsxReader::parseEntry(const QString& entryName, const TokenHandler& handler)
+{
+    if (!zip_->openEntry(entryName)) {
+        return fail(zip_->lastError());
+    }
+
+    // Feed the tokenizer one inflated chunk at a time; it reports a premature
+    // end whenever it needs more input
+    QXmlStreamReader xml;
+    QByteArray buffer(READ_CHUNK, Qt::Uninitialized);
+    bool moreInput = true;
+
+    for (;;) {
+        xml.readNext();
+
+        if (xml.hasError()) {
+            if (xml.error() == QXmlStreamReader::PrematureEndOfDocumentError && moreInput) {
+                qint64 got = zip_->read(buffer.data(), buffer.size());
+                if (got < 0) {
+                    return fail(zip_->lastError());
+                }
+                if (got == 0) {
+                    moreInput = false;
+                } else {
+                    xml.addData(QByteArray(buffer.constData(), int(got)));
+                }
+                continue;
+            }
+            return fail(QString("%1: %2 (line %3)").arg(entryName, xml.errorString()).arg(xml.lineNumber()));
+        }
+
+        if (xml.isEndDocument()) {
+            return true;
+        }
+        if (!handler(xml)) {
+            return true;
+        }
+    }
+}
+
+bool XlsxReader::readWorkbook()
+{
+    // Package relationships name the workbook part (normally xl/workbook.xml)
+    QString workbookEntry = "xl/workbook.xml";
+    if (zip_->contains("_rels/.rels")) {
+        bool ok = parseEntry("_rels/.rels", [&](QXmlStreamReader& xml) {
+            if (xml.isStartElement() && xml.name() == QLatin1String("Relationship")
+                && xml.attributes().value(QLatin1String("Type")).endsWith(QLatin1String(OFFICE_DOCUMENT_TYPE))) {
+                workbookEntry = resolveTarget(QString(), xml.attributes().value(QLatin1String("Target")).toString());
+                return false;
+            }
+            return true;
+        });
+        if (!ok) {
+            return false;
+        }
+    }
+
+    QString baseDir = workbookEntry.section('/', 0, -2);
+    QString relsEntry = (baseDir.isEmpty() ? QString() : baseDir + "/") + "_rels/"
+                        + workbookEntry.section('/', -1) + ".rels";
+
+    QHash<QString, QString> targets;
+    QString sharedStringsEntry;
+    bool ok = parseEntry(relsEntry, [&](QXmlStreamReader& xml) {
+        if (xml.isStartElement() && xml.name() == QLatin1String("Relationship")) {
+            QXmlStreamAttributes attributes = xml.attributes();
+            QString target = resolveTarget(baseDir, attributes.value(QLatin1String("Target")).toString());
+            targets.insert(attributes.value(QLatin1String("Id")).toString(), target);
+            if (attributes.value(QLatin1String("Type")).endsWith(QLatin1String(SHARED_STRINGS_TYPE))) {
+                sharedStringsEntry = target;
+            }
+        }
+        return true;
+    });
+    if (!ok) {
+        return false;
+    }
+
+    ok = parseEntry(workbookEntry, [&](QXmlStreamReader& xml) {
+        if (xml.isStartElement() && xml.name() == QLatin1String("sheet")) {
+            QString name = xml.attributes().value(QLatin1String("name")).toString();
+            QString target = targets.value(relationshipId(xml.attributes()));
+            if (!name.isEmpty() && !target.isEmpty()) {
+                sheetNames_.append(name);
+                sheetEntries_.insert(name, target);
+            }
+        }
+        return true;
+    });
+    if (!ok) {
+        return false;
+    }
+
+    // A workbook without text cells may have no shared string table
+    if (!sharedStringsEntry.isEmpty() && zip_->contains(sharedStringsEntry)) {
+        // The whole table is kept in memory, unlike sheets, which are streamed
+        if (zip_->entrySize(sharedStringsEntry) > Constants::IMPORT_MAX_SHARED_STRINGS_BYTES) {
+            return fail(QString("Shared string table is too large (%1 bytes)")
+                .arg(zip_->entrySize(sharedStringsEntry)));
+        }
+        return readSharedStrings(sharedStringsEntry);
+    }
+    return true;
+}
+
+bool XlsxReader::readSharedStrings(const QString& entryName)
+{
+    // <si> holds either one <t> or rich-text runs (<r><t>); phonetic hints (<rPh>) are skipped
+    QString text;
+    bool inText = false;
+    int phoneticDepth = 0;
+
+    return parseEntry(entryName, [&](QXmlStreamReader& xml) {
+        switch (xml.tokenType()) {
+        case QXmlStreamReader::StartElement:
+            if (xml.name() == QLatin1String("si")) {
+                text.clear();
+            } else if (xml.name() == QLatin1String("t")) {
+                inText = phoneticDepth == 0;
+            } else if (xml.name() == QLatin1String("rPh")) {
+                ++phoneticDepth;
+            }
+            break;
+        case QXmlStreamReader::Characters:
+            if (inText) {
+                text.append(xml.text());
+            }
+            break;
+        case QXmlStreamReader::EndElement:
+            if (xml.name() == QLatin1String("t")) {
+                inText = false;
+            } else if (xml.name() == QLatin1String("rPh")) {
+                --phoneticDepth;
+            } else if (xml.name() == QLatin1String("si")) {
+                sharedStrings_.append(text);
+            }
+            break;
+        default:
+            break;
+        }
+        return true;
+    });
+}
+
+QString XlsxReader::resolveTarget(const QString& baseDir, const QString& target)
+{
+    // Targets are relative to the part's folder, or absolute from the package root
+    if (target.startsWith('/')) {
+        return QDir::cleanPath(target.mid(1));
+    }
+    return QDir::cleanPath(baseDir.isEmpty() ? target : baseDir + "/" + target);
+}
+
+bool XlsxReader::fail(const QString& error)
+{
+    lastError_ = error;
+    Logger::instance().error("XlsxReader", error);
+    return false;
+}
@@ -0,0 +1,75 @@
+#ifndef XLSXREADER_H
+#define XLSXREADER_H
+
+#include "ZipReader.h"
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QFile>
+#include <functional>
+#include <memory>
+
+class QXmlStreamReader;
+
+/**
+ * @brief Streaming (SAX-style) XLSX workbook reader
+ *
+ * open() reads the sheet list and the shared string table; readSheet() then
+ * inflates and tokenizes one worksheet incrementally, handing each row to a
+ * visitor as soon as it closes. Rows are never accumulated, so sheets of
+ * any size are read in constant memory.
+ *
+ * Cells are returned as text: shared/inline strings as written, numbers in
+ * their stored form ("3", "2.5"), booleans as "1"/"0". Cell positions come
+ * from the r attribute, so gaps become empty strings.
+ */
+class XlsxReader
+{
+public:
+    /**
+     * @param rowNumber 1-based row number in the sheet
+     * @param cells Cell text from column A; trailing empty cells are omitted
+     * @return false to stop reading
+     */
+    using RowVisitor = std::function<bool(int rowNumber, const QStringList& cells)>;
+
+    XlsxReader();
+    ~XlsxReader();
+
+    bool open(const QString& filePath);
+    void close();
+
+    QStringList sheetNames() const { return sheetNames_; }
+
+    /**
+     * @brief Case-insensitive sheet lookup; empty if not present
+     */
+    QString findSheet(const QString& name) const;
+
+    /**
+     * @brief Stream a sheet's rows to a visitor
+     * @return false on read/parse error (stopping early is not an error)
+     */
+    bool readSheet(const QString& sheetName, const RowVisitor& visitor);
+
+    QString lastError() const { return lastError_; }
+
+private:
+    using TokenHandler = std::function<bool(QXmlStreamReader& xml)>;
+
+    bool parseEntry(const QString& entryName, const TokenHandler& handler);
+    bool readWorkbook();
+    bool readSharedStrings(const QString& entryName);
+    static QString resolveTarget(const QString& baseDir, const QString& target);
+    bool fail(const QString& error);
+
+private:
+    std::unique_ptr<QFile> file_;
+    std::unique_ptr<ZipReader> zip_;
+    QStringList sheetNames_;
+    QHash<QString, QString> sheetEntries_;  // sheet name -> archive entry
+    QStringList sharedStrings_;
+    QString lastError_;
+};
+
+#endif // XLSXREADER_H
@@ -0,0 +1,479 @@
+#include "XlsxWriter.h"
+#include "Logger.h"
+#include "../core/Constants.h"
+#include <QDate>
+#include <QDateTime>
+#include <cmath>
+
+namespace {
+
+// SpreadsheetML limits
+constexpr int MAX_ROWS = 1048576;
+constexpr int MAX_COLUMNS = 16384;
+constexpr int MAX_SHEET_NAME = 31;
+
+const char* XML_DECLARATION = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+const char* MAIN_NS = "http://schemas.openxmlformats.org/spreadsheetml/2006/main";
+const char* REL_NS = "http://schemas.openxmlformats.org/officeDocument/2006/relationships";
+
+const char* ROOT_RELS =
+    "<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+    "<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" Target=\"xl/workbook.xml\"/>"
+    "</Relationships>";
+
+// cellXfs order must match XlsxWriter::Style
+const char* STYLES =
+    "<styleSheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+    "<numFmts count=\"2\">"
+    "<numFmt numFmtId=\"164\" formatCode=\"yyyy-mm-dd\"/>"
+    "<numFmt numFmtId=\"165\" formatCode=\"yyyy-mm-dd hh:mm:ss\"/>"
+    "</numFmts>"
+    "<fonts count=\"2\">"
+    "<font><sz val=\"11\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+    "<font><b/><sz val=\"11\"/><name val=\"Calibri\"/><family val=\"2\"/></font>"
+    "</fonts>"
+    "<fills count=\"2\">"
+    "<fill><patternFill patternType=\"none\"/></fill>"
+    "<fill><patternFill patternType=\"gray125\"/></fill>"
+    "</fills>"
+    "<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+    "<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+    "<cellXfs count=\"5\">"
+    "<xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/>"
+    "<xf numFmtId=\"0\" fontId=\"1\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyFont=\"1\"/>"
+    "<xf numFmtId=\"164\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyNumberFormat=\"1\"/>"
+    "<xf numFmtId=\"165\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyNumberFormat=\"1\"/>"
+    "<xf numFmtId=\"2\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\" applyNumberFormat=\"1\"/>"
+    "</cellXfs>"
+    "<cellStyles count=\"1\"><cellStyle name=\"Normal\" xfId=\"0\" builtinId=\"0\"/></cellStyles>"
+    "</styleSheet>";
+
+// Spreadsheet serial dates count days from 1899-12-30
+const QDate SERIAL_EPOCH(1899, 12, 30);
+
+/**
+ * @brief Append text as XML character data (control characters XML 1.0 cannot carry are dropped)
+ */
+void appendEscaped(QByteArray& out, const QString& text)
+{
+    const QByteArray utf8 = text.toUtf8();
+    for (char c : utf8) {
+        switch (c) {
+        case '&': out.append("&amp;"); break;
+        case '<': out.append("&lt;"); break;
+        case '>': out.append("&gt;"); break;
+        case '"': out.append("&quot;"); break;
+        default:
+            if (static_cast<unsigned char>(c) >= 0x20 || c == '\t' || c == '\n' || c == '\r') {
+                out.append(c);
+            }
+        }
+    }
+}
+
+void appendText(QByteArray& out, const QString& text)
+{
+    // Leading/trailing whitespace is dropped by readers unless preserved
+    bool preserve = !text.isEmpty() && (text.front().isSpace() || text.back().isSpace());
+    out.append(preserve ? "<t xml:space=\"preserve\">" : "<t>");
+    appendEscaped(out, text);
+    out.append("</t>");
+}
+
+} // namespace
+
+XlsxWriter::XlsxWriter()
+    : inSheet_(false)
+    , rowCount_(0)
+    , cellCount_(0)
+    , sharedReferences_(0)
+{
+}
+
+XlsxWriter::~XlsxWriter()
+{
+    if (file_) {
+        cancel();
+    }
+}
+
+bool XlsxWriter::open(const QString& filePath)
+{
+    lastError_.clear();
+    sheetNames_.clear();
+    sharedIndex_.clear();
+    sharedStrings_.clear();
+    sharedReferences_ = 0;
+    cellCount_ = 0;
+
+    file_.reset(new QSaveFile(filePath));
+    if (!file_->open(QIODevice::WriteOnly)) {
+        QString error = "Cannot open " + filePath + ": " + file_->errorString();
+        file_.reset();
+        return fail(error);
+    }
+
+    zip_.reset(new ZipWriter(file_.get(), Constants::EXPORT_DEFLATE_LEVEL));
+    buffer_.reserve(Constants::EXPORT_WRITE_BUFFER + 4096);
+    return true;
+}
+
+bool XlsxWriter::beginSheet(const QString& name, const QList<double>& columnWidths, int freezeRows)
+{
+    if (!zip_) {
+        return fail("Workbook is not open");
+    }
+    if (inSheet_ && !endSheet()) {
+        return false;
+    }
+
+    sheetNames_.append(uniqueSheetName(name));
+    if (!zip_->beginEntry(QString("xl/worksheets/sheet%1.xml").arg(sheetNames_.size()))) {
+        return fail(zip_->lastError());
+    }
+    inSheet_ = true;
+    rowCount_ = 0;
+
+    buffer_.append(XML_DECLARATION);
+    buffer_.append("<worksheet xmlns=\"").append(MAIN_NS).append("\" xmlns:r=\"").append(REL_NS).append("\">");
+
+    if (freezeRows > 0) {
+        buffer_.append("<sheetViews><sheetView workbookViewId=\"0\"><pane ySplit=\"")
+               .append(QByteArray::number(freezeRows))
+               .append("\" topLeftCell=\"A").append(QByteArray::number(freezeRows + 1))
+               .append("\" activePane=\"bottomLeft\" state=\"frozen\"/></sheetView></sheetViews>");
+    }
+
+    if (!columnWidths.isEmpty()) {
+        buffer_.append("<cols>");
+        for (int i = 0; i < columnWidths.size() && i < MAX_COLUMNS; ++i) {
+            QByteArray index = QByteArray::number(i + 1);
+            buffer_.append("<col min=\"").append(index).append("\" max=\"").append(index)
+                   .append("\" width=\"").append(QByteArray::number(columnWidths[i], 'f', 1))
+                   .append("\" customWidth=\"1\"/>");
+        }
+        buffer_.append("</cols>");
+    }
+
+    buffer_.append("<sheetData>");
+    return true;
+}
+
+bool XlsxWriter::addRow(const QVariantList& cells, Style style)
+{
+    if (!inSheet_) {
+        return fail("No sheet started");
+    }
+    if (rowCount_ >= MAX_ROWS) {
+        return fail(QString("Sheet %1 exceeds %2 rows").arg(sheetNames_.last()).arg(MAX_ROWS));
+    }
+    if (cells.size() > MAX_COLUMNS) {
+        return fail(QString("Sheet %1 exceeds %2 columns").arg(sheetNames_.last()).arg(MAX_COLUMNS));
+    }
+
+    ++rowCount_;
+    buffer_.append("<row r=\"").append(QByteArray::number(rowCount_)).append("\">");
+    for (int column = 0; column < cells.size(); ++column) {
+        appendCell(column, cells[column], style);
+    }
+    buffer_.append("</row>");
+
+    return flushBuffer(false);
+}
+
+bool XlsxWriter::close()
+{
+    if (!zip_) {
+        return fail("Workbook is not open");
+    }
+    if (inSheet_ && !endSheet()) {
+        cancel();
+        return false;
+    }
+    if (sheetNames_.isEmpty()) {
+        // A workbook needs at least one sheet to open
+        if (!beginSheet("Sheet1") || !endSheet()) {
+            cancel();
+            return false;
+        }
+    }
+
+    bool ok = writeSharedStrings()
+        && writePart("xl/styles.xml", QByteArray(XML_DECLARATION) + STYLES)
+        && writePart("xl/workbook.xml", workbookXml())
+        && writePart("xl/_rels/workbook.xml.rels", workbookRelsXml())
+        && writePart("_rels/.rels", QByteArray(XML_DECLARATION) + ROOT_RELS)
+        && writePart("[Content_Types].xml", contentTypesXml());
+
+    if (ok && !zip_->finish()) {
+        ok = fail(zip_->lastError());
+    }
+    if (!ok) {
+        cancel();
+        return false;
+    }
+
+    zip_.reset();
+    if (!file_->commit()) {
+        QString error = "Failed to save " + file_->fileName() + ": " + file_->errorString();
+        file_.reset();
+        return fail(error);
+    }
+    file_.reset();
+
+    LOG_DEBUG("XlsxWriter", QString("Wrote %1 sheets, %2 cells, %3 shared strings")
+        .arg(sheetNames_.size()).arg(cellCount_).arg(sharedStrings_.size()));
+    return true;
+}
+
+void XlsxWriter::cancel()
+{
+    zip_.reset();
+    if (file_) {
+        file_->cancelWriting();
+        file_.reset();
+    }
+    buffer_.clear();
+    inSheet_ = false;
+}
+
+bool XlsxWriter::endSheet()
+{
+    buffer_.append("</sheetData></worksheet>");
+    inSheet_ = false;
+    return flushBuffer(true);
+}
+
+bool XlsxWriter::flushBuffer(bool force)
+{
+    if (buffer_.isEmpty() || (!force && buffer_.size() < Constants::EXPORT_WRITE_BUFFER)) {
+        return true;
+    }
+
+    bool ok = zip_->write(buffer_);
+    buffer_.clear();  // keeps its capacity
+    return ok || fail(zip_->lastError());
+}
+
+bool XlsxWriter::writePart(const QString& name, const QByteArray& xml)
+{
+    if (!zip_->beginEntry(name) || !zip_->write(xml)) {
+        return fail(zip_->lastError());
+    }
+    return true;
+}
+
+void XlsxWriter::appendCell(int column, const QVariant& value, Style style)
+{
+    if (value.isNull() || !value.isValid()) {
+        return;
+    }
+
+    QByteArray reference = columnName(column) + QByteArray::number(rowCount_);
+    auto beginCell = [this, &reference](Style cellStyle, const char* type) {
+        buffer_.append("<c r=\"").append(reference).append('"');
+        if (cellStyle != Default) {
+            buffer_.append(" s=\"").append(QByteArray::number(int(cellStyle))).append('"');
+        }
+        if (type) {
+            buffer_.append(" t=\"").append(type).append('"');
+        }
+        buffer_.append('>');
+    };
+
+    switch (value.typeId()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+        beginCell(style, nullptr);
+        buffer_.append("<v>").append(QByteArray::number(value.toLongLong())).append("</v></c>");
+        break;
+
+    case QMetaType::Double:
+    case QMetaType::Float: {
+        double number = value.toDouble();
+        if (!std::isfinite(number)) {
+            return;
+        }
+        beginCell(style, nullptr);
+        buffer_.append("<v>").append(QByteArray::number(number, 'g', 15)).append("</v></c>");
+        break;
+    }
+
+    case QMetaType::Bool:
+        beginCell(style, "b");
+        buffer_.append(value.toBool() ? "<v>1</v></c>" : "<v>0</v></c>");
+        break;
+
+    case QMetaType::QDate: {
+        QDate date = value.toDate();
+        if (!date.isValid()) {
+            return;
+        }
+        beginCell(Date, nullptr);
+        buffer_.append("<v>").append(QByteArray::number(SERIAL_EPOCH.daysTo(date))).append("</v></c>");
+        break;
+    }
+
+    case QMetaType::QDateTime: {
+        QDateTime dateTime = value.toDateTime().toLocalTime();
+        if (!dateTime.isValid()) {
+            return;
+        }
+        double serial = SERIAL_EPOCH.daysTo(dateTime.date()) + dateTime.time().msecsSinceStartOfDay() / 86400000.0;
+        beginCell(DateTime, nullptr);
+        buffer_.append("<v>").append(QByteArray::number(serial, 'f', 8)).append("</v></c>");
+        break;
+    }
+
+    default: {
+        QString text = value.toString();
+        if (text.isEmpty()) {
+            return;
+        }
+
+        auto it = sharedIndex_.constFind(text);
+        if (it == sharedIndex_.constEnd() && sharedStrings_.size() < Constants::EXPORT_SHARED_STRINGS_MAX) {
+            it = sharedIndex_.insert(text, sharedStrings_.size());
+            sharedStrings_.append(text);
+        }
+
+        if (it != sharedIndex_.constEnd()) {
+            ++sharedReferences_;
+            beginCell(style, "s");
+            buffer_.append("<v>").append(QByteArray::number(it.value())).append("</v></c>");
+        } else {
+            // Table is full: keep memory bounded by writing the string in the cell
+            beginCell(style, "inlineStr");
+            buffer_.append("<is>");
+            appendText(buffer_, text);
+            buffer_.append("</is></c>");
+        }
+        break;
+    }
+    }
+
+    ++cellCount_;
+}
+
+const QByteArray& XlsxWriter::columnName(int column)
+{
+    // A..Z, AA..ZZ, AAA..XFD; built once per column index
+    while (columnNames_.size() <= column) {
+        int n = columnNames_.size() + 1;
+        QByteArray name;
+        while (n > 0) {
+            int remainder = (n - 1) % 26;
+            name.prepend(char('A' + remainder));
+            n = (n - 1) / 26;
+        }
+        columnNames_.append(name);
+    }
+    return columnNames_[column];
+}
+
+QString XlsxWriter::uniqueSheetName(const QString& name) const
+{
+    QString base;
+    for (QChar c : name) {
+        base.append(QString("[]:*?/\\").contains(c) ? QChar('_') : c);
+    }
+    base = base.trimmed().left(MAX_SHEET_NAME);
+    if (base.isEmpty()) {
+        base = "Sheet";
+    }
+
+    // Sheet names are compared case-insensitively
+    QString candidate = base;
+    for (int suffix = 2; sheetNames_.contains(candidate, Qt::CaseInsensitive); ++suffix) {
+        QString tag = QString(" (%1)").arg(suffix);
+        candidate = base.left(MAX_SHEET_NAME - tag.size()) + tag;
+    }
+    return candidate;
+}
+
+QByteArray XlsxWriter::workbookXml() const
+{
+    QByteArray xml(XML_DECLARATION);
+    xml.append("<workbook xmlns=\"").append(MAIN_NS).append("\" xmlns:r=\"").append(REL_NS).append("\"><sheets>");
+    for (int i = 0; i < sheetNames_.size(); ++i) {
+        QByteArray id = QByteArray::number(i + 1);
+        xml.append("<sheet name=\"");
+        appendEscaped(xml, sheetNames_[i]);
+        xml.append("\" sheetId=\"").append(id).append("\" r:id=\"rId").append(id).append("\"/>");
+    }
+    xml.append("</sheets></workbook>");
+    return xml;
+}
+
+QByteArray XlsxWriter::workbookRelsXml() const
+{
+    // rId1..n are the sheets, then styles and shared strings
+    const char* type = "http://schemas.openxmlformats.org/officeDocument/2006/relationships/";
+    int count = sheetNames_.size();
+
+    QByteArray xml(XML_DECLARATION);
+    xml.append("<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">");
+    for (int i = 1; i <= count; ++i) {
+        xml.append("<Relationship Id=\"rId").append(QByteArray::number(i))
+           .append("\" Type=\"").append(type).append("worksheet\" Target=\"worksheets/sheet")
+           .append(QByteArray::number(i)).append(".xml\"/>");
+    }
+    xml.append("<Relationship Id=\"rId").append(QByteArray::number(count + 1))
+       .append("\" Type=\"").append(type).append("styles\" Target=\"styles.xml\"/>");
+    xml.append("<Relationship Id=\"rId").append(QByteArray::number(count + 2))
+       .append("\" Type=\"").append(type).append("sharedStrings\" Target=\"sharedStrings.xml\"/>");
+    xml.append("</Relationships>");
+    return xml;
+}
+
+QByteArray XlsxWriter::contentTypesXml() const
+{
+    const char* prefix = "application/vnd.openxmlformats-officedocument.spreadsheetml.";
+
+    QByteArray xml(XML_DECLARATION);
+    xml.append("<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">");
+    xml.append("<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>");
+    xml.append("<Default Extension=\"xml\" ContentType=\"application/xml\"/>");
+    xml.append("<Override PartName=\"/xl/workbook.xml\" ContentType=\"").append(prefix).append("sheet.main+xml\"/>");
+    for (int i = 1; i <= sheetNames_.size(); ++i) {
+        xml.append("<Override PartName=\"/xl/worksheets/sheet").append(QByteArray::number(i))
+           .append(".xml\" ContentType=\"").append(prefix).append("worksheet+xml\"/>");
+    }
+    xml.append("<Override PartName=\"/xl/styles.xml\" ContentType=\"").append(prefix).append("styles+xml\"/>");
+    xml.append("<Override PartName=\"/xl/sharedStrings.xml\" ContentType=\"").append(prefix).append("sharedStrings+xml\"/>");
+    xml.append("</Types>");
+    return xml;
+}
+
+bool XlsxWriter::writeSharedStrings()
+{
+    if (!zip_->beginEntry("xl/sharedStrings.xml")) {
+        return fail(zip_->lastError());
+    }
+
+    buffer_.append(XML_DECLARATION);
+    buffer_.append("<sst xmlns=\"").append(MAIN_NS)
+           .append("\" count=\"").append(QByteArray::number(sharedReferences_))
+           .append("\" uniqueCount=\"").append(QByteArray::number(sharedStrings_.size())).append("\">");
+    for (const QString& text : sharedStrings_) {
+        buffer_.append("<si>");
+        appendText(buffer_, text);
+        buffer_.append("</si>");
+        if (!flushBuffer(false)) {
+            return false;
+        }
+    }
+    buffer_.append("</sst>");
+    return flushBuffer(true);
+}
+
+bool XlsxWriter::fail(const QString& error)
+{
+    lastError_ = error;
+    Logger::instance().error("XlsxWriter", error);
+    return false;
+}
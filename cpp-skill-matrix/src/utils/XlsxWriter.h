@@ -0,0 +1,106 @@
+#ifndef XLSXWRITER_H
+#define XLSXWRITER_H
+
+#include "ZipWriter.h"
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QHash>
+#include <QSaveFile>
+#include <memory>
+
+/**
+ * @brief Streaming XLSX (SpreadsheetML) workbook writer
+ *
+ * Each sheet's XML is generated row by row and deflated straight into the
+ * archive, so a sheet of any size costs only a small write buffer. Strings
+ * go to the shared string table (only distinct values are kept, up to
+ * Constants::EXPORT_SHARED_STRINGS_MAX; later ones are written inline), and
+ * the workbook, styles and shared strings parts are written by close().
+ *
+ * The file is written through QSaveFile: nothing replaces the target path
+ * unless close() succeeds.
+ */
+class XlsxWriter
+{
+public:
+    /**
+     * @brief Cell styles (indexes into the cellXfs of styles.xml)
+     *
+     * QDate and QDateTime values always use Date / DateTime.
+     */
+    enum Style {
+        Default = 0,
+        Header = 1,     // bold
+        Date = 2,       // yyyy-mm-dd
+        DateTime = 3,   // yyyy-mm-dd hh:mm:ss
+        Decimal = 4     // 0.00
+    };
+
+    XlsxWriter();
+    ~XlsxWriter();
+
+    bool open(const QString& filePath);
+
+    /**
+     * @brief Start a new worksheet (ends the current one)
+     * @param name Sheet name; invalid characters are replaced and it is made unique
+     * @param columnWidths Optional widths in characters, from column A
+     * @param freezeRows Number of header rows kept visible when scrolling
+     */
+    bool beginSheet(const QString& name, const QList<double>& columnWidths = QList<double>(),
+                    int freezeRows = 0);
+
+    /**
+     * @brief Append a row to the current sheet
+     *
+     * Numbers, bools, strings, dates and date-times become typed cells;
+     * null/invalid values leave the cell empty.
+     */
+    bool addRow(const QVariantList& cells, Style style = Default);
+
+    /**
+     * @brief Finish the workbook and commit the file
+     */
+    bool close();
+
+    /**
+     * @brief Abandon the workbook; the target file is left untouched
+     */
+    void cancel();
+
+    qint64 cellCount() const { return cellCount_; }
+    QString lastError() const { return lastError_; }
+
+private:
+    bool endSheet();
+    bool flushBuffer(bool force);
+    bool writePart(const QString& name, const QByteArray& xml);
+    void appendCell(int column, const QVariant& value, Style style);
+    const QByteArray& columnName(int column);
+    QString uniqueSheetName(const QString& name) const;
+    QByteArray workbookXml() const;
+    QByteArray workbookRelsXml() const;
+    QByteArray contentTypesXml() const;
+    bool writeSharedStrings();
+    bool fail(const QString& error);
+
+private:
+    std::unique_ptr<QSaveFile> file_;
+    std::unique_ptr<ZipWriter> zip_;
+    QStringList sheetNames_;
+    bool inSheet_;
+    int rowCount_;
+    qint64 cellCount_;
+    QByteArray buffer_;
+    QList<QByteArray> columnNames_;
+
+    // Shared string table: index by value, values in index order
+    QHash<QString, int> sharedIndex_;
+    QStringList sharedStrings_;
+    qint64 sharedReferences_;
+
+    QString lastError_;
+};
+
+#endif // XLSXWRITER_H
@@ -0,0 +1,273 @@
+#include "ZipReader.h"
+#include "Logger.h"
+#include "../core/Constants.h"
+#include <zlib.h>
+
+namespace {
+
+constexpr quint32 LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr quint32 CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr quint32 END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+constexpr int END_OF_CENTRAL_DIRECTORY_SIZE = 22;
+constexpr int MAX_COMMENT = 0xffff;
+constexpr quint16 FLAG_ENCRYPTED = 0x0001;
+constexpr quint16 METHOD_STORED = 0;
+constexpr quint16 METHOD_DEFLATE = 8;
+constexpr int IN_CHUNK = 65536;
+
+quint16 get16(const char* p)
+{
+    const uchar* u = reinterpret_cast<const uchar*>(p);
+    return quint16(u[0] | (u[1] << 8));
+}
+
+quint32 get32(const char* p)
+{
+    return quint32(get16(p)) | (quint32(get16(p + 2)) << 16);
+}
+
+} // namespace
+
+ZipReader::ZipReader(QIODevice* device)
+    : device_(device)
+    , inEntry_(false)
+    , inflating_(false)
+    , stream_(new z_stream_s())
+    , dataPosition_(0)
+    , compressedLeft_(0)
+    , crc_(0)
+    , produced_(0)
+{
+}
+
+ZipReader::~ZipReader()
+{
+    closeEntry();
+}
+
+bool ZipReader::open()
+{
+    entries_.clear();
+    order_.clear();
+
+    // The end record sits in the last 22 bytes plus an optional comment
+    qint64 fileSize = device_->size();
+    qint64 tailSize = qMin<qint64>(fileSize, END_OF_CENTRAL_DIRECTORY_SIZE + MAX_COMMENT);
+    if (tailSize < END_OF_CENTRAL_DIRECTORY_SIZE || !device_->seek(fileSize - tailSize)) {
+        return fail("Not a ZIP archive");
+    }
+    QByteArray tail = device_->read(tailSize);
+
+    int end = -1;
+    for (int i = tail.size() - END_OF_CENTRAL_DIRECTORY_SIZE; i >= 0; --i) {
+        if (get32(tail.constData() + i) == END_OF_CENTRAL_DIRECTORY_SIGNATURE) {
+            end = i;
+            break;
+        }
+    }
+    if (end < 0) {
+        return fail("Not a ZIP archive (no central directory)");
+    }
+
+    const char* record = tail.constData() + end;
+    quint16 entryCount = get16(record + 10);
+    quint32 directorySize = get32(record + 12);
+    quint32 directoryOffset = get32(record + 16);
+    if (directoryOffset == 0xffffffff || entryCount == 0xffff) {
+        return fail("Zip64 archives are not supported");
+    }
+    if (qint64(directoryOffset) + directorySize > fileSize || !device_->seek(directoryOffset)) {
+        return fail("Corrupt ZIP central directory");
+    }
+
+    QByteArray directory = device_->read(directorySize);
+    if (directory.size() != qint64(directorySize)) {
+        return fail("Corrupt ZIP central directory");
+    }
+
+    int pos = 0;
+    for (int i = 0; i < entryCount; ++i) {
+        if (pos + 46 > directory.size() || get32(directory.constData() + pos) != CENTRAL_HEADER_SIGNATURE) {
+            return fail("Corrupt ZIP central directory");
+        }
+        const char* header = directory.constData() + pos;
+        quint16 flags = get16(header + 8);
+        quint16 nameLength = get16(header + 28);
+        quint16 extraLength = get16(header + 30);
+        quint16 commentLength = get16(header + 32);
+        if (pos + 46 + nameLength > directory.size()) {
+            return fail("Corrupt ZIP central directory");
+        }
+
+        Entry entry;
+        entry.method = get16(header + 10);
+        entry.crc = get32(header + 16);
+        entry.compressedSize = get32(header + 20);
+        entry.uncompressedSize = get32(header + 24);
+        entry.headerOffset = get32(header + 42);
+        if (flags & FLAG_ENCRYPTED) {
+            entry.method = 0xffff;  // rejected by openEntry
+        }
+
+        QString name = QString::fromUtf8(header + 46, nameLength);
+        entries_.insert(name, entry);
+        order_.append(name);
+        pos += 46 + nameLength + extraLength + commentLength;
+    }
+
+    return true;
+}
+
+bool ZipReader::openEntry(const QString& name)
+{
+    closeEntry();
+
+    auto it = entries_.constFind(name);
+    if (it == entries_.constEnd()) {
+        return fail("Missing archive entry: " + name);
+    }
+    const Entry& entry = it.value();
+    if (entry.method != METHOD_STORED && entry.method != METHOD_DEFLATE) {
+        return fail("Unsupported compression or encryption in " + name);
+    }
+    if (entry.compressedSize == 0xffffffff || entry.uncompressedSize == 0xffffffff) {
+        return fail("Zip64 entries are not supported: " + name);
+    }
+    if (entry.uncompressedSize > Constants::IMPORT_MAX_ENTRY_BYTES) {
+        return fail(QString("Archive entry %1 is too large (%2 bytes)").arg(name).arg(entry.uncompressedSize));
+    }
+
+    // The local header's name/extra lengths can differ from the central copy
+    char header[30];
+    if (!device_->seek(entry.headerOffset) || device_->read(header, 30) != 30
+        || get32(header) != LOCAL_HEADER_SIGNATURE) {
+        return fail("Corrupt local header for " + name);
+    }
+
+    current_ = entry;
+    currentName_ = name;
+    dataPosition_ = qint64(entry.headerOffset) + 30 + get16(header + 26) + get16(header + 28);
+    compressedLeft_ = entry.compressedSize;
+    crc_ = 0;
+    produced_ = 0;
+
+    if (entry.method == METHOD_DEFLATE) {
+        *stream_ = z_stream_s();
+        if (inflateInit2(stream_.get(), -MAX_WBITS) != Z_OK) {
+            return fail("Failed to initialise inflate");
+        }
+        inflating_ = true;
+        inBuffer_.resize(IN_CHUNK);
+    }
+
+    inEntry_ = true;
+    return true;
+}
+
+qint64 ZipReader::read(char* data, qint64 maxSize)
+{
+    if (!inEntry_) {
+        fail("No open entry");
+        return -1;
+    }
+
+    qint64 got = 0;
+    bool ended = false;
+
+    if (current_.method == METHOD_STORED) {
+        qint64 wanted = qMin<qint64>(maxSize, compressedLeft_);
+        if (wanted > 0) {
+            if (!device_->seek(dataPosition_) || (got = device_->read(data, wanted)) != wanted) {
+                fail("Truncated archive entry: " + currentName_);
+                return -1;
+            }
+            dataPosition_ += got;
+            compressedLeft_ -= quint32(got);
+        }
+        ended = compressedLeft_ == 0;
+    } else {
+        z_stream_s* stream = stream_.get();
+        stream->next_out = reinterpret_cast<Bytef*>(data);
+        stream->avail_out = uInt(maxSize);
+
+        while (stream->avail_out > 0) {
+            if (stream->avail_in == 0 && compressedLeft_ > 0) {
+                qint64 chunk = qMin<qint64>(inBuffer_.size(), compressedLeft_);
+                if (!device_->seek(dataPosition_) || device_->read(inBuffer_.data(), chunk) != chunk) {
+                    fail("Truncated archive entry: " + currentName_);
+                    return -1;
+                }
+                dataPosition_ += chunk;
+                compressedLeft_ -= quint32(chunk);
+                stream->next_in = reinterpret_cast<Bytef*>(inBuffer_.data());
+                stream->avail_in = uInt(chunk);
+            }
+
+            int status = inflate(stream, Z_NO_FLUSH);
+            if (status == Z_STREAM_END) {
+                ended = true;
+                break;
+            }
+            if (status != Z_OK) {
+                fail(QString("Corrupt compressed data in %1 (%2)").arg(currentName_).arg(status));
+                return -1;
+            }
+        }
+        got = maxSize - qint64(stream->avail_out);
+    }
+
+    if (got > 0) {
+        crc_ = quint32(crc32(crc_, reinterpret_cast<const Bytef*>(data), uInt(got)));
+        produced_ += quint64(got);
+        // The declared size bounds the inflated output, whatever the stream claims
+        if (produced_ > current_.uncompressedSize) {
+            fail("Archive entry is larger than declared: " + currentName_);
+            return -1;
+        }
+    }
+
+    if (ended && got == 0) {
+        if (crc_ != current_.crc || produced_ != current_.uncompressedSize) {
+            fail("Checksum mismatch in " + currentName_);
+            return -1;
+        }
+    } else if (ended && current_.method == METHOD_DEFLATE) {
+        // Report the end on the next call, after the checksum covers this chunk
+        compressedLeft_ = 0;
+        stream_->avail_in = 0;
+    }
+    return got;
+}
+
+bool ZipReader::readEntry(const QString& name, QByteArray& contents)
+{
+    if (!openEntry(name)) {
+        return false;
+    }
+
+    contents.clear();
+    contents.reserve(int(qMin<quint32>(current_.uncompressedSize, 64 * 1024 * 1024)));
+    char buffer[IN_CHUNK];
+    qint64 got;
+    while ((got = read(buffer, sizeof(buffer))) > 0) {
+        contents.append(buffer, got);
+    }
+    closeEntry();
+    return got == 0;
+}
+
+void ZipReader::closeEntry()
+{
+    if (inflating_) {
+        inflateEnd(stream_.get());
+        inflating_ = false;
+    }
+    inEntry_ = false;
+}
+
+bool ZipReader::fail(const QString& error)
+{
+    lastError_ = error;
+    Logger::instance().error("ZipReader", error);
+    return false;
+}
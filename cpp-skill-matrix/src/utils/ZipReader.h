@@ -0,0 +1,95 @@
+#ifndef ZIPREADER_H
+#define ZIPREADER_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QHash>
+#include <QIODevice>
+#include <memory>
+
+struct z_stream_s;
+
+/**
+ * @brief Streaming ZIP archive reader (stored and deflated entries)
+ *
+ * open() reads the central directory; an entry is then opened and read in
+ * chunks, inflating as it goes, so entries of any size are read in constant
+ * memory. Needs a random-access device. No Zip64 or encryption.
+ *
+ * Entries declared larger than IMPORT_MAX_ENTRY_BYTES are refused, and
+ * reading fails as soon as an entry inflates past its declared size.
+ */
+class ZipReader
+{
+public:
+    explicit ZipReader(QIODevice* device);
+    ~ZipReader();
+
+    ZipReader(const ZipReader&) = delete;
+    ZipReader& operator=(const ZipReader&) = delete;
+
+    /**
+     * @brief Read the central directory
+     */
+    bool open();
+
+    QStringList entryNames() const { return order_; }
+    bool contains(const QString& name) const { return entries_.contains(name); }
+
+    /**
+     * @brief Declared uncompressed size of an entry (0 if absent)
+     */
+    qint64 entrySize(const QString& name) const { return entries_.value(name).uncompressedSize; }
+
+    /**
+     * @brief Position at the start of an entry's data (closes the current one)
+     */
+    bool openEntry(const QString& name);
+
+    /**
+     * @brief Read up to maxSize uncompressed bytes of the open entry
+     * @return bytes read, 0 at the end of the entry (CRC checked), -1 on error
+     */
+    qint64 read(char* data, qint64 maxSize);
+
+    /**
+     * @brief Read a whole (small) entry
+     */
+    bool readEntry(const QString& name, QByteArray& contents);
+
+    QString lastError() const { return lastError_; }
+
+private:
+    struct Entry {
+        quint16 method = 0;
+        quint32 crc = 0;
+        quint32 compressedSize = 0;
+        quint32 uncompressedSize = 0;
+        quint32 headerOffset = 0;
+    };
+
+    void closeEntry();
+    bool fail(const QString& error);
+
+private:
+    QIODevice* device_;
+    QHash<QString, Entry> entries_;
+    QStringList order_;
+
+    // Open entry
+    Entry current_;
+    bool inEntry_;
+    bool inflating_;
+    std::unique_ptr<z_stream_s> stream_;
+    qint64 dataPosition_;
+    quint32 compressedLeft_;
+    quint32 crc_;
+    quint64 produced_;
+    QByteArray inBuffer_;
+    QString currentName_;
+
+    QString lastError_;
+};
+
+#endif // ZIPREADER_H
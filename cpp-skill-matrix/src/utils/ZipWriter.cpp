@@ -0,0 +1,238 @@
+#include "ZipWriter.h"
+#include "Logger.h"
+#include <QDateTime>
+#include <zlib.h>
+#include <limits>
+
+namespace {
+
+// Record signatures and fields (APPNOTE.TXT 4.3)
+constexpr quint32 LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr quint32 DATA_DESCRIPTOR_SIGNATURE = 0x08074b50;
+constexpr quint32 CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr quint32 END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+constexpr quint16 VERSION_NEEDED = 20;              // 2.0: deflate
+constexpr quint16 FLAG_DATA_DESCRIPTOR = 0x0008;    // sizes and CRC follow the data
+constexpr quint16 FLAG_UTF8_NAME = 0x0800;
+constexpr quint16 METHOD_DEFLATE = 8;
+constexpr int OUT_CHUNK = 65536;
+
+void put16(QByteArray& out, quint16 value)
+{
+    out.append(char(value & 0xff));
+    out.append(char((value >> 8) & 0xff));
+}
+
+void put32(QByteArray& out, quint32 value)
+{
+    put16(out, quint16(value & 0xffff));
+    put16(out, quint16(value >> 16));
+}
+
+} // namespace
+
+ZipWriter::ZipWriter(QIODevice* device, int level)
+    : device_(device)
+    , level_(level)
+    , stream_(new z_stream_s())
+    , inEntry_(false)
+    , finished_(false)
+    , offset_(0)
+    , dosTime_(0)
+    , dosDate_(0)
+{
+    // Every entry gets the archive's creation time
+    QDateTime now = QDateTime::currentDateTime();
+    QDate date = now.date();
+    QTime time = now.time();
+    dosTime_ = quint16((time.hour() << 11) | (time.minute() << 5) | (time.second() / 2));
+    dosDate_ = quint16(((qMax(date.year(), 1980) - 1980) << 9) | (date.month() << 5) | date.day());
+
+    outBuffer_.resize(OUT_CHUNK);
+}
+
+ZipWriter::~ZipWriter()
+{
+    if (inEntry_) {
+        deflateEnd(stream_.get());
+    }
+}
+
+bool ZipWriter::beginEntry(const QString& name)
+{
+    if (finished_) {
+        return fail("Archive already finished");
+    }
+    if (inEntry_ && !endEntry()) {
+        return false;
+    }
+    if (offset_ > std::numeric_limits<quint32>::max()) {
+        return fail("Archive exceeds 4 GB (Zip64 is not supported)");
+    }
+
+    Entry entry;
+    entry.name = name.toUtf8();
+    entry.offset = offset_;
+
+    // Raw deflate (negative window bits): ZIP stores no zlib header/trailer
+    *stream_ = z_stream_s();
+    if (deflateInit2(stream_.get(), level_, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return fail("Failed to initialise deflate");
+    }
+
+    QByteArray header;
+    header.reserve(30 + entry.name.size());
+    put32(header, LOCAL_HEADER_SIGNATURE);
+    put16(header, VERSION_NEEDED);
+    put16(header, FLAG_DATA_DESCRIPTOR | FLAG_UTF8_NAME);
+    put16(header, METHOD_DEFLATE);
+    put16(header, dosTime_);
+    put16(header, dosDate_);
+    put32(header, 0);  // CRC-32, in the data descriptor
+    put32(header, 0);  // compressed size, in the data descriptor
+    put32(header, 0);  // uncompressed size, in the data descriptor
+    put16(header, quint16(entry.name.size()));
+    put16(header, 0);  // extra field length
+    header.append(entry.name);
+
+    entries_.append(entry);
+    inEntry_ = true;
+    return writeRaw(header);
+}
+
+bool ZipWriter::write(const char* data, qint64 size)
+{
+    if (!inEntry_) {
+        return fail("No open entry");
+    }
+    if (size <= 0) {
+        return true;
+    }
+
+    Entry& entry = entries_.last();
+    entry.crc = quint32(crc32(entry.crc, reinterpret_cast<const Bytef*>(data), uInt(size)));
+    entry.uncompressedSize += quint64(size);
+    return deflateInput(data, size, Z_NO_FLUSH);
+}
+
+bool ZipWriter::endEntry()
+{
+    if (!inEntry_) {
+        return true;
+    }
+
+    bool ok = deflateInput(nullptr, 0, Z_FINISH);
+    deflateEnd(stream_.get());
+    inEntry_ = false;
+    if (!ok) {
+        return false;
+    }
+
+    const Entry& entry = entries_.last();
+    if (entry.compressedSize > std::numeric_limits<quint32>::max()
+        || entry.uncompressedSize > std::numeric_limits<quint32>::max()) {
+        return fail("Entry " + QString::fromUtf8(entry.name) + " exceeds 4 GB (Zip64 is not supported)");
+    }
+
+    QByteArray descriptor;
+    put32(descriptor, DATA_DESCRIPTOR_SIGNATURE);
+    put32(descriptor, entry.crc);
+    put32(descriptor, quint32(entry.compressedSize));
+    put32(descriptor, quint32(entry.uncompressedSize));
+    return writeRaw(descriptor);
+}
+
+bool ZipWriter::finish()
+{
+    if (finished_) {
+        return true;
+    }
+    if (!endEntry()) {
+        return false;
+    }
+    if (offset_ > std::numeric_limits<quint32>::max() || entries_.size() > 0xffff) {
+        return fail("Archive exceeds ZIP limits (Zip64 is not supported)");
+    }
+
+    quint64 directoryOffset = offset_;
+    QByteArray directory;
+    for (const Entry& entry : entries_) {
+        put32(directory, CENTRAL_HEADER_SIGNATURE);
+        put16(directory, VERSION_NEEDED);  // version made by (MS-DOS attributes)
+        put16(directory, VERSION_NEEDED);
+        put16(directory, FLAG_DATA_DESCRIPTOR | FLAG_UTF8_NAME);
+        put16(directory, METHOD_DEFLATE);
+        put16(directory, dosTime_);
+        put16(directory, dosDate_);
+        put32(directory, entry.crc);
+        put32(directory, quint32(entry.compressedSize));
+        put32(directory, quint32(entry.uncompressedSize));
+        put16(directory, quint16(entry.name.size()));
+        put16(directory, 0);  // extra field length
+        put16(directory, 0);  // comment length
+        put16(directory, 0);  // disk number
+        put16(directory, 0);  // internal attributes
+        put32(directory, 0);  // external attributes
+        put32(directory, quint32(entry.offset));
+        directory.append(entry.name);
+    }
+
+    QByteArray end;
+    put32(end, END_OF_CENTRAL_DIRECTORY_SIGNATURE);
+    put16(end, 0);  // this disk
+    put16(end, 0);  // disk with the central directory
+    put16(end, quint16(entries_.size()));
+    put16(end, quint16(entries_.size()));
+    put32(end, quint32(directory.size()));
+    put32(end, quint32(directoryOffset));
+    put16(end, 0);  // comment length
+
+    finished_ = true;
+    return writeRaw(directory) && writeRaw(end);
+}
+
+bool ZipWriter::deflateInput(const char* data, qint64 size, int flush)
+{
+    z_stream_s* stream = stream_.get();
+    stream->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream->avail_in = uInt(size);
+
+    // Drain until zlib has consumed the input (and, when finishing, emitted the end)
+    int status = Z_OK;
+    do {
+        stream->next_out = reinterpret_cast<Bytef*>(outBuffer_.data());
+        stream->avail_out = uInt(outBuffer_.size());
+
+        status = deflate(stream, flush);
+        if (status == Z_STREAM_ERROR) {
+            return fail("Deflate failed");
+        }
+
+        qint64 produced = outBuffer_.size() - qint64(stream->avail_out);
+        if (produced > 0) {
+            entries_.last().compressedSize += quint64(produced);
+            if (device_->write(outBuffer_.constData(), produced) != produced) {
+                return fail("Write failed: " + device_->errorString());
+            }
+            offset_ += quint64(produced);
+        }
+    } while (stream->avail_out == 0 || (flush == Z_FINISH && status != Z_STREAM_END));
+
+    return true;
+}
+
+bool ZipWriter::writeRaw(const QByteArray& data)
+{
+    if (device_->write(data) != data.size()) {
+        return fail("Write failed: " + device_->errorString());
+    }
+    offset_ += quint64(data.size());
+    return true;
+}
+
+bool ZipWriter::fail(const QString& error)
+{
+    lastError_ = error;
+    Logger::instance().error("ZipWriter", error);
+    return false;
+}
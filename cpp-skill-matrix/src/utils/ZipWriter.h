@@ -0,0 +1,80 @@
+#ifndef ZIPWRITER_H
+#define ZIPWRITER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QList>
+#include <QIODevice>
+#include <memory>
+
+struct z_stream_s;
+
+/**
+ * @brief Streaming ZIP archive writer (deflate, no seeking)
+ *
+ * Entries are written one at a time straight to the device: data is
+ * deflated as it arrives and sizes/CRC follow in a data descriptor, so
+ * nothing but the current compression window is held in memory. The
+ * central directory is written by finish(). Archives are limited to 4 GB
+ * (no Zip64).
+ */
+class ZipWriter
+{
+public:
+    explicit ZipWriter(QIODevice* device, int level = -1);
+    ~ZipWriter();
+
+    ZipWriter(const ZipWriter&) = delete;
+    ZipWriter& operator=(const ZipWriter&) = delete;
+
+    /**
+     * @brief Start a new deflated entry (ends the current one, if any)
+     */
+    bool beginEntry(const QString& name);
+
+    /**
+     * @brief Append uncompressed data to the current entry
+     */
+    bool write(const char* data, qint64 size);
+    bool write(const QByteArray& data) { return write(data.constData(), data.size()); }
+
+    /**
+     * @brief Flush the compressor and write the entry's data descriptor
+     */
+    bool endEntry();
+
+    /**
+     * @brief End the last entry and write the central directory
+     */
+    bool finish();
+
+    QString lastError() const { return lastError_; }
+
+private:
+    struct Entry {
+        QByteArray name;
+        quint32 crc = 0;
+        quint64 compressedSize = 0;
+        quint64 uncompressedSize = 0;
+        quint64 offset = 0;
+    };
+
+    bool deflateInput(const char* data, qint64 size, int flush);
+    bool writeRaw(const QByteArray& data);
+    bool fail(const QString& error);
+
+private:
+    QIODevice* device_;
+    int level_;
+    std::unique_ptr<z_stream_s> stream_;
+    QList<Entry> entries_;
+    bool inEntry_;
+    bool finished_;
+    quint64 offset_;
+    quint16 dosTime_;
+    quint16 dosDate_;
+    QByteArray outBuffer_;
+    QString lastError_;
+};
+
+#endif // ZIPWRITER_H